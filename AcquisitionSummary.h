@@ -4,6 +4,7 @@
 
 #include <QString>
 #include <QtGlobal>
+#include <QVector>
 
 /**
  * @brief Résumé statistique d'une session d'acquisition
@@ -13,8 +14,9 @@
  *   - l'affichage récapitulatif en fin de session dans la UI
  *   - l'en-tête du fichier de mesures exporté
  *
- * Les statistiques (min/max/mean) sont calculées en continu par la classe de
- * base IMeasurementSystem via updateRunningStats(), et assemblées ici par
+ * Les statistiques (min/max/mean/écart-type) sont calculées en continu par la
+ * classe de base IMeasurementSystem (Welford, voir RunningStats.h) via
+ * updateRunningStats() / updatePoseStats(), et assemblées ici par
  * buildSummary() à l'arrêt.
  */
 struct AcquisitionSummary {
@@ -29,6 +31,12 @@ struct AcquisitionSummary {
     qint64 endTimestamp    = 0;      // Horodatage de fin   (µs epoch)
     double durationSeconds = 0.0;    // Durée totale de la session (s)
 
+    // Départ commun (StartBarrier) : startTimestamp est alors le t0 partagé par
+    // tous les systèmes de la session, et firstFrameOffsetMs mesure, sur
+    // l'horloge monotone de l'hôte, le délai t0 → première frame de ce système
+    bool   synchronizedStart  = false;
+    double firstFrameOffsetMs = 0.0;   // 0 si aucune frame reçue
+
     // -------------------------------------------------------------------------
     // Frames
     // -------------------------------------------------------------------------
@@ -38,11 +46,23 @@ struct AcquisitionSummary {
 
     // -------------------------------------------------------------------------
     // Fréquence (Hz) — toujours disponible
+    //   freqMeanHz = 1 / période moyenne (et non moyenne des fréquences
+    //   instantanées, biaisée vers le haut par le jitter)
     // -------------------------------------------------------------------------
     double freqMeanHz = 0.0;
     double freqMinHz  = 0.0;
     double freqMaxHz  = 0.0;
 
+    // -------------------------------------------------------------------------
+    // Période inter-frame (ms) et jitter
+    // -------------------------------------------------------------------------
+    double periodMeanMs   = 0.0;
+    double periodJitterMs = 0.0;     // Écart-type de la période
+
+    // Déviation d'Allan de la période, une entrée par octave (τ = 2^k périodes)
+    QVector<double> allanTauS;       // τ (s)
+    QVector<double> allanDevMs;      // σ_A(τ) (ms)
+
     // -------------------------------------------------------------------------
     // Latence (ms) — conditionnelle selon le système
     //   latencyAvailable = false : le système ne peut pas mesurer la latence
@@ -52,6 +72,16 @@ struct AcquisitionSummary {
     double latencyMeanMs    = 0.0;
     double latencyMinMs     = 0.0;
     double latencyMaxMs     = 0.0;
+    double latencyStdMs     = 0.0;   // Jitter de latence (écart-type)
+
+    // -------------------------------------------------------------------------
+    // Bruit de pose — écart-type par axe sur les frames valides
+    //   Ordre : X, Y, Z (mm), Rx, Ry, Rz (degrés)
+    //   Pertinent sur objet statique (qualification du bruit du système)
+    // -------------------------------------------------------------------------
+    quint64 poseSamples      = 0;
+    double  poseMean[6]      = {};
+    double  poseStdDev[6]    = {};
 
     AcquisitionSummary() = default;
 };
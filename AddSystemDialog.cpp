@@ -3,6 +3,8 @@
 #include "SystemCardWidget.h"
 #include "KukaRsiSystem.h"
 #include "KukaRsiConfig.h"
+#include "SyntheticSystem.h"
+#include "ReplaySystem.h"
 
 #include <QVBoxLayout>
 #include <QHBoxLayout>
@@ -11,6 +13,8 @@
 #include <QPushButton>
 #include <QDialogButtonBox>
 #include <QGroupBox>
+#include <QFileDialog>
+#include <QFileInfo>
 
 AddSystemDialog::AddSystemDialog(QWidget* parent)
     : QDialog(parent)
@@ -34,7 +38,9 @@ void AddSystemDialog::buildUi()
         QStringLiteral("KUKA RSI"),
         QStringLiteral("OptiTrack"),
         QStringLiteral("Vicon"),
-        QStringLiteral("Qualisys")
+        QStringLiteral("Qualisys"),
+        QStringLiteral("Synthétique"),
+        QStringLiteral("Rejeu de session")
         });
     typeRow->addWidget(m_typeCombo, 1);
     root->addLayout(typeRow);
@@ -45,6 +51,8 @@ void AddSystemDialog::buildUi()
     buildOptitrackPage();
     buildGenericPage(QStringLiteral("Vicon"));
     buildGenericPage(QStringLiteral("Qualisys"));
+    buildSyntheticPage();
+    buildReplayPage();
     root->addWidget(m_pages);
 
     // Boutons OK / Annuler
@@ -103,6 +111,82 @@ void AddSystemDialog::buildGenericPage(const QString& label)
     m_pages->addWidget(page);
 }
 
+void AddSystemDialog::buildSyntheticPage()
+{
+    QWidget* page = new QWidget();
+    QFormLayout* form = new QFormLayout(page);
+    form->setSpacing(8);
+
+    auto spin = [](double min, double max, double value, int decimals, const QString& suffix) {
+        QDoubleSpinBox* box = new QDoubleSpinBox();
+        box->setRange(min, max);
+        box->setDecimals(decimals);
+        box->setValue(value);
+        box->setSuffix(suffix);
+        return box;
+    };
+
+    const SyntheticConfig defaults;
+    m_synthFreq     = spin(1.0, SyntheticConfig::kMaxFrequencyHz, defaults.frequencyHz, 0, QStringLiteral(" Hz"));
+    m_synthBodies   = new QSpinBox();
+    m_synthBodies->setRange(1, 256);
+    m_synthBodies->setValue(defaults.bodyCount);
+    m_synthNoiseMm  = spin(0.0, 100.0, defaults.positionNoiseMm, 3, QStringLiteral(" mm"));
+    m_synthNoiseDeg = spin(0.0, 10.0, defaults.angleNoiseDeg, 3, QStringLiteral(" °"));
+    m_synthDropout  = spin(0.0, 100.0, defaults.dropoutRate * 100.0, 2, QStringLiteral(" %"));
+    m_synthDrift    = spin(-1000.0, 1000.0, defaults.clockDriftPpm, 1, QStringLiteral(" ppm"));
+    m_synthLatency  = spin(0.0, 1000.0, defaults.latencyMs, 2, QStringLiteral(" ms"));
+
+    form->addRow(QStringLiteral("Fréquence :"), m_synthFreq);
+    form->addRow(QStringLiteral("Corps rigides :"), m_synthBodies);
+    form->addRow(QStringLiteral("Bruit position :"), m_synthNoiseMm);
+    form->addRow(QStringLiteral("Bruit angles :"), m_synthNoiseDeg);
+    form->addRow(QStringLiteral("Pertes :"), m_synthDropout);
+    form->addRow(QStringLiteral("Dérive horloge :"), m_synthDrift);
+    form->addRow(QStringLiteral("Latence :"), m_synthLatency);
+
+    m_pages->addWidget(page);
+}
+
+void AddSystemDialog::buildReplayPage()
+{
+    QWidget* page = new QWidget();
+    QFormLayout* form = new QFormLayout(page);
+    form->setSpacing(8);
+
+    QHBoxLayout* fileRow = new QHBoxLayout();
+    m_replayFile = new QLineEdit();
+    m_replayFile->setPlaceholderText(QStringLiteral("session.csv / session.bin"));
+    QPushButton* browseBtn = new QPushButton(QStringLiteral("📁"));
+    browseBtn->setFixedWidth(32);
+    fileRow->addWidget(m_replayFile, 1);
+    fileRow->addWidget(browseBtn);
+
+    connect(browseBtn, &QPushButton::clicked, this, [this]() {
+        const QString file = QFileDialog::getOpenFileName(
+            this, QStringLiteral("Choisir une session enregistrée"),
+            m_replayFile->text(), QStringLiteral("Sessions (*.csv *.bin);;Tous les fichiers (*)"));
+        if (!file.isEmpty())
+            m_replayFile->setText(file);
+        });
+
+    // 0 = au plus vite (débit maximal du pipeline)
+    m_replaySpeed = new QDoubleSpinBox();
+    m_replaySpeed->setRange(0.0, 100.0);
+    m_replaySpeed->setDecimals(2);
+    m_replaySpeed->setValue(1.0);
+    m_replaySpeed->setSuffix(QStringLiteral(" ×"));
+    m_replaySpeed->setSpecialValueText(QStringLiteral("Au plus vite"));
+
+    m_replayLoop = new QCheckBox(QStringLiteral("Rejouer en boucle"));
+
+    form->addRow(QStringLiteral("Fichier :"), fileRow);
+    form->addRow(QStringLiteral("Vitesse :"), m_replaySpeed);
+    form->addRow(QString(), m_replayLoop);
+
+    m_pages->addWidget(page);
+}
+
 void AddSystemDialog::onSystemTypeChanged(int index)
 {
     m_pages->setCurrentIndex(index);
@@ -123,6 +207,30 @@ SystemCardWidget* AddSystemDialog::createCard(QWidget* cardParent)
         auto* card = new SystemCardWidget(sys, cfg.robotName, cardParent);
         return card;
     }
+    case 4: { // Synthétique
+        SyntheticConfig cfg;
+        cfg.frequencyHz     = m_synthFreq->value();
+        cfg.bodyCount       = m_synthBodies->value();
+        cfg.positionNoiseMm = m_synthNoiseMm->value();
+        cfg.angleNoiseDeg   = m_synthNoiseDeg->value();
+        cfg.dropoutRate     = m_synthDropout->value() / 100.0;
+        cfg.clockDriftPpm   = m_synthDrift->value();
+        cfg.latencyMs       = m_synthLatency->value();
+
+        auto* sys = new SyntheticSystem(cfg, cardParent);
+        return new SystemCardWidget(sys, QStringLiteral("Synthetic"), cardParent);
+    }
+    case 5: { // Rejeu de session
+        ReplayConfig cfg;
+        cfg.filePath = m_replayFile->text().trimmed();
+        cfg.speed    = m_replaySpeed->value();
+        cfg.loop     = m_replayLoop->isChecked();
+        if (cfg.filePath.isEmpty())
+            return nullptr;
+
+        auto* sys = new ReplaySystem(cfg, cardParent);
+        return new SystemCardWidget(sys, QFileInfo(cfg.filePath).fileName(), cardParent);
+    }
     default:
         return nullptr; // OptiTrack/Vicon/Qualisys à brancher quand leurs systèmes seront prêts
     }
@@ -7,6 +7,8 @@
 #include <QStackedWidget>
 #include <QLineEdit>
 #include <QSpinBox>
+#include <QDoubleSpinBox>
+#include <QCheckBox>
 
 class SystemCardWidget;
 
@@ -27,6 +29,8 @@ private:
     void buildKukaPage();
     void buildOptitrackPage();
     void buildGenericPage(const QString& label);
+    void buildSyntheticPage();
+    void buildReplayPage();
 
     QComboBox*     m_typeCombo   = nullptr;
     QStackedWidget* m_pages      = nullptr;
@@ -39,6 +43,20 @@ private:
     // ── OptiTrack ─────────────────────────────────────────────────────────────
     QLineEdit* m_optiIp          = nullptr;
     QLineEdit* m_optiBody        = nullptr;
+
+    // ── Synthétique ───────────────────────────────────────────────────────────
+    QDoubleSpinBox* m_synthFreq    = nullptr;
+    QSpinBox*       m_synthBodies  = nullptr;
+    QDoubleSpinBox* m_synthNoiseMm = nullptr;
+    QDoubleSpinBox* m_synthNoiseDeg = nullptr;
+    QDoubleSpinBox* m_synthDropout = nullptr;
+    QDoubleSpinBox* m_synthDrift   = nullptr;
+    QDoubleSpinBox* m_synthLatency = nullptr;
+
+    // ── Rejeu de session ──────────────────────────────────────────────────────
+    QLineEdit*      m_replayFile   = nullptr;
+    QDoubleSpinBox* m_replaySpeed  = nullptr;
+    QCheckBox*      m_replayLoop   = nullptr;
 };
 
 #endif // ADDSYSTEMDIALOG_H
@@ -0,0 +1,103 @@
+#include "ClockOffsetEstimator.h"
+#include <algorithm>
+#include <cmath>
+
+void ClockOffsetEstimator::reset()
+{
+    m_started = false;
+    m_remoteOrigin = m_localOrigin = m_lastRemote = 0;
+    m_blockStart = 0;
+    m_current = BlockMinimum();
+    m_currentEmpty = true;
+    m_minima.clear();
+    m_calibrated = false;
+    m_intercept = m_slope = 0.0;
+    m_hasPrevious = false;
+    m_previousLatency = 0.0;
+    m_jitter = 0.0;
+}
+
+ClockOffsetEstimator::Estimate ClockOffsetEstimator::addSample(int64_t remoteUs, int64_t localUs)
+{
+    if (m_started && remoteUs < m_lastRemote)
+        reset();
+
+    if (!m_started) {
+        m_started      = true;
+        m_remoteOrigin = remoteUs;
+        m_localOrigin  = localUs;
+        m_blockStart   = remoteUs;
+        m_minima.reserve(static_cast<size_t>(std::max(m_settings.windowBlocks, 2)));
+    }
+    m_lastRemote = remoteUs;
+
+    // Origines soustraites en entier : doubles petits, pas de perte de précision
+    const double t = static_cast<double>(remoteUs - m_remoteOrigin);
+    const double d = static_cast<double>(localUs - m_localOrigin) - t;
+
+    // Bloc terminé : son minimum rejoint la fenêtre, l'enveloppe est réajustée
+    if (remoteUs - m_blockStart >= m_settings.blockDurationUs) {
+        if (!m_currentEmpty) {
+            if (static_cast<int>(m_minima.size()) >= std::max(m_settings.windowBlocks, 2))
+                m_minima.erase(m_minima.begin());
+            m_minima.push_back(m_current);
+            if (static_cast<int>(m_minima.size()) >= std::max(m_settings.calibrationBlocks, 2)) {
+                fitEnvelope();
+                m_calibrated = true;
+            }
+        }
+        m_blockStart   = remoteUs;
+        m_currentEmpty = true;
+    }
+    if (m_currentEmpty || d < m_current.d) {
+        m_current.t    = t;
+        m_current.d    = d;
+        m_currentEmpty = false;
+    }
+
+    Estimate estimate;
+    if (!m_calibrated)
+        return estimate;
+
+    // Sous l'enveloppe (frame plus rapide que toutes les précédentes) : latence plancher,
+    // le minimum du bloc corrigera l'enveloppe à la fin du bloc
+    const double excessUs = std::max(0.0, d - (m_intercept + m_slope * t));
+    const double latency  = m_settings.latencyFloorMs + excessUs / 1000.0;
+
+    if (m_hasPrevious)
+        m_jitter += (std::fabs(latency - m_previousLatency) - m_jitter) / 16.0;
+    m_previousLatency = latency;
+    m_hasPrevious     = true;
+
+    estimate.valid     = true;
+    estimate.latencyMs = latency;
+    estimate.jitterMs  = m_jitter;
+    return estimate;
+}
+
+void ClockOffsetEstimator::fitEnvelope()
+{
+    const double n = static_cast<double>(m_minima.size());
+
+    double meanT = 0.0, meanD = 0.0;
+    for (const BlockMinimum& m : m_minima) {
+        meanT += m.t;
+        meanD += m.d;
+    }
+    meanT /= n;
+    meanD /= n;
+
+    double sTT = 0.0, sTD = 0.0;     // Σ(t − t̄)², Σ(t − t̄)(d − d̄)
+    for (const BlockMinimum& m : m_minima) {
+        sTT += (m.t - meanT) * (m.t - meanT);
+        sTD += (m.t - meanT) * (m.d - meanD);
+    }
+    m_slope     = sTT > 0.0 ? sTD / sTT : 0.0;
+    m_intercept = meanD - m_slope * meanT;
+
+    // Enveloppe basse : aucun minimum ne doit passer sous la droite
+    double lowest = 0.0;
+    for (const BlockMinimum& m : m_minima)
+        lowest = std::min(lowest, m.d - (m_intercept + m_slope * m.t));
+    m_intercept += lowest;
+}
@@ -0,0 +1,92 @@
+#pragma once
+#ifndef CLOCKOFFSETESTIMATOR_H
+#define CLOCKOFFSETESTIMATOR_H
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Latence estimée à partir d'horodatages distants (horloge du système de mesure)
+ *
+ * Chaque frame donne d = réception locale − horodatage distant = décalage d'horloges
+ * + dérive·t + latence. Le décalage est inconnu, mais la latence est toujours positive :
+ * les frames les plus rapides dessinent l'enveloppe basse de d. On garde le minimum
+ * de d par bloc de temps, on ajuste une droite sur ces minima (moindres carrés) puis on
+ * l'abaisse sous tous les minima. Latence estimée = d − enveloppe + plancher.
+ *
+ * La partie constante de la latence (trajet de la frame la plus rapide) n'est pas
+ * observable sans horloges synchronisées : elle est fournie par latencyFloorMs
+ * (0 par défaut → latence au-dessus de la meilleure frame observée).
+ *
+ * Sans Qt : testable hors application. Un seul thread (celui de la réception).
+ */
+class ClockOffsetEstimator {
+public:
+    struct Settings {
+        int64_t blockDurationUs   = 250000;  // Un minimum de d par bloc (horloge distante)
+        int     calibrationBlocks = 8;       // Enveloppe valide après 2 s de flux
+        int     windowBlocks      = 40;      // Fenêtre glissante d'ajustement (10 s), suit la dérive
+        double  latencyFloorMs    = 0.0;     // Latence minimale connue (mesure externe)
+    };
+
+    struct Estimate {
+        bool   valid     = false;   // false pendant la calibration
+        double latencyMs = 0.0;
+        double jitterMs  = 0.0;     // Variation inter-frame lissée (RFC 3550, gain 1/16)
+    };
+
+    ClockOffsetEstimator() = default;
+    explicit ClockOffsetEstimator(const Settings& settings) : m_settings(settings) {}
+
+    void setSettings(const Settings& settings) { m_settings = settings; reset(); }
+    void reset();
+
+    /**
+     * @brief Ajoute une frame et renvoie sa latence estimée
+     * @param remoteUs Horodatage distant (µs), ex. timestamp QTM (instant caméra)
+     * @param localUs  Instant de réception local (µs, horloge monotone)
+     *
+     * Horodatage distant en recul (mesure redémarrée) : recalibration complète.
+     */
+    Estimate addSample(int64_t remoteUs, int64_t localUs);
+
+    bool   isCalibrated() const { return m_calibrated; }
+
+    /** @brief Dérive relative des horloges (ppm, locale par rapport à distante) */
+    double driftPpm() const { return m_slope * 1e6; }
+
+private:
+    struct BlockMinimum {
+        double t = 0.0;     // µs depuis la première frame (horloge distante)
+        double d = 0.0;     // µs, minimum du bloc
+    };
+
+    /** @brief Droite des moindres carrés sur les minima, abaissée sous chacun d'eux */
+    void fitEnvelope();
+
+    Settings m_settings;
+
+    bool    m_started = false;
+    int64_t m_remoteOrigin = 0;
+    int64_t m_localOrigin  = 0;
+    int64_t m_lastRemote   = 0;
+
+    // Bloc en cours
+    int64_t      m_blockStart = 0;
+    BlockMinimum m_current;
+    bool         m_currentEmpty = true;
+
+    std::vector<BlockMinimum> m_minima;   // Blocs terminés, au plus windowBlocks
+
+    // Enveloppe : d = m_intercept + m_slope·t
+    bool   m_calibrated = false;
+    double m_intercept  = 0.0;
+    double m_slope      = 0.0;
+
+    // Jitter
+    bool   m_hasPrevious     = false;
+    double m_previousLatency = 0.0;
+    double m_jitter          = 0.0;
+};
+
+#endif // CLOCKOFFSETESTIMATOR_H
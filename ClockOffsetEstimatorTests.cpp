@@ -0,0 +1,255 @@
+// ============================================================================
+// ClockOffsetEstimatorTests.cpp - Latence estimée depuis des horodatages distants
+// ============================================================================
+// Paires (horodatage distant, réception locale) synthétiques : décalage
+// d'horloges, latence minimale et dérive connus, jitter toujours positif avec
+// une frame sans jitter sur cinq (l'enveloppe basse est donc exacte).
+// Avec latencyFloorMs = latence minimale, local − distant − latence estimée
+// doit redonner le décalage injecté.
+// ============================================================================
+
+#include "ClockOffsetEstimator.h"
+#include "UnitTest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace {
+
+constexpr int64_t kPeriodUs     = 1000;               // Flux 1 kHz
+constexpr int64_t kOffsetUs     = 86400000000LL + 12345;   // Horloge locale en avance d'un jour
+constexpr int64_t kMinDelayUs   = 3500;               // Trajet de la frame la plus rapide
+constexpr double  kToleranceUs  = 2.0;                // Arrondi des horodatages entiers
+
+/**
+ * @brief Flux synthétique : local = distant + décalage + dérive·t + latence min + jitter
+ */
+class SyntheticClock {
+public:
+    struct Sample {
+        int64_t remoteUs = 0;
+        int64_t localUs  = 0;
+        int64_t jitterUs = 0;
+        double  offsetUs = 0.0;     // Décalage réel à cet instant (dérive et saut compris)
+    };
+
+    explicit SyntheticClock(int64_t remoteStartUs = 5000000, double driftPpm = 0.0)
+        : m_remoteStartUs(remoteStartUs), m_driftPpm(driftPpm) {}
+
+    /** @brief Saut de l'horloge locale de stepUs à partir de l'instant distant atUs (relatif) */
+    void setStep(int64_t atUs, int64_t stepUs) { m_stepAtUs = atUs; m_stepUs = stepUs; }
+
+    /** @brief Horloge distante redémarrée : les horodatages repartent de remoteStartUs */
+    void restartRemote(int64_t remoteStartUs)
+    {
+        m_localBaseUs   = m_lastLocalUs + kPeriodUs - remoteStartUs - kOffsetUs - kMinDelayUs;
+        m_remoteStartUs = remoteStartUs;
+        m_index = 0;
+    }
+
+    Sample next()
+    {
+        const int64_t t = m_index * kPeriodUs;
+        const int64_t jitter = (m_index % 5 == 0) ? 0 : 1 + static_cast<int64_t>(random() % 2000);
+
+        Sample s;
+        s.remoteUs = m_remoteStartUs + t;
+        s.jitterUs = jitter;
+        s.offsetUs = static_cast<double>(kOffsetUs + m_localBaseUs)
+            + m_driftPpm * 1e-6 * static_cast<double>(t)
+            + (t >= m_stepAtUs ? static_cast<double>(m_stepUs) : 0.0);
+        s.localUs = s.remoteUs + static_cast<int64_t>(std::llround(s.offsetUs)) + kMinDelayUs + jitter;
+
+        m_lastLocalUs = s.localUs;
+        ++m_index;
+        return s;
+    }
+
+    /** @brief Instant distant relatif du prochain échantillon */
+    int64_t elapsedUs() const { return m_index * kPeriodUs; }
+
+private:
+    uint32_t random()
+    {
+        m_seed = m_seed * 1664525u + 1013904223u;   // LCG : reproductible d'une exécution à l'autre
+        return m_seed >> 8;
+    }
+
+    int64_t  m_remoteStartUs;
+    double   m_driftPpm;
+    int64_t  m_index       = 0;
+    int64_t  m_localBaseUs = 0;
+    int64_t  m_lastLocalUs = 0;
+    int64_t  m_stepAtUs    = INT64_MAX;
+    int64_t  m_stepUs      = 0;
+    uint32_t m_seed        = 12345u;
+};
+
+ClockOffsetEstimator::Settings floorSettings()
+{
+    ClockOffsetEstimator::Settings settings;
+    settings.latencyFloorMs = kMinDelayUs / 1000.0;
+    return settings;
+}
+
+/** @brief Décalage déduit de l'estimation : local − distant − latence estimée */
+double fittedOffsetUs(const SyntheticClock::Sample& s, const ClockOffsetEstimator::Estimate& e)
+{
+    return static_cast<double>(s.localUs - s.remoteUs) - e.latencyMs * 1000.0;
+}
+
+/** @brief Calibration : blockDurationUs × calibrationBlocks de flux */
+int64_t calibrationUs(const ClockOffsetEstimator::Settings& settings)
+{
+    return settings.blockDurationUs * settings.calibrationBlocks;
+}
+
+} // namespace
+
+void registerClockOffsetEstimatorTests(UnitTest& tests)
+{
+    tests.add("ClockOffset/calibration", []() {
+        const ClockOffsetEstimator::Settings settings = floorSettings();
+        ClockOffsetEstimator estimator(settings);
+        SyntheticClock clock;
+
+        // Pendant la calibration : estimation invalide, latence et jitter à 0
+        bool allInvalid = true;
+        while (clock.elapsedUs() < calibrationUs(settings)) {
+            const SyntheticClock::Sample s = clock.next();
+            const ClockOffsetEstimator::Estimate e = estimator.addSample(s.remoteUs, s.localUs);
+            if (e.valid || e.latencyMs != 0.0 || e.jitterMs != 0.0)
+                allInvalid = false;
+        }
+        CHECK(allInvalid);
+        CHECK(!estimator.isCalibrated());
+
+        // Huitième bloc terminé : enveloppe ajustée dès la frame suivante
+        const SyntheticClock::Sample s = clock.next();
+        const ClockOffsetEstimator::Estimate e = estimator.addSample(s.remoteUs, s.localUs);
+        CHECK(e.valid);
+        CHECK(estimator.isCalibrated());
+        CHECK(std::fabs(fittedOffsetUs(s, e) - s.offsetUs) <= kToleranceUs);
+    });
+
+    tests.add("ClockOffset/knownOffset", []() {
+        ClockOffsetEstimator estimator(floorSettings());
+        SyntheticClock clock;
+
+        int checked = 0;
+        double worstOffsetErrorUs = 0.0;
+        double worstLatencyErrorUs = 0.0;
+        bool belowFloor = false;
+        for (int i = 0; i < 6000; ++i) {
+            const SyntheticClock::Sample s = clock.next();
+            const ClockOffsetEstimator::Estimate e = estimator.addSample(s.remoteUs, s.localUs);
+            if (!e.valid) continue;
+            ++checked;
+            worstOffsetErrorUs = std::max(worstOffsetErrorUs, std::fabs(fittedOffsetUs(s, e) - s.offsetUs));
+            // Latence = latence minimale + jitter de la frame
+            const double expectedMs = (kMinDelayUs + s.jitterUs) / 1000.0;
+            worstLatencyErrorUs = std::max(worstLatencyErrorUs, std::fabs(e.latencyMs - expectedMs) * 1000.0);
+            if (e.latencyMs < kMinDelayUs / 1000.0)
+                belowFloor = true;
+        }
+        CHECK(checked == 4000);
+        CHECK(worstOffsetErrorUs <= kToleranceUs);
+        CHECK(worstLatencyErrorUs <= kToleranceUs);
+        CHECK(!belowFloor);
+        CHECK(std::fabs(estimator.driftPpm()) < 0.1);
+
+        // Jitter lissé : positif, de l'ordre de l'écart moyen entre frames (< 2 ms)
+        const SyntheticClock::Sample s = clock.next();
+        const ClockOffsetEstimator::Estimate e = estimator.addSample(s.remoteUs, s.localUs);
+        CHECK(e.jitterMs > 0.0 && e.jitterMs < 2.0);
+    });
+
+    tests.add("ClockOffset/drift", []() {
+        ClockOffsetEstimator estimator(floorSettings());
+        SyntheticClock clock(5000000, 80.0);   // Horloge locale plus rapide de 80 ppm
+
+        double worstOffsetErrorUs = 0.0;
+        for (int i = 0; i < 12000; ++i) {
+            const SyntheticClock::Sample s = clock.next();
+            const ClockOffsetEstimator::Estimate e = estimator.addSample(s.remoteUs, s.localUs);
+            if (e.valid)
+                worstOffsetErrorUs = std::max(worstOffsetErrorUs, std::fabs(fittedOffsetUs(s, e) - s.offsetUs));
+        }
+        CHECK(std::fabs(estimator.driftPpm() - 80.0) < 1.0);
+        // Dérive extrapolée sur un bloc au plus : 80 ppm × 250 ms = 20 µs
+        CHECK(worstOffsetErrorUs <= 20.0 + kToleranceUs);
+    });
+
+    tests.add("ClockOffset/localClockStep", []() {
+        const ClockOffsetEstimator::Settings settings = floorSettings();
+        ClockOffsetEstimator estimator(settings);
+        SyntheticClock clock;
+
+        // Horloge locale avancée de 5 ms en début de bloc, à t = 5 s
+        const int64_t stepAtUs = 5000000;
+        const int64_t stepUs   = 5000;
+        clock.setStep(stepAtUs, stepUs);
+
+        // Bloc du saut : enveloppe encore ajustée sur l'ancien décalage, le saut
+        // apparaît tel quel dans la latence
+        double worstStepErrorUs = 0.0;
+        while (clock.elapsedUs() < stepAtUs + settings.blockDurationUs) {
+            const SyntheticClock::Sample s = clock.next();
+            const ClockOffsetEstimator::Estimate e = estimator.addSample(s.remoteUs, s.localUs);
+            if (clock.elapsedUs() <= stepAtUs) continue;
+            const double expectedMs = (kMinDelayUs + stepUs + s.jitterUs) / 1000.0;
+            worstStepErrorUs = std::max(worstStepErrorUs, std::fabs(e.latencyMs - expectedMs) * 1000.0);
+        }
+        CHECK(worstStepErrorUs <= kToleranceUs);
+
+        // Fenêtre glissante entièrement après le saut : nouveau décalage retrouvé
+        const int64_t settledUs = stepAtUs + settings.blockDurationUs * (settings.windowBlocks + 2);
+        while (clock.elapsedUs() < settledUs) {
+            const SyntheticClock::Sample s = clock.next();
+            estimator.addSample(s.remoteUs, s.localUs);
+        }
+
+        double worstOffsetErrorUs = 0.0;
+        for (int i = 0; i < 1000; ++i) {
+            const SyntheticClock::Sample s = clock.next();
+            const ClockOffsetEstimator::Estimate e = estimator.addSample(s.remoteUs, s.localUs);
+            CHECK(e.valid);
+            worstOffsetErrorUs = std::max(worstOffsetErrorUs, std::fabs(fittedOffsetUs(s, e) - s.offsetUs));
+        }
+        CHECK(worstOffsetErrorUs <= kToleranceUs);
+    });
+
+    tests.add("ClockOffset/remoteRestart", []() {
+        const ClockOffsetEstimator::Settings settings = floorSettings();
+        ClockOffsetEstimator estimator(settings);
+        SyntheticClock clock;
+
+        for (int i = 0; i < 4000; ++i) {
+            const SyntheticClock::Sample s = clock.next();
+            estimator.addSample(s.remoteUs, s.localUs);
+        }
+        CHECK(estimator.isCalibrated());
+
+        // Mesure redémarrée : horodatages distants en recul, nouveau décalage
+        clock.restartRemote(0);
+        bool allInvalid = true;
+        while (clock.elapsedUs() < calibrationUs(settings)) {
+            const SyntheticClock::Sample s = clock.next();
+            const ClockOffsetEstimator::Estimate e = estimator.addSample(s.remoteUs, s.localUs);
+            if (e.valid || e.latencyMs != 0.0)
+                allInvalid = false;
+        }
+        CHECK(allInvalid);
+        CHECK(!estimator.isCalibrated());
+
+        double worstOffsetErrorUs = 0.0;
+        for (int i = 0; i < 1000; ++i) {
+            const SyntheticClock::Sample s = clock.next();
+            const ClockOffsetEstimator::Estimate e = estimator.addSample(s.remoteUs, s.localUs);
+            CHECK(e.valid);
+            worstOffsetErrorUs = std::max(worstOffsetErrorUs, std::fabs(fittedOffsetUs(s, e) - s.offsetUs));
+        }
+        CHECK(worstOffsetErrorUs <= kToleranceUs);
+    });
+}
@@ -1,5 +1,7 @@
 #include "CoordinateConverter.h"
+#include "EulerBatch.h"
 #include <algorithm>
+#include <vector>
 
 MeasurementFrame CoordinateConverter::applyConvention(
     const MeasurementFrame& frame,
@@ -59,6 +61,47 @@ MeasurementFrame CoordinateConverter::applyConvention(
     return converted;
 }
 
+void CoordinateConverter::applyConventionBatch(
+    QVector<MeasurementFrame>& frames,
+    const AngleConvention& convention)
+{
+    // Traitement par blocs : tampons SoA de taille borne, rutiliss
+    constexpr int kBlock = 1024;
+    std::vector<double> qx(kBlock), qy(kBlock), qz(kBlock), qw(kBlock);
+    std::vector<double> a(kBlock), b(kBlock), c(kBlock);
+    std::vector<int>    index(kBlock);
+
+    const int total = frames.size();
+    int next = 0;
+    while (next < total) {
+        // Rassembler les quaternions du bloc
+        int count = 0;
+        for (; next < total && count < kBlock; ++next) {
+            MeasurementFrame& frame = frames[next];
+            if (!frame.quaternion.valid) {
+                frame = applyConvention(frame, convention);
+                continue;
+            }
+            qx[count] = frame.quaternion.x;
+            qy[count] = frame.quaternion.y;
+            qz[count] = frame.quaternion.z;
+            qw[count] = frame.quaternion.w;
+            index[count] = next;
+            ++count;
+        }
+
+        EulerBatch::quaternionsToEuler(qx.data(), qy.data(), qz.data(), qw.data(),
+            count, convention.order, a.data(), b.data(), c.data());
+
+        for (int i = 0; i < count; ++i) {
+            MeasurementFrame& frame = frames[index[i]];
+            frame.rx = a[i];
+            frame.ry = b[i];
+            frame.rz = c[i];
+        }
+    }
+}
+
 QString CoordinateConverter::getCSVHeader(
     const QString& systemName,
     const AngleConvention& convention,
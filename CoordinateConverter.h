@@ -20,6 +20,16 @@ public:
         const MeasurementFrame& frame,
         const AngleConvention& convention);
 
+    /**
+     * @brief Applique une convention d'angles  un lot de frames (rexport d'enregistrements)
+     * Frames avec quaternion : A, B, C recalculs par dcomposition dans l'ordre de
+     * la convention (EulerBatch, vectoris), rangs comme applyConvention (rx=A, ry=B, rz=C).
+     * Frames sans quaternion : applyConvention (rorganisation des angles).
+     */
+    static void applyConventionBatch(
+        QVector<MeasurementFrame>& frames,
+        const AngleConvention& convention);
+
     /**
      * @brief Gnre l'en-tte CSV pour un systme avec convention
      * @param systemName Nom du systme (ex: "OptiTrack")
@@ -0,0 +1,391 @@
+#include "DatagramCapture.h"
+#include <chrono>
+#include <cstring>
+
+namespace {
+
+// Format pcap classique (https://www.tcpdump.org/manpages/pcap-savefile.5.html)
+constexpr uint32_t kMagicMicroseconds = 0xA1B2C3D4;
+constexpr uint32_t kMagicNanoseconds  = 0xA1B23C4D;
+constexpr uint32_t kSnapLength        = 65535;
+
+enum LinkType : uint32_t {
+    LinkEthernet  = 1,
+    LinkRaw       = 101,
+    LinkLinuxSll  = 113,
+    LinkIpv4      = 228
+};
+
+constexpr int kIpv4HeaderSize = 20;
+constexpr int kUdpHeaderSize  = 8;
+
+void put16be(char* p, uint16_t v)
+{
+    p[0] = static_cast<char>(v >> 8);
+    p[1] = static_cast<char>(v);
+}
+
+void put32be(char* p, uint32_t v)
+{
+    put16be(p, static_cast<uint16_t>(v >> 16));
+    put16be(p + 2, static_cast<uint16_t>(v));
+}
+
+void put32le(char* p, uint32_t v)
+{
+    p[0] = static_cast<char>(v);
+    p[1] = static_cast<char>(v >> 8);
+    p[2] = static_cast<char>(v >> 16);
+    p[3] = static_cast<char>(v >> 24);
+}
+
+uint16_t get16be(const unsigned char* p)
+{
+    return static_cast<uint16_t>((p[0] << 8) | p[1]);
+}
+
+uint32_t get32be(const unsigned char* p)
+{
+    return (static_cast<uint32_t>(get16be(p)) << 16) | get16be(p + 2);
+}
+
+uint16_t ipv4Checksum(const char* header)
+{
+    uint32_t sum = 0;
+    for (int i = 0; i < kIpv4HeaderSize; i += 2)
+        sum += get16be(reinterpret_cast<const unsigned char*>(header + i));
+    while (sum >> 16)
+        sum = (sum & 0xFFFF) + (sum >> 16);
+    return static_cast<uint16_t>(~sum);
+}
+
+} // namespace
+
+// =============================================================================
+// DatagramCapture
+// =============================================================================
+
+DatagramCapture::~DatagramCapture()
+{
+    close();
+}
+
+int64_t DatagramCapture::nowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+bool DatagramCapture::open(const std::string& path)
+{
+    close();
+
+    std::lock_guard<std::mutex> lock(m_producerMutex);
+    m_file = std::fopen(path.c_str(), "wb");
+    if (!m_file) {
+        m_lastError = "Cannot create capture file " + path;
+        return false;
+    }
+    m_buffer.resize(1 << 20);
+    std::setvbuf(m_file, m_buffer.data(), _IOFBF, m_buffer.size());
+
+    // En-tête global, ordre natif little-endian (x86 / x64)
+    char header[24];
+    put32le(header,      kMagicNanoseconds);
+    put32le(header + 4,  2 | (4u << 16));      // Version 2.4
+    put32le(header + 8,  0);                   // thiszone
+    put32le(header + 12, 0);                   // sigfigs
+    put32le(header + 16, kSnapLength);
+    put32le(header + 20, LinkIpv4);
+    std::fwrite(header, 1, sizeof(header), m_file);
+    std::fflush(m_file);
+
+    // Emplacements et charges utiles réservés ici : aucune allocation en réception
+    // (datagrammes jusqu'à kSlotReserveBytes)
+    m_queue = std::make_unique<SpscRing<Pending>>(kQueueCapacity);
+    for (std::size_t i = 0; i < m_queue->capacity(); ++i) {
+        m_queue->beginWrite()->payload.reserve(kSlotReserveBytes);
+        m_queue->commitWrite();
+        m_queue->front();
+        m_queue->popFront();
+    }
+
+    m_packets     = 0;
+    m_dropped     = 0;
+    m_ipId        = 0;
+    m_lastFlushNs = nowNs();
+    m_lastError.clear();
+
+    m_writerRunning = true;
+    m_writer = std::thread([this]() { writerLoop(); });
+    m_accepting.store(true, std::memory_order_release);
+    return true;
+}
+
+void DatagramCapture::close()
+{
+    std::lock_guard<std::mutex> lock(m_producerMutex);
+    m_accepting.store(false, std::memory_order_release);
+
+    // Le thread d'écriture vide la file avant de sortir
+    m_writerRunning = false;
+    if (m_writer.joinable())
+        m_writer.join();
+
+    if (m_file) {
+        std::fclose(m_file);
+        m_file = nullptr;
+    }
+    m_queue.reset();
+}
+
+void DatagramCapture::record(const char* payload, int length,
+    uint32_t srcIp, uint16_t srcPort, uint32_t dstIp, uint16_t dstPort,
+    int64_t timestampNs)
+{
+    if (length < 0 || !m_accepting.load(std::memory_order_acquire))
+        return;
+    if (timestampNs == 0)
+        timestampNs = nowNs();
+
+    std::lock_guard<std::mutex> lock(m_producerMutex);
+    if (!m_accepting.load(std::memory_order_relaxed))
+        return;
+
+    Pending* slot = m_queue->beginWrite();
+    if (!slot) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    const int maxPayload = static_cast<int>(kSnapLength) - kIpv4HeaderSize - kUdpHeaderSize;
+    slot->timestampNs = timestampNs;
+    slot->srcIp       = srcIp;
+    slot->srcPort     = srcPort;
+    slot->dstIp       = dstIp;
+    slot->dstPort     = dstPort;
+    slot->length      = length;
+    slot->payload.assign(payload, payload + (length < maxPayload ? length : maxPayload));
+    m_queue->commitWrite();
+}
+
+// =============================================================================
+// Thread d'écriture
+// =============================================================================
+
+void DatagramCapture::writerLoop()
+{
+    while (m_writerRunning.load(std::memory_order_acquire)) {
+        drainQueue();
+
+        const int64_t now = nowNs();
+        if (now - m_lastFlushNs >= kFlushIntervalMs * 1000000LL) {
+            std::fflush(m_file);
+            m_lastFlushNs = now;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(kWriterIntervalMs));
+    }
+
+    // Datagrammes reçus avant close()
+    drainQueue();
+    std::fflush(m_file);
+}
+
+void DatagramCapture::drainQueue()
+{
+    while (const Pending* datagram = m_queue->front()) {
+        writeRecord(*datagram);
+        m_queue->popFront();
+    }
+}
+
+void DatagramCapture::writeRecord(const Pending& datagram)
+{
+    const int      length       = datagram.length;
+    const uint32_t packetSize   = static_cast<uint32_t>(kIpv4HeaderSize + kUdpHeaderSize + length);
+    const uint32_t capturedSize = packetSize < kSnapLength ? packetSize : kSnapLength;
+
+    m_record.resize(16 + capturedSize);
+    char* p = m_record.data();
+
+    // En-tête d'enregistrement pcap
+    put32le(p,      static_cast<uint32_t>(datagram.timestampNs / 1000000000));
+    put32le(p + 4,  static_cast<uint32_t>(datagram.timestampNs % 1000000000));
+    put32le(p + 8,  capturedSize);
+    put32le(p + 12, packetSize);
+    p += 16;
+
+    // IPv4 (sans options) puis UDP (somme de contrôle 0 = absente)
+    std::memset(p, 0, kIpv4HeaderSize + kUdpHeaderSize);
+    p[0] = 0x45;
+    put16be(p + 2, static_cast<uint16_t>(packetSize > 0xFFFF ? 0xFFFF : packetSize));
+    put16be(p + 4, m_ipId++);
+    p[8] = 64;                                  // TTL
+    p[9] = 17;                                  // UDP
+    put32be(p + 12, datagram.srcIp);
+    put32be(p + 16, datagram.dstIp);
+    put16be(p + 10, ipv4Checksum(p));
+
+    char* udp = p + kIpv4HeaderSize;
+    put16be(udp,     datagram.srcPort);
+    put16be(udp + 2, datagram.dstPort);
+    put16be(udp + 4, static_cast<uint16_t>(kUdpHeaderSize + length));
+
+    if (!datagram.payload.empty())
+        std::memcpy(udp + kUdpHeaderSize, datagram.payload.data(),
+            capturedSize - kIpv4HeaderSize - kUdpHeaderSize);
+
+    std::fwrite(m_record.data(), 1, m_record.size(), m_file);
+    m_packets.fetch_add(1, std::memory_order_relaxed);
+}
+
+// =============================================================================
+// DatagramCaptureReader
+// =============================================================================
+
+DatagramCaptureReader::~DatagramCaptureReader()
+{
+    close();
+}
+
+bool DatagramCaptureReader::open(const std::string& path)
+{
+    close();
+
+    m_file = std::fopen(path.c_str(), "rb");
+    if (!m_file) {
+        m_lastError = "Cannot open capture file " + path;
+        return false;
+    }
+    if (!rewind()) {
+        close();
+        return false;
+    }
+    m_lastError.clear();
+    return true;
+}
+
+void DatagramCaptureReader::close()
+{
+    if (m_file) {
+        std::fclose(m_file);
+        m_file = nullptr;
+    }
+}
+
+bool DatagramCaptureReader::rewind()
+{
+    if (!m_file)
+        return false;
+
+    std::rewind(m_file);
+    unsigned char header[24];
+    if (std::fread(header, 1, sizeof(header), m_file) != sizeof(header)) {
+        m_lastError = "Truncated pcap header";
+        return false;
+    }
+
+    const uint32_t magic = static_cast<uint32_t>(header[0]) | (static_cast<uint32_t>(header[1]) << 8)
+                         | (static_cast<uint32_t>(header[2]) << 16) | (static_cast<uint32_t>(header[3]) << 24);
+    if (magic == kMagicMicroseconds || magic == kMagicNanoseconds) {
+        m_swapped = false;
+    }
+    else if (get32be(header) == kMagicMicroseconds || get32be(header) == kMagicNanoseconds) {
+        m_swapped = true;
+    }
+    else {
+        m_lastError = "Not a pcap file (pcapng is not supported, save as pcap)";
+        return false;
+    }
+    m_nanoseconds = read32(header) == kMagicNanoseconds;
+    m_linkType    = read32(header + 20) & 0x0FFFFFFF;
+
+    if (m_linkType != LinkEthernet && m_linkType != LinkRaw
+        && m_linkType != LinkLinuxSll && m_linkType != LinkIpv4) {
+        m_lastError = "Unsupported pcap link type " + std::to_string(m_linkType);
+        return false;
+    }
+    return true;
+}
+
+uint32_t DatagramCaptureReader::read32(const unsigned char* p) const
+{
+    return m_swapped ? get32be(p)
+                     : static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8)
+                     | (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+bool DatagramCaptureReader::next(Datagram& datagram)
+{
+    if (!m_file)
+        return false;
+
+    for (;;) {
+        unsigned char record[16];
+        if (std::fread(record, 1, sizeof(record), m_file) != sizeof(record))
+            return false;
+
+        const uint32_t seconds  = read32(record);
+        const uint32_t fraction = read32(record + 4);
+        const uint32_t captured = read32(record + 8);
+        if (captured > 0x40000) {
+            m_lastError = "Corrupted pcap record";
+            return false;
+        }
+        m_packet.resize(captured);
+        if (captured > 0 && std::fread(m_packet.data(), 1, captured, m_file) != captured)
+            return false;
+
+        const unsigned char* p   = reinterpret_cast<const unsigned char*>(m_packet.data());
+        const unsigned char* end = p + captured;
+
+        // Couche liaison → début de l'en-tête IPv4
+        uint16_t etherType = 0x0800;
+        if (m_linkType == LinkEthernet) {
+            if (end - p < 14) continue;
+            etherType = get16be(p + 12);
+            p += 14;
+            while (etherType == 0x8100 && end - p >= 4) {   // VLAN 802.1Q
+                etherType = get16be(p + 2);
+                p += 4;
+            }
+        }
+        else if (m_linkType == LinkLinuxSll) {
+            if (end - p < 16) continue;
+            etherType = get16be(p + 14);
+            p += 16;
+        }
+        if (etherType != 0x0800 || end - p < kIpv4HeaderSize || (p[0] >> 4) != 4)
+            continue;
+
+        const int      ipHeaderSize = (p[0] & 0x0F) * 4;
+        const uint16_t fragment     = get16be(p + 6);
+        if (p[9] != 17 || ipHeaderSize < kIpv4HeaderSize || (fragment & 0x3FFF) != 0)
+            continue;   // Non UDP, ou fragment (MF ou décalage non nul)
+        if (end - p < ipHeaderSize + kUdpHeaderSize)
+            continue;
+
+        const unsigned char* udp = p + ipHeaderSize;
+        const uint16_t udpLength = get16be(udp + 4);
+        if (udpLength < kUdpHeaderSize)
+            continue;
+        const std::ptrdiff_t available = end - (udp + kUdpHeaderSize);
+        const std::ptrdiff_t payload   = udpLength - kUdpHeaderSize;
+
+        datagram.timestampNs = static_cast<int64_t>(seconds) * 1000000000LL
+                             + (m_nanoseconds ? fraction : fraction * 1000LL);
+        datagram.srcIp   = get32be(p + 12);
+        datagram.dstIp   = get32be(p + 16);
+        datagram.srcPort = get16be(udp);
+        datagram.dstPort = get16be(udp + 2);
+        datagram.payload = reinterpret_cast<const char*>(udp + kUdpHeaderSize);
+        datagram.length  = static_cast<std::size_t>(payload < available ? payload : available);
+        return true;
+    }
+}
+
+std::string DatagramCaptureReader::formatIp(uint32_t ip)
+{
+    return std::to_string(ip >> 24) + "." + std::to_string((ip >> 16) & 0xFF) + "."
+         + std::to_string((ip >> 8) & 0xFF) + "." + std::to_string(ip & 0xFF);
+}
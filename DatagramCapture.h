@@ -0,0 +1,162 @@
+#pragma once
+#ifndef DATAGRAMCAPTURE_H
+#define DATAGRAMCAPTURE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "SpscRing.h"
+
+/**
+ * @brief Capture brute des datagrammes reçus, au format pcap (lisible par Wireshark)
+ *
+ * Branchée sur NativeUdpSocket (setCapture) : chaque datagramme reçu est ajouté tel
+ * quel, avec son horodatage et ses adresses source / destination, dans un fichier
+ * en ajout seul. Les en-têtes IPv4 + UDP sont reconstitués (LINKTYPE_IPV4) pour que
+ * Wireshark dissèque directement le flux RSI (XML) ou NatNet.
+ *
+ * Horodatage : horloge système (ns depuis epoch), pris au retour de recvfrom.
+ * Winsock n'expose pas d'horodatage noyau par datagramme via recvfrom ; l'écart
+ * reste celui du réveil du thread de réception, déjà mesuré par les métriques.
+ *
+ * Aucune entrée/sortie dans le thread de réception : record() copie le datagramme
+ * dans un emplacement préalloué d'une file SPSC et rend la main ; un thread
+ * d'écriture dédié vide la file toutes les kWriterIntervalMs, construit les
+ * enregistrements pcap et vide le fichier au plus toutes les kFlushIntervalMs. Un
+ * disque lent ne retarde donc ni le décodage ni l'ACK RSI : file pleine, le
+ * datagramme n'est pas capturé (droppedCount()).
+ *
+ * Plusieurs sockets (commande + données NatNet) peuvent partager une capture : les
+ * producteurs sont sérialisés par un mutex qui ne couvre que la copie en mémoire.
+ *
+ * Sans Qt, comme NativeUdpSocket.
+ */
+class DatagramCapture {
+public:
+    DatagramCapture() = default;
+    ~DatagramCapture();
+
+    DatagramCapture(const DatagramCapture&) = delete;
+    DatagramCapture& operator=(const DatagramCapture&) = delete;
+
+    /** @brief Crée (ou écrase) le fichier et écrit l'en-tête pcap */
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return m_accepting.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Ajoute un datagramme reçu (copie en file, sans entrée/sortie)
+     * @param srcIp, dstIp Adresses IPv4 dans l'ordre de l'hôte (0x7F000001 = 127.0.0.1)
+     * @param timestampNs  0 = maintenant (horloge système)
+     */
+    void record(const char* payload, int length,
+        uint32_t srcIp, uint16_t srcPort, uint32_t dstIp, uint16_t dstPort,
+        int64_t timestampNs = 0);
+
+    /** @brief Paquets écrits dans le fichier */
+    uint64_t packetCount() const { return m_packets.load(std::memory_order_relaxed); }
+
+    /** @brief Datagrammes non capturés, file pleine (écriture en retard) */
+    uint64_t droppedCount() const { return m_dropped.load(std::memory_order_relaxed); }
+
+    const std::string& lastError() const { return m_lastError; }
+
+    static int64_t nowNs();
+
+    static constexpr int         kFlushIntervalMs  = 250;
+    static constexpr int         kWriterIntervalMs = 10;
+    static constexpr std::size_t kQueueCapacity    = 1024;
+    static constexpr std::size_t kSlotReserveBytes = 4096;  // Au-delà : allocation à la première fois
+
+private:
+    /** @brief Datagramme en attente d'écriture (emplacement de la file) */
+    struct Pending {
+        int64_t           timestampNs = 0;
+        uint32_t          srcIp   = 0;
+        uint32_t          dstIp   = 0;
+        uint16_t          srcPort = 0;
+        uint16_t          dstPort = 0;
+        int               length  = 0;      // Taille reçue (payload : tronquée à la snaplen)
+        std::vector<char> payload;
+    };
+
+    void writerLoop();
+    void drainQueue();
+    void writeRecord(const Pending& datagram);
+
+    std::mutex                         m_producerMutex;     // record() / open() / close()
+    std::unique_ptr<SpscRing<Pending>> m_queue;
+    std::atomic<bool>                  m_accepting{ false };
+    std::atomic<bool>                  m_writerRunning{ false };
+    std::thread                        m_writer;
+
+    // Thread d'écriture uniquement (après open())
+    std::FILE*         m_file = nullptr;
+    std::vector<char>  m_buffer;            // Tampon stdio (setvbuf)
+    std::vector<char>  m_record;            // En-têtes + charge utile d'un paquet
+    int64_t            m_lastFlushNs = 0;
+    uint16_t           m_ipId = 0;
+
+    std::atomic<uint64_t> m_packets{ 0 };
+    std::atomic<uint64_t> m_dropped{ 0 };
+    std::string           m_lastError;
+};
+
+/**
+ * @brief Lecture séquentielle d'un fichier pcap : datagrammes UDP/IPv4
+ *
+ * Accepte les captures de DatagramCapture comme celles de Wireshark / tcpdump :
+ * pcap classique µs ou ns, les deux ordres d'octets, liens Ethernet (VLAN 802.1Q
+ * compris), Linux cooked (SLL), IP brut et IPv4. Les paquets non UDP, non IPv4 ou
+ * fragmentés sont ignorés.
+ */
+class DatagramCaptureReader {
+public:
+    struct Datagram {
+        int64_t     timestampNs = 0;   // Depuis epoch
+        uint32_t    srcIp   = 0;       // Ordre de l'hôte
+        uint16_t    srcPort = 0;
+        uint32_t    dstIp   = 0;
+        uint16_t    dstPort = 0;
+        const char* payload = nullptr; // Valide jusqu'au prochain next()
+        std::size_t length  = 0;
+    };
+
+    DatagramCaptureReader() = default;
+    ~DatagramCaptureReader();
+
+    DatagramCaptureReader(const DatagramCaptureReader&) = delete;
+    DatagramCaptureReader& operator=(const DatagramCaptureReader&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+
+    /** @brief Revient au premier paquet */
+    bool rewind();
+
+    /** @brief Datagramme UDP suivant ; false en fin de fichier (ou si tronqué) */
+    bool next(Datagram& datagram);
+
+    const std::string& lastError() const { return m_lastError; }
+
+    static std::string formatIp(uint32_t ip);
+
+private:
+    uint32_t read32(const unsigned char* p) const;
+
+    std::FILE*         m_file = nullptr;
+    bool               m_swapped = false;
+    bool               m_nanoseconds = false;
+    uint32_t           m_linkType = 0;
+    std::vector<char>  m_packet;
+    std::string        m_lastError;
+};
+
+#endif // DATAGRAMCAPTURE_H
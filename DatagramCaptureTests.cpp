@@ -0,0 +1,70 @@
+// ============================================================================
+// DatagramCaptureTests.cpp - Capture pcap asynchrone et relecture
+// ============================================================================
+// record() ne fait que copier en file : les paquets doivent se retrouver dans le
+// fichier, dans l'ordre et intacts, une fois la capture fermée.
+// ============================================================================
+
+#include "DatagramCapture.h"
+#include "UnitTest.h"
+
+#include <cstdio>
+#include <string>
+
+namespace {
+
+std::string temporaryPath(const char* name)
+{
+    return std::string(name) + ".test.pcap";
+}
+
+} // namespace
+
+void registerDatagramCaptureTests(UnitTest& tests)
+{
+    tests.add("DatagramCapture/roundTrip", []() {
+        const std::string path = temporaryPath("DatagramCapture_roundTrip");
+        const std::string rob   = "<Rob Type=\"KUKA\"><IPOC>123456</IPOC></Rob>";
+        const std::string large(DatagramCapture::kSlotReserveBytes * 3, 'x');   // Au-delà de la réserve
+
+        {
+            DatagramCapture capture;
+            CHECK(capture.open(path));
+            CHECK(capture.isOpen());
+            capture.record(rob.data(), static_cast<int>(rob.size()),
+                0xC0A80101, 49152, 0x7F000001, 6008, 1000000000123LL);
+            capture.record(large.data(), static_cast<int>(large.size()),
+                0xC0A80102, 1511, 0, 1511, 1000000000456LL);
+            capture.record("", 0, 0x0A000001, 1, 0x0A000002, 2, 1000000000789LL);
+            capture.close();
+            CHECK(!capture.isOpen());
+            CHECK(capture.packetCount() == 3);
+            CHECK(capture.droppedCount() == 0);
+
+            // Fermée : plus rien n'est accepté
+            capture.record(rob.data(), static_cast<int>(rob.size()), 1, 1, 1, 1);
+            CHECK(capture.packetCount() == 3);
+        }
+
+        DatagramCaptureReader reader;
+        CHECK(reader.open(path));
+        DatagramCaptureReader::Datagram datagram;
+
+        CHECK(reader.next(datagram));
+        CHECK(std::string(datagram.payload, datagram.length) == rob);
+        CHECK(datagram.srcIp == 0xC0A80101 && datagram.srcPort == 49152);
+        CHECK(datagram.dstIp == 0x7F000001 && datagram.dstPort == 6008);
+        CHECK(datagram.timestampNs == 1000000000123LL);
+
+        CHECK(reader.next(datagram));
+        CHECK(std::string(datagram.payload, datagram.length) == large);
+
+        CHECK(reader.next(datagram));
+        CHECK(datagram.length == 0 && datagram.srcIp == 0x0A000001);
+        CHECK(datagram.timestampNs == 1000000000789LL);
+
+        CHECK(!reader.next(datagram));
+        reader.close();
+        std::remove(path.c_str());
+    });
+}
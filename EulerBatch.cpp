@@ -0,0 +1,179 @@
+#include "EulerBatch.h"
+#include "EulerBatchKernel.h"
+#include <cmath>
+
+#if defined(_M_X64) || defined(__x86_64__) || defined(_M_IX86) || defined(__i386__)
+#define EULERBATCH_X86 1
+#include <emmintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+using EulerBatchDetail::AxisPermutation;
+
+namespace {
+
+// =============================================================================
+// Jeux d'opérations
+// =============================================================================
+
+struct ScalarOps {
+    using V = double;
+    using M = bool;
+    static constexpr int kWidth = 1;
+
+    static V load(const double* p) { return *p; }
+    static void store(double* p, V v) { *p = v; }
+    static V set1(double v) { return v; }
+    static V add(V a, V b) { return a + b; }
+    static V sub(V a, V b) { return a - b; }
+    static V mul(V a, V b) { return a * b; }
+    static V div(V a, V b) { return a / b; }
+    static V sqrt(V a) { return std::sqrt(a); }
+    static V abs(V a) { return std::fabs(a); }
+    static V neg(V a) { return -a; }
+    static V min(V a, V b) { return a < b ? a : b; }
+    static V max(V a, V b) { return a > b ? a : b; }
+    static M gt(V a, V b) { return a > b; }
+    static M lt(V a, V b) { return a < b; }
+    static V select(M m, V a, V b) { return m ? a : b; }
+};
+
+#if defined(EULERBATCH_X86)
+struct Sse2Ops {
+    using V = __m128d;
+    using M = __m128d;
+    static constexpr int kWidth = 2;
+
+    static V load(const double* p) { return _mm_loadu_pd(p); }
+    static void store(double* p, V v) { _mm_storeu_pd(p, v); }
+    static V set1(double v) { return _mm_set1_pd(v); }
+    static V add(V a, V b) { return _mm_add_pd(a, b); }
+    static V sub(V a, V b) { return _mm_sub_pd(a, b); }
+    static V mul(V a, V b) { return _mm_mul_pd(a, b); }
+    static V div(V a, V b) { return _mm_div_pd(a, b); }
+    static V sqrt(V a) { return _mm_sqrt_pd(a); }
+    static V abs(V a) { return _mm_andnot_pd(_mm_set1_pd(-0.0), a); }
+    static V neg(V a) { return _mm_xor_pd(a, _mm_set1_pd(-0.0)); }
+    static V min(V a, V b) { return _mm_min_pd(a, b); }
+    static V max(V a, V b) { return _mm_max_pd(a, b); }
+    static M gt(V a, V b) { return _mm_cmpgt_pd(a, b); }
+    static M lt(V a, V b) { return _mm_cmplt_pd(a, b); }
+    static V select(M m, V a, V b) { return _mm_or_pd(_mm_and_pd(m, a), _mm_andnot_pd(m, b)); }
+};
+#endif
+
+// =============================================================================
+// Ordre des axes et détection du processeur
+// =============================================================================
+
+AxisPermutation permutationFor(AngleConvention::AxisOrder order)
+{
+    // (i, j, k) : indices des axes de A, B, C ; s = +1 si permutation circulaire
+    switch (order) {
+    case AngleConvention::RxRyRz: return { 0, 1, 2,  1.0 };
+    case AngleConvention::RzRyRx: return { 2, 1, 0, -1.0 };
+    case AngleConvention::RzRxRy: return { 2, 0, 1,  1.0 };
+    case AngleConvention::RyRxRz: return { 1, 0, 2, -1.0 };
+    case AngleConvention::RyRzRx: return { 1, 2, 0,  1.0 };
+    case AngleConvention::RxRzRy: return { 0, 2, 1, -1.0 };
+    }
+    return { 2, 1, 0, -1.0 };
+}
+
+EulerBatch::Isa detectIsa()
+{
+#if defined(EULERBATCH_X86)
+#if defined(_MSC_VER)
+    int info[4] = {};
+    __cpuid(info, 0);
+    const int maxLeaf = info[0];
+
+    __cpuid(info, 1);
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx     = (info[2] & (1 << 28)) != 0;
+
+    bool avx2 = false;
+    if (maxLeaf >= 7) {
+        __cpuidex(info, 7, 0);
+        avx2 = (info[1] & (1 << 5)) != 0;
+    }
+
+    // Registres YMM sauvegardés par l'OS (XCR0 bits 1 et 2)
+    if (avx && avx2 && osxsave && (_xgetbv(0) & 0x6) == 0x6)
+        return EulerBatch::Isa::Avx2;
+#else
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        return EulerBatch::Isa::Avx2;
+#endif
+    return EulerBatch::Isa::Sse2;
+#else
+    return EulerBatch::Isa::Scalar;
+#endif
+}
+
+} // namespace
+
+// =============================================================================
+// EulerBatch
+// =============================================================================
+
+EulerBatch::Isa EulerBatch::bestIsa()
+{
+    static const Isa isa = detectIsa();
+    return isa;
+}
+
+const char* EulerBatch::isaName(Isa isa)
+{
+    switch (isa) {
+    case Isa::Scalar: return "Scalar";
+    case Isa::Sse2:   return "SSE2";
+    case Isa::Avx2:   return "AVX2";
+    }
+    return "Unknown";
+}
+
+void EulerBatch::quaternionsToEuler(
+    const double* qx, const double* qy, const double* qz, const double* qw,
+    int count, AngleConvention::AxisOrder order,
+    double* a, double* b, double* c)
+{
+    quaternionsToEuler(qx, qy, qz, qw, count, order, a, b, c, bestIsa());
+}
+
+void EulerBatch::quaternionsToEuler(
+    const double* qx, const double* qy, const double* qz, const double* qw,
+    int count, AngleConvention::AxisOrder order,
+    double* a, double* b, double* c, Isa isa)
+{
+    if (count <= 0)
+        return;
+
+    if (static_cast<int>(isa) > static_cast<int>(bestIsa()))
+        isa = bestIsa();
+
+    const AxisPermutation axes = permutationFor(order);
+
+    // Blocs pleins dans la variante choisie, reste en scalaire
+    int done = 0;
+#if defined(EULERBATCH_X86)
+    if (isa == Isa::Avx2) {
+        done = count & ~3;
+        if (done > 0)
+            EulerBatchDetail::kernelAvx2(qx, qy, qz, qw, done, axes, a, b, c);
+    }
+    else if (isa == Isa::Sse2) {
+        done = count & ~1;
+        if (done > 0)
+            eulerKernel<Sse2Ops>(qx, qy, qz, qw, done, axes, a, b, c);
+    }
+#endif
+
+    if (done < count) {
+        eulerKernel<ScalarOps>(qx + done, qy + done, qz + done, qw + done,
+            count - done, axes, a + done, b + done, c + done);
+    }
+}
@@ -0,0 +1,58 @@
+#pragma once
+#ifndef EULERBATCH_H
+#define EULERBATCH_H
+
+#include "AcquisitionConfig.h"
+
+/**
+ * @brief Conversion par lot quaternions → angles de Tait-Bryan, vectorisée
+ *
+ * Pour un ordre AngleConvention::AxisOrder « RaRbRc », calcule A, B, C tels que
+ * R = Ra(A) · Rb(B) · Rc(C) (rotations intrinsèques, ex. KUKA : Rz·Ry·Rx).
+ * Les sorties suivent l'ordre de la convention : a[] = A, b[] = B, c[] = C.
+ *
+ * Entrées en tableaux séparés (SoA, ex. RigidBodyBatch) ; les quaternions
+ * n'ont pas besoin d'être normalisés. Sorties en degrés, A et C dans
+ * ]-180, 180], B dans [-90, 90].
+ *
+ * atan2 est remplacé par une approximation polynomiale sans branchement
+ * (réduction à |t| <= tan(pi/8), polynôme impair de degré 13), identique pour
+ * toutes les variantes : erreur absolue max kMaxAtanErrorRad par angle, soit
+ * ~6e-10° — très en deçà de la résolution des systèmes de mesure.
+ *
+ * Variantes : scalaire, SSE2 (2 doubles), AVX2 (4 doubles), choisie à
+ * l'exécution (cpuid). En blocage de cardan (B = ±90°), A et C ne sont pas
+ * séparables : la répartition retournée est arbitraire mais cohérente.
+ */
+class EulerBatch {
+public:
+    enum class Isa {
+        Scalar,
+        Sse2,
+        Avx2
+    };
+
+    static constexpr double kMaxAtanErrorRad = 1.0e-11;
+
+    /** @brief Conversion avec la meilleure variante disponible sur ce processeur */
+    static void quaternionsToEuler(
+        const double* qx, const double* qy, const double* qz, const double* qw,
+        int count, AngleConvention::AxisOrder order,
+        double* a, double* b, double* c);
+
+    /** @brief Variante imposée (ramenée à bestIsa() si non supportée) — comparaisons, bancs */
+    static void quaternionsToEuler(
+        const double* qx, const double* qy, const double* qz, const double* qw,
+        int count, AngleConvention::AxisOrder order,
+        double* a, double* b, double* c, Isa isa);
+
+    /** @brief Meilleure variante supportée (détectée une fois) */
+    static Isa bestIsa();
+
+    static const char* isaName(Isa isa);
+
+private:
+    EulerBatch() = default; // Classe utilitaire, pas d'instanciation
+};
+
+#endif // EULERBATCH_H
@@ -0,0 +1,50 @@
+// =============================================================================
+// Variante AVX2 du noyau EulerBatch.
+//
+// Appelée uniquement après détection AVX2 (EulerBatch::bestIsa). MSVC accepte
+// les intrinsèques AVX sans option /arch ; GCC/Clang activent AVX2 pour cette
+// seule unité via le pragma ci-dessous, placé avant toute inclusion.
+// =============================================================================
+
+#if defined(_M_X64) || defined(__x86_64__) || defined(_M_IX86) || defined(__i386__)
+
+#if defined(__GNUC__) && !defined(__AVX2__)
+#pragma GCC target("avx2")
+#endif
+
+#include <immintrin.h>
+#include "EulerBatchKernel.h"
+
+namespace {
+
+struct Avx2Ops {
+    using V = __m256d;
+    using M = __m256d;
+    static constexpr int kWidth = 4;
+
+    static V load(const double* p) { return _mm256_loadu_pd(p); }
+    static void store(double* p, V v) { _mm256_storeu_pd(p, v); }
+    static V set1(double v) { return _mm256_set1_pd(v); }
+    static V add(V a, V b) { return _mm256_add_pd(a, b); }
+    static V sub(V a, V b) { return _mm256_sub_pd(a, b); }
+    static V mul(V a, V b) { return _mm256_mul_pd(a, b); }
+    static V div(V a, V b) { return _mm256_div_pd(a, b); }
+    static V sqrt(V a) { return _mm256_sqrt_pd(a); }
+    static V abs(V a) { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a); }
+    static V neg(V a) { return _mm256_xor_pd(a, _mm256_set1_pd(-0.0)); }
+    static V min(V a, V b) { return _mm256_min_pd(a, b); }
+    static V max(V a, V b) { return _mm256_max_pd(a, b); }
+    static M gt(V a, V b) { return _mm256_cmp_pd(a, b, _CMP_GT_OQ); }
+    static M lt(V a, V b) { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+    static V select(M m, V a, V b) { return _mm256_blendv_pd(b, a, m); }
+};
+
+} // namespace
+
+void EulerBatchDetail::kernelAvx2(const double* qx, const double* qy, const double* qz, const double* qw,
+    int count, const AxisPermutation& axes, double* a, double* b, double* c)
+{
+    eulerKernel<Avx2Ops>(qx, qy, qz, qw, count, axes, a, b, c);
+}
+
+#endif
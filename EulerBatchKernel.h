@@ -0,0 +1,151 @@
+#pragma once
+#ifndef EULERBATCHKERNEL_H
+#define EULERBATCHKERNEL_H
+
+// =============================================================================
+// En-tête interne à EulerBatch.cpp et EulerBatchAvx2.cpp — ne pas inclure ailleurs.
+//
+// Le noyau est un template sur un jeu d'opérations vectorielles (Ops). Il est
+// défini dans un espace de noms anonyme : chaque unité de compilation en
+// instancie sa propre copie avec son jeu d'instructions, sans fusion par
+// l'éditeur de liens entre la version AVX2 et la version de base.
+// Pour la même raison, aucun en-tête contenant des fonctions inline de la
+// bibliothèque standard (conteneurs, algorithmes) ne doit être inclus ici.
+// =============================================================================
+
+#include <cfloat>
+
+namespace EulerBatchDetail {
+
+/**
+ * @brief Ordre des axes R = Ri(A) · Rj(B) · Rk(C), s = +1 si (i, j, k) est
+ *        une permutation circulaire de (0, 1, 2), -1 sinon
+ */
+struct AxisPermutation {
+    int    i;
+    int    j;
+    int    k;
+    double s;
+};
+
+/** @brief Noyau AVX2 (EulerBatchAvx2.cpp), count multiple de 4 */
+void kernelAvx2(const double* qx, const double* qy, const double* qz, const double* qw,
+    int count, const AxisPermutation& axes, double* a, double* b, double* c);
+
+} // namespace EulerBatchDetail
+
+namespace {
+
+constexpr double kPi       = 3.14159265358979323846;
+constexpr double kHalfPi   = kPi / 2.0;
+constexpr double kQuarterPi = kPi / 4.0;
+constexpr double kTanPi8   = 0.41421356237309504880;   // tan(pi/8)
+constexpr double kRadToDeg = 180.0 / kPi;
+
+// atan(t) ≈ t · P(t²) sur |t| <= tan(pi/8) — approximation de Tchebychev,
+// erreur max mesurée 8.1e-12 rad
+constexpr double kAtanCoeffs[7] = {
+     0.9999999999791268,
+    -0.3333333212785248,
+     0.1999988589732043,
+    -0.14281639230744073,
+     0.1104105386755902,
+    -0.08459107735041026,
+     0.04712994595779542
+};
+
+/**
+ * @brief atan2(y, x) sans branchement, en radians
+ *
+ * |y|/|x| ou |x|/|y| ramené à [0, 1], puis à [-tan(pi/8), tan(pi/8)] via
+ * atan(t) = pi/4 + atan((t - 1) / (t + 1)) ; quadrant restauré par sélection.
+ */
+template<typename Ops>
+inline typename Ops::V atan2Poly(typename Ops::V y, typename Ops::V x)
+{
+    using V = typename Ops::V;
+
+    const V ax = Ops::abs(x);
+    const V ay = Ops::abs(y);
+    const V hi = Ops::max(ax, ay);
+    const V lo = Ops::min(ax, ay);
+
+    // t = lo / hi ; si t > tan(pi/8), (t - 1) / (t + 1) = (lo - hi) / (lo + hi) :
+    // une seule division dans les deux cas. (0, 0) → 0 : dénominateur borné.
+    const auto reduce = Ops::gt(lo, Ops::mul(hi, Ops::set1(kTanPi8)));
+    const V num = Ops::select(reduce, Ops::sub(lo, hi), lo);
+    const V den = Ops::select(reduce, Ops::add(lo, hi), hi);
+    const V tr  = Ops::div(num, Ops::max(den, Ops::set1(DBL_MIN)));
+
+    const V u = Ops::mul(tr, tr);
+    V p = Ops::set1(kAtanCoeffs[6]);
+    for (int n = 5; n >= 0; --n)
+        p = Ops::add(Ops::mul(p, u), Ops::set1(kAtanCoeffs[n]));
+    V r = Ops::mul(tr, p);
+
+    r = Ops::select(reduce, Ops::add(r, Ops::set1(kQuarterPi)), r);
+    r = Ops::select(Ops::gt(ay, ax), Ops::sub(Ops::set1(kHalfPi), r), r);
+    r = Ops::select(Ops::lt(x, Ops::set1(0.0)), Ops::sub(Ops::set1(kPi), r), r);
+    r = Ops::select(Ops::lt(y, Ops::set1(0.0)), Ops::neg(r), r);
+    return r;
+}
+
+/**
+ * @brief Noyau commun : count doit être un multiple de Ops::kWidth
+ *
+ * Matrice de rotation en forme homogène (sans normalisation du quaternion) :
+ * les atan2 sont invariants d'échelle, B est obtenu par atan2(sin, cos) avec
+ * cos = hypot(R[i][i], R[i][j]) plutôt que par asin (précis près de ±90°).
+ */
+template<typename Ops>
+inline void eulerKernel(const double* qx, const double* qy, const double* qz, const double* qw,
+    int count, const EulerBatchDetail::AxisPermutation& axes, double* a, double* b, double* c)
+{
+    using V = typename Ops::V;
+
+    const V two   = Ops::set1(2.0);
+    const V sign  = Ops::set1(axes.s);
+    const V toDeg = Ops::set1(kRadToDeg);
+
+    for (int n = 0; n < count; n += Ops::kWidth) {
+        const V x = Ops::load(qx + n);
+        const V y = Ops::load(qy + n);
+        const V z = Ops::load(qz + n);
+        const V w = Ops::load(qw + n);
+
+        const V xx = Ops::mul(x, x), yy = Ops::mul(y, y), zz = Ops::mul(z, z), ww = Ops::mul(w, w);
+        const V xy = Ops::mul(x, y), xz = Ops::mul(x, z), yz = Ops::mul(y, z);
+        const V wx = Ops::mul(w, x), wy = Ops::mul(w, y), wz = Ops::mul(w, z);
+
+        V R[3][3];
+        R[0][0] = Ops::sub(Ops::add(ww, xx), Ops::add(yy, zz));
+        R[1][1] = Ops::sub(Ops::add(ww, yy), Ops::add(xx, zz));
+        R[2][2] = Ops::sub(Ops::add(ww, zz), Ops::add(xx, yy));
+        R[0][1] = Ops::mul(two, Ops::sub(xy, wz));
+        R[1][0] = Ops::mul(two, Ops::add(xy, wz));
+        R[0][2] = Ops::mul(two, Ops::add(xz, wy));
+        R[2][0] = Ops::mul(two, Ops::sub(xz, wy));
+        R[1][2] = Ops::mul(two, Ops::sub(yz, wx));
+        R[2][1] = Ops::mul(two, Ops::add(yz, wx));
+
+        const V rii = R[axes.i][axes.i];
+        const V rij = R[axes.i][axes.j];
+        const V rik = R[axes.i][axes.k];
+        const V rjk = R[axes.j][axes.k];
+        const V rkk = R[axes.k][axes.k];
+
+        // sin B = s·R[i][k], A = atan2(-s·R[j][k], R[k][k]), C = atan2(-s·R[i][j], R[i][i])
+        const V cosB = Ops::sqrt(Ops::add(Ops::mul(rii, rii), Ops::mul(rij, rij)));
+        const V angA = atan2Poly<Ops>(Ops::neg(Ops::mul(sign, rjk)), rkk);
+        const V angB = atan2Poly<Ops>(Ops::mul(sign, rik), cosB);
+        const V angC = atan2Poly<Ops>(Ops::neg(Ops::mul(sign, rij)), rii);
+
+        Ops::store(a + n, Ops::mul(angA, toDeg));
+        Ops::store(b + n, Ops::mul(angB, toDeg));
+        Ops::store(c + n, Ops::mul(angC, toDeg));
+    }
+}
+
+} // namespace
+
+#endif // EULERBATCHKERNEL_H
@@ -0,0 +1,160 @@
+#include "FrameDispatcher.h"
+#include "IMeasurementSystem.h"
+#include "TraceRecorder.h"
+#include "Profiler.h"
+#include <QMetaObject>
+#include <QMutexLocker>
+#include <QTimer>
+#include <cmath>
+
+FrameDispatcher::FrameDispatcher(QObject* parent)
+    : QObject(parent)
+{
+    setDeliveryRate(kDefaultDeliveryRateHz);
+    m_sinceFlush.start();
+}
+
+// =============================================================================
+// Configuration
+// =============================================================================
+
+void FrameDispatcher::setDeliveryRate(double hz)
+{
+    m_intervalMs = hz > 0.0
+        ? qMax(1, static_cast<int>(std::lround(1000.0 / hz)))
+        : 0;
+}
+
+double FrameDispatcher::deliveryRate() const
+{
+    const int interval = m_intervalMs.load();
+    return interval > 0 ? 1000.0 / static_cast<double>(interval) : 0.0;
+}
+
+void FrameDispatcher::setBatchDeliveryEnabled(bool enabled)
+{
+    m_batchEnabled = enabled;
+    if (!enabled) {
+        QMutexLocker locker(&m_mutex);
+        m_batch.clear();
+    }
+}
+
+bool FrameDispatcher::isBatchDeliveryEnabled() const
+{
+    return m_batchEnabled.load();
+}
+
+// =============================================================================
+// Producteurs
+// =============================================================================
+
+void FrameDispatcher::postFrame(const MeasurementFrame& frame)
+{
+    MOBOT_TRACE_SCOPE("dispatch.post");
+
+    // Pas de coalescence : émission directe (DirectConnection ou QueuedConnection
+    // selon le récepteur, comme avant l'introduction du dispatcher)
+    if (m_intervalMs.load(std::memory_order_relaxed) == 0) {
+        emit latestFrame(frame);
+        if (m_batchEnabled.load(std::memory_order_relaxed))
+            emit frameBatch(QVector<MeasurementFrame>{ frame });
+        return;
+    }
+
+    {
+        QMutexLocker locker(&m_mutex);
+        if (m_hasLatest)
+            m_coalesced.fetch_add(1, std::memory_order_relaxed);
+        m_latest    = frame;
+        m_hasLatest = true;
+        if (m_batchEnabled.load(std::memory_order_relaxed))
+            m_batch.append(frame);
+        MOBOT_PROFILE_GAUGE("Dispatcher / lot en attente", m_batch.size());
+    }
+    requestFlush();
+}
+
+void FrameDispatcher::postMetrics(const PerformanceMetrics& metrics)
+{
+    if (m_intervalMs.load(std::memory_order_relaxed) == 0) {
+        emit metricsUpdated(metrics);
+        return;
+    }
+
+    {
+        QMutexLocker locker(&m_mutex);
+        m_metrics    = metrics;
+        m_hasMetrics = true;
+    }
+    requestFlush();
+}
+
+// =============================================================================
+// Livraison (thread du dispatcher)
+// =============================================================================
+
+void FrameDispatcher::requestFlush()
+{
+    // Un seul événement en vol : les frames suivantes rejoignent le flush planifié
+    if (m_flushPending.exchange(true, std::memory_order_acq_rel))
+        return;
+    QMetaObject::invokeMethod(this, [this]() { scheduleFlush(); }, Qt::QueuedConnection);
+}
+
+void FrameDispatcher::scheduleFlush()
+{
+    const qint64 remaining = static_cast<qint64>(m_intervalMs.load()) - m_sinceFlush.elapsed();
+    if (remaining <= 0)
+        flush();
+    else
+        QTimer::singleShot(static_cast<int>(remaining), Qt::PreciseTimer, this, [this]() { flush(); });
+}
+
+void FrameDispatcher::flush()
+{
+    MOBOT_TRACE_SCOPE("dispatch.flush");
+    MOBOT_PROFILE_SYSTEM(profileSystem());
+    MOBOT_PROFILE_SCOPE("Dispatcher / flush");
+
+    // Libérer le drapeau AVANT l'échange : une frame postée pendant la livraison
+    // replanifie un flush au lieu d'être oubliée
+    m_flushPending.store(false, std::memory_order_release);
+    m_sinceFlush.restart();
+
+    MeasurementFrame          latest;
+    PerformanceMetrics        metrics;
+    QVector<MeasurementFrame> batch;
+    bool hasLatest = false, hasMetrics = false;
+    {
+        QMutexLocker locker(&m_mutex);
+        if (m_hasLatest) {
+            latest      = m_latest;
+            hasLatest   = true;
+            m_hasLatest = false;
+        }
+        if (m_hasMetrics) {
+            metrics      = m_metrics;
+            hasMetrics   = true;
+            m_hasMetrics = false;
+        }
+        if (!m_batch.isEmpty()) {
+            batch.swap(m_batch);
+            m_batch.reserve(batch.size());
+        }
+    }
+
+    if (!batch.isEmpty()) emit frameBatch(batch);
+    if (hasLatest)        emit latestFrame(latest);
+    if (hasMetrics)       emit metricsUpdated(metrics);
+}
+
+const char* FrameDispatcher::profileSystem()
+{
+    // Dispatcher créé par IMeasurementSystem (parent) : même thread, nom constant
+    if (m_profileSystem.empty()) {
+        if (const auto* system = qobject_cast<const IMeasurementSystem*>(parent()))
+            m_profileSystem = system->getSystemName().toStdString();
+    }
+    return m_profileSystem.c_str();
+}
@@ -0,0 +1,86 @@
+#pragma once
+#ifndef FRAMEDISPATCHER_H
+#define FRAMEDISPATCHER_H
+
+#include <QObject>
+#include <QMutex>
+#include <QVector>
+#include <QElapsedTimer>
+#include <atomic>
+#include <string>
+
+#include "MeasurementFrame.h"
+#include "PerformanceMetrics.h"
+
+/**
+ * @brief Coalescence des notifications frame/métriques vers le thread Qt
+ *
+ * Les threads d'acquisition (ou SDK) appellent postFrame()/postMetrics() à
+ * chaque frame. Au lieu de poster un événement Qt par frame, le dispatcher :
+ *   - garde la dernière frame / les dernières métriques (valeur courante pour l'UI)
+ *   - accumule optionnellement toutes les frames dans un lot (consommateurs exhaustifs)
+ *   - planifie AU PLUS un flush par période (1 / deliveryRate) dans son thread
+ *
+ * Coût côté producteur : une copie sous mutex + un échange atomique.
+ * Un seul événement posté par période, quel que soit le débit (2 kHz × N systèmes).
+ *
+ * deliveryRate = 0 → pas de coalescence, émission directe depuis le thread appelant
+ * (comportement historique).
+ */
+class FrameDispatcher : public QObject {
+    Q_OBJECT
+
+public:
+    static constexpr double kDefaultDeliveryRateHz = 50.0;
+
+    explicit FrameDispatcher(QObject* parent = nullptr);
+
+    // ========== Configuration (thread du dispatcher) ==========
+
+    void   setDeliveryRate(double hz);
+    double deliveryRate() const;
+
+    /** @brief Active l'accumulation de toutes les frames (signal frameBatch) */
+    void setBatchDeliveryEnabled(bool enabled);
+    bool isBatchDeliveryEnabled() const;
+
+    // ========== Producteurs (thread-safe) ==========
+
+    void postFrame(const MeasurementFrame& frame);
+    void postMetrics(const PerformanceMetrics& metrics);
+
+    /** @brief Livre immédiatement ce qui est en attente (thread du dispatcher) */
+    void flush();
+
+    /** @brief Nombre de frames écrasées avant livraison (coalescées) depuis le début */
+    quint64 coalescedFrames() const { return m_coalesced.load(std::memory_order_relaxed); }
+
+signals:
+    void latestFrame(const MeasurementFrame& frame);
+    void frameBatch(const QVector<MeasurementFrame>& frames);
+    void metricsUpdated(const PerformanceMetrics& metrics);
+
+private:
+    void requestFlush();
+    void scheduleFlush();
+
+    /** @brief Nom du système parent, pour MOBOT_PROFILE_SYSTEM (thread du dispatcher) */
+    const char* profileSystem();
+
+    mutable QMutex            m_mutex;
+    MeasurementFrame          m_latest;
+    bool                      m_hasLatest  = false;
+    PerformanceMetrics        m_metrics;
+    bool                      m_hasMetrics = false;
+    QVector<MeasurementFrame> m_batch;
+
+    std::atomic<bool>    m_batchEnabled{ false };
+    std::atomic<int>     m_intervalMs{ 0 };
+    std::atomic<bool>    m_flushPending{ false };
+    std::atomic<quint64> m_coalesced{ 0 };
+
+    QElapsedTimer m_sinceFlush;      // Accédé uniquement dans le thread du dispatcher
+    std::string   m_profileSystem;   // Idem, résolu au premier flush
+};
+
+#endif // FRAMEDISPATCHER_H
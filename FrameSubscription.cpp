@@ -0,0 +1,89 @@
+#include "FrameSubscription.h"
+#include "Profiler.h"
+#include <QMutexLocker>
+
+// =============================================================================
+// FrameRingConsumer
+// =============================================================================
+
+FrameRingConsumer::FrameRingConsumer(std::size_t capacity)
+    : m_ring(capacity)
+{
+}
+
+bool FrameRingConsumer::pop(MeasurementFrame& frame)
+{
+    return m_ring.tryPop(frame);
+}
+
+bool FrameRingConsumer::takeLatest(MeasurementFrame& frame)
+{
+    QMutexLocker locker(&m_latestMutex);
+    if (!m_latestFresh)
+        return false;
+    frame = m_latest;
+    m_latestFresh = false;
+    return true;
+}
+
+void FrameRingConsumer::push(const MeasurementFrame& frame)
+{
+    if (!m_ring.tryPush(frame)) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        MOBOT_PROFILE_COUNT("Abonnés / pertes anneau", 1);
+    }
+    MOBOT_PROFILE_GAUGE("Abonnés / anneau", m_ring.size());
+}
+
+void FrameRingConsumer::storeLatest(const MeasurementFrame& frame)
+{
+    QMutexLocker locker(&m_latestMutex);
+    m_latest      = frame;
+    m_latestFresh = true;
+}
+
+// =============================================================================
+// FrameSubscriber
+// =============================================================================
+
+void FrameSubscriber::deliver(const MeasurementFrame& frame)
+{
+    // Abonné par lot uniquement : ne pas consommer le compteur de décimation des lots
+    if (!callback && !ring)
+        return;
+
+    if (!options.objectName.isEmpty() && frame.objectName != options.objectName)
+        return;
+
+    if (options.policy == DeliveryPolicy::Decimated) {
+        const quint64 n = seen.fetch_add(1, std::memory_order_relaxed);
+        const quint64 every = options.decimation > 1 ? static_cast<quint64>(options.decimation) : 1;
+        if (n % every != 0)
+            return;
+    }
+
+    if (callback)
+        callback(frame);
+
+    if (ring) {
+        if (options.policy == DeliveryPolicy::LatestOnly)
+            ring->storeLatest(frame);
+        else
+            ring->push(frame);
+    }
+}
+
+void FrameSubscriber::deliverBatch(const RigidBodyBatch& batch)
+{
+    if (!batchCallback)
+        return;
+
+    if (options.policy == DeliveryPolicy::Decimated) {
+        const quint64 n = seen.fetch_add(1, std::memory_order_relaxed);
+        const quint64 every = options.decimation > 1 ? static_cast<quint64>(options.decimation) : 1;
+        if (n % every != 0)
+            return;
+    }
+
+    batchCallback(batch);
+}
@@ -0,0 +1,104 @@
+#pragma once
+#ifndef FRAMESUBSCRIPTION_H
+#define FRAMESUBSCRIPTION_H
+
+#include <QString>
+#include <QMutex>
+#include <atomic>
+#include <functional>
+#include <memory>
+
+#include "MeasurementFrame.h"
+#include "RigidBodyBatch.h"
+#include "SpscRing.h"
+
+/**
+ * @brief Politique de livraison d'un abonnement C++ aux frames
+ *
+ * Les abonnés sont servis dans le thread producteur (acquisition ou SDK),
+ * sans passer par le méta-objet Qt : la frame est transmise par référence.
+ */
+enum class DeliveryPolicy {
+    EveryFrame,     // Toutes les frames
+    LatestOnly,     // Seule la plus récente compte (anneau : écrasement d'un slot unique)
+    Decimated       // Une frame sur N (SubscriptionOptions::decimation)
+};
+
+struct SubscriptionOptions {
+    DeliveryPolicy policy     = DeliveryPolicy::EveryFrame;
+    int            decimation = 1;       // N pour DeliveryPolicy::Decimated
+    QString        objectName;           // Filtre sur frame.objectName (vide = tous)
+};
+
+using SubscriptionId = quint64;
+
+/**
+ * @brief Callback synchrone : appelé dans le thread producteur, doit rester court
+ *
+ * Pour un callback, LatestOnly équivaut à EveryFrame (l'appel est synchrone,
+ * il n'y a jamais de frame en attente).
+ */
+using FrameCallback = std::function<void(const MeasurementFrame&)>;
+
+/**
+ * @brief Callback de lot : tous les corps d'une frame (systèmes multi-corps).
+ *        Mêmes contraintes que FrameCallback, le lot n'est valide que pendant l'appel.
+ */
+using BatchCallback = std::function<void(const RigidBodyBatch&)>;
+
+/**
+ * @brief Consommateur par anneau : le producteur dépose, le consommateur vient
+ *        chercher depuis son propre thread (enregistreur, synchroniseur...)
+ *
+ * Un seul thread consommateur par instance. En cas de débordement, la frame
+ * est perdue et comptée (droppedFrames) : le producteur ne bloque jamais.
+ */
+class FrameRingConsumer {
+public:
+    explicit FrameRingConsumer(std::size_t capacity = 1024);
+
+    // ========== Consommateur ==========
+
+    /** @brief Frame la plus ancienne (EveryFrame / Decimated) */
+    bool pop(MeasurementFrame& frame);
+
+    /** @brief Frame la plus récente, une seule fois par nouvelle frame (LatestOnly) */
+    bool takeLatest(MeasurementFrame& frame);
+
+    std::size_t pending() const { return m_ring.size(); }
+    std::size_t capacity() const { return m_ring.capacity(); }
+    quint64     droppedFrames() const { return m_dropped.load(std::memory_order_relaxed); }
+
+    // ========== Producteur (IMeasurementSystem) ==========
+
+    void push(const MeasurementFrame& frame);
+    void storeLatest(const MeasurementFrame& frame);
+
+private:
+    SpscRing<MeasurementFrame> m_ring;
+    std::atomic<quint64>       m_dropped{ 0 };
+
+    QMutex           m_latestMutex;
+    MeasurementFrame m_latest;
+    bool             m_latestFresh = false;
+};
+
+/**
+ * @brief Entrée de registre (interne à IMeasurementSystem)
+ */
+struct FrameSubscriber {
+    SubscriptionId                     id = 0;
+    SubscriptionOptions                options;
+    FrameCallback                      callback;
+    std::shared_ptr<FrameRingConsumer> ring;
+    BatchCallback                      batchCallback;
+    std::atomic<quint64>               seen{ 0 };   // Compteur de décimation (thread producteur)
+
+    /** @brief Applique filtre + politique puis livre la frame */
+    void deliver(const MeasurementFrame& frame);
+
+    /** @brief Livre un lot multi-corps (abonnés par lot uniquement, décimation appliquée) */
+    void deliverBatch(const RigidBodyBatch& batch);
+};
+
+#endif // FRAMESUBSCRIPTION_H
@@ -0,0 +1,404 @@
+#include "HeadlessRunner.h"
+
+#include "KukaRsiConfig.h"
+#include "KukaRsiSystem.h"
+#include "StartBarrier.h"
+#include "SystemFactory.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QRegularExpression>
+#include <cstdio>
+
+// =============================================================================
+// HeadlessConfig
+// =============================================================================
+
+bool HeadlessConfig::parseFormat(const QString& text, SessionFile::Format& format)
+{
+    const QString lower = text.trimmed().toLower();
+    if (lower == QLatin1String("binary") || lower == QLatin1String("bin"))
+        format = SessionFile::Format::Binary;
+    else if (lower == QLatin1String("csv"))
+        format = SessionFile::Format::Csv;
+    else
+        return false;
+    return true;
+}
+
+bool HeadlessConfig::fromJson(const QByteArray& json, HeadlessConfig& config, QString& error)
+{
+    QJsonParseError parseError;
+    const QJsonDocument doc = QJsonDocument::fromJson(json, &parseError);
+    if (doc.isNull()) {
+        error = QString("Invalid JSON at offset %1: %2")
+            .arg(parseError.offset).arg(parseError.errorString());
+        return false;
+    }
+    if (!doc.isObject()) {
+        error = "Configuration root must be a JSON object";
+        return false;
+    }
+
+    const QJsonObject root = doc.object();
+    config.durationS       = root.value("durationSeconds").toDouble(config.durationS);
+    config.targetFrequency = root.value("targetFrequency").toDouble(config.targetFrequency);
+    config.outputDirectory = root.value("outputDirectory").toString(config.outputDirectory);
+    config.statusIntervalS = root.value("statusIntervalSeconds").toDouble(config.statusIntervalS);
+    if (root.contains("format") && !parseFormat(root.value("format").toString(), config.format)) {
+        error = QString("Unknown format \"%1\" (expected binary or csv)")
+            .arg(root.value("format").toString());
+        return false;
+    }
+
+    config.triggered = root.contains("trigger");
+    if (config.triggered && !TriggerConfig::fromJson(root.value("trigger").toObject(), config.trigger, error))
+        return false;
+
+    const QJsonArray systems = root.value("systems").toArray();
+    if (systems.isEmpty()) {
+        error = "No system in \"systems\"";
+        return false;
+    }
+
+    config.systems.clear();
+    for (int i = 0; i < systems.size(); ++i) {
+        const QJsonObject obj = systems.at(i).toObject();
+
+        HeadlessSystemConfig sys;
+        sys.type = obj.value("type").toString();
+        const SystemFactory::SystemType type = SystemFactory::systemTypeFromString(sys.type);
+        if (type == SystemFactory::SystemType::Unknown) {
+            error = QString("systems[%1]: unknown type \"%2\" (available: %3)")
+                .arg(i).arg(sys.type).arg(SystemFactory::availableSystems().join(", "));
+            return false;
+        }
+        sys.name = obj.value("name").toString(sys.type);
+
+        // KUKA : adresse et port d'écoute de CE PC (KukaRsiConfig), pas du serveur
+        ConnectionConfig& c = sys.connection;
+        c.systemType = sys.type;
+        if (type == SystemFactory::SystemType::RSI_KUKA) {
+            c.serverAddress = KukaRsiConfig().hostAddress;
+            c.port          = KukaRsiConfig().hostPort;
+        }
+        c.serverAddress      = obj.value("address").toString(c.serverAddress);
+        c.port               = obj.value("port").toInt(c.port);
+        c.multicastAddress   = obj.value("multicast").toString(c.multicastAddress);
+        c.requestedFrequency = obj.value("frequency").toDouble(c.requestedFrequency);
+        c.objectName         = obj.value("object").toString(c.objectName);
+        c.objectId           = obj.value("objectId").toInt(c.objectId);
+        c.customParams       = obj.value("params").toObject().toVariantMap();
+
+        config.systems.append(sys);
+    }
+    return true;
+}
+
+// =============================================================================
+// HeadlessRunner
+// =============================================================================
+
+HeadlessRunner::HeadlessRunner(const HeadlessConfig& config, QObject* parent)
+    : QObject(parent)
+    , m_config(config)
+{
+    m_drainTimer = new QTimer(this);
+    m_drainTimer->setInterval(kDrainIntervalMs);
+    QObject::connect(m_drainTimer, &QTimer::timeout, this, &HeadlessRunner::onDrainTick);
+}
+
+HeadlessRunner::~HeadlessRunner()
+{
+    shutdownSystems();
+}
+
+IMeasurementSystem* HeadlessRunner::createSystem(const HeadlessSystemConfig& config)
+{
+    // Même construction que AddSystemDialog::createCard : KUKA reçoit sa config propre,
+    // les autres systèmes lisent tout dans ConnectionConfig::customParams
+    if (SystemFactory::systemTypeFromString(config.type) == SystemFactory::SystemType::RSI_KUKA) {
+        KukaRsiConfig cfg;
+        cfg.hostAddress = config.connection.serverAddress;
+        cfg.hostPort    = config.connection.port;
+        cfg.robotName   = config.name;
+        return new KukaRsiSystem(cfg, this);
+    }
+    return SystemFactory::createSystem(config.type, this);
+}
+
+bool HeadlessRunner::openSessionFile(Channel& channel, const QString& stamp)
+{
+    QString safeName = channel.name;
+    safeName.replace(QRegularExpression("[^A-Za-z0-9_-]"), "_");
+    const QString extension = m_config.format == SessionFile::Format::Csv ? "csv" : "bin";
+
+    QDir dir(m_config.outputDirectory);
+    if (!dir.exists() && !dir.mkpath(".")) {
+        std::fprintf(stderr, "Cannot create output directory %s\n", qUtf8Printable(m_config.outputDirectory));
+        return false;
+    }
+
+    channel.file.setFileName(dir.filePath(QString("%1_%2.%3").arg(safeName, stamp, extension)));
+    if (!channel.file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        std::fprintf(stderr, "[%s] %s\n", qUtf8Printable(channel.name),
+            qUtf8Printable(channel.file.errorString()));
+        return false;
+    }
+    channel.pending = SessionFile::fileHeader(m_config.format);
+    channel.pending.reserve(kWriteChunkBytes * 2);
+    return true;
+}
+
+bool HeadlessRunner::start()
+{
+    const QString stamp = QDateTime::currentDateTime().toString("yyyyMMdd_HHmmss");
+
+    // Mode déclenché : créé avant les systèmes, détruit avant eux (ordre des enfants Qt)
+    if (m_config.triggered) {
+        TriggerConfig trigger   = m_config.trigger;
+        trigger.outputDirectory = m_config.outputDirectory;
+        trigger.format          = m_config.format;
+        m_trigger = new TriggerRecorder(trigger, this);
+        QObject::connect(m_trigger, &TriggerRecorder::logMessage, this, [](const QString& message) {
+            std::printf("[trigger] %s\n", qUtf8Printable(message));
+            std::fflush(stdout);
+        });
+        QObject::connect(m_trigger, &TriggerRecorder::errorOccurred, this, [this](const QString& message) {
+            std::fprintf(stderr, "[trigger] ERROR %s\n", qUtf8Printable(message));
+            m_exitCode = 1;
+            if (m_drainTimer->isActive())
+                requestStop();
+        });
+    }
+
+    for (const HeadlessSystemConfig& cfg : m_config.systems) {
+        auto channel = std::make_unique<Channel>();
+        channel->name   = cfg.name;
+        channel->system = createSystem(cfg);
+        if (!channel->system) {
+            std::fprintf(stderr, "[%s] System type %s is not available in this build\n",
+                qUtf8Printable(cfg.name), qUtf8Printable(cfg.type));
+            shutdownSystems();
+            return false;
+        }
+
+        Channel* raw = channel.get();
+        IMeasurementSystem* sys = channel->system;
+        QObject::connect(sys, &IMeasurementSystem::logMessage, this, [raw](const QString& message) {
+            std::printf("[%s] %s\n", qUtf8Printable(raw->name), qUtf8Printable(message));
+            std::fflush(stdout);
+        });
+        QObject::connect(sys, &IMeasurementSystem::errorOccurred, this, [raw](const QString& message) {
+            std::fprintf(stderr, "[%s] ERROR %s\n", qUtf8Printable(raw->name), qUtf8Printable(message));
+        });
+        QObject::connect(sys, &IMeasurementSystem::acquisitionCompleted, this,
+            [raw](const AcquisitionSummary& summary) {
+                raw->summary    = summary;
+                raw->hasSummary = true;
+            });
+
+        // Personne n'écoute les signaux de frames : une notification par seconde suffit
+        sys->setNotificationRate(1.0);
+
+        m_channels.push_back(std::move(channel));
+
+        if (!sys->initialize() || !sys->connect(cfg.connection)) {
+            std::fprintf(stderr, "[%s] Connection failed\n", qUtf8Printable(cfg.name));
+            shutdownSystems();
+            return false;
+        }
+        if (m_trigger) {
+            m_trigger->attach(sys, cfg.name);
+            if (auto* robot = qobject_cast<KukaRsiSystem*>(sys))
+                m_trigger->addTriggerSource(robot);
+            continue;
+        }
+        if (!openSessionFile(*raw, stamp)) {
+            shutdownSystems();
+            return false;
+        }
+
+        // Toutes les frames de tous les corps, vidées par le thread principal
+        raw->ring = std::make_shared<FrameRingConsumer>(kRingCapacity);
+        raw->subscription = sys->subscribe(raw->ring);
+    }
+    if (m_trigger && !m_trigger->start()) {
+        shutdownSystems();
+        return false;
+    }
+
+    // Départ commun : chaque système s'arme, le t0 de session est relevé une fois tous prêts
+    auto barrier = std::make_shared<StartBarrier>();
+    for (const auto& channel : m_channels) {
+        channel->system->setTargetFrequency(m_config.targetFrequency);
+        channel->system->setStartBarrier(barrier);
+        if (!channel->system->startAcquisition()) {
+            std::fprintf(stderr, "[%s] Acquisition start failed\n", qUtf8Printable(channel->name));
+            barrier->cancel();
+            shutdownSystems();
+            return false;
+        }
+    }
+    barrier->release();
+
+    m_clock.start();
+    m_lastStatusMs = 0;
+    m_drainTimer->start();
+
+    std::printf("Recording %d system(s)%s to %s (%s), %s\n",
+        static_cast<int>(m_channels.size()), m_trigger ? " on trigger" : "",
+        qUtf8Printable(QDir(m_config.outputDirectory).absolutePath()),
+        m_config.format == SessionFile::Format::Csv ? "CSV" : "binary",
+        m_config.durationS > 0.0
+            ? qUtf8Printable(QString("for %1 s").arg(m_config.durationS))
+            : "until Ctrl+C");
+    std::fflush(stdout);
+    return true;
+}
+
+void HeadlessRunner::onDrainTick()
+{
+    for (const auto& channel : m_channels) {
+        if (!drain(*channel, false)) {
+            m_exitCode = 1;
+            requestStop();
+            return;
+        }
+    }
+
+    const qint64 elapsedMs = m_clock.elapsed();
+    if (m_config.statusIntervalS > 0.0
+        && elapsedMs - m_lastStatusMs >= static_cast<qint64>(m_config.statusIntervalS * 1000.0)) {
+        m_lastStatusMs = elapsedMs;
+        printStatus();
+    }
+
+    if (m_config.durationS > 0.0 && elapsedMs >= static_cast<qint64>(m_config.durationS * 1000.0))
+        requestStop();
+}
+
+bool HeadlessRunner::drain(Channel& channel, bool final)
+{
+    if (!channel.ring)
+        return true;
+
+    MeasurementFrame frame;
+    while (channel.ring->pop(frame)) {
+        SessionFile::appendFrame(m_config.format, channel.pending, frame);
+        ++channel.recorded;
+    }
+
+    if (channel.pending.size() < kWriteChunkBytes && !final)
+        return true;
+    if (channel.file.write(channel.pending) != channel.pending.size()) {
+        std::fprintf(stderr, "[%s] Write error on %s: %s\n", qUtf8Printable(channel.name),
+            qUtf8Printable(channel.file.fileName()), qUtf8Printable(channel.file.errorString()));
+        return false;
+    }
+    channel.pending.clear();
+    return true;
+}
+
+void HeadlessRunner::printStatus()
+{
+    std::printf("[%8.1f s]", m_clock.elapsed() / 1000.0);
+    for (const auto& channel : m_channels) {
+        if (!channel->ring)
+            continue;
+        std::printf("  %s: %llu frames, %llu lost", qUtf8Printable(channel->name),
+            static_cast<unsigned long long>(channel->recorded),
+            static_cast<unsigned long long>(channel->ring->droppedFrames()));
+    }
+    if (m_trigger)
+        std::printf("  captures: %d%s", m_trigger->captureCount(), m_trigger->isCapturing() ? " (recording)" : "");
+    std::printf("\n");
+    std::fflush(stdout);
+}
+
+void HeadlessRunner::requestStop()
+{
+    if (m_stopping)
+        return;
+    m_stopping = true;
+    m_drainTimer->stop();
+
+    // acquisitionCompleted est émis pendant stopAcquisition() (même thread : synchrone)
+    for (const auto& channel : m_channels)
+        channel->system->stopAcquisition();
+
+    // Capture en cours terminée avec les frames reçues avant l'arrêt
+    if (m_trigger)
+        m_trigger->stop();
+
+    finish();
+}
+
+void HeadlessRunner::finish()
+{
+    for (const auto& channel : m_channels) {
+        if (!drain(*channel, true))
+            m_exitCode = 1;
+        channel->file.close();
+    }
+
+    std::printf("\n===== Acquisition summary (%.1f s) =====\n", m_clock.elapsed() / 1000.0);
+    if (m_trigger)
+        std::printf("%d trigger capture(s) saved\n", m_trigger->captureCount());
+    for (const auto& channel : m_channels) {
+        const AcquisitionSummary& s = channel->summary;
+        std::printf("\n[%s] %s\n", qUtf8Printable(channel->name), qUtf8Printable(channel->file.fileName()));
+        if (channel->ring) {
+            std::printf("  recorded %llu frames, %llu lost by the recorder\n",
+                static_cast<unsigned long long>(channel->recorded),
+                static_cast<unsigned long long>(channel->ring->droppedFrames()));
+        }
+        if (!channel->hasSummary) {
+            std::printf("  no summary (acquisition not stopped cleanly)\n");
+            continue;
+        }
+        std::printf("  system %s, object %s, %.3f s\n",
+            qUtf8Printable(s.systemName), qUtf8Printable(s.objectName), s.durationSeconds);
+        std::printf("  start %s t0 %s, first frame %+.3f ms\n",
+            s.synchronizedStart ? "common" : "own",
+            qUtf8Printable(QDateTime::fromMSecsSinceEpoch(s.startTimestamp / 1000).toString(Qt::ISODateWithMs)),
+            s.firstFrameOffsetMs);
+        std::printf("  frames %llu, dropped %llu (%.3f %%)\n",
+            static_cast<unsigned long long>(s.totalFrames),
+            static_cast<unsigned long long>(s.droppedFrames), s.dropRatePercent);
+        std::printf("  frequency Hz: mean %.3f  min %.3f  max %.3f\n", s.freqMeanHz, s.freqMinHz, s.freqMaxHz);
+        std::printf("  period ms: mean %.4f  jitter %.4f\n", s.periodMeanMs, s.periodJitterMs);
+        if (s.latencyAvailable) {
+            std::printf("  latency ms: mean %.3f  min %.3f  max %.3f  std %.3f\n",
+                s.latencyMeanMs, s.latencyMinMs, s.latencyMaxMs, s.latencyStdMs);
+        }
+        else {
+            std::printf("  latency: N/A\n");
+        }
+        if (s.poseSamples > 0) {
+            std::printf("  pose std (%llu samples): X %.4f  Y %.4f  Z %.4f mm, Rx %.4f  Ry %.4f  Rz %.4f deg\n",
+                static_cast<unsigned long long>(s.poseSamples),
+                s.poseStdDev[0], s.poseStdDev[1], s.poseStdDev[2],
+                s.poseStdDev[3], s.poseStdDev[4], s.poseStdDev[5]);
+        }
+    }
+    std::fflush(stdout);
+
+    shutdownSystems();
+    emit finished(m_exitCode);
+}
+
+void HeadlessRunner::shutdownSystems()
+{
+    for (const auto& channel : m_channels) {
+        if (channel->subscription != 0)
+            channel->system->unsubscribe(channel->subscription);
+        channel->subscription = 0;
+        if (channel->system->isAcquiring())
+            channel->system->stopAcquisition();
+        channel->system->disconnect();
+    }
+}
@@ -0,0 +1,137 @@
+#pragma once
+#ifndef HEADLESSRUNNER_H
+#define HEADLESSRUNNER_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QString>
+#include <QTimer>
+#include <QVector>
+#include <memory>
+#include <vector>
+
+#include "ConnectionConfig.h"
+#include "IMeasurementSystem.h"
+#include "SessionFile.h"
+#include "TriggerRecorder.h"
+
+/**
+ * @brief Système décrit dans le fichier de configuration de Mobot4Cli
+ */
+struct HeadlessSystemConfig {
+    QString          type;        // Nom SystemFactory : "KUKA", "Synthetic", "Replay"...
+    QString          name;        // Préfixe des messages et nom du fichier de session
+    ConnectionConfig connection;  // customParams = objet "params" du fichier
+};
+
+/**
+ * @brief Configuration d'une acquisition sans interface (fichier JSON)
+ *
+ *   {
+ *     "durationSeconds": 28800,          // 0 = jusqu'à Ctrl+C
+ *     "targetFrequency": 0,              // AcquisitionConfig::targetFrequency
+ *     "outputDirectory": "D:/captures",
+ *     "format": "binary",                // "binary" (.bin) ou "csv" (.csv)
+ *     "statusIntervalSeconds": 10,       // 0 = pas de ligne d'état
+ *     "trigger": { "event": "Bloc_Start", "preSeconds": 5, "postSeconds": 10 },
+ *     "systems": [
+ *       { "type": "KUKA", "name": "KR210", "address": "172.31.2.100", "port": 49152 },
+ *       { "type": "Synthetic", "object": "Body1", "params": { "frequency": 1000 } },
+ *       { "type": "Replay", "params": { "file": "session.bin", "speed": 0 } }
+ *     ]
+ *   }
+ *
+ * "address", "port", "multicast", "frequency", "object" et "objectId" renseignent
+ * ConnectionConfig ; "params" devient customParams (clés propres à chaque système).
+ *
+ * "trigger" (facultatif, voir TriggerConfig) : au lieu d'un fichier continu par système,
+ * seules les fenêtres autour des événements des robots KUKA sont enregistrées.
+ */
+struct HeadlessConfig {
+    double              durationS       = 0.0;
+    double              targetFrequency = 0.0;
+    QString             outputDirectory = QStringLiteral(".");
+    SessionFile::Format format          = SessionFile::Format::Binary;
+    double              statusIntervalS = 10.0;
+    bool                triggered       = false;   // Section "trigger" présente
+    TriggerConfig       trigger;
+    QVector<HeadlessSystemConfig> systems;
+
+    static bool fromJson(const QByteArray& json, HeadlessConfig& config, QString& error);
+    static bool parseFormat(const QString& text, SessionFile::Format& format);
+};
+
+/**
+ * @brief Acquisition sans Qt Widgets : connexion, enregistrement, résumé
+ *
+ * Les systèmes vivent dans le thread principal (QCoreApplication) ; leurs threads
+ * d'acquisition déposent chaque frame dans un FrameRingConsumer, vidé toutes les
+ * kDrainIntervalMs vers un fichier de session (SessionFile) par système. Aucune
+ * notification Qt n'est consommée : la cadence de FrameDispatcher est réduite au
+ * minimum pour laisser le CPU aux threads d'acquisition.
+ *
+ * Arrêt : durée écoulée, requestStop() (signal système relayé par main) ou erreur
+ * d'écriture. Les AcquisitionSummary sont alors affichés sur la sortie standard et
+ * finished() est émis avec le code de sortie du processus.
+ */
+class HeadlessRunner : public QObject {
+    Q_OBJECT
+
+public:
+    static constexpr int         kDrainIntervalMs = 20;
+    static constexpr std::size_t kRingCapacity    = 1u << 14;   // ~16 s à 1 kHz sans vidage
+    static constexpr int         kWriteChunkBytes = 1 << 20;
+
+    explicit HeadlessRunner(const HeadlessConfig& config, QObject* parent = nullptr);
+    ~HeadlessRunner() override;
+
+    /**
+     * @brief Crée, connecte et démarre tous les systèmes, ouvre les fichiers de session
+     * @return false si un système ne peut être créé, connecté ou démarré (tout est alors
+     *         déconnecté ; le détail a été écrit sur la sortie d'erreur)
+     */
+    bool start();
+
+public slots:
+    /** @brief Arrête l'acquisition, termine les fichiers et affiche les résumés */
+    void requestStop();
+
+signals:
+    void finished(int exitCode);
+
+private:
+    struct Channel {
+        QString                            name;
+        IMeasurementSystem*                system = nullptr;   // Enfant Qt du runner
+        std::shared_ptr<FrameRingConsumer> ring;
+        SubscriptionId                     subscription = 0;
+        QFile                              file;
+        QByteArray                         pending;
+        quint64                            recorded = 0;
+        bool                               hasSummary = false;
+        AcquisitionSummary                 summary;
+    };
+
+    IMeasurementSystem* createSystem(const HeadlessSystemConfig& config);
+    bool openSessionFile(Channel& channel, const QString& stamp);
+
+    void onDrainTick();
+    bool drain(Channel& channel, bool final);
+    void printStatus();
+    void finish();
+    void shutdownSystems();
+
+    HeadlessConfig                        m_config;
+    std::vector<std::unique_ptr<Channel>> m_channels;
+
+    QTimer*          m_drainTimer   = nullptr;
+    TriggerRecorder* m_trigger      = nullptr;   // Mode déclenché uniquement
+    QElapsedTimer    m_clock;
+    qint64           m_lastStatusMs = 0;
+    bool             m_stopping     = false;
+    int              m_exitCode     = 0;
+};
+
+#endif // HEADLESSRUNNER_H
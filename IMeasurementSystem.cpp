@@ -1,48 +1,244 @@
 #include "IMeasurementSystem.h"
+#include "TraceRecorder.h"
 #include <QDateTime>
+#include <cmath>
 #include <limits>
 
+namespace {
+    /// Réévaluation de l'arrêt pendant l'attente du départ commun
+    constexpr int kSessionStartPollMs = 50;
+
+    /// Replie un angle (degrés) dans [-180, 180[
+    double wrapDegrees(double a)
+    {
+        a = std::fmod(a + 180.0, 360.0);
+        if (a < 0.0) a += 360.0;
+        return a - 180.0;
+    }
+}
+
 IMeasurementSystem::IMeasurementSystem(QObject* parent)
     : QObject(parent)
     , m_isAcquiring(false)
     , m_acquisitionThread(nullptr)
     , m_lastFrameTimestamp(0)
+    , m_dispatcher(new FrameDispatcher(this))
 {
+    QObject::connect(m_dispatcher, &FrameDispatcher::latestFrame,
+        this, &IMeasurementSystem::newFrameAvailable);
+    QObject::connect(m_dispatcher, &FrameDispatcher::frameBatch,
+        this, &IMeasurementSystem::frameBatchAvailable);
+    QObject::connect(m_dispatcher, &FrameDispatcher::metricsUpdated,
+        this, &IMeasurementSystem::performanceUpdate);
 }
 
 IMeasurementSystem::~IMeasurementSystem()
 {
 }
 
+// =============================================================================
+// Diffusion
+// =============================================================================
+
+void IMeasurementSystem::setNotificationRate(double hz)
+{
+    m_dispatcher->setDeliveryRate(hz);
+}
+
+double IMeasurementSystem::notificationRate() const
+{
+    return m_dispatcher->deliveryRate();
+}
+
+void IMeasurementSystem::setFrameBatchDelivery(bool enabled)
+{
+    m_dispatcher->setBatchDeliveryEnabled(enabled);
+}
+
+void IMeasurementSystem::setTargetFrequency(double hz)
+{
+    m_targetFrequency = hz > 0.0 ? hz : 0.0;
+}
+
+double IMeasurementSystem::targetFrequency() const
+{
+    return m_targetFrequency;
+}
+
+void IMeasurementSystem::setStartBarrier(std::shared_ptr<StartBarrier> barrier)
+{
+    m_pendingBarrier = std::move(barrier);
+}
+
+void IMeasurementSystem::publishFrame(const MeasurementFrame& frame)
+{
+    notifySubscribers(frame);
+    m_dispatcher->postFrame(frame);
+}
+
+void IMeasurementSystem::notifySubscribers(const MeasurementFrame& frame)
+{
+    MOBOT_TRACE_SCOPE("publish.subscribers");
+    const std::shared_ptr<const SubscriberList> subscribers = std::atomic_load(&m_subscribers);
+    if (subscribers) {
+        for (const auto& subscriber : *subscribers)
+            subscriber->deliver(frame);
+    }
+}
+
+void IMeasurementSystem::publishBatch(const RigidBodyBatch& batch)
+{
+    MOBOT_TRACE_SCOPE("publish.batch");
+    const std::shared_ptr<const SubscriberList> subscribers = std::atomic_load(&m_subscribers);
+    if (subscribers) {
+        for (const auto& subscriber : *subscribers)
+            subscriber->deliverBatch(batch);
+    }
+}
+
+void IMeasurementSystem::publishMetrics()
+{
+    m_dispatcher->postMetrics(m_metrics);
+}
+
+// =============================================================================
+// Abonnements C++
+// =============================================================================
+
+SubscriptionId IMeasurementSystem::subscribe(FrameCallback callback,
+    const SubscriptionOptions& options)
+{
+    if (!callback)
+        return 0;
+    auto subscriber = std::make_shared<FrameSubscriber>();
+    subscriber->options  = options;
+    subscriber->callback = std::move(callback);
+    return addSubscriber(std::move(subscriber));
+}
+
+SubscriptionId IMeasurementSystem::subscribe(std::shared_ptr<FrameRingConsumer> consumer,
+    const SubscriptionOptions& options)
+{
+    if (!consumer)
+        return 0;
+    auto subscriber = std::make_shared<FrameSubscriber>();
+    subscriber->options = options;
+    subscriber->ring    = std::move(consumer);
+    return addSubscriber(std::move(subscriber));
+}
+
+SubscriptionId IMeasurementSystem::subscribeBatches(BatchCallback callback,
+    const SubscriptionOptions& options)
+{
+    if (!callback)
+        return 0;
+    auto subscriber = std::make_shared<FrameSubscriber>();
+    subscriber->options       = options;
+    subscriber->batchCallback = std::move(callback);
+    return addSubscriber(std::move(subscriber));
+}
+
+SubscriptionId IMeasurementSystem::addSubscriber(std::shared_ptr<FrameSubscriber> subscriber)
+{
+    QMutexLocker locker(&m_subscribersMutex);
+    subscriber->id = m_nextSubscriptionId++;
+
+    const auto current = std::atomic_load(&m_subscribers);
+    auto updated = current ? std::make_shared<SubscriberList>(*current)
+                           : std::make_shared<SubscriberList>();
+    updated->push_back(subscriber);
+    std::atomic_store(&m_subscribers, std::shared_ptr<const SubscriberList>(std::move(updated)));
+    return subscriber->id;
+}
+
+bool IMeasurementSystem::unsubscribe(SubscriptionId id)
+{
+    QMutexLocker locker(&m_subscribersMutex);
+    const auto current = std::atomic_load(&m_subscribers);
+    if (!current)
+        return false;
+
+    auto updated = std::make_shared<SubscriberList>();
+    updated->reserve(current->size());
+    for (const auto& s : *current) {
+        if (s->id != id)
+            updated->push_back(s);
+    }
+    if (updated->size() == current->size())
+        return false;
+
+    std::atomic_store(&m_subscribers, std::shared_ptr<const SubscriberList>(std::move(updated)));
+    return true;
+}
+
 // =============================================================================
 // Gestion des statistiques de session
 // =============================================================================
 
 void IMeasurementSystem::resetSessionStats()
 {
-    // Horodatage de début de session en µs
+    // Horodatage de début de session en µs (remplacé par le t0 commun s'il y a barrière)
     m_sessionStartTimestamp = QDateTime::currentMSecsSinceEpoch() * 1000LL;
+    m_sessionStartNs        = StartBarrier::steadyNowNs();
+    m_firstFrameNs          = 0;
+    m_synchronizedStart     = false;
 
-    // Réinitialisation des accumulateurs fréquence
-    m_freqSum   = 0.0;
-    m_freqMin   = std::numeric_limits<double>::max();
-    m_freqMax   = 0.0;
-    m_freqCount = 0;
+    // Le thread d'acquisition n'est pas encore lancé : son démarrage publie ces valeurs
+    m_sessionBarrier = std::move(m_pendingBarrier);
+    m_sessionStarted.store(!m_sessionBarrier, std::memory_order_relaxed);
+
+    // Réinitialisation des accumulateurs période
+    m_periodStats.reset();
+    m_periodAllan.reset();
 
     // Réinitialisation des accumulateurs latence
     m_latencyKnown = false;
-    m_latencySum   = 0.0;
-    m_latencyMin   = std::numeric_limits<double>::max();
-    m_latencyMax   = 0.0;
-    m_latencyCount = 0;
+    m_latencyStats.reset();
+
+    // Réinitialisation des accumulateurs pose
+    for (RunningStats& s : m_poseStats)
+        s.reset();
 
     // Réinitialisation des métriques live
     m_metrics             = PerformanceMetrics();
     m_metrics.systemName  = getSystemName();
 }
 
+bool IMeasurementSystem::sessionStarted()
+{
+    if (m_sessionStarted.load(std::memory_order_relaxed))
+        return true;
+    if (!m_sessionBarrier->wait(0))
+        return false;
+
+    if (m_sessionBarrier->isReleased()) {
+        m_sessionStartTimestamp = m_sessionBarrier->t0EpochUs();
+        m_sessionStartNs        = m_sessionBarrier->t0SteadyNs();
+        m_synchronizedStart     = true;
+    }
+    else {
+        m_sessionStartTimestamp = QDateTime::currentMSecsSinceEpoch() * 1000LL;
+        m_sessionStartNs        = StartBarrier::steadyNowNs();
+    }
+    m_sessionStarted.store(true, std::memory_order_relaxed);
+    return true;
+}
+
+bool IMeasurementSystem::waitForSessionStart()
+{
+    while (!sessionStarted()) {
+        if (!m_isAcquiring.load())
+            return false;
+        m_sessionBarrier->wait(kSessionStartPollMs);
+    }
+    return true;
+}
+
 void IMeasurementSystem::updateRunningStats(double latencyMs, double freqHz, bool latencyKnown)
 {
+    if (m_firstFrameNs == 0)
+        m_firstFrameNs = StartBarrier::steadyNowNs();
+
     // --- Métriques live (signal performanceUpdate) ---
     m_metrics.frequencyHz = freqHz;
     m_metrics.latencyMs   = latencyKnown ? latencyMs : 0.0;
@@ -50,24 +246,38 @@ void IMeasurementSystem::updateRunningStats(double latencyMs, double freqHz, boo
     // m_metrics.droppedFrames est mis à jour directement par chaque système
     // (détection via delta frame number, spécifique à chaque protocole)
 
-    // --- Accumulation fréquence ---
+    // --- Accumulation période (la fréquence instantanée est l'inverse) ---
     if (freqHz > 0.0) {
-        m_freqSum += freqHz;
-        if (freqHz < m_freqMin) m_freqMin = freqHz;
-        if (freqHz > m_freqMax) m_freqMax = freqHz;
-        ++m_freqCount;
+        const double periodMs = 1000.0 / freqHz;
+        m_periodStats.add(periodMs);
+        m_periodAllan.add(periodMs);
     }
 
     // --- Accumulation latence ---
     if (latencyKnown && latencyMs > 0.0) {
-        m_latencyKnown  = true;
-        m_latencySum   += latencyMs;
-        if (latencyMs < m_latencyMin) m_latencyMin = latencyMs;
-        if (latencyMs > m_latencyMax) m_latencyMax = latencyMs;
-        ++m_latencyCount;
+        m_latencyKnown = true;
+        m_latencyStats.add(latencyMs);
     }
 }
 
+void IMeasurementSystem::updatePoseStats(const MeasurementFrame& frame)
+{
+    if (!frame.isValid)
+        return;
+
+    const double angles[3] = { frame.rx, frame.ry, frame.rz };
+    if (m_poseStats[0].count() == 0) {
+        for (int i = 0; i < 3; ++i)
+            m_angleRef[i] = angles[i];
+    }
+
+    m_poseStats[0].add(frame.x);
+    m_poseStats[1].add(frame.y);
+    m_poseStats[2].add(frame.z);
+    for (int i = 0; i < 3; ++i)
+        m_poseStats[3 + i].add(wrapDegrees(angles[i] - m_angleRef[i]));
+}
+
 AcquisitionSummary IMeasurementSystem::buildSummary(const QString& objectName) const
 {
     AcquisitionSummary summary;
@@ -80,6 +290,10 @@ AcquisitionSummary IMeasurementSystem::buildSummary(const QString& objectName) c
     summary.endTimestamp    = QDateTime::currentMSecsSinceEpoch() * 1000LL;
     summary.durationSeconds = static_cast<double>(summary.endTimestamp - summary.startTimestamp)
                               / 1'000'000.0;
+    summary.synchronizedStart = m_synchronizedStart;
+    summary.firstFrameOffsetMs = m_firstFrameNs > 0
+        ? static_cast<double>(m_firstFrameNs - m_sessionStartNs) / 1e6
+        : 0.0;
 
     // Frames
     summary.totalFrames   = m_metrics.frameCount;
@@ -89,20 +303,42 @@ AcquisitionSummary IMeasurementSystem::buildSummary(const QString& objectName) c
         ? (static_cast<double>(summary.droppedFrames) / static_cast<double>(totalPossible)) * 100.0
         : 0.0;
 
-    // Fréquence
-    summary.freqMeanHz = m_freqCount > 0
-        ? m_freqSum / static_cast<double>(m_freqCount)
-        : 0.0;
-    summary.freqMinHz  = m_freqCount > 0 ? m_freqMin : 0.0;
-    summary.freqMaxHz  = m_freqMax;
+    // Période / fréquence
+    if (m_periodStats.count() > 0) {
+        summary.periodMeanMs   = m_periodStats.mean();
+        summary.periodJitterMs = m_periodStats.stddev();
+        summary.freqMeanHz     = 1000.0 / m_periodStats.mean();
+        summary.freqMinHz      = 1000.0 / m_periodStats.max();
+        summary.freqMaxHz      = 1000.0 / m_periodStats.min();
+    }
+
+    // Déviation d'Allan de la période
+    const int octaves = m_periodAllan.octaveCount();
+    summary.allanTauS.reserve(octaves);
+    summary.allanDevMs.reserve(octaves);
+    for (int k = 0; k < octaves; ++k) {
+        summary.allanTauS.append(static_cast<double>(AllanDeviation::windowSamples(k))
+                                 * summary.periodMeanMs / 1000.0);
+        summary.allanDevMs.append(m_periodAllan.deviation(k));
+    }
 
     // Latence
     summary.latencyAvailable = m_latencyKnown;
-    if (m_latencyKnown && m_latencyCount > 0) {
-        summary.latencyMeanMs = m_latencySum / static_cast<double>(m_latencyCount);
-        summary.latencyMinMs  = m_latencyMin;
-        summary.latencyMaxMs  = m_latencyMax;
+    if (m_latencyKnown && m_latencyStats.count() > 0) {
+        summary.latencyMeanMs = m_latencyStats.mean();
+        summary.latencyMinMs  = m_latencyStats.min();
+        summary.latencyMaxMs  = m_latencyStats.max();
+        summary.latencyStdMs  = m_latencyStats.stddev();
+    }
+
+    // Bruit de pose (angles : moyenne ramenée dans le repère absolu)
+    summary.poseSamples = m_poseStats[0].count();
+    for (int i = 0; i < 6; ++i) {
+        summary.poseMean[i]   = m_poseStats[i].mean();
+        summary.poseStdDev[i] = m_poseStats[i].stddev();
     }
+    for (int i = 0; i < 3; ++i)
+        summary.poseMean[3 + i] = wrapDegrees(summary.poseMean[3 + i] + m_angleRef[i]);
 
     return summary;
 }
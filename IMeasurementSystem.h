@@ -5,14 +5,21 @@
 #include <QObject>
 #include <QThread>
 #include <QMutex>
+#include <QVector>
 #include <atomic>
 #include <limits>
+#include <memory>
+#include <vector>
 #include "MeasurementFrame.h"
 #include "SystemCapabilities.h"
 #include "ConnectionConfig.h"
 #include "PerformanceMetrics.h"
 #include "AcquisitionSummary.h"
 #include "CircularBuffer.h"
+#include "RunningStats.h"
+#include "StartBarrier.h"
+#include "FrameDispatcher.h"
+#include "FrameSubscription.h"
 
 /**
  * @brief Interface abstraite pour tous les systèmes de mesure
@@ -22,8 +29,19 @@
  *
  * Gestion des statistiques de session :
  *   - Appeler resetSessionStats() dans startAcquisition()
+ *   - Dans le thread d'acquisition, ne publier qu'une fois sessionStarted() vrai
+ *     (ou après waitForSessionStart()) : départ commun via setStartBarrier()
  *   - Appeler updateRunningStats() à chaque frame reçue
+ *   - Appeler updatePoseStats() à chaque frame valide (bruit de pose)
  *   - Appeler buildSummary() dans stopAcquisition() puis emit acquisitionCompleted()
+ *
+ * Diffusion des frames :
+ *   - Appeler publishFrame() / publishMetrics() au lieu d'émettre directement
+ *     newFrameAvailable / performanceUpdate depuis le thread d'acquisition.
+ *     Les notifications sont coalescées (FrameDispatcher) et livrées dans le
+ *     thread Qt au plus à notificationRate() Hz.
+ *   - publishFrame() sert aussi, de façon synchrone et sans copie, les abonnés
+ *     C++ enregistrés via subscribe() (enregistreurs, synchroniseurs, plugins).
  */
 class IMeasurementSystem : public QObject {
     Q_OBJECT
@@ -73,14 +91,82 @@ public:
     virtual QString getSystemVersion() const = 0;
     virtual ThreadingModel getThreadingModel() const = 0;
 
+    // ========== Diffusion ==========
+
+    /**
+     * @brief Cadence max de livraison de newFrameAvailable / performanceUpdate / frameBatchAvailable
+     * @param hz 0 = une émission par frame depuis le thread d'acquisition (pas de coalescence)
+     */
+    void   setNotificationRate(double hz);
+    double notificationRate() const;
+
+    /** @brief Active frameBatchAvailable (toutes les frames, livrées par lots) */
+    void setFrameBatchDelivery(bool enabled);
+
+    // ========== Synchronisation ==========
+
+    /**
+     * @brief Fréquence de sortie du synchroniseur (AcquisitionConfig::targetFrequency)
+     *
+     * Indicative : un système capable de décimer à la source (ex. Qualisys) en
+     * déduit la cadence demandée au serveur au prochain startAcquisition().
+     * @param hz 0 = toutes les frames natives
+     */
+    void   setTargetFrequency(double hz);
+    double targetFrequency() const;
+
+    /**
+     * @brief Barrière de départ commune, prise en compte au prochain startAcquisition()
+     *
+     * Le système s'arme normalement puis retient ses frames jusqu'à la libération
+     * de la barrière, dont le t0 devient le début de session. Consommée par ce
+     * démarrage : les suivants reprennent leur propre origine.
+     */
+    void setStartBarrier(std::shared_ptr<StartBarrier> barrier);
+
+    // ========== Abonnements C++ (hors Qt, thread-safe) ==========
+
+    /**
+     * @brief Enregistre un callback appelé dans le thread producteur à chaque frame retenue
+     * @return Identifiant à passer à unsubscribe()
+     */
+    SubscriptionId subscribe(FrameCallback callback,
+        const SubscriptionOptions& options = SubscriptionOptions());
+
+    /**
+     * @brief Enregistre un anneau que le consommateur vide depuis son propre thread
+     */
+    SubscriptionId subscribe(std::shared_ptr<FrameRingConsumer> consumer,
+        const SubscriptionOptions& options = SubscriptionOptions());
+
+    /**
+     * @brief Enregistre un callback de lot : tous les corps rigides de chaque frame
+     *        (systèmes multi-corps uniquement, ex. OptiTrack en capture complète).
+     *        Le filtre objectName des options est ignoré.
+     */
+    SubscriptionId subscribeBatches(BatchCallback callback,
+        const SubscriptionOptions& options = SubscriptionOptions());
+
+    /**
+     * @brief Retire un abonnement. Une livraison déjà en cours dans le thread
+     *        producteur peut encore se terminer après le retour.
+     */
+    bool unsubscribe(SubscriptionId id);
+
 signals:
     void connected();
     void disconnected();
+
+    /** @brief Dernière frame connue, au plus notificationRate() fois par seconde */
     void newFrameAvailable(const MeasurementFrame& frame);
+
+    /** @brief Toutes les frames depuis le lot précédent (si setFrameBatchDelivery(true)) */
+    void frameBatchAvailable(const QVector<MeasurementFrame>& frames);
+
     void errorOccurred(const QString& error);
     void logMessage(const QString& message);
 
-    /** @brief Émis à chaque frame avec les métriques instantanées */
+    /** @brief Métriques instantanées les plus récentes, au plus notificationRate() fois par seconde */
     void performanceUpdate(const PerformanceMetrics& metrics);
 
     /** @brief Émis une seule fois à l'arrêt de l'acquisition */
@@ -99,6 +185,25 @@ protected:
      */
     void resetSessionStats();
 
+    /**
+     * @brief Début de session atteint (thread d'acquisition, non bloquant)
+     *
+     * Toujours vrai sans barrière. Avec barrière : faux tant qu'elle est armée, les
+     * frames reçues entre-temps sont à écarter (pas de publication ni de statistiques).
+     * Au passage à vrai, le début de session prend le t0 commun (ou, barrière
+     * annulée, l'instant présent).
+     */
+    bool sessionStarted();
+
+    /**
+     * @brief Attend le début de session (systèmes qui cadencent eux-mêmes leurs frames)
+     * @return false si l'acquisition est arrêtée pendant l'attente
+     */
+    bool waitForSessionStart();
+
+    /** @brief Début de session (µs epoch), commun aux systèmes d'une même barrière */
+    qint64 sessionStartTimestamp() const { return m_sessionStartTimestamp; }
+
     /**
      * @brief Met à jour m_metrics (valeurs live) et accumule pour le résumé final.
      *        À appeler à chaque frame dans la boucle d'acquisition.
@@ -109,6 +214,13 @@ protected:
      */
     void updateRunningStats(double latencyMs, double freqHz, bool latencyKnown = true);
 
+    /**
+     * @brief Accumule la pose d'une frame valide (écart-type par axe dans le résumé).
+     *        Les angles sont accumulés relativement à la première frame, repliés
+     *        dans [-180, 180[, pour ne pas exploser autour de ±180°.
+     */
+    void updatePoseStats(const MeasurementFrame& frame);
+
     /**
      * @brief Construit l'AcquisitionSummary à partir des accumulateurs.
      *        À appeler dans stopAcquisition() avant emit acquisitionCompleted().
@@ -117,13 +229,32 @@ protected:
      */
     AcquisitionSummary buildSummary(const QString& objectName = QString()) const;
 
+    // =========================================================================
+    // Diffusion (appelable depuis n'importe quel thread)
+    // =========================================================================
+
+    /** @brief Publie une frame : abonnés C++ (synchrone) puis signaux Qt (coalescés) */
+    void publishFrame(const MeasurementFrame& frame);
+
+    /**
+     * @brief Abonnés C++ uniquement, sans signal Qt ni mise à jour des métriques.
+     *        Flux par corps d'un système multi-corps (filtrés par objectName).
+     */
+    void notifySubscribers(const MeasurementFrame& frame);
+
+    /** @brief Publie un lot multi-corps aux abonnés subscribeBatches() */
+    void publishBatch(const RigidBodyBatch& batch);
+
+    /** @brief Publie m_metrics (coalescé vers performanceUpdate) */
+    void publishMetrics();
+
     // =========================================================================
     // Membres protégés
     // =========================================================================
 
     SystemCapabilities m_capabilities;
     std::atomic<bool>  m_isAcquiring;
-    QThread*           m_acquisitionThread;
+    QThread*           m_acquisitionThread;   // Rattaché au thread du système (moveToThread)
 
     mutable QMutex   m_frameMutex;
     MeasurementFrame m_latestFrame;
@@ -133,25 +264,50 @@ protected:
     PerformanceMetrics m_metrics;           // Métriques live (frame courante)
     qint64             m_lastFrameTimestamp;
 
+    FrameDispatcher*   m_dispatcher;        // Enfant Qt → vit dans le thread du système
+
 private:
+    double m_targetFrequency = 0.0;     // Hz, 0 = cadence native (setTargetFrequency)
+
     // =========================================================================
     // Accumulateurs de session (privés, manipulés via les méthodes protégées)
     // =========================================================================
 
     qint64  m_sessionStartTimestamp = 0;
 
-    // Fréquence
-    double  m_freqSum   = 0.0;
-    double  m_freqMin   = std::numeric_limits<double>::max();
-    double  m_freqMax   = 0.0;
-    quint64 m_freqCount = 0;
+    // Départ commun : barrière en attente du prochain démarrage, puis celle de la
+    // session en cours (lue par le thread d'acquisition)
+    std::shared_ptr<StartBarrier> m_pendingBarrier;
+    std::shared_ptr<StartBarrier> m_sessionBarrier;
+    std::atomic<bool>             m_sessionStarted{ false };
+    bool    m_synchronizedStart  = false;
+    qint64  m_sessionStartNs     = 0;       // Horloge monotone hôte (StartBarrier::steadyNowNs)
+    qint64  m_firstFrameNs       = 0;       // Première frame comptée, même horloge
+
+    // Période inter-frame (ms) — la fréquence moyenne en est dérivée
+    RunningStats   m_periodStats;
+    AllanDeviation m_periodAllan;
 
     // Latence
-    bool    m_latencyKnown = false;
-    double  m_latencySum   = 0.0;
-    double  m_latencyMin   = std::numeric_limits<double>::max();
-    double  m_latencyMax   = 0.0;
-    quint64 m_latencyCount = 0;
+    bool         m_latencyKnown = false;
+    RunningStats m_latencyStats;
+
+    // Pose (X, Y, Z, Rx, Ry, Rz)
+    RunningStats m_poseStats[6];
+    double       m_angleRef[3] = {};
+
+    // =========================================================================
+    // Abonnés C++ — copie sur écriture : le producteur lit un instantané
+    // atomique, sans verrou, et ne voit jamais un vecteur en cours de modification
+    // =========================================================================
+
+    using SubscriberList = std::vector<std::shared_ptr<FrameSubscriber>>;
+
+    SubscriptionId addSubscriber(std::shared_ptr<FrameSubscriber> subscriber);
+
+    QMutex                                m_subscribersMutex;   // Sérialise les écrivains
+    std::shared_ptr<const SubscriberList> m_subscribers;
+    SubscriptionId                        m_nextSubscriptionId = 1;
 };
 
 #endif // IMEASUREMENTSYSTEM_H
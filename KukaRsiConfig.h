@@ -28,6 +28,15 @@ public:
     // ── Identité ──────────────────────────────────────────────────────────────
     QString robotName = QStringLiteral("KUKA RSI");
 
+    // ── Diagnostic ────────────────────────────────────────────────────────────
+    // Capture pcap de chaque datagramme reçu (vide = aucune)
+    QString captureFile;
+
+    // Rejeu d'une capture pcap à la place du robot (vide = socket réel).
+    // replaySpeed : 1 = cadence d'origine, N = N fois plus vite, 0 = au plus vite
+    QString replayFile;
+    double  replaySpeed = 1.0;
+
     // ── Tags optionnels à extraire ────────────────────────────────────────────
     // Sélection par défaut : angles articulaires + métriques RT
     QList<RsiTag> selectedTags = {
@@ -6,11 +6,17 @@
 #include "RsiTrame.h"
 #include "TrameHelper.h"
 #include "RsiTag.h"
+#include "TraceRecorder.h"
+#include "Profiler.h"
 
 #include <QThread>
 #include <QDateTime>
 #include <QMutexLocker>
 
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
 // ============================================================================
 // Constructeur / Destructeur
 // ============================================================================
@@ -43,11 +49,35 @@ bool KukaRsiSystem::initialize()
     return true;
 }
 
-bool KukaRsiSystem::connect(const ConnectionConfig& /*config*/)
+bool KukaRsiSystem::connect(const ConnectionConfig& config)
 {
     if (m_isConnected)
         return true;
 
+    const QVariantMap& p = config.customParams;
+    m_config.captureFile = p.value("captureFile", m_config.captureFile).toString();
+    m_config.replayFile  = p.value("replayFile",  m_config.replayFile).toString();
+    m_config.replaySpeed = qMax(0.0, p.value("replaySpeed", m_config.replaySpeed).toDouble());
+
+    // Rejeu : la capture remplace le robot, aucun socket ouvert
+    if (!m_config.replayFile.isEmpty()) {
+        m_replay = std::make_unique<DatagramCaptureReader>();
+        if (!m_replay->open(m_config.replayFile.toLocal8Bit().toStdString())) {
+            emit errorOccurred(QStringLiteral("KukaRsi: %1")
+                .arg(QString::fromStdString(m_replay->lastError())));
+            m_replay.reset();
+            return false;
+        }
+        m_isConnected = true;
+        emit connected();
+        emit logMessage(QStringLiteral("KukaRsi: rejeu de %1 (%2)")
+            .arg(m_config.replayFile)
+            .arg(m_config.replaySpeed > 0.0
+                ? QStringLiteral("vitesse x%1").arg(m_config.replaySpeed)
+                : QStringLiteral("au plus vite")));
+        return true;
+    }
+
     m_socket = std::make_unique<NativeUdpSocket>(
         m_config.hostAddress.toStdString(),
         static_cast<u_short>(m_config.hostPort),
@@ -68,6 +98,19 @@ bool KukaRsiSystem::connect(const ConnectionConfig& /*config*/)
         return false;
     }
 
+    if (!m_config.captureFile.isEmpty()) {
+        auto capture = std::make_shared<DatagramCapture>();
+        if (capture->open(m_config.captureFile.toLocal8Bit().toStdString())) {
+            m_socket->setCapture(capture);
+            emit logMessage(QStringLiteral("KukaRsi: capture des datagrammes dans %1")
+                .arg(m_config.captureFile));
+        }
+        else {
+            emit logMessage(QStringLiteral("KukaRsi: %1")
+                .arg(QString::fromStdString(capture->lastError())));
+        }
+    }
+
     m_robotAddrKnown = false;
     m_isConnected = true;
     emit connected();
@@ -84,6 +127,7 @@ bool KukaRsiSystem::disconnect()
     if (m_socket)
         m_socket->close();
     m_socket.reset();
+    m_replay.reset();
 
     m_isConnected = false;
     m_robotAddrKnown = false;
@@ -109,10 +153,21 @@ bool KukaRsiSystem::startAcquisition()
     if (m_isAcquiring)
         return true;
 
+    if (m_replay && !m_replay->rewind()) {
+        emit errorOccurred(QStringLiteral("KukaRsi: %1")
+            .arg(QString::fromStdString(m_replay->lastError())));
+        return false;
+    }
+
+    // Sans canal de réveil, la boucle retombe sur une attente bornée (kFallbackTimeoutMs)
+    if (!m_replay && !m_wakeup.open())
+        emit logMessage(QStringLiteral("KukaRsi: canal de réveil indisponible, attente bornée"));
+
     resetSessionStats();
     m_isAcquiring = true;
 
     m_acquisitionThread = QThread::create([this]() { acquisitionLoop(); });
+    m_acquisitionThread->moveToThread(thread());
     m_acquisitionThread->setObjectName(QStringLiteral("KukaRsiAcqThread"));
     m_acquisitionThread->start(QThread::TimeCriticalPriority);
 
@@ -126,12 +181,14 @@ bool KukaRsiSystem::stopAcquisition()
         return true;
 
     m_isAcquiring = false;
+    m_wakeup.wake();
 
     if (m_acquisitionThread) {
         m_acquisitionThread->wait(3000);
         delete m_acquisitionThread;
         m_acquisitionThread = nullptr;
     }
+    m_wakeup.close();
 
     const AcquisitionSummary summary = buildSummary(m_config.robotName);
     emit acquisitionCompleted(summary);
@@ -178,10 +235,21 @@ IMeasurementSystem::ThreadingModel KukaRsiSystem::getThreadingModel() const
 
 void KukaRsiSystem::acquisitionLoop()
 {
+    MOBOT_TRACE_THREAD_NAME("KUKA RSI");
+    MOBOT_PROFILE_SYSTEM("KUKA RSI");
+
+    if (m_replay) {
+        if (waitForSessionStart())
+            replayLoop();
+        return;
+    }
+
+    const SOCKET robotSocket = m_socket->nativeHandle();
+
     while (m_isAcquiring) {
 
-        // 1. Attente données — 100 ms timeout (tolère les délais d'établissement)
-        if (!m_socket->waitForData(100))
+        // 1. Attente données sans délai — stopAcquisition() réveille la boucle
+        if (m_wakeup.waitForAny(&robotSocket, 1, -1) != 0)
             continue;
 
         // 2. Réception
@@ -192,6 +260,9 @@ void KukaRsiSystem::acquisitionLoop()
         if (len <= 0)
             continue;
 
+        // Cycle tracé de l'arrivée du datagramme à la publication (parse, ACK, publish imbriqués)
+        MOBOT_TRACE_SCOPE("rsi.cycle");
+
         // 3. Mémorisation adresse robot au 1er paquet
         if (!m_robotAddrKnown) {
             m_robotIp = senderIp;
@@ -208,38 +279,118 @@ void KukaRsiSystem::acquisitionLoop()
         MeasurementFrame frame;
         RsiRobotState    state;
 
-        if (!parseRobBlock(m_recvBuf, dataLen, frame, state))
+        if (!parseDatagram(m_recvBuf, dataLen, frame, state))
             continue; // IPOC absent ou RIst absent → trame invalide, pas d'ACK
 
-        parseLogBlock(m_recvBuf, dataLen, state);
-        parseOptionalTags(m_recvBuf, dataLen, frame, state);
-
         // 5. ACK immédiat — corrections nulles, IPOC en écho
         sendAck(std::to_string(state.ipoc), m_robotIp, m_robotPort);
 
-        // 6. Timestamp wall-clock + complétion frame
-        frame.timestamp = QDateTime::currentMSecsSinceEpoch() * 1000LL;
-        frame.systemName = QStringLiteral("KUKA RSI");
-        frame.objectName = m_config.robotName;
-
-        // 7. Métriques — fréquence depuis DtSend, latence depuis DurationJob
-        const double freqHz = (state.dtSendMs > 0.0)
-            ? 1000.0 / state.dtSendMs
-            : 250.0;
-        const bool latencyKnown = (state.durationJobMs > 0.0);
-        m_latencyMs.store(state.durationJobMs);
-        updateRunningStats(state.durationJobMs, freqHz, latencyKnown);
-
-        // 8. Mise à jour frame partagée + émissions
-        {
-            QMutexLocker lk(&m_frameMutex);
-            m_latestFrame = frame;
+        // Armé en attente du départ commun : le robot reçoit ses ACK, rien n'est publié
+        if (!sessionStarted())
+            continue;
+
+        // 6. Timestamp wall-clock, métriques, émissions
+        publishRobotFrame(frame, state, QDateTime::currentMSecsSinceEpoch() * 1000LL);
+    }
+}
+
+// ============================================================================
+// Rejeu de capture — cadence d'origine (÷ replaySpeed) ou au plus vite
+// ============================================================================
+
+void KukaRsiSystem::replayLoop()
+{
+    using Clock = std::chrono::steady_clock;
+
+    const double speed = m_config.replaySpeed;
+    const Clock::time_point start = Clock::now();
+    DatagramCaptureReader::Datagram datagram;
+    int64_t  firstNs  = -1;
+    uint64_t replayed = 0;
+
+    while (m_isAcquiring && m_replay->next(datagram)) {
+        if (firstNs < 0)
+            firstNs = datagram.timestampNs;
+
+        if (speed > 0.0) {
+            const Clock::time_point due = start + std::chrono::nanoseconds(
+                static_cast<int64_t>((datagram.timestampNs - firstNs) / speed));
+            // Attente découpée : l'arrêt reste pris en compte sur une capture lente
+            while (m_isAcquiring && Clock::now() < due)
+                std::this_thread::sleep_until(std::min(due, Clock::now() + std::chrono::milliseconds(100)));
+            if (!m_isAcquiring)
+                break;
         }
 
-        emit newFrameAvailable(frame);
-        emit robotStateUpdated(state);
-        emit performanceUpdate(m_metrics);
+        // Les ACK d'une capture Wireshark (<Sen>, sans RIst) sont rejetés par le parsing
+        if (ingestDatagram(datagram.payload, datagram.length, datagram.timestampNs / 1000))
+            ++replayed;
+    }
+
+    if (m_isAcquiring) {
+        const double elapsedS = std::chrono::duration<double>(Clock::now() - start).count();
+        emit logMessage(QStringLiteral("KukaRsi: fin du rejeu — %1 trames en %2 s")
+            .arg(replayed).arg(elapsedS, 0, 'f', 3));
+    }
+}
+
+// ============================================================================
+// Chemin de parsing commun (socket, rejeu, bancs)
+// ============================================================================
+
+bool KukaRsiSystem::ingestDatagram(const char* data, std::size_t len, qint64 timestampUs)
+{
+    MeasurementFrame frame;
+    RsiRobotState    state;
+    if (!parseDatagram(data, len, frame, state))
+        return false;
+
+    publishRobotFrame(frame, state, timestampUs);
+    return true;
+}
+
+bool KukaRsiSystem::parseDatagram(const char* data, std::size_t len,
+    MeasurementFrame& frame, RsiRobotState& state)
+{
+    MOBOT_TRACE_SCOPE("rsi.parse");
+    MOBOT_PROFILE_SCOPE("KUKA RSI / parse");
+
+    if (!parseRobBlock(data, len, frame, state))
+        return false;
+
+    parseLogBlock(data, len, state);
+    parseOptionalTags(data, len, frame, state);
+    return true;
+}
+
+void KukaRsiSystem::publishRobotFrame(MeasurementFrame& frame,
+    const RsiRobotState& state, qint64 timestampUs)
+{
+    MOBOT_TRACE_SCOPE_ARG("rsi.publish", state.ipoc);
+    MOBOT_PROFILE_SCOPE("KUKA RSI / publish");
+
+    frame.timestamp = timestampUs;
+    frame.systemName = QStringLiteral("KUKA RSI");
+    frame.objectName = m_config.robotName;
+
+    // Métriques — fréquence depuis DtSend, latence depuis DurationJob
+    const double freqHz = (state.dtSendMs > 0.0)
+        ? 1000.0 / state.dtSendMs
+        : 250.0;
+    const bool latencyKnown = (state.durationJobMs > 0.0);
+    m_latencyMs.store(state.durationJobMs);
+    updateRunningStats(state.durationJobMs, freqHz, latencyKnown);
+    updatePoseStats(frame);
+
+    // Mise à jour frame partagée + émissions
+    {
+        QMutexLocker lk(&m_frameMutex);
+        m_latestFrame = frame;
     }
+
+    publishFrame(frame);
+    emit robotStateUpdated(state);
+    publishMetrics();
 }
 
 // ============================================================================
@@ -417,6 +568,9 @@ void KukaRsiSystem::parseOptionalTags(const char* data, std::size_t len,
 bool KukaRsiSystem::sendAck(const std::string& ipoc,
     const std::string& destIp, u_short destPort)
 {
+    MOBOT_TRACE_SCOPE("rsi.ack");
+    MOBOT_PROFILE_SCOPE("KUKA RSI / ACK");
+
     RsiTrame trame;
     trame.setIPOC(ipoc);
 
@@ -5,6 +5,8 @@
 #include "IMeasurementSystem.h"
 #include "KukaRsiConfig.h"
 #include "NativeUdpSocket.h"
+#include "DatagramCapture.h"
+#include "WakeupChannel.h"
 #include "RsiRobotState.h"
 
 #include <memory>
@@ -36,6 +38,16 @@ public:
     QString            getSystemVersion()  const override;
     ThreadingModel     getThreadingModel() const override;
 
+    /**
+     * @brief Injecte un datagramme <Rob> dans le chemin de parsing, sans ACK
+     *
+     * Même traitement qu'une trame reçue du robot (parsing, extras, métriques,
+     * diffusion), horodatée timestampUs. Sert au rejeu de captures et aux bancs
+     * de parsing. Ne pas appeler pendant une acquisition sur socket réel.
+     * @return false si la trame est invalide (IPOC ou RIst absent)
+     */
+    bool ingestDatagram(const char* data, std::size_t len, qint64 timestampUs);
+
 signals:
     /**
      * @brief Émis à chaque cycle avec l'état complet du robot.
@@ -46,6 +58,12 @@ signals:
 
 private:
     void acquisitionLoop();
+    void replayLoop();
+
+    bool parseDatagram(const char* data, std::size_t len,
+        MeasurementFrame& frame, RsiRobotState& state);
+    void publishRobotFrame(MeasurementFrame& frame,
+        const RsiRobotState& state, qint64 timestampUs);
 
     bool parseRobBlock(const char* data, std::size_t len,
         MeasurementFrame& frame, RsiRobotState& state);
@@ -60,6 +78,8 @@ private:
 private:
     KukaRsiConfig                    m_config;
     std::unique_ptr<NativeUdpSocket> m_socket;
+    std::unique_ptr<DatagramCaptureReader> m_replay;   // Rejeu de capture (m_config.replayFile)
+    WakeupChannel                    m_wakeup;         // Arrêt : réveille la boucle bloquée sur la socket
     std::atomic<bool>                m_isConnected{ false };
 
     // Adresse robot apprise dynamiquement au 1er paquet reçu
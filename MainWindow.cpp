@@ -6,6 +6,9 @@
 #include "AddSystemDialog.h"
 #include "SystemCardWidget.h"
 #include "LogPositionDialog.h"
+#include "TraceRecorder.h"
+#include "Profiler.h"
+#include "ProfilingPanel.h"
 
 #include <QApplication>
 #include <QHBoxLayout>
@@ -16,6 +19,12 @@
 #include <QPushButton>
 #include <QFrame>
 #include <QScreen>
+#include <QShortcut>
+#include <QStatusBar>
+#include <QStandardPaths>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
 
 MainWindow::MainWindow(QWidget* parent)
     : QMainWindow(parent)
@@ -27,12 +36,25 @@ MainWindow::MainWindow(QWidget* parent)
     const QRect screen = QApplication::primaryScreen()->availableGeometry();
     setGeometry(screen);
 
+    m_orchestrator = new SystemOrchestrator(this);
+    connect(m_orchestrator, &SystemOrchestrator::progress,
+        this, &MainWindow::onOrchestratorProgress);
+    connect(m_orchestrator, &SystemOrchestrator::systemFinished,
+        this, &MainWindow::onSystemOperationFinished);
+    connect(m_orchestrator, &SystemOrchestrator::batchFinished,
+        this, &MainWindow::onBatchFinished);
+
     buildLayout();
 
     m_uiTimer = new QTimer(this);
     m_uiTimer->setInterval(50); // 20 Hz
     connect(m_uiTimer, &QTimer::timeout, this, &MainWindow::onUiRefreshTick);
     m_uiTimer->start();
+
+    // Traçage du pipeline : F9 démarre, F9 arrête et enregistre la trace Chrome JSON
+    MOBOT_TRACE_THREAD_NAME("UI");
+    QShortcut* traceShortcut = new QShortcut(QKeySequence(Qt::Key_F9), this);
+    connect(traceShortcut, &QShortcut::activated, this, &MainWindow::onToggleTrace);
 }
 
 // =============================================================================
@@ -96,6 +118,18 @@ void MainWindow::buildLeftPanel()
     connect(m_controlPanel, &AcquisitionControlPanel::stopRequested,
         this, &MainWindow::onStopAcquisition);
 
+    m_connectAllBtn = new QPushButton(QStringLiteral("🔌 Tout connecter"));
+    m_connectAllBtn->setFixedHeight(36);
+    m_connectAllBtn->setEnabled(false); // activé dès qu'un système est déconnecté
+    connect(m_connectAllBtn, &QPushButton::clicked,
+        this, &MainWindow::onConnectAll);
+    layout->addWidget(m_connectAllBtn);
+
+#ifdef MOBOT_PROFILE
+    // Compteurs des chemins chauds (build de profilage uniquement)
+    layout->addWidget(new ProfilingPanel());
+#endif
+
     m_logPosBtn = new QPushButton(QStringLiteral("📍 Log position actuelle"));
     m_logPosBtn->setFixedHeight(36);
     m_logPosBtn->setEnabled(false); // activé seulement en acquisition
@@ -161,6 +195,9 @@ void MainWindow::addSystemCard(SystemCardWidget* card)
     m_cards.append(card);
     m_systems.append(card->system());
 
+    // L'UI ne rafraîchit qu'à 20 Hz : inutile de recevoir plus de notifications
+    card->system()->setNotificationRate(1000.0 / m_uiTimer->interval());
+
     // Insérer avant le bouton "+" (dernier item)
     m_cardsLayout->insertWidget(m_cardsLayout->count() - 1, card);
 
@@ -168,6 +205,8 @@ void MainWindow::addSystemCard(SystemCardWidget* card)
         this, [this, card]() { onSystemConnected(card); });
     connect(card, &SystemCardWidget::disconnected,
         this, [this, card]() { onSystemDisconnected(card); });
+    connect(card, &SystemCardWidget::connectRequested,
+        this, [this, card]() { connectCards({ card }); });
     connect(card, &SystemCardWidget::removeRequested,
         this, [this, card]() {
             m_cards.removeOne(card);
@@ -192,17 +231,123 @@ void MainWindow::onSystemDisconnected(SystemCardWidget* /*card*/)
     updateStartButtonState();
 }
 
+void MainWindow::onConnectAll()
+{
+    connectCards(m_cards);
+}
+
+void MainWindow::connectCards(const QVector<SystemCardWidget*>& cards)
+{
+    // ConnectionConfig par défaut : chaque système tient sa configuration propre
+    QVector<SystemOrchestrator::Target> targets;
+    for (auto* card : cards) {
+        if (card->isConnected() || m_orchestrator->isBusy(card->system()))
+            continue;
+        SystemOrchestrator::Target target;
+        target.system = card->system();
+        targets.append(target);
+        card->setConnecting(true);
+    }
+
+    if (m_orchestrator->connectSystems(targets) != 0)
+        updateStartButtonState();
+}
+
+SystemCardWidget* MainWindow::cardFor(IMeasurementSystem* system) const
+{
+    for (auto* card : m_cards) {
+        if (card->system() == system)
+            return card;
+    }
+    return nullptr;
+}
+
 void MainWindow::onStartAcquisition()
 {
+    if (m_startBatch != 0)
+        return;
+
+    // Les systèmes qui déciment à la source s'alignent sur la fréquence du synchroniseur
+    const double targetHz = m_configPanel->targetFrequency();
     for (auto* sys : m_systems)
-        sys->startAcquisition();
+        sys->setTargetFrequency(targetHz);
 
+    // Démarrages en parallèle : l'acquisition n'est déclarée qu'une fois tous démarrés.
+    // Cartes verrouillées dès maintenant (pas de suppression pendant le démarrage)
+    m_startBatch = m_orchestrator->startSystems(m_systems);
+    if (m_startBatch == 0)
+        return;
+    for (auto* card : m_cards)
+        card->setAcquiring(true);
+    updateStartButtonState();
+}
+
+void MainWindow::onOrchestratorProgress(int /*batch*/, SystemOrchestrator::Operation operation,
+    int done, int total)
+{
+    statusBar()->showMessage(QStringLiteral("%1 : %2 / %3 système(s)")
+        .arg(operation == SystemOrchestrator::Operation::Connect
+            ? QStringLiteral("Connexion") : QStringLiteral("Démarrage"))
+        .arg(done).arg(total));
+}
+
+void MainWindow::onSystemOperationFinished(int /*batch*/, IMeasurementSystem* system,
+    SystemOrchestrator::Operation operation, SystemOrchestrator::Outcome outcome, qint64 elapsedMs)
+{
+    SystemCardWidget* card = cardFor(system);
+    const bool connecting = operation == SystemOrchestrator::Operation::Connect;
+    if (card && connecting) {
+        card->setConnecting(false);
+        if (outcome == SystemOrchestrator::Outcome::Failed)
+            card->showConnectionError(QStringLiteral("Échec de connexion"));
+        else if (outcome == SystemOrchestrator::Outcome::TimedOut)
+            card->showConnectionError(QStringLiteral("Délai dépassé"));
+    }
+
+    if (outcome != SystemOrchestrator::Outcome::Succeeded) {
+        statusBar()->showMessage(QStringLiteral("%1 : %2 %3 (%4 ms)")
+            .arg(card ? card->systemName() : system->getSystemName())
+            .arg(connecting ? QStringLiteral("connexion") : QStringLiteral("démarrage"))
+            .arg(outcome == SystemOrchestrator::Outcome::TimedOut
+                ? QStringLiteral("hors délai") : QStringLiteral("en échec"))
+            .arg(elapsedMs), 10000);
+    }
+}
+
+void MainWindow::onBatchFinished(int batch, SystemOrchestrator::Operation operation,
+    int succeeded, int total)
+{
+    if (operation == SystemOrchestrator::Operation::Connect) {
+        statusBar()->showMessage(QStringLiteral("%1 / %2 système(s) connecté(s)")
+            .arg(succeeded).arg(total), 5000);
+        updateStartButtonState();
+        return;
+    }
+
+    if (batch != m_startBatch)
+        return;
+    m_startBatch = 0;
+
+    if (succeeded < total) {
+        // Acquisition partielle inutilisable : arrêter ceux qui ont démarré. Un démarrage
+        // hors délai tourne encore dans l'orchestrateur, qui l'arrêtera s'il aboutit
+        for (auto* sys : m_systems) {
+            if (sys->isAcquiring() && !m_orchestrator->isBusy(sys))
+                sys->stopAcquisition();
+        }
+        for (auto* card : m_cards)
+            card->setAcquiring(false);
+        statusBar()->showMessage(QStringLiteral("Démarrage annulé : %1 / %2 système(s) démarré(s)")
+            .arg(succeeded).arg(total), 10000);
+        updateStartButtonState();
+        return;
+    }
+
+    statusBar()->showMessage(QStringLiteral("Acquisition démarrée (%1 système(s))").arg(total), 5000);
     m_isAcquiring = true;
     m_controlPanel->setAcquiring(true);
     m_logPosBtn->setEnabled(true);
-
-    for (auto* card : m_cards)
-        card->setAcquiring(true);
+    updateStartButtonState();
 }
 
 void MainWindow::onStopAcquisition()
@@ -216,25 +361,60 @@ void MainWindow::onStopAcquisition()
 
     for (auto* card : m_cards)
         card->setAcquiring(false);
+    updateStartButtonState();
 }
 
 void MainWindow::onUiRefreshTick()
 {
+    MOBOT_TRACE_SCOPE("ui.refresh");
+    MOBOT_PROFILE_SCOPE("UI / refresh");
+
     for (auto* card : m_cards)
         card->refreshDisplay();
 
     if (m_isAcquiring) {
+        MOBOT_TRACE_SCOPE("ui.table");
+        MOBOT_PROFILE_SCOPE("UI / table");
         m_realTimeTable->refresh();
         m_controlPanel->updateStats(m_systems);
     }
 }
 
+void MainWindow::onToggleTrace()
+{
+    if (!TraceRecorder::isEnabled()) {
+        TraceRecorder::clear();
+        TraceRecorder::setEnabled(true);
+        statusBar()->showMessage(QStringLiteral("Traçage actif — F9 pour arrêter et enregistrer"));
+        return;
+    }
+
+    TraceRecorder::setEnabled(false);
+
+    const QString dir = QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation);
+    const QString path = QDir(dir).filePath(QStringLiteral("mobot_trace_%1.json")
+        .arg(QDateTime::currentDateTime().toString(QStringLiteral("yyyyMMdd_HHmmss"))));
+
+    std::string error;
+    if (TraceRecorder::writeChromeTrace(QFile::encodeName(path).toStdString(), error)) {
+        statusBar()->showMessage(QStringLiteral("Trace enregistrée (%1 événements) : %2")
+            .arg(TraceRecorder::eventCount()).arg(QDir::toNativeSeparators(path)), 10000);
+    }
+    else {
+        statusBar()->showMessage(QString::fromStdString(error), 10000);
+    }
+}
+
 void MainWindow::updateStartButtonState()
 {
     const bool allConnected = !m_systems.isEmpty() &&
         std::all_of(m_systems.begin(), m_systems.end(),
             [](IMeasurementSystem* s) { return s->isConnected(); });
-    m_controlPanel->setStartEnabled(allConnected);
+    m_controlPanel->setStartEnabled(allConnected && m_startBatch == 0);
+
+    const bool anyToConnect = std::any_of(m_systems.begin(), m_systems.end(),
+        [this](IMeasurementSystem* s) { return !s->isConnected() && !m_orchestrator->isBusy(s); });
+    m_connectAllBtn->setEnabled(anyToConnect && !m_isAcquiring);
 }
 
 void MainWindow::onLogPosition()
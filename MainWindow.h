@@ -10,6 +10,7 @@
 
 #include "IMeasurementSystem.h"
 #include "SystemCardWidget.h"
+#include "SystemOrchestrator.h"
 
 class AcquisitionConfigPanel;
 class AcquisitionControlPanel;
@@ -26,10 +27,16 @@ private slots:
     void onAddSystemClicked();
     void onSystemConnected(SystemCardWidget* card);
     void onSystemDisconnected(SystemCardWidget* card);
+    void onConnectAll();
     void onStartAcquisition();
     void onStopAcquisition();
+    void onOrchestratorProgress(int batch, SystemOrchestrator::Operation operation, int done, int total);
+    void onSystemOperationFinished(int batch, IMeasurementSystem* system,
+        SystemOrchestrator::Operation operation, SystemOrchestrator::Outcome outcome, qint64 elapsedMs);
+    void onBatchFinished(int batch, SystemOrchestrator::Operation operation, int succeeded, int total);
     void onUiRefreshTick();
     void onLogPosition();
+    void onToggleTrace();
 
 private:
     void buildLayout();
@@ -37,7 +44,8 @@ private:
     void buildCentralArea();
     void updateStartButtonState();
     void addSystemCard(SystemCardWidget* card);
-    
+    void connectCards(const QVector<SystemCardWidget*>& cards);
+    SystemCardWidget* cardFor(IMeasurementSystem* system) const;
 
     // ── Layout ───────────────────────────────────────────────────────────────
     QWidget* m_leftPanel = nullptr;
@@ -53,12 +61,17 @@ private:
     QVector<SystemCardWidget*>          m_cards;
     QVector<IMeasurementSystem*>        m_systems;
 
+    // Connexions et démarrages parallèles (hors thread UI)
+    SystemOrchestrator* m_orchestrator = nullptr;
+    int                 m_startBatch = 0;   // Lot de démarrage en cours (0 = aucun)
+
     // ── Timer UI (20 Hz) ─────────────────────────────────────────────────────
     QTimer* m_uiTimer = nullptr;
 
     bool m_isAcquiring = false;
 
     QPushButton* m_logPosBtn = nullptr;
+    QPushButton* m_connectAllBtn = nullptr;
 };
 
 #endif // MAINWINDOW_H
@@ -0,0 +1,422 @@
+#include "MicroBench.h"
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+std::atomic<uint64_t> MicroBench::s_allocCount{ 0 };
+std::atomic<uint64_t> MicroBench::s_allocBytes{ 0 };
+const void* volatile  MicroBench::s_sink = nullptr;
+
+// =============================================================================
+// Comptage des allocations
+// =============================================================================
+
+#if defined(_MSC_VER) && defined(_DEBUG)
+
+// Debug MSVC : le crochet du tas CRT voit aussi les malloc de Qt6Cored (QString...)
+#include <crtdbg.h>
+
+namespace {
+
+int allocationHook(int allocType, void*, std::size_t size, int blockType,
+    long, const unsigned char*, int)
+{
+    if ((allocType == _HOOK_ALLOC || allocType == _HOOK_REALLOC) && blockType != _CRT_BLOCK)
+        MicroBench::countAllocation(size);
+    return TRUE;
+}
+
+struct AllocationHookInstaller {
+    AllocationHookInstaller() { _CrtSetAllocHook(allocationHook); }
+} g_allocationHookInstaller;
+
+} // namespace
+
+const char* MicroBench::allocationSource()
+{
+    return "crt heap";
+}
+
+#else
+
+// Release (et autres compilateurs) : opérateur new global de l'exécutable.
+// Les variantes alignées gardent l'implémentation standard (non comptées).
+void* operator new(std::size_t size)
+{
+    MicroBench::countAllocation(size);
+    if (void* p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    return ::operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    MicroBench::countAllocation(size);
+    return std::malloc(size ? size : 1);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept
+{
+    return ::operator new(size, tag);
+}
+
+void operator delete(void* p) noexcept                               { std::free(p); }
+void operator delete[](void* p) noexcept                             { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept                  { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept                { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept        { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept      { std::free(p); }
+
+const char* MicroBench::allocationSource()
+{
+    return "operator new";
+}
+
+#endif
+
+MicroBench::AllocationCounters MicroBench::allocations()
+{
+    AllocationCounters counters;
+    counters.count = s_allocCount.load(std::memory_order_relaxed);
+    counters.bytes = s_allocBytes.load(std::memory_order_relaxed);
+    return counters;
+}
+
+// =============================================================================
+// Exécution
+// =============================================================================
+
+void MicroBench::add(const std::string& name, Body body)
+{
+    m_cases.push_back({ name, std::move(body) });
+}
+
+std::vector<std::string> MicroBench::names() const
+{
+    std::vector<std::string> list;
+    for (const Case& c : m_cases)
+        list.push_back(c.name);
+    return list;
+}
+
+double MicroBench::measureNs(const Body& body, uint64_t iterations)
+{
+    const auto start = std::chrono::steady_clock::now();
+    body(iterations);
+    const auto stop = std::chrono::steady_clock::now();
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count());
+}
+
+std::vector<MicroBench::Result> MicroBench::run(const Settings& settings) const
+{
+    std::vector<Result> results;
+    const double minTimeNs   = std::max(1.0, settings.minTimeMs) * 1e6;
+    const int    repetitions = std::max(1, settings.repetitions);
+
+    for (const Case& c : m_cases) {
+        if (!settings.filter.empty() && c.name.find(settings.filter) == std::string::npos)
+            continue;
+
+        // Échauffement (caches, premières allocations), puis calibration par puissances de 10
+        c.body(1);
+        uint64_t iterations = 1;
+        double   elapsed    = measureNs(c.body, iterations);
+        while (elapsed < minTimeNs / 10.0 && iterations < (1ull << 40)) {
+            iterations *= 10;
+            elapsed = measureNs(c.body, iterations);
+        }
+        if (elapsed > 0.0 && elapsed < minTimeNs) {
+            const double scaled = static_cast<double>(iterations) * minTimeNs / elapsed;
+            iterations = static_cast<uint64_t>(std::min(scaled, static_cast<double>(1ull << 42)));
+        }
+
+        // nsPerOp réservé avant la fenêtre de comptage : seules les allocations du cas restent
+        std::vector<double> nsPerOp;
+        nsPerOp.reserve(static_cast<std::size_t>(repetitions));
+        const AllocationCounters before = allocations();
+        for (int r = 0; r < repetitions; ++r)
+            nsPerOp.push_back(measureNs(c.body, iterations) / static_cast<double>(iterations));
+        const AllocationCounters after = allocations();
+
+        std::sort(nsPerOp.begin(), nsPerOp.end());
+        const double totalOps = static_cast<double>(iterations) * repetitions;
+
+        Result result;
+        result.name        = c.name;
+        result.nsPerOp     = nsPerOp[nsPerOp.size() / 2];
+        result.bytesPerOp  = static_cast<double>(after.bytes - before.bytes) / totalOps;
+        result.allocsPerOp = static_cast<double>(after.count - before.count) / totalOps;
+        result.iterations  = iterations;
+        results.push_back(result);
+
+        std::printf("%-44s %12.1f ns/op %10.1f B/op %8.2f allocs/op  (%llu it)\n",
+            result.name.c_str(), result.nsPerOp, result.bytesPerOp, result.allocsPerOp,
+            static_cast<unsigned long long>(result.iterations));
+        std::fflush(stdout);
+    }
+    return results;
+}
+
+// =============================================================================
+// Référence JSON
+// =============================================================================
+
+namespace {
+
+std::string jsonEscape(const std::string& text)
+{
+    std::string out;
+    out.reserve(text.size());
+    for (char ch : text) {
+        if (ch == '"' || ch == '\\')
+            out += '\\';
+        out += ch;
+    }
+    return out;
+}
+
+/**
+ * @brief Lecteur JSON minimal pour le format de saveBaseline
+ *
+ * Les clés inconnues sont ignorées (valeurs quelconques), ce qui permet d'annoter
+ * une référence à la main sans casser la comparaison.
+ */
+class JsonReader {
+public:
+    JsonReader(const char* begin, const char* end) : m_p(begin), m_end(end) {}
+
+    bool consume(char expected)
+    {
+        skipSpace();
+        if (m_p < m_end && *m_p == expected) {
+            ++m_p;
+            return true;
+        }
+        return false;
+    }
+
+    bool peek(char expected)
+    {
+        skipSpace();
+        return m_p < m_end && *m_p == expected;
+    }
+
+    bool string(std::string& out)
+    {
+        if (!consume('"'))
+            return false;
+        out.clear();
+        while (m_p < m_end && *m_p != '"') {
+            if (*m_p == '\\' && m_p + 1 < m_end)
+                ++m_p;   // Échappements simples uniquement (\" et \\)
+            out += *m_p++;
+        }
+        return consume('"');
+    }
+
+    bool number(double& out)
+    {
+        skipSpace();
+        const auto res = std::from_chars(m_p, m_end, out);
+        if (res.ec != std::errc{})
+            return false;
+        m_p = res.ptr;
+        return true;
+    }
+
+    bool skipValue()
+    {
+        skipSpace();
+        if (m_p >= m_end)
+            return false;
+        if (*m_p == '"') {
+            std::string ignored;
+            return string(ignored);
+        }
+        if (*m_p == '{' || *m_p == '[') {
+            const char close = *m_p == '{' ? '}' : ']';
+            const bool isObject = *m_p == '{';
+            ++m_p;
+            if (consume(close))
+                return true;
+            do {
+                if (isObject) {
+                    std::string key;
+                    if (!string(key) || !consume(':'))
+                        return false;
+                }
+                if (!skipValue())
+                    return false;
+            } while (consume(','));
+            return consume(close);
+        }
+        // Nombre ou littéral (true, false, null)
+        const char* start = m_p;
+        while (m_p < m_end && *m_p != ',' && *m_p != '}' && *m_p != ']'
+            && *m_p != ' ' && *m_p != '\n' && *m_p != '\r' && *m_p != '\t')
+            ++m_p;
+        return m_p > start;
+    }
+
+private:
+    void skipSpace()
+    {
+        while (m_p < m_end && (*m_p == ' ' || *m_p == '\n' || *m_p == '\r' || *m_p == '\t'))
+            ++m_p;
+    }
+
+    const char* m_p;
+    const char* m_end;
+};
+
+bool readResult(JsonReader& reader, MicroBench::Result& result)
+{
+    if (!reader.consume('{'))
+        return false;
+    if (reader.consume('}'))
+        return true;
+    do {
+        std::string key;
+        if (!reader.string(key) || !reader.consume(':'))
+            return false;
+
+        double value = 0.0;
+        bool ok = true;
+        if (key == "name")               ok = reader.string(result.name);
+        else if (key == "ns_per_op")     ok = reader.number(result.nsPerOp);
+        else if (key == "bytes_per_op")  ok = reader.number(result.bytesPerOp);
+        else if (key == "allocs_per_op") ok = reader.number(result.allocsPerOp);
+        else if (key == "iterations") {
+            ok = reader.number(value);
+            result.iterations = static_cast<uint64_t>(value);
+        }
+        else ok = reader.skipValue();
+        if (!ok)
+            return false;
+    } while (reader.consume(','));
+    return reader.consume('}');
+}
+
+} // namespace
+
+bool MicroBench::saveBaseline(const std::string& path, const std::vector<Result>& results,
+    std::string& error)
+{
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        error = "Cannot create baseline file " + path;
+        return false;
+    }
+
+    std::fprintf(file, "{\n  \"tool\": \"Mobot4Bench\",\n  \"allocation_source\": \"%s\",\n  \"results\": [\n",
+        allocationSource());
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        std::fprintf(file,
+            "    { \"name\": \"%s\", \"ns_per_op\": %.3f, \"bytes_per_op\": %.3f, "
+            "\"allocs_per_op\": %.4f, \"iterations\": %llu }%s\n",
+            jsonEscape(r.name).c_str(), r.nsPerOp, r.bytesPerOp, r.allocsPerOp,
+            static_cast<unsigned long long>(r.iterations), i + 1 < results.size() ? "," : "");
+    }
+    std::fprintf(file, "  ]\n}\n");
+
+    const bool ok = std::ferror(file) == 0;
+    std::fclose(file);
+    if (!ok)
+        error = "Write error on " + path;
+    return ok;
+}
+
+bool MicroBench::loadBaseline(const std::string& path, std::vector<Result>& results,
+    std::string& allocationSource, std::string& error)
+{
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) {
+        error = "Cannot open baseline file " + path;
+        return false;
+    }
+    std::string text;
+    char chunk[4096];
+    std::size_t n = 0;
+    while ((n = std::fread(chunk, 1, sizeof(chunk), file)) > 0)
+        text.append(chunk, n);
+    std::fclose(file);
+
+    results.clear();
+    allocationSource.clear();
+    JsonReader reader(text.data(), text.data() + text.size());
+    bool ok = reader.consume('{');
+    if (ok && !reader.peek('}')) {
+        do {
+            std::string key;
+            ok = reader.string(key) && reader.consume(':');
+            if (!ok)
+                break;
+            if (key == "allocation_source") {
+                ok = reader.string(allocationSource);
+            }
+            else if (key == "results") {
+                ok = reader.consume('[');
+                if (ok && !reader.consume(']')) {
+                    do {
+                        Result result;
+                        ok = readResult(reader, result);
+                        if (ok)
+                            results.push_back(result);
+                    } while (ok && reader.consume(','));
+                    ok = ok && reader.consume(']');
+                }
+            }
+            else {
+                ok = reader.skipValue();
+            }
+        } while (ok && reader.consume(','));
+    }
+    ok = ok && reader.consume('}');
+
+    if (!ok)
+        error = "Malformed baseline file " + path;
+    return ok;
+}
+
+std::vector<MicroBench::Comparison> MicroBench::compare(const std::vector<Result>& baseline,
+    const std::string& baselineAllocationSource,
+    const std::vector<Result>& current, double tolerancePercent)
+{
+    static constexpr double kAllocEpsilon = 0.01;
+    const bool sameAllocationSource = baselineAllocationSource == allocationSource();
+
+    std::vector<Comparison> comparisons;
+    for (const Result& cur : current) {
+        Comparison c;
+        c.name      = cur.name;
+        c.currentNs = cur.nsPerOp;
+        c.currentAllocs = cur.allocsPerOp;
+
+        const auto it = std::find_if(baseline.begin(), baseline.end(),
+            [&](const Result& b) { return b.name == cur.name; });
+        if (it == baseline.end()) {
+            c.missing = true;
+            comparisons.push_back(c);
+            continue;
+        }
+
+        c.baselineNs     = it->nsPerOp;
+        c.baselineAllocs = it->allocsPerOp;
+        c.deltaPercent   = it->nsPerOp > 0.0 ? 100.0 * (cur.nsPerOp - it->nsPerOp) / it->nsPerOp : 0.0;
+        c.allocsCompared = sameAllocationSource;
+        c.regression     = c.deltaPercent > tolerancePercent
+            || (sameAllocationSource && cur.allocsPerOp > it->allocsPerOp + kAllocEpsilon);
+        comparisons.push_back(c);
+    }
+    return comparisons;
+}
@@ -0,0 +1,125 @@
+#pragma once
+#ifndef MICROBENCH_H
+#define MICROBENCH_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Harnais de micro-benchmarks des chemins chauds (exécutable Mobot4Bench)
+ *
+ * Chaque cas reçoit un nombre d'itérations et exécute l'opération mesurée autant de
+ * fois. Le harnais calibre ce nombre pour atteindre Settings::minTimeMs par mesure,
+ * répète la mesure et retient la médiane (ns/op), ainsi que les allocations
+ * observées pendant les mesures (octets/op, allocations/op).
+ *
+ * Allocations : comptées par remplacement de l'opérateur new global de l'exécutable
+ * (std::string, std::vector, flux, nœuds QMap...). Les tampons Qt (QString,
+ * QByteArray, QList) sont alloués par malloc dans Qt6Core : ils ne sont vus qu'en
+ * Debug MSVC, où un crochet CRT (_CrtSetAllocHook) couvre tout le tas du processus.
+ * allocationSource() indique la méthode active ; elle est enregistrée dans la
+ * référence et les allocations ne sont comparées qu'à méthode égale.
+ *
+ * Sans Qt : le harnais ne dépend que de la bibliothèque standard.
+ */
+class MicroBench {
+public:
+    struct Settings {
+        double      minTimeMs   = 200.0;   // Durée minimale d'une mesure
+        int         repetitions = 5;       // Mesures par cas (médiane retenue)
+        std::string filter;                // Sous-chaîne du nom ; vide = tous les cas
+    };
+
+    struct Result {
+        std::string name;
+        double      nsPerOp     = 0.0;
+        double      bytesPerOp  = 0.0;
+        double      allocsPerOp = 0.0;
+        uint64_t    iterations  = 0;      // Par mesure, après calibration
+    };
+
+    /** @brief Écart d'un cas par rapport à la référence */
+    struct Comparison {
+        std::string name;
+        double      baselineNs   = 0.0;
+        double      currentNs    = 0.0;
+        double      deltaPercent = 0.0;
+        bool        allocsCompared = false;
+        double      baselineAllocs = 0.0;
+        double      currentAllocs  = 0.0;
+        bool        regression   = false;
+        bool        missing      = false;   // Absent de la référence
+    };
+
+    using Body = std::function<void(uint64_t iterations)>;
+
+    /** @brief Enregistre un cas (nom "Groupe/cas", ordre d'exécution = ordre d'ajout) */
+    void add(const std::string& name, Body body);
+
+    std::vector<std::string> names() const;
+
+    /** @brief Exécute les cas retenus par le filtre, un résultat affiché par ligne */
+    std::vector<Result> run(const Settings& settings) const;
+
+    // ========== Référence JSON ==========
+
+    static bool saveBaseline(const std::string& path, const std::vector<Result>& results,
+        std::string& error);
+    static bool loadBaseline(const std::string& path, std::vector<Result>& results,
+        std::string& allocationSource, std::string& error);
+
+    /**
+     * @brief Compare aux résultats de référence
+     * @param tolerancePercent Ralentissement admis en ns/op avant de signaler une régression
+     *
+     * Toute allocation supplémentaire par opération (au-delà de 0.01, bruit de
+     * calibration) est une régression, si la méthode de comptage est la même.
+     */
+    static std::vector<Comparison> compare(const std::vector<Result>& baseline,
+        const std::string& baselineAllocationSource,
+        const std::vector<Result>& current, double tolerancePercent);
+
+    // ========== Allocations ==========
+
+    struct AllocationCounters {
+        uint64_t count = 0;
+        uint64_t bytes = 0;
+    };
+
+    static AllocationCounters allocations();
+    static const char* allocationSource();
+
+    /** @brief Appelé par les crochets d'allocation (MicroBench.cpp) */
+    static void countAllocation(std::size_t bytes)
+    {
+        s_allocCount.fetch_add(1, std::memory_order_relaxed);
+        s_allocBytes.fetch_add(bytes, std::memory_order_relaxed);
+    }
+
+    /** @brief Empêche le compilateur d'éliminer un résultat non utilisé */
+    template <class T>
+    static void keep(const T& value)
+    {
+        s_sink = &value;
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+    }
+
+private:
+    struct Case {
+        std::string name;
+        Body        body;
+    };
+
+    static double measureNs(const Body& body, uint64_t iterations);
+
+    std::vector<Case> m_cases;
+
+    static std::atomic<uint64_t> s_allocCount;
+    static std::atomic<uint64_t> s_allocBytes;
+    static const void* volatile  s_sink;
+};
+
+#endif // MICROBENCH_H
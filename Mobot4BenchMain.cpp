@@ -0,0 +1,390 @@
+// ============================================================================
+// Mobot4BenchMain.cpp - Micro-benchmarks des chemins chauds des frames
+// ============================================================================
+// Exemples :
+//   Mobot4Bench                                  (tous les cas)
+//   Mobot4Bench --filter TrameHelper --min-time-ms 500
+//   Mobot4Bench --save bench_baseline.json       (référence avant modification)
+//   Mobot4Bench --compare bench_baseline.json --tolerance 15
+//
+// Entrées réalistes : trames <Rob> de RsiEmulator::buildRobFrame (trajectoire
+// déterministe, mêmes balises que le contrôleur), ACK RsiTrame comme
+// KukaRsiSystem::sendAck, frames robot avec leurs extras.
+//
+// Code de sortie : 0 ; 1 si --compare détecte une régression (ns/op au-delà de
+// la tolérance, ou allocation supplémentaire) ; 2 si erreur d'usage ou de fichier.
+// Mesures à faire en Release, machine au repos.
+// ============================================================================
+
+#include "MicroBench.h"
+
+#include "CircularBuffer.h"
+#include "CoordinateConverter.h"
+#include "MeasurementFrame.h"
+#include "RsiEmulator.h"
+#include "RsiTrame.h"
+#include "TrameHelper.h"
+#include "XmlNode.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t kDatagramCount = 256;   // Puissance de 2 (index masqué)
+constexpr int         kCycleUs       = 4000;
+
+void printUsage()
+{
+    std::printf(
+        "Usage: Mobot4Bench [options]\n"
+        "  --filter TEXT        Run only benchmarks whose name contains TEXT\n"
+        "  --min-time-ms N      Minimum duration of one measurement (default 200)\n"
+        "  --repetitions N      Measurements per benchmark, median kept (default 5)\n"
+        "  --save FILE          Write results as a JSON baseline\n"
+        "  --compare FILE       Compare with a JSON baseline (exit 1 on regression)\n"
+        "  --tolerance PCT      Allowed ns/op slowdown for --compare (default 10)\n"
+        "  --list               List benchmark names and exit\n");
+}
+
+// ===== Données d'entrée =====
+
+struct RsiCorpus {
+    std::vector<std::string> datagrams;
+    std::vector<std::string> ipocs;
+    std::vector<const char*> ristBegin;    // Fenêtre d'attributs <RIst ...>
+    std::vector<const char*> ristEnd;
+};
+
+RsiCorpus buildCorpus()
+{
+    RsiCorpus corpus;
+    char buffer[2048];
+    for (std::size_t c = 0; c < kDatagramCount; ++c) {
+        const uint64_t ipoc = 1000000 + c * (kCycleUs / 1000);
+        const std::size_t len = RsiEmulator::buildRobFrame(c, ipoc, kCycleUs, 0.8, buffer, sizeof(buffer));
+        corpus.datagrams.emplace_back(buffer, len);
+        corpus.ipocs.push_back(std::to_string(ipoc));
+    }
+    // Fenêtres calculées après remplissage : les chaînes ne bougent plus
+    for (const std::string& d : corpus.datagrams) {
+        const char* wb = nullptr, * we = nullptr;
+        TrameHelper::findOpenTagWindow(d.data(), d.size(), "RIst ", wb, we);
+        corpus.ristBegin.push_back(wb);
+        corpus.ristEnd.push_back(we);
+    }
+    return corpus;
+}
+
+/** @brief Frame robot telle que publiée par KukaRsiSystem (pose + extras usuels) */
+MeasurementFrame buildRobotFrame(const RsiCorpus& corpus)
+{
+    static const char* kXYZABC[] = { "X", "Y", "Z", "A", "B", "C" };
+    double rist[6] = {};
+    TrameHelper::extractAttrDoubles(corpus.ristBegin[0], corpus.ristEnd[0], kXYZABC, rist, 6);
+
+    MeasurementFrame frame(1700000000000000LL, QStringLiteral("KUKA_RSI"), QStringLiteral("Robot"));
+    frame.x  = rist[0];
+    frame.y  = rist[1];
+    frame.z  = rist[2];
+    frame.rz = rist[3];
+    frame.ry = rist[4];
+    frame.rx = rist[5];
+    frame.frameNumber = 1;
+
+    frame.extras[QStringLiteral("RSol")]  = { rist[0], rist[1], rist[2], rist[3], rist[4], rist[5] };
+    frame.extras[QStringLiteral("AIPos")] = { 0.0, -90.0, 90.0, 0.0, 45.0, 0.0 };
+    frame.extras[QStringLiteral("ASPos")] = { 0.1, -89.9, 90.1, 0.0, 45.1, 0.0 };
+    frame.extras[QStringLiteral("MACur")] = { 0.2, 1.1, -0.4, 0.05, 0.3, 0.01 };
+    frame.extras[QStringLiteral("Delay")] = { 0.0 };
+    frame.extras[QStringLiteral("Digin")] = { 0.0 };
+    frame.extras[QStringLiteral("Krl")]   = { 0.0 };
+    frame.extras[QStringLiteral("Mode")]  = { 1.0 };
+    return frame;
+}
+
+/** @brief Nœuds XML additionnels typiques d'un ACK (technologie, correction axes) */
+XmlNode buildXmlNode()
+{
+    XmlNode tech("Tech");
+    for (int i = 1; i <= 6; ++i)
+        tech.setAttribute("T2" + std::to_string(i), std::to_string(0.125 * i));
+
+    XmlNode korr("AKorr");
+    for (int i = 1; i <= 6; ++i)
+        korr.setAttribute("A" + std::to_string(i), "0.000");
+    tech.addChild(korr);
+    tech.addChild(XmlNode("Comment", "step <3> & \"retry\""));
+    return tech;
+}
+
+// ===== Enregistrement des cas =====
+
+void registerTrameHelper(MicroBench& bench, const RsiCorpus& corpus)
+{
+    bench.add("TrameHelper/findLastTag_IPOC", [&corpus](uint64_t n) {
+        for (uint64_t i = 0; i < n; ++i) {
+            const std::string& d = corpus.datagrams[i & (kDatagramCount - 1)];
+            const char* vb = nullptr;
+            std::size_t vl = 0;
+            TrameHelper::findLastTag(d.data(), d.size(), "IPOC>", "</IPOC>", vb, vl);
+            MicroBench::keep(vl);
+        }
+    });
+
+    bench.add("TrameHelper/findOpenTagWindow_RIst", [&corpus](uint64_t n) {
+        for (uint64_t i = 0; i < n; ++i) {
+            const std::string& d = corpus.datagrams[i & (kDatagramCount - 1)];
+            const char* wb = nullptr, * we = nullptr;
+            TrameHelper::findOpenTagWindow(d.data(), d.size(), "RIst ", wb, we);
+            MicroBench::keep(we);
+        }
+    });
+
+    bench.add("TrameHelper/extractAttrDoubles_XYZABC", [&corpus](uint64_t n) {
+        static const char* kXYZABC[] = { "X", "Y", "Z", "A", "B", "C" };
+        double values[6];
+        for (uint64_t i = 0; i < n; ++i) {
+            const std::size_t k = i & (kDatagramCount - 1);
+            TrameHelper::extractAttrDoubles(corpus.ristBegin[k], corpus.ristEnd[k], kXYZABC, values, 6);
+            MicroBench::keep(values);
+        }
+    });
+}
+
+void registerRsiTrame(MicroBench& bench, const RsiCorpus& corpus)
+{
+    // Même préparation que KukaRsiSystem::sendAck, IPOC de la trame reçue
+    auto prepare = [&corpus](RsiTrame& trame, uint64_t i) {
+        float delta[6] = { 0.01f, -0.02f, 0.0f, 0.001f, 0.0f, -0.003f };
+        trame.setIPOC(corpus.ipocs[i & (kDatagramCount - 1)]);
+        trame.setPose(/*isCartesian=*/true, delta, /*isInRobotBase=*/true);
+        trame.setStopFlag(false);
+        trame.setKrl(0);
+        trame.setMode(0);
+    };
+
+    bench.add("RsiTrame/build_string", [prepare](uint64_t n) {
+        RsiTrame trame;
+        const Trame& base = trame;
+        for (uint64_t i = 0; i < n; ++i) {
+            prepare(trame, i);
+            const std::string xml = base.build();
+            MicroBench::keep(xml);
+        }
+    });
+
+    bench.add("RsiTrame/build_buffer", [prepare](uint64_t n) {
+        RsiTrame trame;
+        const Trame& base = trame;
+        char out[1024];
+        for (uint64_t i = 0; i < n; ++i) {
+            prepare(trame, i);
+            std::size_t len = 0;
+            base.build(out, sizeof(out), len);
+            MicroBench::keep(len);
+        }
+    });
+}
+
+void registerXmlNode(MicroBench& bench)
+{
+    bench.add("XmlNode/toBuffer_singleLine", [](uint64_t n) {
+        const XmlNode node = buildXmlNode();
+        char out[1024];
+        for (uint64_t i = 0; i < n; ++i) {
+            char* p = out;
+            node.toBuffer(p, out + sizeof(out), true);
+            MicroBench::keep(p);
+        }
+    });
+}
+
+void registerCircularBuffer(MicroBench& bench, const MeasurementFrame& robotFrame)
+{
+    bench.add("CircularBuffer/push_pop_uncontended", [&robotFrame](uint64_t n) {
+        CircularBuffer<MeasurementFrame, 100> buffer;
+        MeasurementFrame frame = robotFrame;
+        MeasurementFrame out;
+        for (uint64_t i = 0; i < n; ++i) {
+            frame.frameNumber = static_cast<int>(i);
+            buffer.push(frame);
+            buffer.pop(out);
+        }
+        MicroBench::keep(out);
+    });
+
+    // Producteur (thread du système) contre consommateur en attente active
+    // (synchroniseur) : une opération = un push, pendant que l'autre cœur dépile
+    bench.add("CircularBuffer/push_pop_contended", [&robotFrame](uint64_t n) {
+        CircularBuffer<MeasurementFrame, 100> buffer;
+        std::atomic<bool> done{ false };
+        std::thread consumer([&buffer, &done]() {
+            MeasurementFrame out;
+            while (!done.load(std::memory_order_acquire))
+                buffer.pop(out);
+            while (buffer.pop(out)) {}
+            MicroBench::keep(out);
+        });
+
+        MeasurementFrame frame = robotFrame;
+        for (uint64_t i = 0; i < n; ++i) {
+            frame.frameNumber = static_cast<int>(i);
+            buffer.push(frame);
+        }
+        done.store(true, std::memory_order_release);
+        consumer.join();
+    });
+}
+
+void registerFrames(MicroBench& bench, const MeasurementFrame& robotFrame)
+{
+    bench.add("CoordinateConverter/frameToCSVLine_KUKA", [&robotFrame](uint64_t n) {
+        const AcquisitionConfig config;
+        for (uint64_t i = 0; i < n; ++i) {
+            const QString line = CoordinateConverter::frameToCSVLine(robotFrame, AngleConventions::KUKA, config);
+            MicroBench::keep(line);
+        }
+    });
+
+    bench.add("MeasurementFrame/copy", [&robotFrame](uint64_t n) {
+        for (uint64_t i = 0; i < n; ++i) {
+            const MeasurementFrame copy = robotFrame;
+            MicroBench::keep(copy);
+        }
+    });
+
+    // Copie puis écriture dans les extras : détachement (copie profonde de la QMap)
+    bench.add("MeasurementFrame/copy_detach_extras", [&robotFrame](uint64_t n) {
+        const QString key = QStringLiteral("Delay");
+        for (uint64_t i = 0; i < n; ++i) {
+            MeasurementFrame copy = robotFrame;
+            copy.extras[key] = { static_cast<double>(i) };
+            MicroBench::keep(copy);
+        }
+    });
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    MicroBench::Settings settings;
+    std::string savePath;
+    std::string comparePath;
+    double tolerancePercent = 10.0;
+    bool listOnly = false;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+
+        if (std::strcmp(arg, "--help") == 0 || std::strcmp(arg, "-h") == 0) {
+            printUsage();
+            return 0;
+        }
+        if (std::strcmp(arg, "--list") == 0) {
+            listOnly = true;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            std::fprintf(stderr, "Missing value for %s\n", arg);
+            return 2;
+        }
+        const std::string value = argv[++i];
+
+        if (std::strcmp(arg, "--filter") == 0)           settings.filter = value;
+        else if (std::strcmp(arg, "--min-time-ms") == 0) settings.minTimeMs = std::atof(value.c_str());
+        else if (std::strcmp(arg, "--repetitions") == 0) settings.repetitions = std::atoi(value.c_str());
+        else if (std::strcmp(arg, "--save") == 0)        savePath = value;
+        else if (std::strcmp(arg, "--compare") == 0)     comparePath = value;
+        else if (std::strcmp(arg, "--tolerance") == 0)   tolerancePercent = std::atof(value.c_str());
+        else {
+            std::fprintf(stderr, "Unknown option %s\n", arg);
+            printUsage();
+            return 2;
+        }
+    }
+
+    if (settings.minTimeMs <= 0.0 || settings.repetitions <= 0 || tolerancePercent < 0.0) {
+        std::fprintf(stderr, "Invalid settings (min time, repetitions or tolerance)\n");
+        return 2;
+    }
+
+    // Référence chargée avant les mesures : une erreur de chemin ne coûte pas un passage
+    std::vector<MicroBench::Result> baseline;
+    std::string baselineAllocationSource;
+    std::string error;
+    if (!comparePath.empty()
+        && !MicroBench::loadBaseline(comparePath, baseline, baselineAllocationSource, error)) {
+        std::fprintf(stderr, "%s\n", error.c_str());
+        return 2;
+    }
+
+    const RsiCorpus corpus = buildCorpus();
+    const MeasurementFrame robotFrame = buildRobotFrame(corpus);
+
+    MicroBench bench;
+    registerTrameHelper(bench, corpus);
+    registerRsiTrame(bench, corpus);
+    registerXmlNode(bench);
+    registerCircularBuffer(bench, robotFrame);
+    registerFrames(bench, robotFrame);
+
+    if (listOnly) {
+        for (const std::string& name : bench.names())
+            std::printf("%s\n", name.c_str());
+        return 0;
+    }
+
+    std::size_t corpusBytes = 0;
+    for (const std::string& d : corpus.datagrams)
+        corpusBytes += d.size();
+    std::printf("Mobot4Bench: %zu RSI datagrams (%zu bytes on average), allocations via %s\n\n",
+        corpus.datagrams.size(), corpusBytes / corpus.datagrams.size(), MicroBench::allocationSource());
+
+    const std::vector<MicroBench::Result> results = bench.run(settings);
+    if (results.empty()) {
+        std::fprintf(stderr, "No benchmark matches filter '%s'\n", settings.filter.c_str());
+        return 2;
+    }
+
+    if (!savePath.empty()) {
+        if (!MicroBench::saveBaseline(savePath, results, error)) {
+            std::fprintf(stderr, "%s\n", error.c_str());
+            return 2;
+        }
+        std::printf("\nBaseline written to %s\n", savePath.c_str());
+    }
+
+    if (comparePath.empty())
+        return 0;
+
+    if (baselineAllocationSource != MicroBench::allocationSource()) {
+        std::printf("\nBaseline allocations counted via '%s', now '%s': allocations not compared\n",
+            baselineAllocationSource.c_str(), MicroBench::allocationSource());
+    }
+
+    std::printf("\nComparison with %s (tolerance %.1f %%)\n", comparePath.c_str(), tolerancePercent);
+    bool regression = false;
+    for (const MicroBench::Comparison& c : MicroBench::compare(baseline, baselineAllocationSource,
+             results, tolerancePercent)) {
+        if (c.missing) {
+            std::printf("  %-44s %12.1f ns/op  (new, not in baseline)\n", c.name.c_str(), c.currentNs);
+            continue;
+        }
+        std::printf("  %-44s %12.1f -> %10.1f ns/op  %+7.1f %%", c.name.c_str(),
+            c.baselineNs, c.currentNs, c.deltaPercent);
+        if (c.allocsCompared && c.currentAllocs != c.baselineAllocs)
+            std::printf("  allocs %.2f -> %.2f", c.baselineAllocs, c.currentAllocs);
+        std::printf("%s\n", c.regression ? "  REGRESSION" : "");
+        regression = regression || c.regression;
+    }
+
+    std::printf("%s\n", regression ? "FAIL" : "PASS");
+    return regression ? 1 : 0;
+}
@@ -0,0 +1,157 @@
+// ============================================================================
+// Mobot4CliMain.cpp - Acquisition sans interface (nœuds de production, nuits)
+// ============================================================================
+// Exemples :
+//   Mobot4Cli --config night.json
+//   Mobot4Cli --config bench.json --duration 600 --output D:/captures --format csv
+//
+// Arrêt : fin de --duration (ou "durationSeconds"), Ctrl+C ou SIGTERM. Les fichiers
+// de session sont terminés et les résumés d'acquisition affichés dans tous les cas.
+//
+// Section "trigger" du fichier : seules les fenêtres autour des événements robot
+// (Bloc_Start, Bloc_End, fronts Digin) sont écrites, voir TriggerRecorder.
+//
+// Code de sortie : 0 si l'acquisition s'est déroulée normalement ; 1 si un système
+// n'a pu être connecté ou démarré, ou en cas d'erreur d'écriture ; 2 si erreur
+// d'usage ou de configuration.
+// ============================================================================
+
+#include "HeadlessRunner.h"
+#include "TraceRecorder.h"
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QTimer>
+
+#include <atomic>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+std::atomic<bool> g_stop{ false };
+
+void onSignal(int)
+{
+    g_stop.store(true);
+}
+
+void printUsage()
+{
+    std::printf(
+        "Usage: Mobot4Cli --config FILE [options]\n"
+        "  --config FILE        JSON acquisition configuration (see HeadlessRunner.h)\n"
+        "  --duration S         Recording time in seconds, 0 = until Ctrl+C\n"
+        "  --output DIR         Session file directory\n"
+        "  --format F           Session format: binary or csv\n"
+        "  --target-hz HZ       Synchronizer target frequency (0 = native)\n"
+        "  --status S           Status line interval in seconds (0 = none)\n");
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QString configPath;
+    double  durationS = -1.0;
+    double  targetHz  = -1.0;
+    double  statusS   = -1.0;
+    QString outputDir;
+    QString format;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        auto value = [&]() { return QString::fromLocal8Bit(argv[++i]); };
+
+        if (std::strcmp(arg, "--help") == 0 || std::strcmp(arg, "-h") == 0) {
+            printUsage();
+            return 0;
+        }
+        if (!hasValue) {
+            std::fprintf(stderr, "Missing value for %s\n", arg);
+            return 2;
+        }
+
+        if (std::strcmp(arg, "--config") == 0)         configPath = value();
+        else if (std::strcmp(arg, "--duration") == 0)  durationS = value().toDouble();
+        else if (std::strcmp(arg, "--output") == 0)    outputDir = value();
+        else if (std::strcmp(arg, "--format") == 0)    format = value();
+        else if (std::strcmp(arg, "--target-hz") == 0) targetHz = value().toDouble();
+        else if (std::strcmp(arg, "--status") == 0)    statusS = value().toDouble();
+        else {
+            std::fprintf(stderr, "Unknown option %s\n", arg);
+            printUsage();
+            return 2;
+        }
+    }
+
+    if (configPath.isEmpty()) {
+        printUsage();
+        return 2;
+    }
+
+    QFile file(configPath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        std::fprintf(stderr, "Cannot read %s: %s\n", qUtf8Printable(configPath), qUtf8Printable(file.errorString()));
+        return 2;
+    }
+
+    HeadlessConfig config;
+    QString error;
+    if (!HeadlessConfig::fromJson(file.readAll(), config, error)) {
+        std::fprintf(stderr, "%s: %s\n", qUtf8Printable(configPath), qUtf8Printable(error));
+        return 2;
+    }
+
+    // La ligne de commande l'emporte sur le fichier
+    if (durationS >= 0.0)    config.durationS = durationS;
+    if (targetHz >= 0.0)     config.targetFrequency = targetHz;
+    if (statusS >= 0.0)      config.statusIntervalS = statusS;
+    if (!outputDir.isEmpty()) config.outputDirectory = outputDir;
+    if (!format.isEmpty() && !HeadlessConfig::parseFormat(format, config.format)) {
+        std::fprintf(stderr, "Unknown --format %s (expected binary or csv)\n", qUtf8Printable(format));
+        return 2;
+    }
+
+    // MOBOT_TRACE=1 : même traçage que l'interface, vidé dans mobot_trace.json à la fin
+    const bool tracing = qEnvironmentVariableIntValue("MOBOT_TRACE") != 0;
+    if (tracing)
+        TraceRecorder::setEnabled(true);
+
+    HeadlessRunner runner(config);
+    int exitCode = 0;
+    QObject::connect(&runner, &HeadlessRunner::finished, &app, [&](int code) {
+        exitCode = code;
+        QCoreApplication::quit();
+    });
+
+    std::signal(SIGINT, onSignal);
+    std::signal(SIGTERM, onSignal);
+
+    // Le gestionnaire de signal ne peut pas toucher à Qt : relais par scrutation
+    QTimer stopPoll;
+    stopPoll.setInterval(100);
+    QObject::connect(&stopPoll, &QTimer::timeout, &runner, [&runner]() {
+        if (g_stop.load())
+            runner.requestStop();
+    });
+
+    if (!runner.start())
+        return 1;
+    stopPoll.start();
+
+    app.exec();
+
+    if (tracing) {
+        TraceRecorder::setEnabled(false);
+        std::string traceError;
+        if (!TraceRecorder::writeChromeTrace("mobot_trace.json", traceError))
+            std::fprintf(stderr, "%s\n", traceError.c_str());
+    }
+    return exitCode;
+}
@@ -0,0 +1,80 @@
+// ============================================================================
+// Mobot4TestsMain.cpp - Tests unitaires des décodeurs de protocole
+// ============================================================================
+// Exemples :
+//   Mobot4Tests                          (tous les cas)
+//   Mobot4Tests --filter NatNet
+//   Mobot4Tests --filter QtmRt/data
+//   Mobot4Tests --list
+//
+// Entrées : paquets de référence construits champ par champ selon la
+// description du protocole, tronqués ou corrompus par les cas eux-mêmes.
+//
+// Code de sortie : 0 si tous les cas passent ; 1 si au moins un échoue ;
+// 2 si erreur d'usage.
+// ============================================================================
+
+#include "UnitTest.h"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+void registerClockOffsetEstimatorTests(UnitTest& tests);
+void registerDatagramCaptureTests(UnitTest& tests);
+void registerNatNetDepacketizerTests(UnitTest& tests);
+void registerQtmRtProtocolTests(UnitTest& tests);
+void registerTrameHelperTests(UnitTest& tests);
+
+namespace {
+
+void printUsage()
+{
+    std::printf(
+        "Usage: Mobot4Tests [options]\n"
+        "  --filter TEXT        Run only tests whose name contains TEXT\n"
+        "  --list               List test names and exit\n");
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    std::string filter;
+    bool listOnly = false;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+
+        if (std::strcmp(arg, "--help") == 0 || std::strcmp(arg, "-h") == 0) {
+            printUsage();
+            return 0;
+        }
+        if (std::strcmp(arg, "--list") == 0) {
+            listOnly = true;
+            continue;
+        }
+        if (std::strcmp(arg, "--filter") == 0 && i + 1 < argc) {
+            filter = argv[++i];
+            continue;
+        }
+        std::fprintf(stderr, "Unknown option %s\n", arg);
+        printUsage();
+        return 2;
+    }
+
+    UnitTest tests;
+    registerClockOffsetEstimatorTests(tests);
+    registerDatagramCaptureTests(tests);
+    registerNatNetDepacketizerTests(tests);
+    registerQtmRtProtocolTests(tests);
+    registerTrameHelperTests(tests);
+
+    if (listOnly) {
+        for (const std::string& name : tests.names())
+            std::printf("%s\n", name.c_str());
+        return 0;
+    }
+
+    return tests.run(filter) == 0 ? 0 : 1;
+}
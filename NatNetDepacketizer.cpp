@@ -0,0 +1,386 @@
+#include "NatNetDepacketizer.h"
+#include <cstring>
+
+namespace {
+
+// =============================================================================
+// Lecteur borné : toute lecture hors du tampon invalide le lecteur
+// =============================================================================
+
+class PacketReader {
+public:
+    PacketReader(const char* data, int size)
+        : m_pos(data)
+        , m_end(data + (size > 0 ? size : 0))
+    {
+    }
+
+    bool ok() const { return m_ok; }
+    int  remaining() const { return static_cast<int>(m_end - m_pos); }
+
+    template<typename T>
+    T read()
+    {
+        T value{};
+        if (!require(static_cast<int>(sizeof(T))))
+            return value;
+        std::memcpy(&value, m_pos, sizeof(T));
+        m_pos += sizeof(T);
+        return value;
+    }
+
+    /** @brief Compteur d'éléments : un nombre négatif invalide le paquet */
+    int32_t readCount()
+    {
+        const int32_t n = read<int32_t>();
+        if (n < 0)
+            m_ok = false;
+        return m_ok ? n : 0;
+    }
+
+    void skip(int64_t bytes)
+    {
+        if (bytes < 0 || bytes > remaining()) {
+            m_ok = false;
+            m_pos = m_end;
+            return;
+        }
+        m_pos += bytes;
+    }
+
+    /** @brief Chaîne terminée par '\0' ; pointeur dans le tampon, nullptr si non terminée */
+    const char* readString()
+    {
+        if (!m_ok)
+            return nullptr;
+        const void* nul = std::memchr(m_pos, '\0', static_cast<size_t>(remaining()));
+        if (!nul) {
+            m_ok = false;
+            m_pos = m_end;
+            return nullptr;
+        }
+        const char* s = m_pos;
+        m_pos = static_cast<const char*>(nul) + 1;
+        return s;
+    }
+
+private:
+    bool require(int bytes)
+    {
+        if (!m_ok || bytes > remaining()) {
+            m_ok = false;
+            m_pos = m_end;
+            return false;
+        }
+        return true;
+    }
+
+    const char* m_pos;
+    const char* m_end;
+    bool        m_ok = true;
+};
+
+// Tailles fixes des éléments de frame (NatNet >= 3.0)
+constexpr int kRigidBodyBytes     = 4 + 3 * 4 + 4 * 4 + 4 + 2;   // id, pos, quat, meanError, params
+constexpr int kLabeledMarkerBytes = 4 + 3 * 4 + 4 + 2 + 4;       // id, pos, size, params, residual
+
+/** @brief Section de taille connue à partir de NatNet 4.1 : compteur puis octets */
+bool sizedSections(const NatNetVersion& version)
+{
+    return version.atLeast(4, 1);
+}
+
+void readRigidBody(PacketReader& r, NatNetRigidBodySample& body)
+{
+    body.id        = r.read<int32_t>();
+    body.x         = r.read<float>();
+    body.y         = r.read<float>();
+    body.z         = r.read<float>();
+    body.qx        = r.read<float>();
+    body.qy        = r.read<float>();
+    body.qz        = r.read<float>();
+    body.qw        = r.read<float>();
+    body.meanError = r.read<float>();
+    body.params    = r.read<int16_t>();
+}
+
+/** @brief Plateformes de force / périphériques : id, canaux, trames de floats */
+void skipAnalogSection(PacketReader& r, bool sized)
+{
+    const int32_t count = r.readCount();
+    if (sized) {
+        r.skip(r.readCount());
+        return;
+    }
+    for (int32_t i = 0; i < count && r.ok(); ++i) {
+        r.skip(4);                                  // id
+        const int32_t channels = r.readCount();
+        for (int32_t c = 0; c < channels && r.ok(); ++c)
+            r.skip(static_cast<int64_t>(r.readCount()) * 4);
+    }
+}
+
+void readRigidBodyDescription(PacketReader& r, const NatNetVersion& version,
+    std::vector<NatNetRigidBodyDescription>& bodies)
+{
+    NatNetRigidBodyDescription body;
+    const char* name = r.readString();
+    body.id       = r.read<int32_t>();
+    body.parentId = r.read<int32_t>();
+    r.skip(3 * 4);                                  // offset x, y, z
+
+    const int32_t markers = r.readCount();
+    r.skip(static_cast<int64_t>(markers) * (3 * 4 + 4));   // positions + labels requis
+    if (version.major >= 4) {
+        for (int32_t m = 0; m < markers && r.ok(); ++m)
+            r.readString();                         // noms des marqueurs
+    }
+
+    if (r.ok() && name) {
+        body.name = name;
+        bodies.push_back(std::move(body));
+    }
+}
+
+} // namespace
+
+// =============================================================================
+// En-tête et informations serveur
+// =============================================================================
+
+bool NatNetDepacketizer::readHeader(const char* data, int length, uint16_t& messageId, int& payloadSize)
+{
+    if (!data || length < NatNetProtocol::kHeaderSize)
+        return false;
+
+    uint16_t size = 0;
+    std::memcpy(&messageId, data, 2);
+    std::memcpy(&size, data + 2, 2);
+    payloadSize = size;
+    return payloadSize <= length - NatNetProtocol::kHeaderSize;
+}
+
+bool NatNetDepacketizer::parseServerInfo(const char* payload, int size, NatNetServerInfo& info)
+{
+    // sSender : nom (256) + version application (4) + version NatNet (4)
+    constexpr int kSenderBytes = NatNetProtocol::kMaxNameLength + 4 + 4;
+    if (!payload || size < kSenderBytes)
+        return false;
+
+    info.appName.assign(payload, strnlen(payload, NatNetProtocol::kMaxNameLength));
+    std::memcpy(info.appVersion, payload + NatNetProtocol::kMaxNameLength, 4);
+
+    const uint8_t* v = reinterpret_cast<const uint8_t*>(payload + NatNetProtocol::kMaxNameLength + 4);
+    info.natNetVersion = { v[0], v[1], v[2], v[3] };
+
+    // Extension NatNet 3.0+ : horloge, port de données, multicast
+    PacketReader r(payload + kSenderBytes, size - kSenderBytes);
+    const uint64_t clock     = r.read<uint64_t>();
+    const uint16_t dataPort  = r.read<uint16_t>();
+    const uint8_t  multicast = r.read<uint8_t>();
+    const uint8_t  a = r.read<uint8_t>(), b = r.read<uint8_t>(), c = r.read<uint8_t>(), d = r.read<uint8_t>();
+
+    info.connectionInfoValid = r.ok();
+    if (info.connectionInfoValid) {
+        info.highResClockFrequency = clock;
+        info.dataPort              = dataPort;
+        info.multicast             = multicast != 0;
+        info.multicastAddress      = std::to_string(a) + "." + std::to_string(b) + "."
+                                   + std::to_string(c) + "." + std::to_string(d);
+    }
+    return true;
+}
+
+// =============================================================================
+// Frame de données
+// =============================================================================
+
+bool NatNetDepacketizer::parseFrameOfData(const char* payload, int size,
+    const NatNetVersion& version, NatNetFrameSnapshot& frame)
+{
+    if (!payload || !version.atLeast(3, 0))
+        return false;
+
+    const bool sized = sizedSections(version);
+    PacketReader r(payload, size);
+
+    frame.frameNumber = r.read<int32_t>();
+
+    // --- Marker sets (non utilisés) ---
+    {
+        const int32_t count = r.readCount();
+        if (sized) {
+            r.skip(r.readCount());
+        }
+        else {
+            for (int32_t i = 0; i < count && r.ok(); ++i) {
+                r.readString();
+                r.skip(static_cast<int64_t>(r.readCount()) * 3 * 4);
+            }
+        }
+    }
+
+    // --- Marqueurs non labellisés (hérités) ---
+    {
+        const int32_t count = r.readCount();
+        if (sized)
+            r.skip(r.readCount());
+        else
+            r.skip(static_cast<int64_t>(count) * 3 * 4);
+    }
+
+    // --- Rigid bodies : écriture directe dans l'instantané ---
+    {
+        const int32_t count = r.readCount();
+        if (sized)
+            r.readCount();                          // taille de section, redondante ici
+
+        const int32_t kept = count < NatNetFrameSnapshot::kMaxRigidBodies
+            ? count : NatNetFrameSnapshot::kMaxRigidBodies;
+        for (int32_t i = 0; i < kept && r.ok(); ++i)
+            readRigidBody(r, frame.rigidBodies[i]);
+        r.skip(static_cast<int64_t>(count - kept) * kRigidBodyBytes);
+        frame.rigidBodyCount = r.ok() ? kept : 0;
+    }
+
+    // --- Squelettes ---
+    {
+        const int32_t count = r.readCount();
+        if (sized) {
+            r.skip(r.readCount());
+        }
+        else {
+            for (int32_t i = 0; i < count && r.ok(); ++i) {
+                r.skip(4);                          // id squelette
+                r.skip(static_cast<int64_t>(r.readCount()) * kRigidBodyBytes);
+            }
+        }
+    }
+
+    // --- Assets (NatNet 4.1+) ---
+    if (sized) {
+        r.readCount();
+        r.skip(r.readCount());
+    }
+
+    // --- Marqueurs labellisés (non utilisés) ---
+    {
+        const int32_t count = r.readCount();
+        if (sized)
+            r.skip(r.readCount());
+        else
+            r.skip(static_cast<int64_t>(count) * kLabeledMarkerBytes);
+    }
+
+    // --- Plateformes de force, périphériques ---
+    skipAnalogSection(r, sized);
+    skipAnalogSection(r, sized);
+
+    // --- Suffixe : horodatages et paramètres ---
+    r.skip(4 + 4);                                  // timecode, sous-trame
+    frame.timestamp                  = r.read<double>();
+    frame.cameraMidExposureTimestamp = r.read<uint64_t>();
+    r.skip(8);                                      // CameraDataReceivedTimestamp
+    frame.transmitTimestamp          = r.read<uint64_t>();
+    if (sized)
+        r.skip(4 + 4);                              // horodatage précis (s, fraction)
+    frame.params = r.read<int16_t>();
+
+    return r.ok();
+}
+
+// =============================================================================
+// Descriptions de modèles
+// =============================================================================
+
+bool NatNetDepacketizer::parseModelDef(const char* payload, int size,
+    const NatNetVersion& version, std::vector<NatNetRigidBodyDescription>& bodies)
+{
+    enum DescriptorType { MarkerSet = 0, RigidBody = 1, Skeleton = 2 };
+
+    bodies.clear();
+    if (!payload || !version.atLeast(3, 0))
+        return false;
+
+    const bool sized = sizedSections(version);
+    PacketReader r(payload, size);
+
+    const int32_t count = r.readCount();
+    for (int32_t i = 0; i < count && r.ok(); ++i) {
+        const int32_t type  = r.read<int32_t>();
+        const int32_t bytes = sized ? r.readCount() : 0;
+
+        const int before = r.remaining();
+        if (type == RigidBody) {
+            readRigidBodyDescription(r, version, bodies);
+        }
+        else if (type == Skeleton) {
+            r.readString();                         // nom du squelette
+            r.skip(4);                              // id
+            const int32_t segments = r.readCount();
+            for (int32_t s = 0; s < segments && r.ok(); ++s)
+                readRigidBodyDescription(r, version, bodies);
+        }
+        else if (sized) {
+            r.skip(bytes);
+            continue;
+        }
+        else if (type == MarkerSet) {
+            r.readString();
+            const int32_t markers = r.readCount();
+            for (int32_t m = 0; m < markers && r.ok(); ++m)
+                r.readString();
+        }
+        else {
+            // Format de description non décodable sans taille : liste partielle
+            return true;
+        }
+
+        // 4.1+ : se recaler sur la taille annoncée (champs ajoutés par les versions futures)
+        if (sized && r.ok())
+            r.skip(bytes - (before - r.remaining()));
+    }
+    return r.ok() || !bodies.empty();
+}
+
+// =============================================================================
+// Requêtes
+// =============================================================================
+
+int NatNetDepacketizer::buildConnect(char* buffer, int capacity, const NatNetVersion& requested)
+{
+    // sSender (264 octets) + sConnectionOptions { bool subscribedDataOnly; uint8 BitstreamVersion[4] }
+    constexpr int kPayload = NatNetProtocol::kMaxNameLength + 4 + 4 + 1 + 4;
+    constexpr int kTotal   = NatNetProtocol::kHeaderSize + kPayload;
+    if (!buffer || capacity < kTotal)
+        return 0;
+
+    std::memset(buffer, 0, kTotal);
+    const uint16_t id   = NatNetProtocol::Connect;
+    const uint16_t size = kPayload;
+    std::memcpy(buffer, &id, 2);
+    std::memcpy(buffer + 2, &size, 2);
+
+    char* payload = buffer + NatNetProtocol::kHeaderSize;
+    std::memcpy(payload, "Mobot4", 6);
+
+    const uint8_t version[4] = { requested.major, requested.minor, requested.build, requested.revision };
+    std::memcpy(payload + NatNetProtocol::kMaxNameLength + 4, version, 4);          // NatNetVersion
+    std::memcpy(payload + NatNetProtocol::kMaxNameLength + 4 + 4 + 1, version, 4);  // BitstreamVersion
+    return kTotal;
+}
+
+int NatNetDepacketizer::buildRequest(char* buffer, int capacity, uint16_t messageId, const char* text)
+{
+    const int textBytes = text ? static_cast<int>(std::strlen(text)) + 1 : 0;
+    const int total     = NatNetProtocol::kHeaderSize + textBytes;
+    if (!buffer || capacity < total)
+        return 0;
+
+    const uint16_t size = static_cast<uint16_t>(textBytes);
+    std::memcpy(buffer, &messageId, 2);
+    std::memcpy(buffer + 2, &size, 2);
+    if (textBytes > 0)
+        std::memcpy(buffer + NatNetProtocol::kHeaderSize, text, static_cast<size_t>(textBytes));
+    return total;
+}
@@ -0,0 +1,138 @@
+#pragma once
+#ifndef NATNETDEPACKETIZER_H
+#define NATNETDEPACKETIZER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "NatNetFrameData.h"
+
+/**
+ * @brief Constantes du protocole NatNet (ports, identifiants de messages)
+ *
+ * Chaque paquet commence par un en-tête de 4 octets : uint16 messageId,
+ * uint16 taille de la charge utile. Tout est little-endian.
+ */
+namespace NatNetProtocol {
+
+enum MessageId : uint16_t {
+    Connect             = 0,
+    ServerInfo          = 1,
+    Request             = 2,
+    Response            = 3,
+    RequestModelDef     = 4,
+    ModelDef            = 5,
+    RequestFrameOfData  = 6,
+    FrameOfData         = 7,
+    MessageString       = 8,
+    Disconnect          = 9,
+    KeepAlive           = 10,
+    UnrecognizedRequest = 100
+};
+
+constexpr int      kHeaderSize        = 4;
+constexpr int      kMaxPacketSize     = 65503;
+constexpr int      kMaxNameLength     = 256;
+constexpr uint16_t kDefaultCommandPort = 1510;
+constexpr uint16_t kDefaultDataPort    = 1511;
+constexpr const char* kDefaultMulticastAddress = "239.255.42.99";
+
+} // namespace NatNetProtocol
+
+/**
+ * @brief Version du flux NatNet (major.minor.build.revision)
+ */
+struct NatNetVersion {
+    uint8_t major    = 0;
+    uint8_t minor    = 0;
+    uint8_t build    = 0;
+    uint8_t revision = 0;
+
+    bool atLeast(int maj, int min) const
+    {
+        return major > maj || (major == maj && minor >= min);
+    }
+};
+
+/**
+ * @brief Réponse NAT_SERVERINFO (sSender_Server)
+ */
+struct NatNetServerInfo {
+    std::string   appName;
+    uint8_t       appVersion[4] = {};
+    NatNetVersion natNetVersion;
+
+    // Présents à partir de NatNet 3.0 (sinon valeurs par défaut, connectionInfoValid = false)
+    bool        connectionInfoValid   = false;
+    uint64_t    highResClockFrequency = 0;
+    uint16_t    dataPort              = NatNetProtocol::kDefaultDataPort;
+    bool        multicast             = true;
+    std::string multicastAddress;
+};
+
+/**
+ * @brief Description d'un rigid body (NAT_MODELDEF), squelettes compris
+ */
+struct NatNetRigidBodyDescription {
+    int32_t     id       = -1;
+    int32_t     parentId = -1;
+    std::string name;
+};
+
+/**
+ * @brief Décodage des paquets NatNet, sans SDK ni Qt
+ *
+ * Fonctions pures sur un tampon reçu : testables sur n'importe quelle plateforme
+ * à partir de paquets capturés. parseFrameOfData écrit directement dans un
+ * NatNetFrameSnapshot (typiquement un emplacement de la file du worker).
+ *
+ * Flux supportés : NatNet 3.0 à 4.x. À partir de 4.1, chaque section de la
+ * frame est précédée de sa taille en octets : les sections inutiles (marker
+ * sets, squelettes, assets, marqueurs labellisés, plateformes de force,
+ * périphériques) sont sautées d'un bloc. Les longueurs sont vérifiées à chaque lecture : un paquet tronqué
+ * ou corrompu est rejeté (retour false), jamais lu au-delà du tampon.
+ *
+ * Hypothèse : hôte little-endian (x86, ARM usuels), comme le protocole.
+ */
+class NatNetDepacketizer {
+public:
+    /** @brief En-tête de paquet ; false si incomplet ou taille incohérente */
+    static bool readHeader(const char* data, int length, uint16_t& messageId, int& payloadSize);
+
+    static bool parseServerInfo(const char* payload, int size, NatNetServerInfo& info);
+
+    /**
+     * @brief Décode NAT_FRAMEOFDATA : en-tête de frame et rigid bodies
+     *
+     * Les champs de mesure locale (hostReceiveUs, latencyMs) ne sont pas touchés.
+     */
+    static bool parseFrameOfData(const char* payload, int size,
+        const NatNetVersion& version, NatNetFrameSnapshot& frame);
+
+    /**
+     * @brief Extrait les rigid bodies de NAT_MODELDEF (y compris ceux des squelettes)
+     *
+     * Avant NatNet 4.1, les descriptions n'ont pas de taille : le parcours s'arrête
+     * au premier type non décodable (plateforme de force, caméra...). Les corps
+     * déjà lus restent valides, d'où un retour true avec une liste partielle.
+     */
+    static bool parseModelDef(const char* payload, int size,
+        const NatNetVersion& version, std::vector<NatNetRigidBodyDescription>& bodies);
+
+    // ========== Construction de requêtes ==========
+
+    /**
+     * @brief NAT_CONNECT : sSender (nom, versions) + options de connexion
+     *        (BitstreamVersion = version de flux demandée)
+     * @return Taille du paquet, 0 si capacité insuffisante
+     */
+    static int buildConnect(char* buffer, int capacity, const NatNetVersion& requested);
+
+    /** @brief Requête simple (NAT_REQUEST_MODELDEF, NAT_KEEPALIVE, NAT_REQUEST + texte...) */
+    static int buildRequest(char* buffer, int capacity, uint16_t messageId, const char* text = nullptr);
+
+private:
+    NatNetDepacketizer() = default; // Classe utilitaire, pas d'instanciation
+};
+
+#endif // NATNETDEPACKETIZER_H
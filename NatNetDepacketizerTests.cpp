@@ -0,0 +1,453 @@
+// ============================================================================
+// NatNetDepacketizerTests.cpp - Décodage des paquets NatNet (client natif)
+// ============================================================================
+// Paquets de référence construits selon la disposition du protocole (NatNet 3.x
+// sans tailles de section, 4.1+ avec), puis tronqués à chaque longueur ou
+// corrompus (compteurs négatifs ou démesurés, sections plus longues que le
+// paquet) : le décodeur doit refuser sans lire au-delà du tampon.
+// ============================================================================
+
+#include "NatNetDepacketizer.h"
+#include "UnitTest.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <memory>
+
+namespace {
+
+const NatNetVersion kVersion31 = { 3, 1, 0, 0 };
+const NatNetVersion kVersion41 = { 4, 1, 0, 0 };
+
+constexpr int kFixtureMarkers = 2;
+
+// ===== Frame de données =====
+
+/** @brief Section de frame : compteur, puis (4.1+) taille en octets du contenu */
+template<typename Content>
+void putSection(PacketWriter& w, const NatNetVersion& version, int32_t count, Content content)
+{
+    w.put<int32_t>(count);
+    if (!version.atLeast(4, 1)) {
+        content();
+        return;
+    }
+    const std::size_t at = w.reserveInt32();
+    const std::size_t from = w.size();
+    content();
+    w.patchSize(at, from);
+}
+
+void putRigidBody(PacketWriter& w, int32_t id)
+{
+    const float f = static_cast<float>(id);
+    w.put<int32_t>(id)
+     .put<float>(0.1f * f).put<float>(0.2f * f).put<float>(0.3f * f)      // position
+     .put<float>(0.0f).put<float>(0.0f).put<float>(0.6f).put<float>(0.8f)  // quaternion
+     .put<float>(0.001f * f)                                              // meanError
+     .put<int16_t>(1);                                                    // tracking valide
+}
+
+/** @brief Numéro de frame, marker sets, marqueurs non labellisés : jusqu'au compteur de rigid bodies */
+void putFramePrefix(PacketWriter& w, const NatNetVersion& version)
+{
+    w.put<int32_t>(4242);                                       // frameNumber
+
+    putSection(w, version, 1, [&]() {                           // marker sets
+        w.putString("all").put<int32_t>(2);
+        for (int i = 0; i < 2 * 3; ++i)
+            w.put<float>(1.0f);
+    });
+    putSection(w, version, 1, [&]() {                           // non labellisés
+        w.put<float>(1.0f).put<float>(2.0f).put<float>(3.0f);
+    });
+}
+
+/** @brief NAT_FRAMEOFDATA complet : toutes les sections non vides, sauf les périphériques */
+std::string buildFrameOfData(const NatNetVersion& version, int32_t rigidBodies)
+{
+    PacketWriter w;
+    putFramePrefix(w, version);
+    putSection(w, version, rigidBodies, [&]() {
+        for (int32_t i = 0; i < rigidBodies; ++i)
+            putRigidBody(w, i + 1);
+    });
+    putSection(w, version, 1, [&]() {                           // squelettes
+        w.put<int32_t>(7).put<int32_t>(1);
+        putRigidBody(w, 0x70001);
+    });
+    if (version.atLeast(4, 1)) {
+        putSection(w, version, 1, [&]() {                       // assets
+            w.put<int32_t>(9).put<int32_t>(0);
+        });
+    }
+    putSection(w, version, kFixtureMarkers, [&]() {
+        for (int32_t i = 0; i < kFixtureMarkers; ++i) {
+            w.put<int32_t>((1 << 16) | (i + 1))
+             .put<float>(1.5f).put<float>(2.5f).put<float>(3.5f + i)
+             .put<float>(0.014f)
+             .put<int16_t>(static_cast<int16_t>(i))
+             .put<float>(0.0002f);
+        }
+    });
+    putSection(w, version, 1, [&]() {                           // plateformes de force
+        w.put<int32_t>(1).put<int32_t>(1).put<int32_t>(2).put<float>(9.81f).put<float>(9.82f);
+    });
+    putSection(w, version, 0, []() {});                         // périphériques
+
+    w.put<int32_t>(0).put<int32_t>(0)                           // timecode, sous-trame
+     .put<double>(12.5)
+     .put<uint64_t>(1000001).put<uint64_t>(1000002).put<uint64_t>(1000003);
+    if (version.atLeast(4, 1))
+        w.put<uint32_t>(12).put<uint32_t>(500);                 // horodatage précis
+    w.put<int16_t>(2);
+    return w.bytes();
+}
+
+bool parseFrame(const std::string& packet, int size, const NatNetVersion& version,
+    NatNetFrameSnapshot& frame)
+{
+    return NatNetDepacketizer::parseFrameOfData(packet.data(), size, version, frame);
+}
+
+void checkFrameRoundTrip(const NatNetVersion& version)
+{
+    const std::string packet = buildFrameOfData(version, 3);
+    auto frame = std::make_unique<NatNetFrameSnapshot>();
+
+    CHECK(parseFrame(packet, static_cast<int>(packet.size()), version, *frame));
+    CHECK(frame->frameNumber == 4242);
+    CHECK(frame->rigidBodyCount == 3);
+    CHECK(frame->rigidBodies[0].id == 1);
+    CHECK(frame->rigidBodies[2].id == 3);
+    CHECK(frame->rigidBodies[2].x == 0.1f * 3.0f);
+    CHECK(frame->rigidBodies[2].z == 0.3f * 3.0f);
+    CHECK(frame->rigidBodies[1].qz == 0.6f);
+    CHECK(frame->rigidBodies[1].qw == 0.8f);
+    CHECK(frame->rigidBodies[1].meanError == 0.002f);
+    CHECK(frame->rigidBodies[1].params == 1);
+    CHECK(frame->timestamp == 12.5);
+    CHECK(frame->cameraMidExposureTimestamp == 1000001);
+    CHECK(frame->transmitTimestamp == 1000003);
+    CHECK(frame->params == 2);
+}
+
+void checkFrameTruncated(const NatNetVersion& version)
+{
+    const std::string packet = buildFrameOfData(version, 3);
+    auto frame = std::make_unique<NatNetFrameSnapshot>();
+
+    int accepted = 0;
+    for (int size = 0; size < static_cast<int>(packet.size()); ++size) {
+        // Copie exacte : un dépassement de lecture est visible sous sanitizer
+        const std::string truncated = packet.substr(0, static_cast<std::size_t>(size));
+        if (parseFrame(truncated, size, version, *frame))
+            ++accepted;
+    }
+    CHECK(accepted == 0);
+}
+
+void registerFrameOfData(UnitTest& tests)
+{
+    tests.add("NatNet/frameOfData_3_1", []() { checkFrameRoundTrip(kVersion31); });
+    tests.add("NatNet/frameOfData_4_1", []() { checkFrameRoundTrip(kVersion41); });
+    tests.add("NatNet/frameOfData_truncated_3_1", []() { checkFrameTruncated(kVersion31); });
+    tests.add("NatNet/frameOfData_truncated_4_1", []() { checkFrameTruncated(kVersion41); });
+
+    tests.add("NatNet/frameOfData_rigidBodiesAboveMax", []() {
+        // Au-delà de kMaxRigidBodies : corps suivants sautés, reste de la frame lu
+        const int32_t count = NatNetFrameSnapshot::kMaxRigidBodies + 44;
+        for (const NatNetVersion& version : { kVersion31, kVersion41 }) {
+            const std::string packet = buildFrameOfData(version, count);
+            auto frame = std::make_unique<NatNetFrameSnapshot>();
+            CHECK(parseFrame(packet, static_cast<int>(packet.size()), version, *frame));
+            CHECK(frame->rigidBodyCount == NatNetFrameSnapshot::kMaxRigidBodies);
+            CHECK(frame->rigidBodies[NatNetFrameSnapshot::kMaxRigidBodies - 1].id
+                == NatNetFrameSnapshot::kMaxRigidBodies);
+            CHECK(frame->params == 2);
+        }
+    });
+
+    tests.add("NatNet/frameOfData_invalidCounts", []() {
+        auto frame = std::make_unique<NatNetFrameSnapshot>();
+
+        for (const NatNetVersion& version : { kVersion31, kVersion41 }) {
+            const std::string packet = buildFrameOfData(version, 3);
+            PacketWriter prefix;
+            putFramePrefix(prefix, version);
+            const std::size_t at = prefix.size();                  // compteur de rigid bodies
+
+            for (const int32_t bad : { -1, INT_MIN, INT_MAX }) {
+                std::string corrupted = packet;
+                std::memcpy(&corrupted[at], &bad, sizeof(bad));
+                CHECK(!parseFrame(corrupted, static_cast<int>(corrupted.size()), version, *frame));
+                CHECK(frame->rigidBodyCount == 0);
+            }
+        }
+
+        // 4.1 : taille de section au-delà du paquet, ou négative (marker sets)
+        const std::string packet = buildFrameOfData(kVersion41, 3);
+        for (const int32_t bad : { -8, static_cast<int32_t>(packet.size()), INT_MAX }) {
+            std::string corrupted = packet;
+            std::memcpy(&corrupted[8], &bad, sizeof(bad));
+            CHECK(!parseFrame(corrupted, static_cast<int>(corrupted.size()), kVersion41, *frame));
+        }
+    });
+
+    tests.add("NatNet/frameOfData_unsupportedVersion", []() {
+        const std::string packet = buildFrameOfData(kVersion31, 1);
+        auto frame = std::make_unique<NatNetFrameSnapshot>();
+        const NatNetVersion old = { 2, 10, 0, 0 };
+        CHECK(!parseFrame(packet, static_cast<int>(packet.size()), old, *frame));
+        CHECK(!NatNetDepacketizer::parseFrameOfData(nullptr, 0, kVersion41, *frame));
+    });
+}
+
+// ===== Informations serveur =====
+
+std::string buildServerInfo(bool withConnectionInfo)
+{
+    PacketWriter w;
+    std::string name("Motive");
+    name.resize(NatNetProtocol::kMaxNameLength, '\0');
+    w.putBytes(name)
+     .put<uint8_t>(3).put<uint8_t>(1).put<uint8_t>(0).put<uint8_t>(2)     // application
+     .put<uint8_t>(4).put<uint8_t>(1).put<uint8_t>(0).put<uint8_t>(0);    // NatNet
+    if (withConnectionInfo) {
+        w.put<uint64_t>(10000000).put<uint16_t>(1600).put<uint8_t>(1)
+         .put<uint8_t>(239).put<uint8_t>(255).put<uint8_t>(42).put<uint8_t>(99);
+    }
+    return w.bytes();
+}
+
+void registerServerInfo(UnitTest& tests)
+{
+    tests.add("NatNet/serverInfo", []() {
+        const std::string packet = buildServerInfo(true);
+        NatNetServerInfo info;
+        CHECK(NatNetDepacketizer::parseServerInfo(packet.data(), static_cast<int>(packet.size()), info));
+        CHECK(info.appName == "Motive");
+        CHECK(info.appVersion[0] == 3 && info.appVersion[3] == 2);
+        CHECK(info.natNetVersion.atLeast(4, 1));
+        CHECK(info.connectionInfoValid);
+        CHECK(info.highResClockFrequency == 10000000);
+        CHECK(info.dataPort == 1600);
+        CHECK(info.multicast);
+        CHECK(info.multicastAddress == "239.255.42.99");
+    });
+
+    tests.add("NatNet/serverInfo_truncated", []() {
+        // sSender seul (NatNet < 3.0) : accepté, sans informations de connexion
+        const std::string packet = buildServerInfo(true);
+        const int senderBytes = static_cast<int>(buildServerInfo(false).size());
+        for (int size = 0; size < static_cast<int>(packet.size()); ++size) {
+            const std::string truncated = packet.substr(0, static_cast<std::size_t>(size));
+            NatNetServerInfo info;
+            const bool ok = NatNetDepacketizer::parseServerInfo(truncated.data(), size, info);
+            CHECK(ok == (size >= senderBytes));
+            CHECK(!info.connectionInfoValid);
+            CHECK(info.dataPort == NatNetProtocol::kDefaultDataPort);
+        }
+    });
+
+    tests.add("NatNet/serverInfo_unterminatedName", []() {
+        // Nom sur 256 octets sans '\0' : borné à kMaxNameLength
+        std::string packet = buildServerInfo(false);
+        std::fill(packet.begin(), packet.begin() + NatNetProtocol::kMaxNameLength, 'M');
+        NatNetServerInfo info;
+        CHECK(NatNetDepacketizer::parseServerInfo(packet.data(), static_cast<int>(packet.size()), info));
+        CHECK(info.appName.size() == static_cast<std::size_t>(NatNetProtocol::kMaxNameLength));
+    });
+}
+
+// ===== Descriptions de modèles =====
+
+/** @brief Description : type, puis (4.1+) taille en octets du contenu */
+template<typename Content>
+void putDescription(PacketWriter& w, const NatNetVersion& version, int32_t type, Content content)
+{
+    w.put<int32_t>(type);
+    if (!version.atLeast(4, 1)) {
+        content();
+        return;
+    }
+    const std::size_t at = w.reserveInt32();
+    const std::size_t from = w.size();
+    content();
+    w.patchSize(at, from);
+}
+
+void putBodyDescription(PacketWriter& w, const NatNetVersion& version,
+    const char* name, int32_t id, int32_t parentId)
+{
+    w.putString(name).put<int32_t>(id).put<int32_t>(parentId)
+     .put<float>(0.0f).put<float>(0.0f).put<float>(0.0f)
+     .put<int32_t>(2);
+    for (int m = 0; m < 2; ++m)
+        w.put<float>(0.01f).put<float>(0.02f).put<float>(0.03f);
+    w.put<int32_t>(0).put<int32_t>(0);                          // labels requis
+    if (version.major >= 4)
+        w.putString("m1").putString("m2");
+}
+
+/** @brief Marker set, rigid body, squelette à deux segments (+ type non décodé si demandé) */
+std::string buildModelDef(const NatNetVersion& version, bool trailingUnknown)
+{
+    PacketWriter w;
+    w.put<int32_t>(trailingUnknown ? 4 : 3);
+
+    putDescription(w, version, 0, [&]() {
+        w.putString("all").put<int32_t>(2).putString("m1").putString("m2");
+    });
+    putDescription(w, version, 1, [&]() {
+        putBodyDescription(w, version, "Tool", 1, -1);
+        if (version.atLeast(4, 1))
+            w.put<int32_t>(0);                                  // champ d'une version future
+    });
+    putDescription(w, version, 2, [&]() {
+        w.putString("Skel").put<int32_t>(7).put<int32_t>(2);
+        putBodyDescription(w, version, "Hip", 0x70001, -1);
+        putBodyDescription(w, version, "Spine", 0x70002, 0x70001);
+    });
+    if (trailingUnknown) {
+        putDescription(w, version, 3, [&]() {                  // plateforme de force
+            w.put<int32_t>(1).putString("FP1").put<float>(0.5f);
+        });
+    }
+    return w.bytes();
+}
+
+void checkModelDef(const NatNetVersion& version)
+{
+    const std::string packet = buildModelDef(version, false);
+    std::vector<NatNetRigidBodyDescription> bodies;
+    CHECK(NatNetDepacketizer::parseModelDef(packet.data(), static_cast<int>(packet.size()), version, bodies));
+    CHECK(bodies.size() == 3);
+    if (bodies.size() == 3) {
+        CHECK(bodies[0].name == "Tool" && bodies[0].id == 1 && bodies[0].parentId == -1);
+        CHECK(bodies[1].name == "Hip" && bodies[1].id == 0x70001);
+        CHECK(bodies[2].name == "Spine" && bodies[2].parentId == 0x70001);
+    }
+}
+
+void checkModelDefTruncated(const NatNetVersion& version)
+{
+    // Liste partielle admise (corps complets seulement), jamais un corps en trop
+    const std::string packet = buildModelDef(version, false);
+    for (int size = 0; size < static_cast<int>(packet.size()); ++size) {
+        const std::string truncated = packet.substr(0, static_cast<std::size_t>(size));
+        std::vector<NatNetRigidBodyDescription> bodies;
+        const bool ok = NatNetDepacketizer::parseModelDef(truncated.data(), size, version, bodies);
+        CHECK(bodies.size() < 3);
+        CHECK(ok == !bodies.empty());
+    }
+}
+
+void registerModelDef(UnitTest& tests)
+{
+    tests.add("NatNet/modelDef_3_1", []() { checkModelDef(kVersion31); });
+    tests.add("NatNet/modelDef_4_1", []() { checkModelDef(kVersion41); });
+    tests.add("NatNet/modelDef_truncated_3_1", []() { checkModelDefTruncated(kVersion31); });
+    tests.add("NatNet/modelDef_truncated_4_1", []() { checkModelDefTruncated(kVersion41); });
+
+    tests.add("NatNet/modelDef_unknownType", []() {
+        // 3.x : arrêt au type non décodable, corps déjà lus gardés ; 4.1 : sauté par sa taille
+        for (const NatNetVersion& version : { kVersion31, kVersion41 }) {
+            const std::string packet = buildModelDef(version, true);
+            std::vector<NatNetRigidBodyDescription> bodies;
+            CHECK(NatNetDepacketizer::parseModelDef(packet.data(), static_cast<int>(packet.size()),
+                version, bodies));
+            CHECK(bodies.size() == 3);
+        }
+    });
+
+    tests.add("NatNet/modelDef_invalidSize", []() {
+        // 4.1 : taille de description au-delà du paquet ou négative
+        const std::string packet = buildModelDef(kVersion41, false);
+        for (const int32_t bad : { -1, static_cast<int32_t>(packet.size()), INT_MAX }) {
+            std::string corrupted = packet;
+            std::memcpy(&corrupted[8], &bad, sizeof(bad));         // marker set (premier)
+            std::vector<NatNetRigidBodyDescription> bodies;
+            CHECK(!NatNetDepacketizer::parseModelDef(corrupted.data(),
+                static_cast<int>(corrupted.size()), kVersion41, bodies));
+            CHECK(bodies.empty());
+        }
+    });
+}
+
+// ===== En-têtes et requêtes =====
+
+void registerRequests(UnitTest& tests)
+{
+    tests.add("NatNet/readHeader", []() {
+        PacketWriter w;
+        w.put<uint16_t>(NatNetProtocol::FrameOfData).put<uint16_t>(4).put<int32_t>(0);
+        const std::string packet = w.bytes();
+
+        uint16_t id = 0;
+        int payloadSize = 0;
+        CHECK(NatNetDepacketizer::readHeader(packet.data(), static_cast<int>(packet.size()), id, payloadSize));
+        CHECK(id == NatNetProtocol::FrameOfData);
+        CHECK(payloadSize == 4);
+
+        // Charge utile annoncée plus longue que le datagramme
+        CHECK(!NatNetDepacketizer::readHeader(packet.data(), static_cast<int>(packet.size()) - 1, id, payloadSize));
+        CHECK(!NatNetDepacketizer::readHeader(packet.data(), NatNetProtocol::kHeaderSize - 1, id, payloadSize));
+        CHECK(!NatNetDepacketizer::readHeader(nullptr, 64, id, payloadSize));
+    });
+
+    tests.add("NatNet/buildConnect", []() {
+        char buffer[512] = {};
+        const int size = NatNetDepacketizer::buildConnect(buffer, sizeof(buffer), kVersion41);
+        CHECK(size == NatNetProtocol::kHeaderSize + NatNetProtocol::kMaxNameLength + 4 + 4 + 1 + 4);
+
+        uint16_t id = 0xFFFF;
+        int payloadSize = 0;
+        CHECK(NatNetDepacketizer::readHeader(buffer, size, id, payloadSize));
+        CHECK(id == NatNetProtocol::Connect);
+        CHECK(payloadSize == size - NatNetProtocol::kHeaderSize);
+
+        const char* payload = buffer + NatNetProtocol::kHeaderSize;
+        CHECK(std::strcmp(payload, "Mobot4") == 0);
+        CHECK(payload[NatNetProtocol::kMaxNameLength + 4] == 4);          // NatNetVersion
+        CHECK(payload[NatNetProtocol::kMaxNameLength + 5] == 1);
+        CHECK(payload[NatNetProtocol::kMaxNameLength + 8] == 0);          // subscribedDataOnly
+        CHECK(payload[NatNetProtocol::kMaxNameLength + 9] == 4);          // BitstreamVersion
+        CHECK(payload[NatNetProtocol::kMaxNameLength + 10] == 1);
+
+        CHECK(NatNetDepacketizer::buildConnect(buffer, size - 1, kVersion41) == 0);
+    });
+
+    tests.add("NatNet/buildRequest", []() {
+        char buffer[64] = {};
+        uint16_t id = 0;
+        int payloadSize = -1;
+
+        const int size = NatNetDepacketizer::buildRequest(buffer, sizeof(buffer),
+            NatNetProtocol::Request, "TimelinePlay");
+        CHECK(size == NatNetProtocol::kHeaderSize + 13);
+        CHECK(NatNetDepacketizer::readHeader(buffer, size, id, payloadSize));
+        CHECK(id == NatNetProtocol::Request);
+        CHECK(payloadSize == 13);
+        CHECK(std::strcmp(buffer + NatNetProtocol::kHeaderSize, "TimelinePlay") == 0);
+
+        const int keepAlive = NatNetDepacketizer::buildRequest(buffer, sizeof(buffer), NatNetProtocol::KeepAlive);
+        CHECK(keepAlive == NatNetProtocol::kHeaderSize);
+        CHECK(NatNetDepacketizer::readHeader(buffer, keepAlive, id, payloadSize));
+        CHECK(id == NatNetProtocol::KeepAlive && payloadSize == 0);
+
+        CHECK(NatNetDepacketizer::buildRequest(buffer, NatNetProtocol::kHeaderSize + 12,
+            NatNetProtocol::Request, "TimelinePlay") == 0);
+    });
+}
+
+} // namespace
+
+void registerNatNetDepacketizerTests(UnitTest& tests)
+{
+    registerFrameOfData(tests);
+    registerServerInfo(tests);
+    registerModelDef(tests);
+    registerRequests(tests);
+}
@@ -0,0 +1,53 @@
+#pragma once
+#ifndef NATNETFRAMEDATA_H
+#define NATNETFRAMEDATA_H
+
+#include <cstdint>
+
+/**
+ * @brief Corps rigide tel que reçu dans une frame NatNet (unités SDK : mètres, quaternion)
+ *
+ * Volontairement indépendant des en-têtes NatNet : rempli aussi bien depuis
+ * sFrameOfMocapData (callback SDK) que par NatNetDepacketizer (client natif).
+ */
+struct NatNetRigidBodySample {
+    int32_t id        = 0;
+    float   x         = 0.0f;
+    float   y         = 0.0f;
+    float   z         = 0.0f;
+    float   qx        = 0.0f;
+    float   qy        = 0.0f;
+    float   qz        = 0.0f;
+    float   qw        = 1.0f;
+    float   meanError = 0.0f;   // Erreur moyenne marqueurs (m)
+    int16_t params    = 0;      // bit 0 : tracking valide
+};
+
+/**
+ * @brief Instantané d'une frame NatNet, copié tel quel par le thread réseau/SDK
+ *
+ * Taille fixe (pas d'allocation) : les emplacements sont préalloués dans la file
+ * lock-free d'OptiTrackSystem et remplis en place. Toute la conversion
+ * (mm, Euler, qualité, statistiques) se fait ensuite dans le worker applicatif.
+ * Rigid bodies seulement : les marqueurs ne sont pas copiés (aucun consommateur),
+ * pour garder la copie du callback minimale.
+ */
+struct NatNetFrameSnapshot {
+    static constexpr int kMaxRigidBodies = 256;   // = MAX_RIGIDBODIES (NatNetTypes.h)
+
+    int32_t  frameNumber                = 0;
+    double   timestamp                  = 0.0;    // s, horloge Motive
+    uint64_t cameraMidExposureTimestamp = 0;      // ticks horloge haute résolution hôte
+    uint64_t transmitTimestamp          = 0;
+    int16_t  params                     = 0;      // bit 1 : liste des modèles modifiée
+
+    // Mesures prises à la réception (thread réseau/SDK)
+    int64_t  hostReceiveUs     = 0;               // µs, horloge monotone locale
+    double   latencyMs         = 0.0;
+    bool     latencyFromCamera = false;           // true = latence A→E, false = D→E
+
+    int32_t               rigidBodyCount = 0;
+    NatNetRigidBodySample rigidBodies[kMaxRigidBodies];
+};
+
+#endif // NATNETFRAMEDATA_H
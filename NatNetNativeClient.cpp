@@ -0,0 +1,269 @@
+#include "NatNetNativeClient.h"
+
+namespace {
+
+constexpr int kHandshakeAttempts = 3;
+constexpr std::chrono::milliseconds kKeepAliveInterval(1000);
+
+int remainingMs(std::chrono::steady_clock::time_point deadline)
+{
+    const auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+        deadline - std::chrono::steady_clock::now()).count();
+    return left > 0 ? static_cast<int>(left) : 0;
+}
+
+} // namespace
+
+NatNetNativeClient::~NatNetNativeClient()
+{
+    disconnect();
+}
+
+// =============================================================================
+// Connexion
+// =============================================================================
+
+bool NatNetNativeClient::connect(const Settings& settings)
+{
+    disconnect();
+    m_settings = settings;
+    m_lastError.clear();
+
+    // Socket de commande sur port éphémère ; en unicast, il reçoit aussi les frames
+    m_commandSocket = std::make_unique<NativeUdpSocket>(settings.localAddress, 0, settings.recvBufferSize);
+    m_commandSocket->setCapture(settings.capture);
+    if (!m_commandSocket->open() || !m_commandSocket->bind()) {
+        m_lastError = "Cannot open NatNet command socket on " + settings.localAddress;
+        disconnect();
+        return false;
+    }
+
+    if (!handshake()) {
+        disconnect();
+        return false;
+    }
+
+    // Le serveur (NatNet 3+) annonce son mode de diffusion : il prime sur les réglages
+    if (m_serverInfo.connectionInfoValid) {
+        m_settings.multicast = m_serverInfo.multicast;
+        m_settings.dataPort  = m_serverInfo.dataPort;
+        if (m_serverInfo.multicast)
+            m_settings.multicastAddress = m_serverInfo.multicastAddress;
+    }
+
+    if (m_settings.multicast) {
+        m_dataSocket = std::make_unique<NativeUdpSocket>("0.0.0.0", m_settings.dataPort, settings.recvBufferSize);
+        m_dataSocket->setCapture(settings.capture);
+        if (!m_dataSocket->open()
+            || !m_dataSocket->setReuseAddress(true)
+            || !m_dataSocket->bind()
+            || !m_dataSocket->joinMulticastGroup(m_settings.multicastAddress, m_settings.localAddress)) {
+            m_lastError = "Cannot join NatNet multicast group " + m_settings.multicastAddress
+                        + ":" + std::to_string(m_settings.dataPort);
+            disconnect();
+            return false;
+        }
+    }
+
+    m_lastKeepAlive = std::chrono::steady_clock::now();
+    m_connected = true;
+    return true;
+}
+
+void NatNetNativeClient::disconnect()
+{
+    if (m_connected) {
+        char packet[NatNetProtocol::kHeaderSize];
+        const int length = NatNetDepacketizer::buildRequest(packet, sizeof(packet), NatNetProtocol::Disconnect);
+        sendCommand(packet, length);
+    }
+
+    m_dataSocket.reset();
+    m_commandSocket.reset();
+    m_connected = false;
+    m_payloadSize = 0;
+
+    std::lock_guard<std::mutex> locker(m_modelsMutex);
+    m_rigidBodies.clear();
+}
+
+bool NatNetNativeClient::handshake()
+{
+    char request[NatNetProtocol::kHeaderSize + 512];
+    const int requestLength = NatNetDepacketizer::buildConnect(request, sizeof(request), m_settings.requestedVersion);
+
+    for (int attempt = 0; attempt < kHandshakeAttempts; ++attempt) {
+        if (!sendCommand(request, requestLength)) {
+            m_lastError = "Cannot send NAT_CONNECT to " + m_settings.serverAddress;
+            return false;
+        }
+
+        const auto deadline = std::chrono::steady_clock::now()
+            + std::chrono::milliseconds(m_settings.timeoutMs);
+        while (m_commandSocket->waitForData(remainingMs(deadline))) {
+            u_short port = 0;
+            const int length = m_commandSocket->recvFrom(m_packet, sizeof(m_packet),
+                m_senderIp, sizeof(m_senderIp), port);
+
+            uint16_t messageId = 0;
+            int payloadSize = 0;
+            if (length <= 0 || !NatNetDepacketizer::readHeader(m_packet, length, messageId, payloadSize))
+                continue;
+            if (messageId != NatNetProtocol::ServerInfo)
+                continue;
+
+            if (!NatNetDepacketizer::parseServerInfo(m_packet + NatNetProtocol::kHeaderSize,
+                    payloadSize, m_serverInfo)) {
+                m_lastError = "Malformed NAT_SERVERINFO";
+                return false;
+            }
+
+            // Flux à la version demandée si le serveur la supporte, sinon à la sienne
+            const NatNetVersion& server = m_serverInfo.natNetVersion;
+            m_streamVersion = server.atLeast(m_settings.requestedVersion.major, m_settings.requestedVersion.minor)
+                ? m_settings.requestedVersion
+                : server;
+
+            if (!m_streamVersion.atLeast(3, 0)) {
+                m_lastError = "NatNet " + std::to_string(server.major) + "." + std::to_string(server.minor)
+                            + " not supported (3.0 or later required)";
+                return false;
+            }
+            return true;
+        }
+    }
+
+    m_lastError = "No NAT_SERVERINFO from " + m_settings.serverAddress + ":"
+                + std::to_string(m_settings.commandPort);
+    return false;
+}
+
+bool NatNetNativeClient::sendCommand(const char* packet, int length)
+{
+    if (!m_commandSocket || length <= 0)
+        return false;
+    return m_commandSocket->sendTo(packet, length, m_settings.serverAddress, m_settings.commandPort) == length;
+}
+
+double NatNetNativeClient::ticksToMs(uint64_t ticks) const
+{
+    const uint64_t frequency = m_serverInfo.highResClockFrequency;
+    return frequency > 0 ? static_cast<double>(ticks) * 1000.0 / static_cast<double>(frequency) : 0.0;
+}
+
+// =============================================================================
+// Descriptions
+// =============================================================================
+
+bool NatNetNativeClient::fetchModelDefinitions(int timeoutMs)
+{
+    if (!requestModelDefinitions())
+        return false;
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    while (m_commandSocket->waitForData(remainingMs(deadline))) {
+        u_short port = 0;
+        const int length = m_commandSocket->recvFrom(m_packet, sizeof(m_packet),
+            m_senderIp, sizeof(m_senderIp), port);
+        if (length > 0 && handlePacket(length) == Message::ModelDef)
+            return true;
+    }
+
+    m_lastError = "No NAT_MODELDEF from " + m_settings.serverAddress;
+    return false;
+}
+
+bool NatNetNativeClient::requestModelDefinitions()
+{
+    char packet[NatNetProtocol::kHeaderSize];
+    const int length = NatNetDepacketizer::buildRequest(packet, sizeof(packet), NatNetProtocol::RequestModelDef);
+    return sendCommand(packet, length);
+}
+
+std::vector<NatNetRigidBodyDescription> NatNetNativeClient::rigidBodyDescriptions() const
+{
+    std::lock_guard<std::mutex> locker(m_modelsMutex);
+    return m_rigidBodies;
+}
+
+// =============================================================================
+// Réception
+// =============================================================================
+
+NatNetNativeClient::Message NatNetNativeClient::receive(int timeoutMs)
+{
+    if (!m_connected)
+        return Message::Invalid;
+
+    sendKeepAliveIfDue();
+
+    NativeUdpSocket* sockets[2] = { m_dataSocket.get(), m_commandSocket.get() };
+    const int ready = NativeUdpSocket::waitForAny(sockets, 2, timeoutMs);
+    if (ready < 0)
+        return Message::None;
+
+    u_short port = 0;
+    const int length = sockets[ready]->recvFrom(m_packet, sizeof(m_packet),
+        m_senderIp, sizeof(m_senderIp), port);
+    if (length <= 0)
+        return Message::Invalid;
+
+    return handlePacket(length);
+}
+
+bool NatNetNativeClient::decodeFrame(NatNetFrameSnapshot& frame) const
+{
+    uint16_t messageId = 0;
+    int payloadSize = 0;
+    if (m_payloadSize <= 0
+        || !NatNetDepacketizer::readHeader(m_packet, m_payloadSize + NatNetProtocol::kHeaderSize, messageId, payloadSize)
+        || messageId != NatNetProtocol::FrameOfData)
+        return false;
+
+    return NatNetDepacketizer::parseFrameOfData(m_packet + NatNetProtocol::kHeaderSize,
+        payloadSize, m_streamVersion, frame);
+}
+
+NatNetNativeClient::Message NatNetNativeClient::handlePacket(int length)
+{
+    uint16_t messageId = 0;
+    int payloadSize = 0;
+    m_payloadSize = 0;
+    if (!NatNetDepacketizer::readHeader(m_packet, length, messageId, payloadSize))
+        return Message::Invalid;
+    m_payloadSize = payloadSize;
+
+    switch (messageId) {
+    case NatNetProtocol::FrameOfData:
+        return Message::FrameOfData;
+
+    case NatNetProtocol::ModelDef: {
+        std::vector<NatNetRigidBodyDescription> bodies;
+        if (!NatNetDepacketizer::parseModelDef(m_packet + NatNetProtocol::kHeaderSize,
+                payloadSize, m_streamVersion, bodies))
+            return Message::Invalid;
+        std::lock_guard<std::mutex> locker(m_modelsMutex);
+        m_rigidBodies.swap(bodies);
+        return Message::ModelDef;
+    }
+
+    default:
+        return Message::Other;
+    }
+}
+
+void NatNetNativeClient::sendKeepAliveIfDue()
+{
+    // En unicast, le serveur cesse d'émettre vers un client silencieux
+    if (m_settings.multicast)
+        return;
+
+    const auto now = std::chrono::steady_clock::now();
+    if (now - m_lastKeepAlive < kKeepAliveInterval)
+        return;
+    m_lastKeepAlive = now;
+
+    char packet[NatNetProtocol::kHeaderSize];
+    const int length = NatNetDepacketizer::buildRequest(packet, sizeof(packet), NatNetProtocol::KeepAlive);
+    sendCommand(packet, length);
+}
@@ -0,0 +1,118 @@
+#pragma once
+#ifndef NATNETNATIVECLIENT_H
+#define NATNETNATIVECLIENT_H
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "NativeUdpSocket.h"
+#include "NatNetDepacketizer.h"
+
+/**
+ * @brief Client NatNet intégré : flux de données Motive sans NatNetClient (SDK)
+ *
+ * Port de commande : NAT_CONNECT → NAT_SERVERINFO (version de flux, port de
+ * données, groupe multicast), requêtes de descriptions (NAT_REQUEST_MODELDEF).
+ * Port de données : multicast (groupe rejoint par NativeUdpSocket) ou unicast
+ * (frames reçues sur le socket de commande, entretenu par NAT_KEEPALIVE).
+ *
+ * Sans SDK ni Qt : se compile sous Windows (Winsock) comme sous Linux, par ex.
+ *   g++ -std=c++17 -c NatNetNativeClient.cpp NatNetDepacketizer.cpp NativeUdpSocket.cpp DatagramCapture.cpp
+ * et se teste contre des paquets capturés ou un serveur de substitution local.
+ *
+ * Threads : connect / fetchModelDefinitions / disconnect hors réception ;
+ * receive / decodeFrame depuis un unique thread de réception ;
+ * requestModelDefinitions et rigidBodyDescriptions depuis n'importe quel thread.
+ */
+class NatNetNativeClient {
+public:
+    struct Settings {
+        std::string   serverAddress    = "127.0.0.1";
+        std::string   localAddress     = "0.0.0.0";
+        std::string   multicastAddress = NatNetProtocol::kDefaultMulticastAddress;
+        uint16_t      commandPort      = NatNetProtocol::kDefaultCommandPort;
+        uint16_t      dataPort         = NatNetProtocol::kDefaultDataPort;
+        bool          multicast        = true;
+        NatNetVersion requestedVersion { 4, 1, 0, 0 };
+        int           timeoutMs        = 1000;   // Par tentative de poignée de main
+        int           recvBufferSize   = 4 * 1024 * 1024;
+
+        // Capture pcap de tous les paquets reçus, poignée de main comprise (nullptr = aucune)
+        std::shared_ptr<DatagramCapture> capture;
+    };
+
+    enum class Message {
+        None,           // Délai écoulé
+        FrameOfData,    // Frame prête pour decodeFrame()
+        ModelDef,       // Descriptions mises à jour (rigidBodyDescriptions)
+        Other,          // Message de service (traité ou ignoré)
+        Invalid         // Paquet tronqué / inconnu
+    };
+
+    NatNetNativeClient() = default;
+    ~NatNetNativeClient();
+
+    NatNetNativeClient(const NatNetNativeClient&) = delete;
+    NatNetNativeClient& operator=(const NatNetNativeClient&) = delete;
+
+    // ========== Connexion ==========
+
+    bool connect(const Settings& settings);
+    void disconnect();
+    bool isConnected() const { return m_connected; }
+
+    const NatNetServerInfo& serverInfo() const { return m_serverInfo; }
+    const NatNetVersion&    streamVersion() const { return m_streamVersion; }
+    const std::string&      lastError() const { return m_lastError; }
+
+    /** @brief Ticks de l'horloge haute résolution du serveur → ms (0 si fréquence inconnue) */
+    double ticksToMs(uint64_t ticks) const;
+
+    // ========== Descriptions ==========
+
+    /** @brief Requête + attente de la réponse (hors réception en cours) */
+    bool fetchModelDefinitions(int timeoutMs);
+
+    /** @brief Requête seule : la réponse est traitée par receive() (Message::ModelDef) */
+    bool requestModelDefinitions();
+
+    std::vector<NatNetRigidBodyDescription> rigidBodyDescriptions() const;
+
+    // ========== Réception (thread de réception) ==========
+
+    /** @brief Attend et lit un paquet ; les messages de service sont traités ici */
+    Message receive(int timeoutMs);
+
+    /** @brief Décode la frame reçue par le dernier receive() directement dans frame */
+    bool decodeFrame(NatNetFrameSnapshot& frame) const;
+
+private:
+    bool handshake();
+    bool sendCommand(const char* packet, int length);
+    Message handlePacket(int length);
+    void sendKeepAliveIfDue();
+
+    Settings      m_settings;
+    bool          m_connected = false;
+    std::string   m_lastError;
+
+    std::unique_ptr<NativeUdpSocket> m_commandSocket;
+    std::unique_ptr<NativeUdpSocket> m_dataSocket;   // nullptr en unicast
+
+    NatNetServerInfo m_serverInfo;
+    NatNetVersion    m_streamVersion;
+
+    // Dernier paquet reçu (thread de réception)
+    char m_packet[NatNetProtocol::kMaxPacketSize + NatNetProtocol::kHeaderSize];
+    int  m_payloadSize = 0;
+    char m_senderIp[64] = {};
+
+    std::chrono::steady_clock::time_point m_lastKeepAlive;
+
+    mutable std::mutex                      m_modelsMutex;
+    std::vector<NatNetRigidBodyDescription> m_rigidBodies;
+};
+
+#endif // NATNETNATIVECLIENT_H
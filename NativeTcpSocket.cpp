@@ -0,0 +1,232 @@
+#include "NativeTcpSocket.h"
+
+std::atomic<uint32_t> NativeTcpSocket::s_instanceCount = 0;
+
+NativeTcpSocket::NativeTcpSocket() :
+	m_socket(INVALID_SOCKET)
+{
+	ensure_wsa_started();
+}
+
+NativeTcpSocket::~NativeTcpSocket()
+{
+	close();
+	maybe_wsa_cleanup();
+}
+
+bool NativeTcpSocket::ensure_wsa_started()
+{
+#ifndef _WIN32
+	return true; // Pas d'initialisation de la pile réseau hors Winsock
+#else
+	uint32_t prev = s_instanceCount.fetch_add(1, std::memory_order_acq_rel);
+	if (prev == 0)
+	{
+		WSADATA wsaData;
+		const int rc = WSAStartup(MAKEWORD(2, 2), &wsaData);
+		if (rc != 0) {
+			s_instanceCount.fetch_sub(1, std::memory_order_acq_rel);
+			return false;
+		}
+	}
+	return true;
+#endif
+}
+
+void NativeTcpSocket::maybe_wsa_cleanup()
+{
+#ifdef _WIN32
+	uint32_t prev = s_instanceCount.fetch_sub(1, std::memory_order_acq_rel);
+	if (prev == 1)
+	{
+		WSACleanup();
+	}
+#endif
+}
+
+bool NativeTcpSocket::setBlocking(SOCKET socket, bool blocking)
+{
+#ifdef _WIN32
+	u_long mode = blocking ? 0 : 1;
+	return ioctlsocket(socket, FIONBIO, &mode) == 0;
+#else
+	const int flags = fcntl(socket, F_GETFL, 0);
+	if (flags < 0)
+		return false;
+	return fcntl(socket, F_SETFL, blocking ? (flags & ~O_NONBLOCK) : (flags | O_NONBLOCK)) == 0;
+#endif
+}
+
+bool NativeTcpSocket::connectTo(const std::string& host, u_short port, int timeoutMs)
+{
+	close();
+
+	addrinfo hints = {};
+	hints.ai_family = AF_INET;
+	hints.ai_socktype = SOCK_STREAM;
+	hints.ai_protocol = IPPROTO_TCP;
+
+	addrinfo* result = nullptr;
+	if (getaddrinfo(host.c_str(), nullptr, &hints, &result) != 0 || !result)
+	{
+		WSASetLastError(WSAEINVAL);
+		return false;
+	}
+	sockaddr_in addr = *reinterpret_cast<sockaddr_in*>(result->ai_addr);
+	freeaddrinfo(result);
+	addr.sin_port = htons(port);
+
+	m_socket = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	if (m_socket == INVALID_SOCKET)
+		return false;
+
+	// Connexion non bloquante : un serveur absent ne fige pas l'appelant (délai système ~20 s)
+	setBlocking(m_socket, false);
+	int rc = ::connect(m_socket, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+	if (rc == SOCKET_ERROR)
+	{
+		const int error = WSAGetLastError();
+		if (error != WSAEWOULDBLOCK && error != WSAEINPROGRESS)
+		{
+			close();
+			return false;
+		}
+
+		fd_set writefds;
+		FD_ZERO(&writefds);
+		FD_SET(m_socket, &writefds);
+		fd_set exceptfds; // Échec de connexion signalé ici sous Winsock
+		FD_ZERO(&exceptfds);
+		FD_SET(m_socket, &exceptfds);
+
+		timeval tv;
+		tv.tv_sec = timeoutMs / 1000;
+		tv.tv_usec = (timeoutMs % 1000) * 1000;
+
+		if (select(static_cast<int>(m_socket) + 1, nullptr, &writefds, &exceptfds, &tv) <= 0
+			|| !FD_ISSET(m_socket, &writefds))
+		{
+			close();
+			WSASetLastError(WSAETIMEDOUT);
+			return false;
+		}
+
+		int soError = 0;
+		socklen_t len = sizeof(soError);
+		getsockopt(m_socket, SOL_SOCKET, SO_ERROR, reinterpret_cast<char*>(&soError), &len);
+		if (soError != 0)
+		{
+			close();
+			WSASetLastError(soError);
+			return false;
+		}
+	}
+	setBlocking(m_socket, true);
+
+	char ipbuf[INET_ADDRSTRLEN] = {};
+	m_peerIp = inet_ntop(AF_INET, &addr.sin_addr, ipbuf, sizeof(ipbuf)) ? ipbuf : host;
+	m_connected = true;
+	return true;
+}
+
+void NativeTcpSocket::close()
+{
+	if (m_socket != INVALID_SOCKET)
+	{
+		closesocket(m_socket);
+		m_socket = INVALID_SOCKET;
+	}
+	m_connected = false;
+}
+
+bool NativeTcpSocket::setNoDelay(bool enable)
+{
+	if (m_socket == INVALID_SOCKET)
+		return false;
+
+	const int value = enable ? 1 : 0;
+	return setsockopt(m_socket, IPPROTO_TCP, TCP_NODELAY,
+		reinterpret_cast<const char*>(&value), sizeof(value)) != SOCKET_ERROR;
+}
+
+bool NativeTcpSocket::setRecvBufferSize(int size)
+{
+	if (m_socket == INVALID_SOCKET)
+		return false;
+
+	return setsockopt(m_socket, SOL_SOCKET, SO_RCVBUF,
+		reinterpret_cast<const char*>(&size), sizeof(size)) != SOCKET_ERROR;
+}
+
+int NativeTcpSocket::sendAll(const char* data, int len)
+{
+	if (m_socket == INVALID_SOCKET || !m_connected)
+	{
+		WSASetLastError(WSAENOTCONN);
+		return SOCKET_ERROR;
+	}
+
+	int sent = 0;
+	while (sent < len)
+	{
+		const int rc = ::send(m_socket, data + sent, len - sent, 0);
+		if (rc <= 0)
+			return SOCKET_ERROR;
+		sent += rc;
+	}
+	return sent;
+}
+
+bool NativeTcpSocket::waitForData(int timeoutMs)
+{
+	return waitForAny(&m_socket, 1, timeoutMs) == 0;
+}
+
+int NativeTcpSocket::recv(char* buffer, int buflen)
+{
+	if (m_socket == INVALID_SOCKET || !m_connected)
+	{
+		WSASetLastError(WSAENOTCONN);
+		return SOCKET_ERROR;
+	}
+
+	const int rc = ::recv(m_socket, buffer, buflen, 0);
+	if (rc == 0)
+		m_connected = false; // Fermeture ordonnée par le pair
+	return rc;
+}
+
+int NativeTcpSocket::waitForAny(const SOCKET* handles, int count, int timeoutMs)
+{
+	fd_set readfds;
+	FD_ZERO(&readfds);
+
+	SOCKET maxFd = 0;
+	bool any = false;
+	for (int i = 0; i < count; ++i)
+	{
+		if (handles[i] == INVALID_SOCKET)
+			continue;
+		FD_SET(handles[i], &readfds);
+		if (handles[i] > maxFd)
+			maxFd = handles[i];
+		any = true;
+	}
+	if (!any)
+		return -1;
+
+	timeval tv;
+	tv.tv_sec = timeoutMs / 1000;
+	tv.tv_usec = (timeoutMs % 1000) * 1000;
+
+	// Sous Winsock, le premier argument de select est ignoré (POSIX : plus grand fd + 1)
+	if (select(static_cast<int>(maxFd) + 1, &readfds, nullptr, nullptr, &tv) <= 0)
+		return -1;
+
+	for (int i = 0; i < count; ++i)
+	{
+		if (handles[i] != INVALID_SOCKET && FD_ISSET(handles[i], &readfds))
+			return i;
+	}
+	return -1;
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include "platform_socket.h"
+
+#include <string>
+#include <atomic>
+#include <cstdint>
+
+// Client TCP minimal, pendant de NativeUdpSocket (Winsock sous Windows, POSIX ailleurs)
+class NativeTcpSocket {
+public:
+    NativeTcpSocket();
+    ~NativeTcpSocket();
+
+    NativeTcpSocket(const NativeTcpSocket&) = delete;
+    NativeTcpSocket& operator=(const NativeTcpSocket&) = delete;
+
+    // Connexion avec délai borné ; host = adresse IPv4 ou nom d'hôte
+    bool connectTo(const std::string& host, u_short port, int timeoutMs);
+    void close();
+
+    bool isConnected() const { return m_connected; }
+
+    // Options (après connectTo())
+    bool setNoDelay(bool enable);
+    bool setRecvBufferSize(int size);
+
+    // Envoi complet : boucle jusqu'à len octets, SOCKET_ERROR en cas d'échec
+    int sendAll(const char* data, int len);
+
+    bool waitForData(int timeoutMs);
+
+    // Réception : octets lus, 0 = connexion fermée par le pair, SOCKET_ERROR sinon
+    int recv(char* buffer, int buflen);
+
+    // Attente sur plusieurs handles (nativeHandle() de NativeTcpSocket ou NativeUdpSocket) :
+    // index du premier prêt, -1 si délai écoulé ; INVALID_SOCKET ignorés
+    static int waitForAny(const SOCKET* handles, int count, int timeoutMs);
+
+    SOCKET nativeHandle() const { return m_socket; }
+    std::string peerIp() const { return m_peerIp; }
+
+private:
+    static bool ensure_wsa_started();
+    static void maybe_wsa_cleanup();
+    static bool setBlocking(SOCKET socket, bool blocking);
+
+private:
+	static std::atomic<uint32_t> s_instanceCount;
+    bool m_connected{ false };
+    SOCKET m_socket;
+    std::string m_peerIp;
+};
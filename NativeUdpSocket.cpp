@@ -1,4 +1,5 @@
 #include "NativeUdpSocket.h"
+#include "DatagramCapture.h"
 
 std::atomic<uint32_t> NativeUdpSocket::s_instanceCount = 0;
 
@@ -30,6 +31,9 @@ NativeUdpSocket::~NativeUdpSocket()
 
 bool NativeUdpSocket::ensure_wsa_started() 
 {
+#ifndef _WIN32
+	return true; // Pas d'initialisation de la pile réseau hors Winsock
+#else
 	uint32_t prev = s_instanceCount.fetch_add(1, std::memory_order_acq_rel);
 	if (prev == 0) 
 	{
@@ -41,15 +45,18 @@ bool NativeUdpSocket::ensure_wsa_started()
 		}
 	}
 	return true;
+#endif
 }
 
 void NativeUdpSocket::maybe_wsa_cleanup() 
 {
+#ifdef _WIN32
 	uint32_t prev = s_instanceCount.fetch_sub(1, std::memory_order_acq_rel);
 	if (prev == 1) 
 	{
 		WSACleanup();
 	}
+#endif
 }
 
 bool NativeUdpSocket::open()
@@ -84,7 +91,46 @@ bool NativeUdpSocket::bind()
 	{
 		return false;
 	}
-	return ::bind(m_socket, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != SOCKET_ERROR;
+	if (::bind(m_socket, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == SOCKET_ERROR)
+		return false;
+	m_captureLocalIp = ntohl(addr.sin_addr.s_addr);
+
+	// Port 0 : récupérer le port éphémère attribué (à communiquer au serveur), sans
+	// écraser le port demandé : une réouverture reprend un nouveau port éphémère
+	m_boundPort = m_localPort;
+	if (m_localPort == 0)
+	{
+		sockaddr_in bound = {};
+		socklen_t len = sizeof(bound);
+		if (getsockname(m_socket, reinterpret_cast<sockaddr*>(&bound), &len) != SOCKET_ERROR)
+			m_boundPort = ntohs(bound.sin_port);
+	}
+	return true;
+}
+
+bool NativeUdpSocket::setReuseAddress(bool enable)
+{
+	if (m_socket == INVALID_SOCKET)
+		return false;
+
+	const int value = enable ? 1 : 0;
+	return setsockopt(m_socket, SOL_SOCKET, SO_REUSEADDR,
+		reinterpret_cast<const char*>(&value), sizeof(value)) != SOCKET_ERROR;
+}
+
+bool NativeUdpSocket::joinMulticastGroup(const std::string& groupIp, const std::string& interfaceIp)
+{
+	if (m_socket == INVALID_SOCKET)
+		return false;
+
+	ip_mreq mreq = {};
+	if (inet_pton(AF_INET, groupIp.c_str(), &mreq.imr_multiaddr) != 1)
+		return false;
+	if (inet_pton(AF_INET, interfaceIp.c_str(), &mreq.imr_interface) != 1)
+		return false;
+
+	return setsockopt(m_socket, IPPROTO_IP, IP_ADD_MEMBERSHIP,
+		reinterpret_cast<const char*>(&mreq), sizeof(mreq)) != SOCKET_ERROR;
 }
 
 void NativeUdpSocket::close()
@@ -96,6 +142,7 @@ void NativeUdpSocket::close()
 	}
 	m_connected = false;
 	m_opened = false;
+	m_boundPort = 0;
 }
 
 int NativeUdpSocket::sendTo(const char* data, int len, const std::string& destIp, u_short destPort)
@@ -133,6 +180,8 @@ bool NativeUdpSocket::connectTo(const char* destIp, u_short destPort)
 	}
 	int rc = ::connect(m_socket, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
 	m_connected = (rc != SOCKET_ERROR);
+	if (m_connected)
+		m_peer = addr;
 	return m_connected;
 }
 
@@ -159,22 +208,59 @@ bool NativeUdpSocket::waitForData(int timeoutMs)
 	tv.tv_sec = timeoutMs / 1000;
 	tv.tv_usec = (timeoutMs % 1000) * 1000;
 
-	// Sous Winsock, le premier argument de select est ignoré
-	int result = select(0, &readfds, nullptr, nullptr, &tv);
+	// Sous Winsock, le premier argument de select est ignoré (POSIX : plus grand fd + 1)
+	int result = select(static_cast<int>(m_socket) + 1, &readfds, nullptr, nullptr, &tv);
 	return (result > 0) && FD_ISSET(m_socket, &readfds);
 }
 
+int NativeUdpSocket::waitForAny(NativeUdpSocket* const* sockets, int count, int timeoutMs)
+{
+	fd_set readfds;
+	FD_ZERO(&readfds);
+
+	SOCKET maxFd = 0;
+	bool any = false;
+	for (int i = 0; i < count; ++i)
+	{
+		if (!sockets[i] || sockets[i]->m_socket == INVALID_SOCKET)
+			continue;
+		FD_SET(sockets[i]->m_socket, &readfds);
+		if (sockets[i]->m_socket > maxFd)
+			maxFd = sockets[i]->m_socket;
+		any = true;
+	}
+	if (!any)
+		return -1;
+
+	timeval tv;
+	tv.tv_sec = timeoutMs / 1000;
+	tv.tv_usec = (timeoutMs % 1000) * 1000;
+
+	if (select(static_cast<int>(maxFd) + 1, &readfds, nullptr, nullptr, &tv) <= 0)
+		return -1;
+
+	for (int i = 0; i < count; ++i)
+	{
+		if (sockets[i] && sockets[i]->m_socket != INVALID_SOCKET && FD_ISSET(sockets[i]->m_socket, &readfds))
+			return i;
+	}
+	return -1;
+}
+
 int NativeUdpSocket::recvFrom(char* buffer, int buflen, char* senderIp, int senderIpCap, u_short& senderPort)
 {
 	if (m_socket == INVALID_SOCKET)
 		return SOCKET_ERROR;
 
 	sockaddr_in from = {};
-	int fromlen = sizeof(from);
+	socklen_t fromlen = sizeof(from);
 
 	int ret = recvfrom(m_socket, buffer, buflen, 0, reinterpret_cast<sockaddr*>(&from), &fromlen);
 	if (ret > 0)
 	{
+		if (m_capture)
+			captureReceived(buffer, ret, from);
+
 		// Write sender IP to senderIp buffer
 		if (inet_ntop(AF_INET, &from.sin_addr, senderIp, senderIpCap) == nullptr)
 		{
@@ -193,11 +279,14 @@ int NativeUdpSocket::recvFrom(char* buffer, int buflen, std::string& senderIp, u
 		return SOCKET_ERROR;
 
 	sockaddr_in from = {};
-	int fromlen = sizeof(from);
+	socklen_t fromlen = sizeof(from);
 
 	int ret = recvfrom(m_socket, buffer, buflen, 0, reinterpret_cast<sockaddr*>(&from), &fromlen);
 	if (ret > 0)
 	{
+		if (m_capture)
+			captureReceived(buffer, ret, from);
+
 		char ipbuf[INET_ADDRSTRLEN] = {};
 		if (inet_ntop(AF_INET, &from.sin_addr, ipbuf, sizeof(ipbuf)) != nullptr)
 		{
@@ -219,5 +308,27 @@ int NativeUdpSocket::recv(char* buffer, int buflen)
 		WSASetLastError(WSAENOTCONN);
 		return SOCKET_ERROR;
 	}
-	return ::recv(m_socket, buffer, buflen, 0);
+	const int ret = ::recv(m_socket, buffer, buflen, 0);
+	if (ret > 0 && m_capture)
+		captureReceived(buffer, ret, m_peer);
+	return ret;
+}
+
+void NativeUdpSocket::setCapture(std::shared_ptr<DatagramCapture> capture)
+{
+	m_capture = std::move(capture);
+
+	// Destination des paquets capturés : adresse locale liée (0.0.0.0 si toutes interfaces),
+	// convertie une fois ici plutôt qu'à chaque datagramme
+	in_addr local = {};
+	if (inet_pton(AF_INET, m_localIp.c_str(), &local) != 1)
+		local.s_addr = 0;
+	m_captureLocalIp = ntohl(local.s_addr);
+}
+
+void NativeUdpSocket::captureReceived(const char* data, int len, const sockaddr_in& from) const
+{
+	m_capture->record(data, len,
+		ntohl(from.sin_addr.s_addr), ntohs(from.sin_port),
+		m_captureLocalIp, localPort());
 }
@@ -1,8 +1,12 @@
 #pragma once
-#include "platform_windows.h"
+#include "platform_socket.h"
 
 #include <string>
 #include <atomic>
+#include <cstdint>
+#include <memory>
+
+class DatagramCapture;
 
 class NativeUdpSocket {
 public:
@@ -20,6 +24,12 @@ public:
     bool bind();
     void close();
 
+    // Plusieurs récepteurs sur le même port (multicast) : à appeler avant bind()
+    bool setReuseAddress(bool enable);
+
+    // Abonnement à un groupe multicast (après bind()), interface locale "0.0.0.0" = défaut
+    bool joinMulticastGroup(const std::string& groupIp, const std::string& interfaceIp = "0.0.0.0");
+
 	bool isOpened() const { return m_opened; }
 	bool isConnected() const { return m_connected; }
 
@@ -33,6 +43,9 @@ public:
 
     bool waitForData(int timeoutMs);
 
+    // Attente sur plusieurs sockets : index du premier prêt, -1 si délai écoulé
+    static int waitForAny(NativeUdpSocket* const* sockets, int count, int timeoutMs);
+
     // Réception: version qui retourne l'expéditeur
     int recvFrom(char* buffer, int buflen, char* senderIp, int senderIpCap, u_short& senderPort);
     int recvFrom(char* buffer, int buflen, std::string& senderIp, u_short& senderPort);
@@ -40,20 +53,31 @@ public:
     // Réception simplifiée en mode "connecté"
     int recv(char* buffer, int buflen);
 
+    // Capture brute (pcap) de chaque datagramme reçu ; nullptr = désactivée
+    void setCapture(std::shared_ptr<DatagramCapture> capture);
+
     // Getters
     std::string localIp() const { return m_localIp; }
-    u_short localPort() const { return m_localPort; }
+    // Port lié (éphémère attribué si demandé 0), sinon port demandé
+    u_short localPort() const { return m_boundPort != 0 ? m_boundPort : m_localPort; }
+    SOCKET nativeHandle() const { return m_socket; }
 
 private:
     static bool ensure_wsa_started();
     static void maybe_wsa_cleanup();
 
+    void captureReceived(const char* data, int len, const sockaddr_in& from) const;
+
 private:
 	static std::atomic<uint32_t> s_instanceCount;
     int m_recvBufferSize{ 0 };
     bool m_opened{ false };
     bool m_connected{ false };
-    u_short m_localPort;
+    u_short m_localPort;                            // Demandé ; 0 = éphémère à chaque bind()
+    u_short m_boundPort{ 0 };                       // Attribué par le dernier bind()
     SOCKET m_socket;
     std::string m_localIp;
+    sockaddr_in m_peer{};                           // Pair de connectTo() (capture de recv)
+    std::shared_ptr<DatagramCapture> m_capture;
+    uint32_t m_captureLocalIp{ 0 };                 // m_localIp, ordre de l'hôte (setCapture / bind)
 };
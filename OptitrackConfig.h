@@ -24,6 +24,9 @@ struct OptiTrackConfig {
     // Acquisition
     int rigidBodyId = -1;                   // ID du rigid body (-1 = premier trouv)
     QString rigidBodyName = "";             // Nom du rigid body (prioritaire sur ID)
+    bool captureAllBodies = false;          // Tous les rigid bodies de chaque frame (RigidBodyBatch)
+    bool useNativeTransport = false;        // Client NatNet intgr (NatNetNativeClient) au lieu du SDK
+    QString captureFile = "";               // Capture pcap des paquets reus (transport intgr, vide = aucune)
 
     // Options
     bool enableLogging = false;             // Activer les logs SDK
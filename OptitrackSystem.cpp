@@ -1,19 +1,32 @@
 #include "OptiTrackSystem.h"
+#include "EulerBatch.h"
+#include "DatagramCapture.h"
+#include "TraceRecorder.h"
+#include "Profiler.h"
 #include <QDebug>
 #include <cmath>
 
 OptiTrackSystem::OptiTrackSystem(QObject* parent)
     : IMeasurementSystem(parent)
     , m_pClient(nullptr)
-    , m_isConnected(false)
     , m_latency(0.0)
     , m_frequency(0.0)
     , m_lastFrameTime(0)
     , m_frameCount(0)
     , m_logFile(nullptr)
     , m_currentRigidBodyId(-1)
+    , m_snapshotQueue(kSnapshotQueueCapacity)
+    , m_workerRunning(false)
+    , m_queueOverflows(0)
+    , m_lastFrameNumber(-1)
+    , m_receiverThread(nullptr)
+    , m_directoryReady(false)
+    , m_directoryStale(false)
+    , m_directoryThread(nullptr)
+    , m_receiverRunning(false)
 {
     initializeCapabilities();
+    m_batch.systemName = "OptiTrack";
     m_timer.start();
 }
 
@@ -55,44 +68,64 @@ bool OptiTrackSystem::connect(const ConnectionConfig& config)
         disconnect();
     }
 
-    if (!m_pClient) {
-        if (!initialize()) return false;
-    }
-
     emit logMessage(QString("Connecting to OptiTrack server: %1:%2")
         .arg(config.serverAddress).arg(config.port));
 
-    m_connectParams.connectionType   = kDefaultConnectionType;
-    m_connectParams.serverAddress    = config.serverAddress.isEmpty()
-        ? nullptr : config.serverAddress.toStdString().c_str();
-    m_connectParams.localAddress     = nullptr;
-    m_connectParams.multicastAddress = m_optitrackConfig.multicastAddress.toStdString().c_str();
+    m_optitrackConfig.useNativeTransport = config.customParams
+        .value("nativeTransport", m_optitrackConfig.useNativeTransport).toBool();
 
-    ErrorCode ret = m_pClient->Connect(m_connectParams);
-    if (ret != ErrorCode_OK) {
-        emit errorOccurred(QString("Failed to connect to OptiTrack server (error code: %1)")
-            .arg(static_cast<int>(ret)));
-        return false;
+    if (m_optitrackConfig.useNativeTransport) {
+        if (!connectNative(config)) return false;
     }
+    else {
+        if (!m_pClient) {
+            if (!initialize()) return false;
+        }
 
-    memset(&m_serverDescription, 0, sizeof(m_serverDescription));
-    ret = m_pClient->GetServerDescription(&m_serverDescription);
-    if (ret != ErrorCode_OK) {
-        emit logMessage("Warning: Could not get server description");
+        m_connectParams.connectionType   = kDefaultConnectionType;
+        m_connectParams.serverAddress    = config.serverAddress.isEmpty()
+            ? nullptr : config.serverAddress.toStdString().c_str();
+        m_connectParams.localAddress     = nullptr;
+        m_connectParams.multicastAddress = m_optitrackConfig.multicastAddress.toStdString().c_str();
+
+        ErrorCode ret = m_pClient->Connect(m_connectParams);
+        if (ret != ErrorCode_OK) {
+            emit errorOccurred(QString("Failed to connect to OptiTrack server (error code: %1)")
+                .arg(static_cast<int>(ret)));
+            return false;
+        }
+
+        memset(&m_serverDescription, 0, sizeof(m_serverDescription));
+        ret = m_pClient->GetServerDescription(&m_serverDescription);
+        if (ret != ErrorCode_OK) {
+            emit logMessage("Warning: Could not get server description");
+        }
+        else {
+            const QString version = QString("NatNet %1.%2.%3.%4")
+                .arg(m_serverDescription.NatNetVersion[0])
+                .arg(m_serverDescription.NatNetVersion[1])
+                .arg(m_serverDescription.NatNetVersion[2])
+                .arg(m_serverDescription.NatNetVersion[3]);
+            {
+                // Lu par l'UI pendant que connect() tourne dans un thread de l'orchestrateur
+                QMutexLocker locker(&m_frameMutex);
+                m_capabilities.version = version;
+            }
+            emit logMessage(QString("Connected to: %1 (NatNet %2.%3)")
+                .arg(m_serverDescription.szHostComputerName)
+                .arg(m_serverDescription.NatNetVersion[0])
+                .arg(m_serverDescription.NatNetVersion[1]));
+        }
     }
-    else {
-        m_capabilities.version = QString("NatNet %1.%2.%3.%4")
-            .arg(m_serverDescription.NatNetVersion[0])
-            .arg(m_serverDescription.NatNetVersion[1])
-            .arg(m_serverDescription.NatNetVersion[2])
-            .arg(m_serverDescription.NatNetVersion[3]);
-        emit logMessage(QString("Connected to: %1 (NatNet %2.%3)")
-            .arg(m_serverDescription.szHostComputerName)
-            .arg(m_serverDescription.NatNetVersion[0])
-            .arg(m_serverDescription.NatNetVersion[1]));
-    }
-
-    m_currentRigidBodyName = config.objectName;
+
+    m_currentRigidBodyName           = config.objectName;
+    m_optitrackConfig.rigidBodyName  = config.objectName;
+    m_optitrackConfig.rigidBodyId    = config.objectId;
+    m_optitrackConfig.captureAllBodies = config.customParams
+        .value("captureAllBodies", m_optitrackConfig.captureAllBodies).toBool();
+    loadDirectory();
+    resolveCurrentBody();
+
     m_isConnected = true;
     emit connected();
     emit logMessage("OptiTrack connected successfully");
@@ -105,7 +138,8 @@ bool OptiTrackSystem::disconnect()
 
     emit logMessage("Disconnecting from OptiTrack...");
     if (m_isAcquiring) stopAcquisition();
-    if (m_pClient)     m_pClient->Disconnect();
+    if (m_nativeClient) m_nativeClient.reset();     // Envoie NAT_DISCONNECT
+    else if (m_pClient) m_pClient->Disconnect();
 
     m_isConnected = false;
     emit disconnected();
@@ -134,8 +168,55 @@ bool OptiTrackSystem::startAcquisition()
 
     // ✅ Réinitialiser les statistiques de session
     resetSessionStats();
+    m_frequency       = 0.0;
+    m_lastFrameTime   = 0;
+    m_lastFrameNumber = -1;
+    m_queueOverflows  = 0;
+
+    // Modèles éventuellement modifiés dans Motive depuis la connexion
+    // (transport natif : requête synchrone, le thread de réception n'est pas encore lancé)
+    if (m_nativeClient && !m_nativeClient->fetchModelDefinitions(1000))
+        emit logMessage("Warning: Could not refresh OptiTrack data descriptions");
+    loadDirectory();
+    resolveCurrentBody();
+    if (m_optitrackConfig.captureAllBodies) {
+        emit logMessage(QString("OptiTrack multi-body capture: %1 rigid body description(s)")
+            .arg(m_directory.size()));
+    }
+
+    // Instantanés restés en file après l'arrêt précédent (worker arrêté : accès exclusif)
+    while (m_snapshotQueue.front())
+        m_snapshotQueue.popFront();
+
+    // Annuaire déposé après l'arrêt précédent : périmé, celui de loadDirectory() fait foi
+    {
+        QMutexLocker locker(&m_directoryMutex);
+        m_pendingDirectory.reset();
+    }
+    m_directoryReady = false;
+    m_directoryStale = false;
+    m_directoryRequests.tryAcquire(m_directoryRequests.available());
+
+    // Réception par le callback SDK ou par le thread natif ; le traitement part dans le worker
+    m_workerRunning = true;
+    m_acquisitionThread = QThread::create([this]() { processingLoop(); });
+    m_acquisitionThread->moveToThread(thread());
+    m_acquisitionThread->setObjectName(QStringLiteral("OptiTrackWorker"));
+    m_acquisitionThread->start(QThread::HighPriority);
+
+    m_directoryThread = QThread::create([this]() { directoryLoop(); });
+    m_directoryThread->moveToThread(thread());
+    m_directoryThread->setObjectName(QStringLiteral("OptiTrackDirectory"));
+    m_directoryThread->start();
+
+    if (m_nativeClient) {
+        m_receiverRunning = true;
+        m_receiverThread = QThread::create([this]() { nativeReceiveLoop(); });
+        m_receiverThread->moveToThread(thread());
+        m_receiverThread->setObjectName(QStringLiteral("OptiTrackReceiver"));
+        m_receiverThread->start(QThread::TimeCriticalPriority);
+    }
 
-    // Pas de thread à créer, le SDK gère via callback
     m_isAcquiring = true;
     emit logMessage("OptiTrack acquisition started");
     return true;
@@ -148,6 +229,28 @@ bool OptiTrackSystem::stopAcquisition()
     emit logMessage("Stopping OptiTrack acquisition...");
     m_isAcquiring = false;
 
+    // Producteur arrêté d'abord : plus aucune écriture pendant la vidange finale
+    stopNativeReceiver();
+
+    // Le worker vide la file avant de sortir : le résumé inclut toutes les frames reçues
+    m_workerRunning = false;
+    m_snapshotsReady.release();
+    m_directoryRequests.release();
+    if (m_acquisitionThread) {
+        m_acquisitionThread->wait(3000);
+        delete m_acquisitionThread;
+        m_acquisitionThread = nullptr;
+    }
+    if (m_directoryThread) {
+        m_directoryThread->wait(3000);      // Un rechargement en cours se termine d'abord
+        delete m_directoryThread;
+        m_directoryThread = nullptr;
+    }
+
+    const quint64 overflows = m_queueOverflows.load();
+    if (overflows > 0)
+        emit logMessage(QString("OptiTrack worker queue overflowed: %1 frame(s) dropped").arg(overflows));
+
     // ✅ Émettre le résumé de session
     AcquisitionSummary summary = buildSummary(m_currentRigidBodyName);
     emit acquisitionCompleted(summary);
@@ -171,7 +274,9 @@ MeasurementFrame OptiTrackSystem::getLatestFrame() const
 
 double OptiTrackSystem::getNativeFrequency() const
 {
-    return m_frequency > 0.0 ? m_frequency : m_capabilities.maxNativeFrequency;
+    if (m_frequency > 0.0) return m_frequency;
+    QMutexLocker locker(&m_frameMutex);
+    return m_capabilities.maxNativeFrequency;
 }
 
 double OptiTrackSystem::getLatency() const
@@ -181,51 +286,310 @@ double OptiTrackSystem::getLatency() const
 
 QStringList OptiTrackSystem::getAvailableObjects() const
 {
-    QStringList objects;
-    if (!m_isConnected || !m_pClient) return objects;
+    if (!m_isConnected) return QStringList();
 
-    sDataDescriptions* pDataDefs = nullptr;
-    ErrorCode ret = m_pClient->GetDataDescriptionList(&pDataDefs);
-    if (ret == ErrorCode_OK && pDataDefs) {
-        for (int i = 0; i < pDataDefs->nDataDescriptions; i++) {
-            if (pDataDefs->arrDataDescriptions[i].type == Descriptor_RigidBody) {
-                sRigidBodyDescription* rb =
-                    pDataDefs->arrDataDescriptions[i].Data.RigidBodyDescription;
-                objects << QString::fromUtf8(rb->szName);
-            }
-        }
-        NatNet_FreeDescriptions(pDataDefs);
-    }
-    return objects;
+    // Copie de l'annuaire en cache : pas d'aller-retour serveur à chaque appel
+    QMutexLocker locker(&m_directoryMutex);
+    return m_availableObjects;
 }
 
 // ========== Capacités ==========
 
-SystemCapabilities OptiTrackSystem::getCapabilities() const { return m_capabilities; }
-QString OptiTrackSystem::getSystemName()    const { return "OptiTrack"; }
-QString OptiTrackSystem::getSystemVersion() const { return m_capabilities.version; }
+SystemCapabilities OptiTrackSystem::getCapabilities() const
+{
+    QMutexLocker locker(&m_frameMutex);
+    return m_capabilities;
+}
+
+QString OptiTrackSystem::getSystemName() const { return "OptiTrack"; }
+
+QString OptiTrackSystem::getSystemVersion() const
+{
+    QMutexLocker locker(&m_frameMutex);
+    return m_capabilities.version;
+}
 
 IMeasurementSystem::ThreadingModel OptiTrackSystem::getThreadingModel() const
 {
-    return ThreadingModel::SdkManaged; // SDK gère le thread via callback
+    // SDK : thread de réception du SDK (callback) ; natif : thread de réception applicatif
+    return m_nativeClient ? ThreadingModel::ApplicationManaged : ThreadingModel::SdkManaged;
 }
 
 // ========== Découverte / connexion serveur ==========
 
-int OptiTrackSystem::discoverServers()
+int OptiTrackSystem::discoverServers(int timeoutMs, int minServers)
 {
     emit logMessage("Discovering OptiTrack servers on network...");
-    m_discoveredServers.clear();
+    {
+        QMutexLocker locker(&m_discoveryMutex);
+        m_discoveredServers.clear();
+    }
+    m_discoveryReplies.tryAcquire(m_discoveryReplies.available());
+
+    QElapsedTimer clock;
+    clock.start();
+
     NatNetDiscoveryHandle discovery;
     NatNet_CreateAsyncServerDiscovery(&discovery, serverDiscoveredCallback, this);
-    QThread::msleep(2000);
+
+    // Un jeton par réponse : réveil dès la minServers-ième, sinon à l'échéance
+    int found = 0;
+    while (found < minServers) {
+        const qint64 remaining = timeoutMs - clock.elapsed();
+        if (remaining <= 0 || !m_discoveryReplies.tryAcquire(1, static_cast<int>(remaining)))
+            break;
+        ++found;
+    }
     NatNet_FreeAsyncServerDiscovery(discovery);
-    emit logMessage(QString("Found %1 OptiTrack server(s)").arg(m_discoveredServers.size()));
-    return static_cast<int>(m_discoveredServers.size());
+
+    int count = 0;
+    {
+        QMutexLocker locker(&m_discoveryMutex);
+        count = static_cast<int>(m_discoveredServers.size());
+    }
+    emit logMessage(QString("Found %1 OptiTrack server(s) in %2 ms").arg(count).arg(clock.elapsed()));
+    return count;
+}
+
+// ========== Capture multi-corps ==========
+
+void OptiTrackSystem::setCaptureAllBodies(bool enabled)
+{
+    m_optitrackConfig.captureAllBodies = enabled;
+}
+
+bool OptiTrackSystem::captureAllBodies() const
+{
+    return m_optitrackConfig.captureAllBodies;
+}
+
+// ========== Transport natif ==========
+
+void OptiTrackSystem::setNativeTransport(bool enabled)
+{
+    m_optitrackConfig.useNativeTransport = enabled;
+}
+
+bool OptiTrackSystem::nativeTransport() const
+{
+    return m_optitrackConfig.useNativeTransport;
+}
+
+bool OptiTrackSystem::connectNative(const ConnectionConfig& config)
+{
+    NatNetNativeClient::Settings settings;
+    if (!config.serverAddress.isEmpty())
+        settings.serverAddress = config.serverAddress.toStdString();
+    if (!m_optitrackConfig.localAddress.isEmpty())
+        settings.localAddress = m_optitrackConfig.localAddress.toStdString();
+    settings.commandPort = static_cast<uint16_t>(config.port > 0 ? config.port : m_optitrackConfig.commandPort);
+    settings.dataPort    = static_cast<uint16_t>(m_optitrackConfig.dataPort);
+    settings.multicast   = (m_optitrackConfig.connectionType == OptiTrackConfig::Multicast);
+    // Groupe multicast : celui annoncé par le serveur (NatNet 3+), sinon celui de Motive par défaut
+
+    m_optitrackConfig.captureFile = config.customParams
+        .value("captureFile", m_optitrackConfig.captureFile).toString();
+    if (!m_optitrackConfig.captureFile.isEmpty()) {
+        auto capture = std::make_shared<DatagramCapture>();
+        if (capture->open(m_optitrackConfig.captureFile.toLocal8Bit().toStdString())) {
+            settings.capture = capture;
+            emit logMessage(QString("Capturing NatNet packets to %1").arg(m_optitrackConfig.captureFile));
+        }
+        else {
+            emit logMessage(QString("Warning: %1").arg(QString::fromStdString(capture->lastError())));
+        }
+    }
+
+    m_nativeClient = std::make_unique<NatNetNativeClient>();
+    if (!m_nativeClient->connect(settings)) {
+        emit errorOccurred(QString("Failed to connect to OptiTrack server (native transport): %1")
+            .arg(QString::fromStdString(m_nativeClient->lastError())));
+        m_nativeClient.reset();
+        return false;
+    }
+
+    const NatNetServerInfo& info   = m_nativeClient->serverInfo();
+    const NatNetVersion&    stream = m_nativeClient->streamVersion();
+    const QString version = QString("NatNet %1.%2.%3.%4 (native)")
+        .arg(int(stream.major)).arg(int(stream.minor))
+        .arg(int(stream.build)).arg(int(stream.revision));
+    {
+        QMutexLocker locker(&m_frameMutex);
+        m_capabilities.version = version;
+    }
+    emit logMessage(QString("Connected to: %1 %2.%3 (NatNet %4.%5, %6, native transport)")
+        .arg(QString::fromStdString(info.appName))
+        .arg(int(info.appVersion[0])).arg(int(info.appVersion[1]))
+        .arg(int(stream.major)).arg(int(stream.minor))
+        .arg(info.multicast ? "multicast" : "unicast"));
+
+    if (!m_nativeClient->fetchModelDefinitions(1000))
+        emit logMessage("Warning: Could not get OptiTrack data descriptions");
+    return true;
+}
+
+void OptiTrackSystem::stopNativeReceiver()
+{
+    m_receiverRunning = false;
+    if (m_receiverThread) {
+        m_receiverThread->wait(3000);   // receive() bornée à 100 ms
+        delete m_receiverThread;
+        m_receiverThread = nullptr;
+    }
+}
+
+void OptiTrackSystem::nativeReceiveLoop()
+{
+    MOBOT_PROFILE_SYSTEM("OptiTrack");
+    NatNetNativeClient& client = *m_nativeClient;
+
+    while (m_receiverRunning.load(std::memory_order_acquire)) {
+        // Attente bornée : m_receiverRunning est réévalué même sans trafic
+        const NatNetNativeClient::Message message = client.receive(100);
+
+        if (message == NatNetNativeClient::Message::ModelDef) {
+            requestDirectoryReload();
+            continue;
+        }
+        if (message != NatNetNativeClient::Message::FrameOfData)
+            continue;
+
+        const qint64 receiveUs = m_timer.nsecsElapsed() / 1000; // µs
+
+        NatNetFrameSnapshot* slot = m_snapshotQueue.beginWrite();
+        if (!slot) {
+            m_queueOverflows.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+
+        // Dépaquetage directement dans l'emplacement de la file : aucune copie intermédiaire.
+        // Paquet rejeté : l'emplacement n'est pas publié et sera réutilisé.
+        if (!client.decodeFrame(*slot))
+            continue;
+
+        // Sans l'horloge synchronisée du SDK, seule la partie serveur est mesurable :
+        // mi-exposition caméra → émission par Motive (A→D, hors transit réseau)
+        slot->hostReceiveUs     = receiveUs;
+        slot->latencyFromCamera = slot->cameraMidExposureTimestamp != 0
+                               && slot->transmitTimestamp > slot->cameraMidExposureTimestamp;
+        slot->latencyMs = slot->latencyFromCamera
+            ? client.ticksToMs(slot->transmitTimestamp - slot->cameraMidExposureTimestamp)
+            : 0.0;
+
+        m_snapshotQueue.commitWrite();
+        m_snapshotsReady.release();
+    }
+}
+
+bool OptiTrackSystem::loadDirectory()
+{
+    RigidBodyDirectory directory;
+    if (!fetchDirectory(directory))
+        return false;
+
+    m_directory = std::move(directory);
+    QMutexLocker locker(&m_directoryMutex);
+    m_availableObjects = m_directory.names();
+    return true;
+}
+
+bool OptiTrackSystem::fetchDirectory(RigidBodyDirectory& directory)
+{
+    std::vector<NatNetRigidBodyDescription> bodies;
+
+    if (m_nativeClient) {
+        // Descriptions déjà reçues par le client (NAT_MODELDEF)
+        bodies = m_nativeClient->rigidBodyDescriptions();
+    }
+    else {
+        if (!m_pClient) return false;
+
+        sDataDescriptions* pDataDefs = nullptr;
+        if (m_pClient->GetDataDescriptionList(&pDataDefs) != ErrorCode_OK || !pDataDefs) {
+            emit logMessage("Warning: Could not get OptiTrack data descriptions");
+            return false;
+        }
+
+        for (int i = 0; i < pDataDefs->nDataDescriptions; i++) {
+            if (pDataDefs->arrDataDescriptions[i].type == Descriptor_RigidBody) {
+                const sRigidBodyDescription* rb =
+                    pDataDefs->arrDataDescriptions[i].Data.RigidBodyDescription;
+                NatNetRigidBodyDescription body;
+                body.id       = rb->ID;
+                body.parentId = rb->parentID;
+                body.name     = rb->szName;
+                bodies.push_back(body);
+            }
+        }
+        NatNet_FreeDescriptions(pDataDefs);
+    }
+
+    directory.clear();
+    for (const NatNetRigidBodyDescription& body : bodies)
+        directory.addBody(body.id, QString::fromStdString(body.name));
+    return true;
+}
+
+void OptiTrackSystem::requestDirectoryReload()
+{
+    m_directoryStale.store(true, std::memory_order_release);
+    m_directoryRequests.release();
+}
+
+void OptiTrackSystem::directoryLoop()
+{
+    while (m_workerRunning.load(std::memory_order_acquire)) {
+        if (!m_directoryRequests.tryAcquire(1, 100))
+            continue;
+        // Demandes fusionnées : un seul rechargement pour une rafale de frames marquées
+        if (!m_directoryStale.exchange(false, std::memory_order_acq_rel))
+            continue;
+
+        auto directory = std::make_unique<RigidBodyDirectory>();
+        if (!fetchDirectory(*directory))
+            continue;
+
+        {
+            QMutexLocker locker(&m_directoryMutex);
+            m_availableObjects = directory->names();
+            m_pendingDirectory = std::move(directory);
+        }
+        m_directoryReady.store(true, std::memory_order_release);
+    }
+}
+
+void OptiTrackSystem::adoptPendingDirectory()
+{
+    std::unique_ptr<RigidBodyDirectory> directory;
+    {
+        QMutexLocker locker(&m_directoryMutex);
+        directory = std::move(m_pendingDirectory);
+    }
+    if (!directory)
+        return;
+
+    m_directory = std::move(*directory);
+    resolveCurrentBody();
+}
+
+void OptiTrackSystem::resolveCurrentBody()
+{
+    int id = -1;
+    if (!m_optitrackConfig.rigidBodyName.isEmpty()) {
+        id = m_directory.idForName(m_optitrackConfig.rigidBodyName);
+        if (id < 0 && !m_directory.isEmpty()) {
+            emit logMessage(QString("Warning: rigid body '%1' not found in Motive data descriptions")
+                .arg(m_optitrackConfig.rigidBodyName));
+        }
+    }
+    if (id < 0)
+        id = m_optitrackConfig.rigidBodyId;
+    m_currentRigidBodyId = id;
 }
 
 QStringList OptiTrackSystem::getDiscoveredServers() const
 {
+    QMutexLocker locker(&m_discoveryMutex);
     QStringList servers;
     for (const auto& server : m_discoveredServers) {
         servers << QString("%1 (%2)")
@@ -237,11 +601,15 @@ QStringList OptiTrackSystem::getDiscoveredServers() const
 
 bool OptiTrackSystem::connectToServer(int serverIndex)
 {
-    if (serverIndex < 0 || serverIndex >= static_cast<int>(m_discoveredServers.size())) {
-        emit errorOccurred("Invalid server index");
-        return false;
+    sNatNetDiscoveredServer server;
+    {
+        QMutexLocker locker(&m_discoveryMutex);
+        if (serverIndex < 0 || serverIndex >= static_cast<int>(m_discoveredServers.size())) {
+            emit errorOccurred("Invalid server index");
+            return false;
+        }
+        server = m_discoveredServers[serverIndex];
     }
-    const auto& server = m_discoveredServers[serverIndex];
     ConnectionConfig config;
     config.systemType     = "OptiTrack";
     config.serverAddress  = QString(server.serverAddress);
@@ -257,7 +625,11 @@ void NATNET_CALLCONV OptiTrackSystem::serverDiscoveredCallback(
 {
     OptiTrackSystem* system = static_cast<OptiTrackSystem*>(pUserContext);
     if (!system || !pDiscoveredServer) return;
-    system->m_discoveredServers.push_back(*pDiscoveredServer);
+    {
+        QMutexLocker locker(&system->m_discoveryMutex);
+        system->m_discoveredServers.push_back(*pDiscoveredServer);
+    }
+    system->m_discoveryReplies.release();
     qDebug() << "[OptiTrack] Discovered server:"
              << pDiscoveredServer->serverDescription.szHostComputerName
              << "at" << pDiscoveredServer->serverAddress;
@@ -270,71 +642,210 @@ void NATNET_CALLCONV OptiTrackSystem::dataHandler(
     OptiTrackSystem* system = static_cast<OptiTrackSystem*>(pUserData);
     if (!system || !data || !system->m_isAcquiring) return;
 
+    MOBOT_TRACE_THREAD_NAME("NatNet SDK");
+    MOBOT_TRACE_SCOPE_ARG("natnet.dataHandler", data->iFrame);
+    MOBOT_PROFILE_SYSTEM("OptiTrack");
+    MOBOT_PROFILE_SCOPE("OptiTrack / SDK callback");
+
+    // Thread SDK : copie brute dans un emplacement préalloué, rien d'autre.
+    // Pas de mutex, pas d'allocation, pas de signal : le SDK reprend la main au plus vite.
+    NatNetFrameSnapshot* slot = system->m_snapshotQueue.beginWrite();
+    if (!slot) {
+        // Worker en retard : frame perdue (comptée aussi comme trou de numérotation)
+        system->m_queueOverflows.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    slot->frameNumber                = data->iFrame;
+    slot->timestamp                  = data->fTimestamp;
+    slot->cameraMidExposureTimestamp = data->CameraMidExposureTimestamp;
+    slot->transmitTimestamp          = data->TransmitTimestamp;
+    slot->params                     = data->params;
+    slot->hostReceiveUs              = system->m_timer.nsecsElapsed() / 1000; // µs
+
+    // Latence mesurée à la réception : SecondsSinceHostTimestamp dépend de l'instant d'appel.
+    // CameraMidExposureTimestamp disponible sur caméras Ethernet = latence totale précise (A→E),
+    // sinon Transmission Latency (D→E), toujours disponible mais moins précis
+    slot->latencyFromCamera = (data->CameraMidExposureTimestamp != 0);
+    slot->latencyMs = system->m_pClient->SecondsSinceHostTimestamp(
+        slot->latencyFromCamera ? data->CameraMidExposureTimestamp
+                                : data->TransmitTimestamp) * 1000.0;
+
+    const int count = qMin(static_cast<int>(data->nRigidBodies), NatNetFrameSnapshot::kMaxRigidBodies);
+    slot->rigidBodyCount = count;
+    for (int i = 0; i < count; i++) {
+        const sRigidBodyData&  src = data->RigidBodies[i];
+        NatNetRigidBodySample& dst = slot->rigidBodies[i];
+        dst.id        = src.ID;
+        dst.x         = src.x;
+        dst.y         = src.y;
+        dst.z         = src.z;
+        dst.qx        = src.qx;
+        dst.qy        = src.qy;
+        dst.qz        = src.qz;
+        dst.qw        = src.qw;
+        dst.meanError = src.MeanError;
+        dst.params    = src.params;
+    }
+
+    system->m_snapshotQueue.commitWrite();
+    system->m_snapshotsReady.release();
+}
+
+void NATNET_CALLCONV OptiTrackSystem::messageHandler(
+    Verbosity msgType,
+    const char* msg)
+{
+    if      (msgType == Verbosity_Error)   qCritical() << "[OptiTrack SDK Error]"   << msg;
+    else if (msgType == Verbosity_Warning) qWarning()  << "[OptiTrack SDK Warning]" << msg;
+    else                                   qDebug()    << "[OptiTrack SDK]"         << msg;
+}
+
+// ========== Worker applicatif ==========
+
+void OptiTrackSystem::processingLoop()
+{
+    MOBOT_TRACE_THREAD_NAME("OptiTrack worker");
+    MOBOT_PROFILE_SYSTEM("OptiTrack");
+
+    while (m_workerRunning.load(std::memory_order_acquire)) {
+        // Attente bornée : m_workerRunning est réévalué même sans frame entrante.
+        // Chaque réveil vide toute la file (jetons excédentaires = réveils à vide, sans effet)
+        if (!m_snapshotsReady.tryAcquire(1, 100))
+            continue;
+
+        MOBOT_PROFILE_GAUGE("OptiTrack / file snapshots", m_snapshotQueue.size());
+        while (const NatNetFrameSnapshot* snapshot = m_snapshotQueue.front()) {
+            processSnapshot(*snapshot);
+            m_snapshotQueue.popFront();
+        }
+    }
+
+    // Frames reçues juste avant l'arrêt
+    while (const NatNetFrameSnapshot* snapshot = m_snapshotQueue.front()) {
+        processSnapshot(*snapshot);
+        m_snapshotQueue.popFront();
+    }
+}
+
+void OptiTrackSystem::processSnapshot(const NatNetFrameSnapshot& snapshot)
+{
+    MOBOT_TRACE_SCOPE_ARG("natnet.process", snapshot.frameNumber);
+    MOBOT_PROFILE_SCOPE("OptiTrack / process");
+
+    // Armé en attente du départ commun : la file est vidée sans rien publier
+    if (!sessionStarted())
+        return;
+
+    // Trous de numérotation : pertes réseau et débordements de la file
+    if (m_lastFrameNumber >= 0 && snapshot.frameNumber > m_lastFrameNumber + 1)
+        m_metrics.droppedFrames += static_cast<quint64>(snapshot.frameNumber - m_lastFrameNumber - 1);
+    m_lastFrameNumber = snapshot.frameNumber;
+
+    // Liste des modèles modifiée dans Motive : rechargement par le chargeur d'annuaire,
+    // l'ancien cache sert jusqu'à l'adoption du nouvel annuaire. Transport natif : la
+    // requête part sans attente, la réponse arrive par le thread de réception
+    if (snapshot.params & 0x02) {
+        if (m_nativeClient)
+            m_nativeClient->requestModelDefinitions();
+        else
+            requestDirectoryReload();
+    }
+    if (m_directoryReady.exchange(false, std::memory_order_acq_rel))
+        adoptPendingDirectory();
+
+    // Capture multi-corps : lot complet + flux par corps pour les abonnés C++
+    const bool captureAll = m_optitrackConfig.captureAllBodies;
+    if (captureAll && snapshot.rigidBodyCount > 0) {
+        fillBatch(snapshot);
+        publishBatch(m_batch);
+        for (int i = 0; i < m_batch.size(); i++)
+            notifySubscribers(m_batch.frameAt(i));
+    }
+
     // Convertir la frame
-    MeasurementFrame frame = system->convertNatNetFrame(data);
+    MeasurementFrame frame = convertNatNetFrame(snapshot);
     if (!frame.isValid) return;
 
     // Mettre à jour la dernière frame (thread-safe)
     {
-        QMutexLocker locker(&system->m_frameMutex);
-        system->m_latestFrame = frame;
+        QMutexLocker locker(&m_frameMutex);
+        m_latestFrame = frame;
     }
 
     // Ajouter au buffer circulaire
-    system->m_frameBuffer.push(frame);
+    m_frameBuffer.push(frame);
 
-    // Calcul de fréquence
-    const qint64 now = system->m_timer.nsecsElapsed() / 1000; // µs
-    if (system->m_lastFrameTime > 0) {
-        const qint64 delta = now - system->m_lastFrameTime;
+    // Calcul de fréquence sur l'instant de réception (pas l'instant de traitement)
+    if (m_lastFrameTime > 0) {
+        const qint64 delta = snapshot.hostReceiveUs - m_lastFrameTime;
         if (delta > 0)
-            system->m_frequency = 1000000.0 / static_cast<double>(delta);
+            m_frequency = 1000000.0 / static_cast<double>(delta);
     }
-    system->m_lastFrameTime = now;
+    m_lastFrameTime = snapshot.hostReceiveUs;
 
-    // Calcul de latence
-    // CameraMidExposureTimestamp disponible sur caméras Ethernet = latence totale précise (A→E)
-    const bool bClientLatencyAvailable = (data->CameraMidExposureTimestamp != 0);
-    if (bClientLatencyAvailable) {
-        system->m_latency =
-            system->m_pClient->SecondsSinceHostTimestamp(
-                data->CameraMidExposureTimestamp) * 1000.0;
-    }
-    else {
-        // Fallback : Transmission Latency (D→E), toujours disponible mais moins précis
-        system->m_latency =
-            system->m_pClient->SecondsSinceHostTimestamp(
-                data->TransmitTimestamp) * 1000.0;
-    }
+    m_latency = snapshot.latencyMs;
 
     // ✅ Mettre à jour métriques live + accumulateurs session
-    system->updateRunningStats(system->m_latency, system->m_frequency, bClientLatencyAvailable);
-
-    // Émettre via QueuedConnection (thread-safe vers le thread Qt)
-    emit system->newFrameAvailable(frame);
-    emit system->performanceUpdate(system->m_metrics);
+    updateRunningStats(m_latency, m_frequency, snapshot.latencyFromCamera);
+    updatePoseStats(frame);
+
+    // Diffusion coalescée vers le thread Qt (FrameDispatcher). En capture multi-corps,
+    // les abonnés C++ ont déjà reçu ce corps via son flux dédié.
+    if (captureAll)
+        m_dispatcher->postFrame(frame);
+    else
+        publishFrame(frame);
+    publishMetrics();
 }
 
-void NATNET_CALLCONV OptiTrackSystem::messageHandler(
-    Verbosity msgType,
-    const char* msg)
+void OptiTrackSystem::fillBatch(const NatNetFrameSnapshot& snapshot)
 {
-    if      (msgType == Verbosity_Error)   qCritical() << "[OptiTrack SDK Error]"   << msg;
-    else if (msgType == Verbosity_Warning) qWarning()  << "[OptiTrack SDK Warning]" << msg;
-    else                                   qDebug()    << "[OptiTrack SDK]"         << msg;
+    const int count = snapshot.rigidBodyCount;
+    m_batch.timestamp   = static_cast<qint64>(snapshot.timestamp * 1000000.0); // → µs
+    m_batch.frameNumber = snapshot.frameNumber;
+    m_batch.resize(count);
+
+    for (int i = 0; i < count; i++) {
+        const NatNetRigidBodySample& body = snapshot.rigidBodies[i];
+
+        m_batch.ids[i]   = body.id;
+        m_batch.names[i] = m_directory.nameForId(body.id);
+
+        // Position mètres → mm
+        m_batch.x[i] = body.x * 1000.0;
+        m_batch.y[i] = body.y * 1000.0;
+        m_batch.z[i] = body.z * 1000.0;
+
+        m_batch.qx[i] = body.qx;
+        m_batch.qy[i] = body.qy;
+        m_batch.qz[i] = body.qz;
+        m_batch.qw[i] = body.qw;
+
+        m_batch.meanError[i] = body.meanError * 1000.0;
+        m_batch.quality[i]   = body.meanError < 1.0 ? (1.0 - body.meanError) : 0.0;
+        m_batch.tracked[i]   = (body.params & 0x01) ? 1 : 0;
+    }
+
+    // Euler de tous les corps en un appel vectorisé — même convention que
+    // quaternionToEuler : R = Rz·Ry·Rx (A = Rz, B = Ry, C = Rx)
+    EulerBatch::quaternionsToEuler(
+        m_batch.qx.constData(), m_batch.qy.constData(), m_batch.qz.constData(), m_batch.qw.constData(),
+        count, AngleConvention::RzRyRx,
+        m_batch.rz.data(), m_batch.ry.data(), m_batch.rx.data());
 }
 
 // ========== Méthodes de conversion ==========
 
-MeasurementFrame OptiTrackSystem::convertNatNetFrame(const sFrameOfMocapData* data)
+MeasurementFrame OptiTrackSystem::convertNatNetFrame(const NatNetFrameSnapshot& snapshot)
 {
     MeasurementFrame frame;
     frame.systemName  = "OptiTrack";
-    frame.timestamp   = static_cast<qint64>(data->fTimestamp * 1000000.0); // → µs
-    frame.frameNumber = data->iFrame;
+    frame.timestamp   = static_cast<qint64>(snapshot.timestamp * 1000000.0); // → µs
+    frame.frameNumber = snapshot.frameNumber;
     frame.isValid     = false;
 
-    const sRigidBodyData* rigidBody = findRigidBody(data);
+    const NatNetRigidBodySample* rigidBody = findRigidBody(snapshot);
     if (!rigidBody) return frame;
 
     const bool bTrackingValid = rigidBody->params & 0x01;
@@ -359,21 +870,19 @@ MeasurementFrame OptiTrackSystem::convertNatNetFrame(const sFrameOfMocapData* da
     quaternionToEuler(rigidBody->qx, rigidBody->qy, rigidBody->qz, rigidBody->qw,
         frame.rx, frame.ry, frame.rz);
 
-    frame.quality = rigidBody->MeanError < 1.0 ? (1.0 - rigidBody->MeanError) : 0.0;
+    frame.quality = rigidBody->meanError < 1.0 ? (1.0 - rigidBody->meanError) : 0.0;
     return frame;
 }
 
-const sRigidBodyData* OptiTrackSystem::findRigidBody(const sFrameOfMocapData* data)
+const NatNetRigidBodySample* OptiTrackSystem::findRigidBody(const NatNetFrameSnapshot& snapshot)
 {
-    if (!data || data->nRigidBodies == 0) return nullptr;
+    if (snapshot.rigidBodyCount == 0) return nullptr;
 
     if (m_currentRigidBodyId >= 0) {
-        for (int i = 0; i < data->nRigidBodies; i++) {
-            if (data->RigidBodies[i].ID == m_currentRigidBodyId)
-                return &data->RigidBodies[i];
-        }
+        if (const NatNetRigidBodySample* body = m_directory.find(snapshot, m_currentRigidBodyId))
+            return body;
     }
-    return &data->RigidBodies[0];
+    return &snapshot.rigidBodies[0];
 }
 
 void OptiTrackSystem::quaternionToEuler(float qx, float qy, float qz, float qw,
@@ -4,7 +4,16 @@
 
 #include "IMeasurementSystem.h"
 #include "OptiTrackConfig.h"
+#include "NatNetFrameData.h"
+#include "NatNetNativeClient.h"
+#include "RigidBodyBatch.h"
+#include "RigidBodyDirectory.h"
+#include "SpscRing.h"
 #include <QElapsedTimer>
+#include <QMutex>
+#include <QSemaphore>
+#include <atomic>
+#include <memory>
 #include <vector>
 
 #include <NatNetTypes.h>
@@ -39,10 +48,40 @@ public:
     ThreadingModel getThreadingModel() const override;
 
     // ========== Méthodes spécifiques OptiTrack ==========
-    int discoverServers();
+    static constexpr int kDiscoveryTimeoutMs = 2000;
+
+    /**
+     * @brief Découverte des serveurs Motive (diffusion NatNet)
+     *
+     * Retourne dès que minServers serveurs ont répondu, au plus tard après timeoutMs :
+     * sur un réseau où Motive répond en quelques ms, l'attente n'est plus fixe.
+     * @return Nombre de serveurs trouvés
+     */
+    int discoverServers(int timeoutMs = kDiscoveryTimeoutMs, int minServers = 1);
     QStringList getDiscoveredServers() const;
     bool connectToServer(int serverIndex);
 
+    /**
+     * @brief Capture de tous les rigid bodies de chaque frame
+     *
+     * Les abonnés subscribeBatches() reçoivent un RigidBodyBatch par frame ; les
+     * abonnés subscribe() filtrés par objectName reçoivent le flux de leur corps.
+     * newFrameAvailable et les statistiques suivent toujours le corps sélectionné.
+     * À régler avant startAcquisition() (ou ConnectionConfig::customParams["captureAllBodies"]).
+     */
+    void setCaptureAllBodies(bool enabled);
+    bool captureAllBodies() const;
+
+    /**
+     * @brief Réception par le client NatNet intégré au lieu du NatNetClient du SDK
+     *
+     * Dépaquetage direct dans la file du worker, sans copie intermédiaire par le
+     * SDK. Latence limitée à la partie serveur (caméra → émission Motive).
+     * À régler avant connect() (ou ConnectionConfig::customParams["nativeTransport"]).
+     */
+    void setNativeTransport(bool enabled);
+    bool nativeTransport() const;
+
 private:
     // ========== Callbacks SDK (threads SDK) ==========
     static void NATNET_CALLCONV serverDiscoveredCallback(
@@ -57,9 +96,51 @@ private:
         Verbosity msgType,
         const char* msg);
 
+    // ========== Worker applicatif ==========
+    /**
+     * @brief Boucle du worker : vide la file des instantanés reçus par le callback
+     *
+     * Conversion, statistiques et diffusion se font ici et non plus dans le thread
+     * SDK, qui doit rendre la main immédiatement pour ne pas retarder la réception.
+     */
+    void processingLoop();
+    void processSnapshot(const NatNetFrameSnapshot& snapshot);
+
+    /**
+     * @brief Boucle du chargeur d'annuaire : recharge les descriptions quand elles sont périmées
+     *
+     * GetDataDescriptionList est un aller-retour bloquant vers Motive : il ne se fait
+     * jamais dans le worker. Le nouvel annuaire est publié sous m_directoryMutex ; le
+     * worker l'adopte entre deux frames et garde l'ancien cache jusque-là.
+     */
+    void directoryLoop();
+
+    /** @brief Marque l'annuaire comme périmé et réveille le chargeur (tout thread) */
+    void requestDirectoryReload();
+
+    /** @brief Worker : remplace m_directory par l'annuaire publié, s'il y en a un */
+    void adoptPendingDirectory();
+
+    // ========== Transport natif ==========
+    bool connectNative(const ConnectionConfig& config);
+
+    /** @brief Thread de réception : décode chaque frame directement dans la file du worker */
+    void nativeReceiveLoop();
+    void stopNativeReceiver();
+
     // ========== Méthodes internes ==========
-    MeasurementFrame convertNatNetFrame(const sFrameOfMocapData* data);
-    const sRigidBodyData* findRigidBody(const sFrameOfMocapData* data);
+    MeasurementFrame convertNatNetFrame(const NatNetFrameSnapshot& snapshot);
+    const NatNetRigidBodySample* findRigidBody(const NatNetFrameSnapshot& snapshot);
+    void fillBatch(const NatNetFrameSnapshot& snapshot);
+
+    /** @brief Recharge m_directory, worker arrêté (connexion, démarrage) */
+    bool loadDirectory();
+
+    /** @brief Construit un annuaire depuis les descriptions de données du serveur (bloquant) */
+    bool fetchDirectory(RigidBodyDirectory& directory);
+
+    /** @brief Nom demandé (prioritaire) ou ID demandé → m_currentRigidBodyId */
+    void resolveCurrentBody();
     void quaternionToEuler(float qx, float qy, float qz, float qw,
         double& rx, double& ry, double& rz);
     void initializeCapabilities();
@@ -67,13 +148,18 @@ private:
 
     // ========== Membres privés ==========
     NatNetClient* m_pClient;
+
+    // Découverte : remplie par le thread SDK, lue par discoverServers()
     std::vector<sNatNetDiscoveredServer> m_discoveredServers;
+    mutable QMutex                       m_discoveryMutex;
+    QSemaphore                           m_discoveryReplies;
+
     sNatNetClientConnectParams m_connectParams;
     sServerDescription m_serverDescription;
 
     OptiTrackConfig m_optitrackConfig;
 
-    bool m_isConnected;
+    std::atomic<bool> m_isConnected{ false };
 
     // ✅ Timestamps séparés pour calcul latence correct
     QElapsedTimer m_timer;
@@ -87,6 +173,35 @@ private:
     QString m_currentRigidBodyName;
     int     m_currentRigidBodyId;
 
+    // File callback SDK → worker (emplacements préalloués, un producteur / un consommateur)
+    static constexpr std::size_t kSnapshotQueueCapacity = 64;
+    SpscRing<NatNetFrameSnapshot> m_snapshotQueue;
+    QSemaphore                    m_snapshotsReady;
+    std::atomic<bool>             m_workerRunning;
+    std::atomic<quint64>          m_queueOverflows;   // Frames perdues file pleine (thread SDK)
+    int                           m_lastFrameNumber;  // Détection des trous (worker)
+
+    // Annuaire des corps : chargé à la connexion et au démarrage (worker arrêté), puis
+    // propriété du worker. Sur changement de modèles, le chargeur construit un nouvel
+    // annuaire et le dépose dans m_pendingDirectory ; getAvailableObjects() lit la copie
+    // protégée des noms.
+    RigidBodyDirectory                  m_directory;
+    mutable QMutex                      m_directoryMutex;
+    QStringList                         m_availableObjects;
+    std::unique_ptr<RigidBodyDirectory> m_pendingDirectory;   // Sous m_directoryMutex
+    std::atomic<bool>                   m_directoryReady;     // m_pendingDirectory déposé
+    std::atomic<bool>                   m_directoryStale;     // Rechargement demandé
+    QSemaphore                          m_directoryRequests;
+    QThread*                            m_directoryThread;
+
+    // Capture multi-corps (lot réutilisé d'une frame à l'autre, worker uniquement)
+    RigidBodyBatch     m_batch;
+
+    // Transport natif : le thread de réception remplace le callback SDK comme producteur
+    std::unique_ptr<NatNetNativeClient> m_nativeClient;
+    QThread*           m_receiverThread;
+    std::atomic<bool>  m_receiverRunning;
+
     static const ConnectionType kDefaultConnectionType = ConnectionType_Multicast;
 };
 
@@ -17,6 +17,7 @@ struct PerformanceMetrics {
     QString systemName    = "";    // Nom du système source (routing UI multi-systèmes)
     double  frequencyHz   = 0.0;   // Fréquence instantanée mesurée (Hz)
     double  latencyMs     = 0.0;   // Latence instantanée (ms) — 0.0 si indisponible
+    double  latencyJitterMs = 0.0; // Variation lissée de la latence (ms) — 0.0 si indisponible
     quint64 frameCount    = 0;     // Frames reçues depuis startAcquisition()
     quint64 droppedFrames = 0;     // Frames manquantes détectées
 
@@ -0,0 +1,279 @@
+#include "Profiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define MOBOT_PROFILER_TSC 1
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+
+namespace {
+
+/** @brief Emplacement d'une sonde pour un thread : écrivain unique, lecteur = collect() */
+struct ProbeSlot {
+    std::atomic<uint64_t> count{ 0 };
+    std::atomic<uint64_t> ticks{ 0 };
+    std::atomic<uint64_t> maxTicks{ 0 };
+    std::atomic<int64_t>  gauge{ 0 };
+    std::atomic<int64_t>  gaugeMax{ 0 };
+    std::atomic<bool>     gaugeSet{ false };
+};
+
+struct ThreadSlots {
+    ProbeSlot         probes[Profiler::kMaxProbes];
+    std::string       system;            // Fixé à la création : repris par le même système uniquement
+    std::atomic<bool> inUse{ true };
+};
+
+struct ProbeInfo {
+    std::string    name;
+    Profiler::Kind kind = Profiler::Kind::Timer;
+};
+
+int64_t steadyNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+struct Registry {
+    std::mutex                                mutex;
+    ProbeInfo                                 probes[Profiler::kMaxProbes];
+    int                                       probeCount = 0;
+    std::vector<std::unique_ptr<ThreadSlots>> threads;
+
+    // Étalonnage ticks → ns (depuis le démarrage, de plus en plus précis)
+    uint64_t startTicks = Profiler::ticks();
+    int64_t  startNs    = steadyNs();
+
+    // Cumuls au collect() précédent, par (système, sonde) ; une entrée = une ligne
+    struct Previous {
+        uint64_t count = 0;
+        uint64_t ticks = 0;
+    };
+    int64_t                                        previousNs = 0;
+    std::map<std::pair<std::string, int>, Previous> previous;
+};
+
+Registry& registry()
+{
+    static Registry instance;
+    return instance;
+}
+
+/**
+ * @brief Emplacements du thread, un jeu par système servi ; libérés à la fin du
+ *        thread (repris par un prochain thread du même système)
+ */
+struct ThreadContext {
+    std::vector<ThreadSlots*> entries;
+    int                       current = -1;   // Index dans entries, -1 = pas encore attribué
+
+    ~ThreadContext()
+    {
+        for (ThreadSlots* entry : entries) {
+            // Une jauge d'un thread terminé ne décrit plus rien
+            for (ProbeSlot& probe : entry->probes)
+                probe.gaugeSet.store(false, std::memory_order_relaxed);
+            entry->inUse.store(false, std::memory_order_release);
+        }
+    }
+};
+
+thread_local ThreadContext t_context;
+
+int slotsIndex(const char* system)
+{
+    for (std::size_t i = 0; i < t_context.entries.size(); ++i) {
+        if (t_context.entries[i]->system == system)
+            return static_cast<int>(i);
+    }
+
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    ThreadSlots* entry = nullptr;
+    for (const auto& candidate : reg.threads) {
+        if (candidate->system == system && !candidate->inUse.load(std::memory_order_acquire)) {
+            candidate->inUse.store(true, std::memory_order_relaxed);
+            entry = candidate.get();
+            break;
+        }
+    }
+    if (!entry) {
+        reg.threads.push_back(std::make_unique<ThreadSlots>());
+        entry = reg.threads.back().get();
+        entry->system = system;
+    }
+    t_context.entries.push_back(entry);
+    return static_cast<int>(t_context.entries.size()) - 1;
+}
+
+ThreadSlots* localSlots()
+{
+    if (t_context.current < 0)
+        t_context.current = slotsIndex("");
+    return t_context.entries[static_cast<std::size_t>(t_context.current)];
+}
+
+// Écrivain unique : load + store relâchés, sans instruction verrouillée
+inline void add(std::atomic<uint64_t>& value, uint64_t delta)
+{
+    value.store(value.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+}
+
+} // namespace
+
+// =============================================================================
+// Sondes
+// =============================================================================
+
+int Profiler::registerProbe(const char* name, Kind kind)
+{
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for (int i = 0; i < reg.probeCount; ++i) {
+        if (reg.probes[i].name == name)
+            return i;
+    }
+    if (reg.probeCount >= kMaxProbes)
+        return -1;
+    reg.probes[reg.probeCount].name = name;
+    reg.probes[reg.probeCount].kind = kind;
+    return reg.probeCount++;
+}
+
+uint64_t Profiler::ticks()
+{
+#ifdef MOBOT_PROFILER_TSC
+    return __rdtsc();
+#else
+    return static_cast<uint64_t>(steadyNs());
+#endif
+}
+
+void Profiler::addTime(int probe, uint64_t elapsedTicks)
+{
+    if (probe < 0)
+        return;
+    ProbeSlot& slot = localSlots()->probes[probe];
+    add(slot.count, 1);
+    add(slot.ticks, elapsedTicks);
+    if (elapsedTicks > slot.maxTicks.load(std::memory_order_relaxed))
+        slot.maxTicks.store(elapsedTicks, std::memory_order_relaxed);
+}
+
+void Profiler::addCount(int probe, uint64_t count)
+{
+    if (probe < 0)
+        return;
+    add(localSlots()->probes[probe].count, count);
+}
+
+void Profiler::setGauge(int probe, int64_t value)
+{
+    if (probe < 0)
+        return;
+    ProbeSlot& slot = localSlots()->probes[probe];
+    slot.gauge.store(value, std::memory_order_relaxed);
+    if (value > slot.gaugeMax.load(std::memory_order_relaxed))
+        slot.gaugeMax.store(value, std::memory_order_relaxed);
+    slot.gaugeSet.store(true, std::memory_order_relaxed);
+}
+
+int Profiler::enterSystem(const char* system)
+{
+    const int previous = t_context.current;
+    t_context.current = slotsIndex(system ? system : "");
+    return previous;
+}
+
+void Profiler::leaveSystem(int previous)
+{
+    t_context.current = previous;
+}
+
+// =============================================================================
+// Agrégation
+// =============================================================================
+
+std::vector<Profiler::ProbeStats> Profiler::collect()
+{
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+
+    const uint64_t nowTicks = ticks();
+    const int64_t  nowNs    = steadyNs();
+    const double   intervalNs = static_cast<double>(
+        nowNs - (reg.previousNs > 0 ? reg.previousNs : reg.startNs));
+    const double   ticksPerNs = nowNs > reg.startNs
+        ? static_cast<double>(nowTicks - reg.startTicks) / static_cast<double>(nowNs - reg.startNs)
+        : 1.0;
+    reg.previousNs = nowNs;
+
+    // Emplacements regroupés par système (ordre alphabétique, commun en tête)
+    std::map<std::string, std::vector<ThreadSlots*>> bySystem;
+    for (const auto& thread : reg.threads)
+        bySystem[thread->system].push_back(thread.get());
+
+    std::vector<ProbeStats> stats;
+    for (const auto& group : bySystem) {
+        for (int p = 0; p < reg.probeCount; ++p) {
+            uint64_t count = 0, elapsed = 0, maxTicks = 0;
+            int64_t  gaugeLast = 0, gaugeMax = 0;
+            bool     gaugeSet  = false;
+            for (ThreadSlots* thread : group.second) {
+                ProbeSlot& slot = thread->probes[p];
+                count   += slot.count.load(std::memory_order_relaxed);
+                elapsed += slot.ticks.load(std::memory_order_relaxed);
+                maxTicks = std::max(maxTicks, slot.maxTicks.exchange(0, std::memory_order_relaxed));
+                if (slot.gaugeSet.load(std::memory_order_relaxed)) {
+                    const int64_t current = slot.gauge.load(std::memory_order_relaxed);
+                    gaugeSet  = true;
+                    gaugeLast = std::max(gaugeLast, current);
+                    gaugeMax  = std::max(gaugeMax, slot.gaugeMax.exchange(current, std::memory_order_relaxed));
+                }
+            }
+
+            // Sonde jamais passée pour ce système : pas de ligne
+            const auto key = std::make_pair(group.first, p);
+            auto it = reg.previous.find(key);
+            if (it == reg.previous.end()) {
+                if (count == 0 && !gaugeSet)
+                    continue;
+                it = reg.previous.emplace(key, Registry::Previous()).first;
+            }
+
+            const uint64_t deltaCount = count - it->second.count;
+            const uint64_t deltaTicks = elapsed - it->second.ticks;
+            it->second.count = count;
+            it->second.ticks = elapsed;
+
+            ProbeStats s;
+            s.system = group.first;
+            s.name   = reg.probes[p].name;
+            s.kind   = reg.probes[p].kind;
+            s.total  = count;
+            if (intervalNs > 0.0)
+                s.perSecond = static_cast<double>(deltaCount) * 1e9 / intervalNs;
+            if (s.kind == Kind::Timer && ticksPerNs > 0.0) {
+                const double deltaNs = static_cast<double>(deltaTicks) / ticksPerNs;
+                s.meanUs      = deltaCount > 0 ? deltaNs / static_cast<double>(deltaCount) / 1000.0 : 0.0;
+                s.maxUs       = static_cast<double>(maxTicks) / ticksPerNs / 1000.0;
+                s.loadPercent = intervalNs > 0.0 ? 100.0 * deltaNs / intervalNs : 0.0;
+            }
+            s.gaugeLast = gaugeLast;
+            s.gaugeMax  = std::max(gaugeMax, gaugeLast);
+            stats.push_back(s);
+        }
+    }
+    return stats;
+}
@@ -0,0 +1,155 @@
+#pragma once
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Compteurs de profilage des chemins chauds (MOBOT_PROFILE)
+ *
+ * Trois types de sondes, déclarées sur place par les macros en fin de fichier :
+ *   - Timer   : durée d'une portée (appels/s, moyenne, maximum, charge du thread) ;
+ *   - Counter : événements comptés (pertes, débordements...) ;
+ *   - Gauge   : valeur échantillonnée (profondeur de file), dernière et maximum.
+ *
+ * MOBOT_PROFILE est défini par la configuration Profile de Mobot4.vcxproj (Release +
+ * MOBOT_PROFILE). Sans lui, les macros disparaissent entièrement : aucun code, aucune
+ * donnée dans les chemins instrumentés.
+ *
+ * Avec MOBOT_PROFILE : chaque thread écrit dans ses propres emplacements (un par
+ * sonde, écrivain unique, atomiques relâchés sans lock), horloge TSC (__rdtsc)
+ * sur x86-64, steady_clock ailleurs. collect(), appelé une fois par seconde par
+ * ProfilingPanel, additionne les threads et calcule les écarts depuis l'appel
+ * précédent. Les emplacements d'un thread terminé sont repris par le suivant :
+ * les cumuls restent cohérents et la mémoire bornée.
+ *
+ * Ventilation par système : MOBOT_PROFILE_SYSTEM(nom) impute au système les sondes
+ * du thread appelant jusqu'à la fin de la portée (boucle d'acquisition, callback SDK,
+ * flush du dispatcher d'un système). Un jeu d'emplacements par (thread, système) :
+ * collect() rend une ligne par couple (système, sonde) ayant servi. Hors de toute
+ * portée, le système est vide (code commun, UI).
+ *
+ * Maximum : remis à zéro par collect() ; une mise à jour concurrente peut
+ * le reporter sur l'intervalle suivant (sans conséquence pour l'affichage).
+ *
+ * Sans Qt, comme TraceRecorder.
+ */
+class Profiler {
+public:
+    static constexpr int kMaxProbes = 64;
+
+    enum class Kind {
+        Timer,
+        Counter,
+        Gauge
+    };
+
+    /** @brief Statistiques d'une sonde sur le dernier intervalle de collect() */
+    struct ProbeStats {
+        std::string system;              // Vide : hors de toute portée MOBOT_PROFILE_SYSTEM
+        std::string name;
+        Kind        kind = Kind::Timer;
+        double      perSecond   = 0.0;   // Appels (Timer) ou événements (Counter) par seconde
+        double      meanUs      = 0.0;   // Timer
+        double      maxUs       = 0.0;   // Timer
+        double      loadPercent = 0.0;   // Timer : temps passé / durée de l'intervalle
+        uint64_t    total       = 0;     // Appels ou événements depuis le démarrage
+        int64_t     gaugeLast   = 0;     // Gauge : plus grande valeur courante des threads
+        int64_t     gaugeMax    = 0;     // Gauge : maximum sur l'intervalle
+    };
+
+    /** @brief Enregistre (ou retrouve par son nom) une sonde ; -1 si kMaxProbes est atteint */
+    static int registerProbe(const char* name, Kind kind);
+
+    static uint64_t ticks();
+
+    // ========== Enregistrement (thread appelant) ==========
+
+    static void addTime(int probe, uint64_t elapsedTicks);
+    static void addCount(int probe, uint64_t count);
+    static void setGauge(int probe, int64_t value);
+
+    /**
+     * @brief Impute les sondes suivantes du thread appelant à ce système
+     * @return Contexte précédent, à rendre à leaveSystem()
+     */
+    static int  enterSystem(const char* system);
+    static void leaveSystem(int previous);
+
+    // ========== Agrégation ==========
+
+    /** @brief Agrège les threads par système ; écarts calculés depuis l'appel précédent */
+    static std::vector<ProbeStats> collect();
+};
+
+/**
+ * @brief Sonde Timer : mesure de la construction à la destruction
+ */
+class ProfileScope {
+public:
+    explicit ProfileScope(int probe) : m_probe(probe), m_start(Profiler::ticks()) {}
+    ~ProfileScope() { Profiler::addTime(m_probe, Profiler::ticks() - m_start); }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    int      m_probe;
+    uint64_t m_start;
+};
+
+/**
+ * @brief Portée de MOBOT_PROFILE_SYSTEM
+ */
+class ProfileSystemScope {
+public:
+    explicit ProfileSystemScope(const char* system) : m_previous(Profiler::enterSystem(system)) {}
+    ~ProfileSystemScope() { Profiler::leaveSystem(m_previous); }
+
+    ProfileSystemScope(const ProfileSystemScope&) = delete;
+    ProfileSystemScope& operator=(const ProfileSystemScope&) = delete;
+
+private:
+    int m_previous;
+};
+
+// ===== Sondes =====
+
+#define MOBOT_PROFILE_CONCAT_INNER(a, b) a##b
+#define MOBOT_PROFILE_CONCAT(a, b) MOBOT_PROFILE_CONCAT_INNER(a, b)
+
+#ifdef MOBOT_PROFILE
+
+#define MOBOT_PROFILE_SCOPE(name)                                                           \
+    static const int MOBOT_PROFILE_CONCAT(mobotProbe_, __LINE__) =                          \
+        Profiler::registerProbe(name, Profiler::Kind::Timer);                               \
+    ProfileScope MOBOT_PROFILE_CONCAT(mobotProfileScope_, __LINE__)(MOBOT_PROFILE_CONCAT(mobotProbe_, __LINE__))
+
+#define MOBOT_PROFILE_COUNT(name, count)                                                    \
+    do {                                                                                    \
+        static const int mobotProbe = Profiler::registerProbe(name, Profiler::Kind::Counter); \
+        Profiler::addCount(mobotProbe, static_cast<uint64_t>(count));                       \
+    } while (0)
+
+#define MOBOT_PROFILE_GAUGE(name, value)                                                    \
+    do {                                                                                    \
+        static const int mobotProbe = Profiler::registerProbe(name, Profiler::Kind::Gauge); \
+        Profiler::setGauge(mobotProbe, static_cast<int64_t>(value));                        \
+    } while (0)
+
+#define MOBOT_PROFILE_SYSTEM(system)                                                        \
+    ProfileSystemScope MOBOT_PROFILE_CONCAT(mobotProfileSystem_, __LINE__)(system)
+
+#else
+
+#define MOBOT_PROFILE_SCOPE(name)          ((void)0)
+#define MOBOT_PROFILE_COUNT(name, count)   ((void)0)
+#define MOBOT_PROFILE_GAUGE(name, value)   ((void)0)
+#define MOBOT_PROFILE_SYSTEM(system)       ((void)0)
+
+#endif
+
+#endif // PROFILER_H
@@ -0,0 +1,94 @@
+﻿#include "ProfilingPanel.h"
+#include "Profiler.h"
+
+#include <QVBoxLayout>
+#include <QGroupBox>
+#include <QHeaderView>
+
+static const char* k_headers[] = { "Système", "Sonde", "/s", "Moy. µs", "Max µs", "Charge %" };
+static const int   k_cols = 6;
+
+ProfilingPanel::ProfilingPanel(QWidget* parent)
+    : QWidget(parent)
+{
+    buildUi();
+
+    m_collectTimer = new QTimer(this);
+    m_collectTimer->setInterval(1000);
+    connect(m_collectTimer, &QTimer::timeout,
+        this, &ProfilingPanel::onCollectTick);
+    m_collectTimer->start();
+}
+
+void ProfilingPanel::buildUi()
+{
+    QGroupBox* box = new QGroupBox(QStringLiteral("Profilage (MOBOT_PROFILE)"));
+    QVBoxLayout* boxLay = new QVBoxLayout(box);
+
+    m_table = new QTableWidget(0, k_cols);
+    m_table->setObjectName(QStringLiteral("ProfilingTable"));
+    m_table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_table->setSelectionMode(QAbstractItemView::NoSelection);
+    m_table->setFocusPolicy(Qt::NoFocus);
+    m_table->verticalHeader()->setVisible(false);
+    for (int i = 0; i < k_cols; ++i)
+        m_table->horizontalHeader()->setSectionResizeMode(
+            i, i == 1 ? QHeaderView::Stretch : QHeaderView::ResizeToContents);
+
+    QStringList headers;
+    for (int i = 0; i < k_cols; ++i)
+        headers << QString::fromUtf8(k_headers[i]);
+    m_table->setHorizontalHeaderLabels(headers);
+
+    m_table->setMaximumHeight(220);
+    boxLay->addWidget(m_table);
+
+    QVBoxLayout* root = new QVBoxLayout(this);
+    root->setContentsMargins(0, 0, 0, 0);
+    root->addWidget(box);
+}
+
+void ProfilingPanel::onCollectTick()
+{
+    const std::vector<Profiler::ProbeStats> stats = Profiler::collect();
+
+    // Une ligne par (système, sonde) au premier passage : la liste ne fait que croître
+    if (m_table->rowCount() != static_cast<int>(stats.size())) {
+        m_table->setRowCount(static_cast<int>(stats.size()));
+        for (int row = 0; row < m_table->rowCount(); ++row) {
+            for (int col = 0; col < k_cols; ++col) {
+                if (!m_table->item(row, col))
+                    m_table->setItem(row, col, new QTableWidgetItem());
+            }
+        }
+    }
+
+    for (int row = 0; row < static_cast<int>(stats.size()); ++row) {
+        const Profiler::ProbeStats& s = stats[static_cast<std::size_t>(row)];
+        m_table->item(row, 0)->setText(s.system.empty()
+            ? QStringLiteral("—") : QString::fromStdString(s.system));
+        m_table->item(row, 1)->setText(QString::fromStdString(s.name));
+
+        switch (s.kind) {
+        case Profiler::Kind::Timer:
+            m_table->item(row, 2)->setText(QString::number(s.perSecond, 'f', 0));
+            m_table->item(row, 3)->setText(QString::number(s.meanUs, 'f', 2));
+            m_table->item(row, 4)->setText(QString::number(s.maxUs, 'f', 1));
+            m_table->item(row, 5)->setText(QString::number(s.loadPercent, 'f', 1));
+            break;
+        case Profiler::Kind::Counter:
+            m_table->item(row, 2)->setText(QString::number(s.perSecond, 'f', 0));
+            m_table->item(row, 3)->setText(QStringLiteral("total %1").arg(s.total));
+            m_table->item(row, 4)->setText(QString());
+            m_table->item(row, 5)->setText(QString());
+            break;
+        case Profiler::Kind::Gauge:
+            // Profondeur de file : valeur courante, maximum de l'intervalle
+            m_table->item(row, 2)->setText(QString());
+            m_table->item(row, 3)->setText(QStringLiteral("= %1").arg(s.gaugeLast));
+            m_table->item(row, 4)->setText(QStringLiteral("≤ %1").arg(s.gaugeMax));
+            m_table->item(row, 5)->setText(QString());
+            break;
+        }
+    }
+}
@@ -0,0 +1,30 @@
+﻿#pragma once
+#ifndef PROFILINGPANEL_H
+#define PROFILINGPANEL_H
+
+#include <QWidget>
+#include <QTableWidget>
+#include <QTimer>
+
+/**
+ * @brief Affichage des sondes MOBOT_PROFILE (Profiler), rafraîchi une fois par seconde
+ *
+ * Une ligne par (système, sonde) : appels/s, durée moyenne et maximale, charge du
+ * thread pour les Timer ; dernière valeur et maximum de l'intervalle pour les Gauge.
+ * Créé par MainWindow uniquement si MOBOT_PROFILE est défini.
+ */
+class ProfilingPanel : public QWidget {
+    Q_OBJECT
+
+public:
+    explicit ProfilingPanel(QWidget* parent = nullptr);
+
+private:
+    void buildUi();
+    void onCollectTick();
+
+    QTableWidget* m_table = nullptr;
+    QTimer* m_collectTimer = nullptr;
+};
+
+#endif // PROFILINGPANEL_H
@@ -0,0 +1,300 @@
+#include "QtmRtClient.h"
+#include <chrono>
+#include <cstring>
+
+namespace {
+
+constexpr int kInitialTcpBufferSize = 64 * 1024;
+constexpr int kUdpBufferSize        = 65536;
+
+int remainingMs(std::chrono::steady_clock::time_point deadline)
+{
+    const auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+        deadline - std::chrono::steady_clock::now()).count();
+    return left > 0 ? static_cast<int>(left) : 0;
+}
+
+} // namespace
+
+QtmRtClient::~QtmRtClient()
+{
+    disconnect();
+}
+
+// =============================================================================
+// Connexion
+// =============================================================================
+
+bool QtmRtClient::connect(const Settings& settings)
+{
+    disconnect();
+    m_settings = settings;
+    m_lastError.clear();
+
+    m_tcpBuffer.assign(kInitialTcpBufferSize, '\0');
+    m_tcpBegin = m_tcpEnd = 0;
+
+    const std::string endpoint = settings.serverAddress + ":" + std::to_string(settings.port);
+    if (!m_tcp.connectTo(settings.serverAddress, settings.port, settings.timeoutMs)) {
+        m_lastError = "Cannot connect to QTM at " + endpoint;
+        return false;
+    }
+    m_tcp.setNoDelay(true);
+    if (settings.recvBufferSize > 0)
+        m_tcp.setRecvBufferSize(settings.recvBufferSize);
+
+    // Facultatif : sans canal de réveil, receive(-1) reste borné (kFallbackTimeoutMs)
+    m_wakeup.open();
+
+    // QTM annonce la connexion ("QTM RT Interface connected") avant toute commande
+    const auto deadline = std::chrono::steady_clock::now()
+        + std::chrono::milliseconds(settings.timeoutMs);
+    Message welcome = Message::None;
+    while (welcome != Message::Command && welcome != Message::Error && welcome != Message::Disconnected) {
+        const int left = remainingMs(deadline);
+        if (left == 0)
+            break;
+        welcome = receive(left);
+    }
+    if (welcome != Message::Command) {
+        m_lastError = welcome == Message::Error
+            ? "QTM refused the connection: " + m_lastText
+            : "No welcome message from QTM at " + endpoint;
+        disconnect();
+        return false;
+    }
+
+    const std::string version = std::to_string(settings.majorVersion) + "." + std::to_string(settings.minorVersion);
+    if (request("Version " + version, Message::Command) != Message::Command
+        || m_lastText.compare(0, 14, "Version set to") != 0) {
+        m_lastError = "QTM does not support RT protocol " + version
+                    + (m_lastText.empty() ? std::string() : " (" + m_lastText + ")");
+        disconnect();
+        return false;
+    }
+
+    if (settings.useUdp) {
+        m_udp = std::make_unique<NativeUdpSocket>("0.0.0.0", settings.udpPort, settings.recvBufferSize);
+        if (!m_udp->open() || !m_udp->bind()) {
+            m_lastError = "Cannot open UDP data port " + std::to_string(settings.udpPort);
+            disconnect();
+            return false;
+        }
+        m_udpBuffer.assign(kUdpBufferSize, '\0');
+    }
+    return true;
+}
+
+void QtmRtClient::disconnect()
+{
+    m_udp.reset();
+    m_tcp.close();
+    m_wakeup.close();
+    m_tcpBegin = m_tcpEnd = 0;
+}
+
+// =============================================================================
+// Commandes
+// =============================================================================
+
+bool QtmRtClient::sendCommand(const std::string& command)
+{
+    const std::string packet = QtmRtPacket::buildCommand(command);
+    return m_tcp.sendAll(packet.data(), static_cast<int>(packet.size())) == static_cast<int>(packet.size());
+}
+
+QtmRtClient::Message QtmRtClient::request(const std::string& command, Message expected)
+{
+    m_lastText.clear();
+    if (!sendCommand(command)) {
+        m_lastError = "Cannot send '" + command + "' to QTM";
+        return Message::Disconnected;
+    }
+
+    // Paquets de données ou événements intercalés : ignorés jusqu'à la réponse
+    const auto deadline = std::chrono::steady_clock::now()
+        + std::chrono::milliseconds(m_settings.timeoutMs);
+    while (true) {
+        const int left = remainingMs(deadline);
+        if (left == 0)
+            return Message::None;
+        const Message message = receive(left);
+        if (message == expected || message == Message::Error || message == Message::Disconnected)
+            return message;
+    }
+}
+
+bool QtmRtClient::read6dSettings(std::vector<std::string>& bodyNames)
+{
+    const Message reply = request("GetParameters 6D", Message::Xml);
+    if (reply != Message::Xml) {
+        m_lastError = reply == Message::Error
+            ? "GetParameters 6D failed: " + m_lastText
+            : "No 6D parameters from QTM";
+        return false;
+    }
+    bodyNames = QtmRtPacket::parse6dBodyNames(m_lastText);
+    return true;
+}
+
+bool QtmRtClient::readGeneralSettings(double& cameraFrequency)
+{
+    const Message reply = request("GetParameters General", Message::Xml);
+    if (reply != Message::Xml) {
+        m_lastError = reply == Message::Error
+            ? "GetParameters General failed: " + m_lastText
+            : "No general parameters from QTM";
+        return false;
+    }
+    if (!QtmRtPacket::parseGeneralFrequency(m_lastText, cameraFrequency)) {
+        m_lastError = "No capture frequency in QTM general parameters";
+        return false;
+    }
+    return true;
+}
+
+bool QtmRtClient::streamFrames(const std::string& rate, const std::string& components)
+{
+    // Pas de réponse en cas de succès : une erreur éventuelle arrive par receive()
+    std::string command = "StreamFrames " + rate;
+    if (m_udp)
+        command += " UDP:" + std::to_string(m_udp->localPort());
+    command += " " + components;
+
+    if (!sendCommand(command)) {
+        m_lastError = "Cannot send StreamFrames to QTM";
+        return false;
+    }
+    return true;
+}
+
+bool QtmRtClient::stopStreaming()
+{
+    return sendCommand("StreamFrames Stop");
+}
+
+// =============================================================================
+// Réception
+// =============================================================================
+
+QtmRtClient::Message QtmRtClient::receive(int timeoutMs)
+{
+    if (!m_tcp.isConnected())
+        return Message::Disconnected;
+
+    const char* packet = nullptr;
+    int size = 0;
+
+    // Paquets déjà reçus (plusieurs paquets TCP par lecture à haute fréquence)
+    int buffered = nextBufferedPacket(packet, size);
+    if (buffered > 0)
+        return handlePacket(packet, size);
+    if (buffered < 0)
+        return Message::Disconnected;
+
+    // Socket de données UDP en premier : les frames déjà arrivées passent avant
+    // un NoMoreData ou une réponse arrivés ensuite sur le canal TCP
+    const SOCKET handles[2] = { m_udp ? m_udp->nativeHandle() : INVALID_SOCKET, m_tcp.nativeHandle() };
+    const int ready = m_wakeup.waitForAny(handles, 2, timeoutMs);
+    if (ready < 0)
+        return Message::None;
+
+    if (ready == 0) {
+        // Flux UDP : un datagramme = un paquet complet, analysé en place
+        char senderIp[64];
+        u_short senderPort = 0;
+        const int length = m_udp->recvFrom(m_udpBuffer.data(), static_cast<int>(m_udpBuffer.size()),
+            senderIp, sizeof(senderIp), senderPort);
+        uint32_t packetSize = 0, packetType = 0;
+        if (length <= 0 || !QtmRtPacket::readHeader(m_udpBuffer.data(), length, packetSize, packetType)
+            || packetSize > static_cast<uint32_t>(length))
+            return Message::Invalid;
+        return handlePacket(m_udpBuffer.data(), static_cast<int>(packetSize));
+    }
+
+    // Flux TCP : compacter le reste du paquet précédent (la vue rendue avant est périmée)
+    if (m_tcpBegin > 0) {
+        std::memmove(m_tcpBuffer.data(), m_tcpBuffer.data() + m_tcpBegin, m_tcpEnd - m_tcpBegin);
+        m_tcpEnd  -= m_tcpBegin;
+        m_tcpBegin = 0;
+    }
+
+    // Paquet annoncé plus grand que le tampon (XML volumineux) : agrandir une fois
+    uint32_t packetSize = 0, packetType = 0;
+    if (QtmRtPacket::readHeader(m_tcpBuffer.data(), m_tcpEnd, packetSize, packetType)
+        && packetSize > m_tcpBuffer.size())
+        m_tcpBuffer.resize(packetSize);
+
+    const int received = m_tcp.recv(m_tcpBuffer.data() + m_tcpEnd,
+        static_cast<int>(m_tcpBuffer.size()) - m_tcpEnd);
+    if (received <= 0) {
+        m_lastError = "QTM closed the connection";
+        m_tcp.close();
+        return Message::Disconnected;
+    }
+    m_tcpEnd += received;
+
+    buffered = nextBufferedPacket(packet, size);
+    if (buffered > 0)
+        return handlePacket(packet, size);
+    return buffered < 0 ? Message::Disconnected : Message::None;
+}
+
+int QtmRtClient::nextBufferedPacket(const char*& packet, int& size)
+{
+    const int available = m_tcpEnd - m_tcpBegin;
+    if (available < QtmRtProtocol::kHeaderSize)
+        return 0;
+
+    uint32_t packetSize = 0, packetType = 0;
+    if (!QtmRtPacket::readHeader(m_tcpBuffer.data() + m_tcpBegin, available, packetSize, packetType)) {
+        // Flux TCP désynchronisé : irrécupérable sans reconnexion
+        m_lastError = "Corrupted QTM stream (invalid packet header)";
+        m_tcp.close();
+        return -1;
+    }
+    if (packetSize > static_cast<uint32_t>(available))
+        return 0;
+
+    packet = m_tcpBuffer.data() + m_tcpBegin;
+    size   = static_cast<int>(packetSize);
+    m_tcpBegin += size;
+    return 1;
+}
+
+QtmRtClient::Message QtmRtClient::handlePacket(const char* packet, int size)
+{
+    uint32_t packetSize = 0, packetType = 0;
+    if (!QtmRtPacket::readHeader(packet, size, packetSize, packetType))
+        return Message::Invalid;
+
+    const char* payload     = packet + QtmRtProtocol::kHeaderSize;
+    const int   payloadSize = size - QtmRtProtocol::kHeaderSize;
+
+    switch (packetType) {
+    case QtmRtProtocol::PacketData:
+        return m_dataPacket.parse(payload, payloadSize) ? Message::Data : Message::Invalid;
+
+    case QtmRtProtocol::PacketNoMoreData:
+        return Message::NoMoreData;
+
+    case QtmRtProtocol::PacketEvent:
+        m_lastEvent = payloadSize > 0 ? static_cast<uint8_t>(payload[0]) : 0;
+        return Message::Event;
+
+    case QtmRtProtocol::PacketCommand:
+        m_lastText = QtmRtPacket::payloadText(payload, payloadSize);
+        return Message::Command;
+
+    case QtmRtProtocol::PacketXml:
+        m_lastText = QtmRtPacket::payloadText(payload, payloadSize);
+        return Message::Xml;
+
+    case QtmRtProtocol::PacketError:
+        m_lastText = QtmRtPacket::payloadText(payload, payloadSize);
+        return Message::Error;
+
+    default:
+        return Message::None;   // C3D, QTM file, discover : non utilisés
+    }
+}
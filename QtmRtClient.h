@@ -0,0 +1,128 @@
+#pragma once
+#ifndef QTMRTCLIENT_H
+#define QTMRTCLIENT_H
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "NativeTcpSocket.h"
+#include "NativeUdpSocket.h"
+#include "QtmRtProtocol.h"
+#include "WakeupChannel.h"
+
+/**
+ * @brief Client QTM RT intégré : flux temps réel Qualisys sans CRTProtocol (SDK)
+ *
+ * Canal de commande TCP (version, paramètres, StreamFrames) ; données sur ce même
+ * canal TCP ou sur un port UDP local annoncé à QTM ("StreamFrames ... UDP:port").
+ * Les paquets sont analysés en place dans le tampon de réception (QtmDataPacket) :
+ * aucune copie entre le socket et la lecture des corps.
+ *
+ * Sans SDK ni Qt : se compile sous Windows (Winsock) comme sous Linux, par ex.
+ *   g++ -std=c++17 -c QtmRtClient.cpp QtmRtProtocol.cpp NativeTcpSocket.cpp NativeUdpSocket.cpp WakeupChannel.cpp
+ * et se teste contre un serveur de substitution qui rejoue des paquets enregistrés.
+ *
+ * Threads : connect / read6dSettings / disconnect hors réception ;
+ * streamFrames / stopStreaming / receive depuis le thread d'acquisition ;
+ * wakeup() depuis n'importe quel thread.
+ */
+class QtmRtClient {
+public:
+    struct Settings {
+        std::string serverAddress  = "127.0.0.1";
+        uint16_t    port           = QtmRtProtocol::kDefaultLittleEndianPort;
+        int         majorVersion   = 1;
+        int         minorVersion   = 19;
+        bool        useUdp         = false;
+        uint16_t    udpPort        = 0;       // 0 = port éphémère
+        int         timeoutMs      = 2000;    // Connexion et réponses aux commandes
+        int         recvBufferSize = 4 * 1024 * 1024;
+    };
+
+    enum class Message {
+        None,           // Délai écoulé, paquet TCP incomplet ou type ignoré
+        Data,           // Paquet de données prêt : dataPacket()
+        NoMoreData,     // Fin du flux (mesure arrêtée dans QTM)
+        Event,          // Événement QTM : lastEvent()
+        Command,        // Réponse texte : lastText()
+        Xml,            // Paramètres XML : lastText()
+        Error,          // Erreur QTM : lastText()
+        Disconnected,   // Connexion TCP fermée
+        Invalid         // Paquet incohérent
+    };
+
+    QtmRtClient() = default;
+    ~QtmRtClient();
+
+    QtmRtClient(const QtmRtClient&) = delete;
+    QtmRtClient& operator=(const QtmRtClient&) = delete;
+
+    // ========== Connexion ==========
+
+    bool connect(const Settings& settings);
+    void disconnect();
+    bool isConnected() const { return m_tcp.isConnected(); }
+
+    const std::string& lastError() const { return m_lastError; }
+
+    // ========== Commandes ==========
+
+    /** @brief "GetParameters 6D" : noms des corps, dans l'ordre des paquets de données */
+    bool read6dSettings(std::vector<std::string>& bodyNames);
+
+    /** @brief "GetParameters General" : fréquence de capture des caméras (Hz) */
+    bool readGeneralSettings(double& cameraFrequency);
+
+    /**
+     * @brief Démarre le flux : "StreamFrames <rate> [UDP:port] <components>"
+     * @param rate        "AllFrames", "Frequency:n" ou "FrequencyDivisor:n"
+     * @param components  Liste QTM séparée par des espaces, ex. "6DEuler" ou "6DRes"
+     */
+    bool streamFrames(const std::string& rate, const std::string& components);
+    bool stopStreaming();
+
+    /** @brief Commande texte sans attente de réponse (la réponse arrive par receive()) */
+    bool sendCommand(const std::string& command);
+
+    // ========== Réception (thread d'acquisition) ==========
+
+    /** @brief timeoutMs < 0 : attente sans délai, interrompue par wakeup() */
+    Message receive(int timeoutMs);
+
+    /** @brief Fait rendre Message::None au receive() en cours (arrêt, changement de consigne) */
+    void wakeup() { m_wakeup.wake(); }
+
+    /** @brief Dernier paquet de données : vue valide jusqu'au receive() suivant */
+    const QtmDataPacket& dataPacket() const { return m_dataPacket; }
+
+    const std::string& lastText() const { return m_lastText; }
+    uint8_t lastEvent() const { return m_lastEvent; }
+
+private:
+    /** @brief Commande + attente d'une réponse du type attendu (hors flux) */
+    Message request(const std::string& command, Message expected);
+
+    /** @brief Paquet en tête du tampon TCP, sans copie : 1 complet, 0 incomplet, -1 en-tête invalide */
+    int nextBufferedPacket(const char*& packet, int& size);
+    Message handlePacket(const char* packet, int size);
+
+    Settings    m_settings;
+    std::string m_lastError;
+
+    NativeTcpSocket                  m_tcp;
+    std::unique_ptr<NativeUdpSocket> m_udp;   // nullptr en flux TCP
+    WakeupChannel                    m_wakeup;
+
+    // Flux TCP : octets reçus [m_tcpBegin, m_tcpEnd) ; compacté seulement au receive() suivant
+    std::vector<char> m_tcpBuffer;
+    int               m_tcpBegin = 0;
+    int               m_tcpEnd   = 0;
+
+    std::vector<char> m_udpBuffer;
+
+    QtmDataPacket m_dataPacket;
+    std::string   m_lastText;
+    uint8_t       m_lastEvent = 0;
+};
+
+#endif // QTMRTCLIENT_H
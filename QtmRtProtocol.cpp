@@ -0,0 +1,289 @@
+#include "QtmRtProtocol.h"
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+template<typename T>
+T readAt(const char* data)
+{
+    T value;
+    std::memcpy(&value, data, sizeof(T));
+    return value;
+}
+
+constexpr int kComponentHeaderSize = 8;    // uint32 taille, uint32 type
+constexpr int kBodyHeaderSize      = 8;    // uint32 nombre de corps, uint16 drop, uint16 out of sync
+constexpr int kFrameHeaderSize     = 16;   // int64 timestamp, uint32 frame, uint32 nombre de composants
+
+std::string decodeEntities(const std::string& text)
+{
+    if (text.find('&') == std::string::npos)
+        return text;
+
+    static const struct { const char* entity; char value; } kEntities[] = {
+        { "&amp;", '&' }, { "&lt;", '<' }, { "&gt;", '>' }, { "&quot;", '"' }, { "&apos;", '\'' }
+    };
+
+    std::string result;
+    result.reserve(text.size());
+    for (size_t i = 0; i < text.size(); ++i) {
+        bool replaced = false;
+        if (text[i] == '&') {
+            for (const auto& e : kEntities) {
+                const size_t len = std::strlen(e.entity);
+                if (text.compare(i, len, e.entity) == 0) {
+                    result += e.value;
+                    i += len - 1;
+                    replaced = true;
+                    break;
+                }
+            }
+        }
+        if (!replaced)
+            result += text[i];
+    }
+    return result;
+}
+
+} // namespace
+
+// =============================================================================
+// QtmDataPacket
+// =============================================================================
+
+bool QtmDataPacket::parse(const char* payload, int size)
+{
+    m_6d    = BodyComponent();
+    m_euler = BodyComponent();
+    m_dropRate2d = m_outOfSyncRate2d = 0;
+
+    if (!payload || size < kFrameHeaderSize)
+        return false;
+
+    m_timestamp   = readAt<int64_t>(payload);
+    m_frameNumber = readAt<uint32_t>(payload + 8);
+    const uint32_t componentCount = readAt<uint32_t>(payload + 12);
+
+    const char* pos = payload + kFrameHeaderSize;
+    const char* end = payload + size;
+
+    for (uint32_t c = 0; c < componentCount; ++c) {
+        if (end - pos < kComponentHeaderSize)
+            return false;
+        const uint32_t componentSize = readAt<uint32_t>(pos);
+        const uint32_t componentType = readAt<uint32_t>(pos + 4);
+        if (componentSize < static_cast<uint32_t>(kComponentHeaderSize)
+            || componentSize > static_cast<uint32_t>(end - pos))
+            return false;
+
+        const int bytes = static_cast<int>(componentSize);
+        bool ok = true;
+        switch (componentType) {
+        case QtmRtProtocol::Component6d:
+            ok = parseBodyComponent(pos, bytes, 12, false, m_6d);
+            break;
+        case QtmRtProtocol::Component6dRes:
+            ok = parseBodyComponent(pos, bytes, 13, true, m_6d);
+            break;
+        case QtmRtProtocol::Component6dEuler:
+            ok = parseBodyComponent(pos, bytes, 6, false, m_euler);
+            break;
+        case QtmRtProtocol::Component6dEulerRes:
+            ok = parseBodyComponent(pos, bytes, 7, true, m_euler);
+            break;
+        default:
+            break;  // Composant non utilisé : sauté d'un bloc
+        }
+        if (!ok)
+            return false;
+
+        pos += componentSize;
+    }
+    return true;
+}
+
+bool QtmDataPacket::parseBodyComponent(const char* component, int size, int floatsPerBody,
+    bool residual, BodyComponent& out)
+{
+    if (size < kComponentHeaderSize + kBodyHeaderSize)
+        return false;
+
+    const uint32_t count = readAt<uint32_t>(component + kComponentHeaderSize);
+    const int      stride = floatsPerBody * static_cast<int>(sizeof(float));
+    const int      available = size - kComponentHeaderSize - kBodyHeaderSize;
+    if (count > static_cast<uint32_t>(available / stride))
+        return false;
+
+    m_dropRate2d      = readAt<uint16_t>(component + kComponentHeaderSize + 4);
+    m_outOfSyncRate2d = readAt<uint16_t>(component + kComponentHeaderSize + 6);
+
+    out.data     = component + kComponentHeaderSize + kBodyHeaderSize;
+    out.count    = static_cast<int>(count);
+    out.stride   = stride;
+    out.residual = residual;
+    return true;
+}
+
+bool QtmDataPacket::body6d(int index, QtmBody6d& body) const
+{
+    if (index < 0 || index >= m_6d.count)
+        return false;
+
+    const char* src = m_6d.data + index * m_6d.stride;
+    std::memcpy(&body.x, src, 3 * sizeof(float));
+    std::memcpy(body.rotation, src + 3 * sizeof(float), 9 * sizeof(float));
+    body.residual = m_6d.residual ? readAt<float>(src + 12 * sizeof(float)) : -1.0f;
+    return true;
+}
+
+bool QtmDataPacket::body6dEuler(int index, QtmBodyEuler& body) const
+{
+    if (index < 0 || index >= m_euler.count)
+        return false;
+
+    const char* src = m_euler.data + index * m_euler.stride;
+    std::memcpy(&body.x, src, 3 * sizeof(float));
+    std::memcpy(body.angles, src + 3 * sizeof(float), 3 * sizeof(float));
+    body.residual = m_euler.residual ? readAt<float>(src + 6 * sizeof(float)) : -1.0f;
+    return true;
+}
+
+// =============================================================================
+// QtmBody6d
+// =============================================================================
+
+void QtmBody6d::quaternion(double& qx, double& qy, double& qz, double& qw) const
+{
+    // R[ligne][colonne], stockage colonne par colonne
+    const double r00 = rotation[0], r10 = rotation[1], r20 = rotation[2];
+    const double r01 = rotation[3], r11 = rotation[4], r21 = rotation[5];
+    const double r02 = rotation[6], r12 = rotation[7], r22 = rotation[8];
+
+    const double trace = r00 + r11 + r22;
+    if (trace > 0.0) {
+        const double s = 2.0 * std::sqrt(1.0 + trace);          // s = 4·qw
+        qw = 0.25 * s;
+        qx = (r21 - r12) / s;
+        qy = (r02 - r20) / s;
+        qz = (r10 - r01) / s;
+    }
+    else if (r00 > r11 && r00 > r22) {
+        const double s = 2.0 * std::sqrt(1.0 + r00 - r11 - r22); // s = 4·qx
+        qw = (r21 - r12) / s;
+        qx = 0.25 * s;
+        qy = (r01 + r10) / s;
+        qz = (r02 + r20) / s;
+    }
+    else if (r11 > r22) {
+        const double s = 2.0 * std::sqrt(1.0 + r11 - r00 - r22); // s = 4·qy
+        qw = (r02 - r20) / s;
+        qx = (r01 + r10) / s;
+        qy = 0.25 * s;
+        qz = (r12 + r21) / s;
+    }
+    else {
+        const double s = 2.0 * std::sqrt(1.0 + r22 - r00 - r11); // s = 4·qz
+        qw = (r10 - r01) / s;
+        qx = (r02 + r20) / s;
+        qy = (r12 + r21) / s;
+        qz = 0.25 * s;
+    }
+
+    // Matrice en float : renormaliser ; hémisphère qw >= 0 pour un flux continu
+    const double norm = std::sqrt(qx * qx + qy * qy + qz * qz + qw * qw);
+    const double scale = (qw < 0.0 ? -1.0 : 1.0) / (norm > 0.0 ? norm : 1.0);
+    qx *= scale;
+    qy *= scale;
+    qz *= scale;
+    qw *= scale;
+}
+
+// =============================================================================
+// QtmRtPacket
+// =============================================================================
+
+bool QtmRtPacket::readHeader(const char* data, int length, uint32_t& packetSize, uint32_t& packetType)
+{
+    if (!data || length < QtmRtProtocol::kHeaderSize)
+        return false;
+
+    packetSize = readAt<uint32_t>(data);
+    packetType = readAt<uint32_t>(data + 4);
+    return packetSize >= static_cast<uint32_t>(QtmRtProtocol::kHeaderSize)
+        && packetSize <= static_cast<uint32_t>(QtmRtProtocol::kMaxPacketSize);
+}
+
+std::string QtmRtPacket::buildCommand(const std::string& command)
+{
+    const uint32_t size = static_cast<uint32_t>(QtmRtProtocol::kHeaderSize + command.size() + 1);
+    const uint32_t type = QtmRtProtocol::PacketCommand;
+
+    std::string packet(size, '\0');
+    std::memcpy(&packet[0], &size, sizeof(size));
+    std::memcpy(&packet[4], &type, sizeof(type));
+    std::memcpy(&packet[QtmRtProtocol::kHeaderSize], command.data(), command.size());
+    return packet;
+}
+
+std::string QtmRtPacket::payloadText(const char* payload, int size)
+{
+    if (!payload || size <= 0)
+        return std::string();
+    const void* nul = std::memchr(payload, '\0', static_cast<size_t>(size));
+    return std::string(payload, nul ? static_cast<const char*>(nul) - payload : size);
+}
+
+std::vector<std::string> QtmRtPacket::parse6dBodyNames(const std::string& xml)
+{
+    std::vector<std::string> names;
+
+    const size_t sectionBegin = xml.find("<The_6D>");
+    if (sectionBegin == std::string::npos)
+        return names;
+    size_t sectionEnd = xml.find("</The_6D>", sectionBegin);
+    if (sectionEnd == std::string::npos)
+        sectionEnd = xml.size();
+
+    size_t pos = sectionBegin;
+    while (true) {
+        const size_t body = xml.find("<Body>", pos);
+        if (body == std::string::npos || body >= sectionEnd)
+            break;
+        const size_t bodyEnd = xml.find("</Body>", body);
+        const size_t nameBegin = xml.find("<Name>", body);
+        if (nameBegin == std::string::npos || nameBegin >= bodyEnd)
+            break;
+        const size_t valueBegin = nameBegin + 6;
+        const size_t valueEnd = xml.find("</Name>", valueBegin);
+        if (valueEnd == std::string::npos || valueEnd > bodyEnd)
+            break;
+
+        names.push_back(decodeEntities(xml.substr(valueBegin, valueEnd - valueBegin)));
+        pos = (bodyEnd == std::string::npos) ? valueEnd : bodyEnd;
+    }
+    return names;
+}
+
+bool QtmRtPacket::parseGeneralFrequency(const std::string& xml, double& frequency)
+{
+    const size_t section = xml.find("<General>");
+    if (section == std::string::npos)
+        return false;
+
+    // Premier <Frequency> de la section : celui du système (les caméras n'en ont pas)
+    const size_t begin = xml.find("<Frequency>", section);
+    const size_t sectionEnd = xml.find("</General>", section);
+    if (begin == std::string::npos || (sectionEnd != std::string::npos && begin > sectionEnd))
+        return false;
+
+    const char* value = xml.c_str() + begin + 11;
+    char* parsed = nullptr;
+    const double hz = std::strtod(value, &parsed);
+    if (parsed == value || !(hz > 0.0))
+        return false;
+
+    frequency = hz;
+    return true;
+}
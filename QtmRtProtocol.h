@@ -0,0 +1,175 @@
+#pragma once
+#ifndef QTMRTPROTOCOL_H
+#define QTMRTPROTOCOL_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Constantes du protocole temps réel QTM (types de paquets et de composants)
+ *
+ * Chaque paquet commence par un en-tête de 8 octets : uint32 taille totale
+ * (en-tête compris), uint32 type. Port de base + 1 (22223) : little-endian.
+ */
+namespace QtmRtProtocol {
+
+enum PacketType : uint32_t {
+    PacketError      = 0,
+    PacketCommand    = 1,
+    PacketXml        = 2,
+    PacketData       = 3,
+    PacketNoMoreData = 4,
+    PacketC3dFile    = 5,
+    PacketEvent      = 6,
+    PacketDiscover   = 7,
+    PacketQtmFile    = 8,
+    PacketNone       = 9
+};
+
+enum ComponentType : uint32_t {
+    Component3d          = 1,
+    Component3dNoLabels  = 2,
+    ComponentAnalog      = 3,
+    ComponentForce       = 4,
+    Component6d          = 5,
+    Component6dEuler     = 6,
+    Component2d          = 7,
+    Component2dLin       = 8,
+    Component3dRes       = 9,
+    Component3dNoLabelsRes = 10,
+    Component6dRes       = 11,
+    Component6dEulerRes  = 12,
+    ComponentAnalogSingle = 13,
+    ComponentImage       = 14,
+    ComponentForceSingle = 15,
+    ComponentGazeVector  = 16,
+    ComponentTimecode    = 17,
+    ComponentSkeleton    = 18,
+    ComponentEyeTracker  = 19
+};
+
+constexpr int      kHeaderSize          = 8;
+constexpr int      kMaxPacketSize       = 16 * 1024 * 1024;  // Garde-fou contre un en-tête corrompu
+constexpr uint16_t kDefaultLittleEndianPort = 22223;
+
+} // namespace QtmRtProtocol
+
+/**
+ * @brief Corps 6DOF avec matrice de rotation (composants 6D / 6DRes), mm
+ *
+ * rotation : 9 éléments dans l'ordre du flux QTM, colonne par colonne
+ * (r11, r21, r31, r12, ...), soit R[ligne][colonne] = rotation[colonne * 3 + ligne].
+ * Corps non suivi : positions NaN.
+ */
+struct QtmBody6d {
+    float x = 0.0f;
+    float y = 0.0f;
+    float z = 0.0f;
+    float rotation[9] = {};
+    float residual = -1.0f;     // mm, -1 si composant sans résidu
+
+    /**
+     * @brief Matrice de rotation → quaternion unitaire (méthode de Shepperd)
+     *
+     * Pivot sur le plus grand de w², x², y², z² : pas de division par une
+     * quantité proche de zéro, quelle que soit l'orientation (pas de singularité).
+     */
+    void quaternion(double& qx, double& qy, double& qz, double& qw) const;
+};
+
+/**
+ * @brief Corps 6DOF en angles d'Euler (composants 6DEuler / 6DEulerRes), mm / degrés
+ *
+ * Angles dans la convention configurée dans QTM (Project Options > Euler angles).
+ */
+struct QtmBodyEuler {
+    float x = 0.0f;
+    float y = 0.0f;
+    float z = 0.0f;
+    float angles[3] = {};
+    float residual = -1.0f;     // mm, -1 si composant sans résidu
+};
+
+/**
+ * @brief Vue sur un paquet de données QTM, sans copie
+ *
+ * parse() indexe les composants 6DOF en place dans le tampon de réception ;
+ * les accesseurs lisent ensuite directement les corps demandés. La vue reste
+ * valide tant que le tampon n'est pas réutilisé (jusqu'au receive() suivant).
+ *
+ * Hypothèse : hôte little-endian (x86, ARM usuels), comme le port 22223.
+ */
+class QtmDataPacket {
+public:
+    /** @brief Charge utile d'un paquet PacketData (après l'en-tête de 8 octets) */
+    bool parse(const char* payload, int size);
+
+    int64_t  timestamp() const { return m_timestamp; }      // µs, horloge QTM
+    uint32_t frameNumber() const { return m_frameNumber; }
+
+    bool has6d() const { return m_6d.data != nullptr; }
+    bool has6dEuler() const { return m_euler.data != nullptr; }
+
+    int bodyCount6d() const { return m_6d.count; }
+    int bodyCount6dEuler() const { return m_euler.count; }
+
+    /** @brief Pertes 2D / désynchronisation signalées par QTM (‰ des caméras), 6D ou 6DEuler */
+    uint16_t dropRate2d() const { return m_dropRate2d; }
+    uint16_t outOfSyncRate2d() const { return m_outOfSyncRate2d; }
+
+    bool body6d(int index, QtmBody6d& body) const;
+    bool body6dEuler(int index, QtmBodyEuler& body) const;
+
+private:
+    struct BodyComponent {
+        const char* data     = nullptr;   // Premier corps, dans le tampon de réception
+        int         count    = 0;
+        int         stride   = 0;
+        bool        residual = false;
+    };
+
+    bool parseBodyComponent(const char* component, int size, int floatsPerBody,
+        bool residual, BodyComponent& out);
+
+    int64_t       m_timestamp   = 0;
+    uint32_t      m_frameNumber = 0;
+    uint16_t      m_dropRate2d      = 0;
+    uint16_t      m_outOfSyncRate2d = 0;
+    BodyComponent m_6d;
+    BodyComponent m_euler;
+};
+
+/**
+ * @brief Paquets QTM RT : en-têtes, commandes, paramètres XML
+ */
+class QtmRtPacket {
+public:
+    /** @brief En-tête de paquet ; false si incomplet ou taille incohérente */
+    static bool readHeader(const char* data, int length, uint32_t& packetSize, uint32_t& packetType);
+
+    /** @brief Paquet commande (texte terminé par '\0') ; taille totale */
+    static std::string buildCommand(const std::string& command);
+
+    /** @brief Texte d'un paquet commande / erreur / XML (sans le '\0' final) */
+    static std::string payloadText(const char* payload, int size);
+
+    /**
+     * @brief Noms des corps de <The_6D> (réponse à "GetParameters 6D")
+     *
+     * Analyse volontairement minimale : seuls <Body><Name> sont extraits, dans
+     * l'ordre, qui est aussi l'ordre des corps dans les paquets de données.
+     */
+    static std::vector<std::string> parse6dBodyNames(const std::string& xml);
+
+    /**
+     * @brief Fréquence caméra de <General><Frequency> (réponse à "GetParameters General")
+     * @return false si absente ou non numérique
+     */
+    static bool parseGeneralFrequency(const std::string& xml, double& frequency);
+
+private:
+    QtmRtPacket() = default; // Classe utilitaire, pas d'instanciation
+};
+
+#endif // QTMRTPROTOCOL_H
@@ -0,0 +1,296 @@
+// ============================================================================
+// QtmRtProtocolTests.cpp - Décodage des paquets QTM RT (port little-endian)
+// ============================================================================
+// Paquets de données de référence construits selon la disposition du protocole
+// (composants 6D, 6DRes, 6DEuler, 6DEulerRes, plus un composant ignoré), puis
+// tronqués à chaque longueur ou corrompus (taille de composant au-delà du
+// paquet, nombre de corps au-delà du composant).
+// ============================================================================
+
+#include "QtmRtProtocol.h"
+#include "UnitTest.h"
+
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+/** @brief Composant : uint32 taille (en-tête compris), uint32 type, contenu */
+template<typename Content>
+void putComponent(PacketWriter& w, uint32_t type, Content content)
+{
+    const std::size_t at = w.reserveInt32();
+    const std::size_t from = at;
+    w.put<uint32_t>(type);
+    content();
+    w.patchSize(at, from);
+}
+
+/** @brief En-tête de corps 6DOF : nombre, pertes 2D, désynchronisation */
+void putBodyHeader(PacketWriter& w, uint32_t count)
+{
+    w.put<uint32_t>(count).put<uint16_t>(12).put<uint16_t>(3);
+}
+
+/**
+ * @brief Paquet de données : 3D ignoré, puis 6D (ou 6DRes) à deux corps et
+ *        6DEuler (ou 6DEulerRes) à un corps
+ */
+std::string buildDataPacket(bool residual)
+{
+    PacketWriter w;
+    w.put<int64_t>(123456789).put<uint32_t>(77).put<uint32_t>(3);
+
+    putComponent(w, QtmRtProtocol::Component3d, [&]() {            // sauté d'un bloc
+        w.put<uint32_t>(1).put<uint16_t>(0).put<uint16_t>(0)
+         .put<float>(1.0f).put<float>(2.0f).put<float>(3.0f).put<uint32_t>(1);
+    });
+
+    putComponent(w, residual ? QtmRtProtocol::Component6dRes : QtmRtProtocol::Component6d, [&]() {
+        putBodyHeader(w, 2);
+        for (int b = 0; b < 2; ++b) {
+            w.put<float>(100.0f * (b + 1)).put<float>(200.0f).put<float>(300.0f);
+            // Rotation de 90° autour de z, colonne par colonne
+            const float rotation[9] = { 0.0f, 1.0f, 0.0f, -1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f };
+            for (float r : rotation)
+                w.put<float>(r);
+            if (residual)
+                w.put<float>(0.5f * (b + 1));
+        }
+    });
+
+    putComponent(w, residual ? QtmRtProtocol::Component6dEulerRes : QtmRtProtocol::Component6dEuler, [&]() {
+        putBodyHeader(w, 1);
+        w.put<float>(-1.0f).put<float>(-2.0f).put<float>(-3.0f)
+         .put<float>(10.0f).put<float>(20.0f).put<float>(30.0f);
+        if (residual)
+            w.put<float>(0.25f);
+    });
+    return w.bytes();
+}
+
+bool parse(QtmDataPacket& packet, const std::string& bytes, int size)
+{
+    return packet.parse(bytes.data(), size);
+}
+
+void checkDataPacket(bool residual)
+{
+    const std::string bytes = buildDataPacket(residual);
+    QtmDataPacket packet;
+    CHECK(parse(packet, bytes, static_cast<int>(bytes.size())));
+    CHECK(packet.timestamp() == 123456789);
+    CHECK(packet.frameNumber() == 77);
+    CHECK(packet.has6d() && packet.has6dEuler());
+    CHECK(packet.bodyCount6d() == 2);
+    CHECK(packet.bodyCount6dEuler() == 1);
+    CHECK(packet.dropRate2d() == 12);
+    CHECK(packet.outOfSyncRate2d() == 3);
+
+    QtmBody6d body;
+    CHECK(packet.body6d(1, body));
+    CHECK(body.x == 200.0f && body.y == 200.0f && body.z == 300.0f);
+    CHECK(body.rotation[1] == 1.0f && body.rotation[3] == -1.0f && body.rotation[8] == 1.0f);
+    CHECK(body.residual == (residual ? 1.0f : -1.0f));
+    CHECK(!packet.body6d(2, body));
+    CHECK(!packet.body6d(-1, body));
+
+    QtmBodyEuler euler;
+    CHECK(packet.body6dEuler(0, euler));
+    CHECK(euler.x == -1.0f && euler.z == -3.0f);
+    CHECK(euler.angles[0] == 10.0f && euler.angles[2] == 30.0f);
+    CHECK(euler.residual == (residual ? 0.25f : -1.0f));
+    CHECK(!packet.body6dEuler(1, euler));
+}
+
+/** @brief Position du premier composant 6D/6DRes (après l'en-tête de frame et le 3D) */
+std::size_t sixDofComponentOffset()
+{
+    const std::string bytes = buildDataPacket(false);
+    uint32_t size3d = 0;
+    std::memcpy(&size3d, bytes.data() + 16, sizeof(size3d));
+    return 16 + size3d;
+}
+
+void registerDataPacket(UnitTest& tests)
+{
+    tests.add("QtmRt/data_6d_6dEuler", []() { checkDataPacket(false); });
+    tests.add("QtmRt/data_6dRes_6dEulerRes", []() { checkDataPacket(true); });
+
+    tests.add("QtmRt/data_truncated", []() {
+        for (const bool residual : { false, true }) {
+            const std::string bytes = buildDataPacket(residual);
+            int accepted = 0;
+            for (int size = 0; size < static_cast<int>(bytes.size()); ++size) {
+                // Copie exacte : un dépassement de lecture est visible sous sanitizer
+                const std::string truncated = bytes.substr(0, static_cast<std::size_t>(size));
+                QtmDataPacket packet;
+                if (parse(packet, truncated, size))
+                    ++accepted;
+                CHECK(!packet.has6d() || packet.bodyCount6d() <= 2);
+            }
+            CHECK(accepted == 0);
+        }
+    });
+
+    tests.add("QtmRt/data_componentSizeAbovePacket", []() {
+        const std::string bytes = buildDataPacket(false);
+        const std::size_t at = sixDofComponentOffset();
+        const uint32_t remaining = static_cast<uint32_t>(bytes.size() - at);
+        for (const uint32_t bad : { remaining + 1, 0xFFFFFFFFu, 0u, 7u }) {
+            std::string corrupted = bytes;
+            std::memcpy(&corrupted[at], &bad, sizeof(bad));
+            QtmDataPacket packet;
+            CHECK(!parse(packet, corrupted, static_cast<int>(corrupted.size())));
+            CHECK(!packet.has6d());
+        }
+    });
+
+    tests.add("QtmRt/data_bodyCountAboveComponent", []() {
+        const std::string bytes = buildDataPacket(true);
+        const std::size_t at = sixDofComponentOffset() + 8;         // nombre de corps
+        for (const uint32_t bad : { 3u, 0x80000000u, 0xFFFFFFFFu }) {
+            std::string corrupted = bytes;
+            std::memcpy(&corrupted[at], &bad, sizeof(bad));
+            QtmDataPacket packet;
+            CHECK(!parse(packet, corrupted, static_cast<int>(corrupted.size())));
+            CHECK(packet.bodyCount6d() == 0);
+        }
+    });
+
+    tests.add("QtmRt/data_componentCountAbovePacket", []() {
+        std::string bytes = buildDataPacket(false);
+        const uint32_t count = 4;
+        std::memcpy(&bytes[12], &count, sizeof(count));
+        QtmDataPacket packet;
+        CHECK(!parse(packet, bytes, static_cast<int>(bytes.size())));
+    });
+
+    tests.add("QtmRt/data_reuseResetsView", []() {
+        // Un paquet sans 6DOF ne garde pas la vue du précédent
+        const std::string bytes = buildDataPacket(false);
+        QtmDataPacket packet;
+        CHECK(parse(packet, bytes, static_cast<int>(bytes.size())));
+
+        PacketWriter empty;
+        empty.put<int64_t>(1).put<uint32_t>(2).put<uint32_t>(0);
+        CHECK(parse(packet, empty.bytes(), static_cast<int>(empty.size())));
+        CHECK(!packet.has6d() && !packet.has6dEuler());
+        CHECK(packet.bodyCount6d() == 0 && packet.dropRate2d() == 0);
+    });
+}
+
+// ===== Rotation =====
+
+void registerQuaternion(UnitTest& tests)
+{
+    tests.add("QtmRt/quaternion", []() {
+        auto near = [](double a, double b) { return std::fabs(a - b) < 1e-6; };
+        double qx = 0.0, qy = 0.0, qz = 0.0, qw = 0.0;
+
+        QtmBody6d body;
+        const float identity[9] = { 1, 0, 0, 0, 1, 0, 0, 0, 1 };
+        std::memcpy(body.rotation, identity, sizeof(identity));
+        body.quaternion(qx, qy, qz, qw);
+        CHECK(near(qx, 0.0) && near(qy, 0.0) && near(qz, 0.0) && near(qw, 1.0));
+
+        // 90° autour de z (colonne par colonne)
+        const float rz[9] = { 0, 1, 0, -1, 0, 0, 0, 0, 1 };
+        std::memcpy(body.rotation, rz, sizeof(rz));
+        body.quaternion(qx, qy, qz, qw);
+        CHECK(near(qz, std::sqrt(0.5)) && near(qw, std::sqrt(0.5)) && near(qx, 0.0));
+
+        // 180° autour de x : trace négative, pivot sur qx
+        const float rx[9] = { 1, 0, 0, 0, -1, 0, 0, 0, -1 };
+        std::memcpy(body.rotation, rx, sizeof(rx));
+        body.quaternion(qx, qy, qz, qw);
+        CHECK(near(std::fabs(qx), 1.0) && near(qw, 0.0));
+    });
+}
+
+// ===== En-têtes, commandes, XML =====
+
+void registerPackets(UnitTest& tests)
+{
+    tests.add("QtmRt/readHeader", []() {
+        PacketWriter w;
+        w.put<uint32_t>(24).put<uint32_t>(QtmRtProtocol::PacketData);
+        uint32_t size = 0, type = 0;
+        CHECK(QtmRtPacket::readHeader(w.bytes().data(), static_cast<int>(w.size()), size, type));
+        CHECK(size == 24 && type == QtmRtProtocol::PacketData);
+        CHECK(!QtmRtPacket::readHeader(w.bytes().data(), QtmRtProtocol::kHeaderSize - 1, size, type));
+
+        for (const uint32_t bad : { 0u, 7u, static_cast<uint32_t>(QtmRtProtocol::kMaxPacketSize) + 1 }) {
+            PacketWriter corrupted;
+            corrupted.put<uint32_t>(bad).put<uint32_t>(QtmRtProtocol::PacketData);
+            CHECK(!QtmRtPacket::readHeader(corrupted.bytes().data(), static_cast<int>(corrupted.size()),
+                size, type));
+        }
+    });
+
+    tests.add("QtmRt/buildCommand", []() {
+        const std::string command = "StreamFrames AllFrames 6DEuler";
+        const std::string packet = QtmRtPacket::buildCommand(command);
+        uint32_t size = 0, type = 0;
+        CHECK(QtmRtPacket::readHeader(packet.data(), static_cast<int>(packet.size()), size, type));
+        CHECK(size == packet.size());
+        CHECK(size == QtmRtProtocol::kHeaderSize + command.size() + 1);
+        CHECK(type == QtmRtProtocol::PacketCommand);
+        CHECK(packet.back() == '\0');
+
+        const std::string text = QtmRtPacket::payloadText(packet.data() + QtmRtProtocol::kHeaderSize,
+            static_cast<int>(size) - QtmRtProtocol::kHeaderSize);
+        CHECK(text == command);
+    });
+
+    tests.add("QtmRt/payloadText", []() {
+        CHECK(QtmRtPacket::payloadText("Connected", 9) == "Connected");  // sans '\0'
+        CHECK(QtmRtPacket::payloadText("Ok\0junk", 7) == "Ok");
+        CHECK(QtmRtPacket::payloadText(nullptr, 4).empty());
+        CHECK(QtmRtPacket::payloadText("x", 0).empty());
+    });
+
+    tests.add("QtmRt/parse6dBodyNames", []() {
+        const std::string xml =
+            "<QTM_Parameters_Ver_1.25>"
+            "<The_6D><Bodies>2</Bodies>"
+            "<Body><Name>Tool &amp; tip</Name><Color R=\"255\" G=\"0\" B=\"0\"/></Body>"
+            "<Body><Name>Base</Name></Body>"
+            "</The_6D>"
+            "<Skeletons><Body><Name>NotA6dBody</Name></Body></Skeletons>"
+            "</QTM_Parameters_Ver_1.25>";
+        const std::vector<std::string> names = QtmRtPacket::parse6dBodyNames(xml);
+        CHECK(names.size() == 2);
+        if (names.size() == 2)
+            CHECK(names[0] == "Tool & tip" && names[1] == "Base");
+
+        CHECK(QtmRtPacket::parse6dBodyNames("<General></General>").empty());
+
+        // Réponse tronquée : corps complets seulement
+        const std::string truncated = xml.substr(0, xml.find("<Name>Base") + 8);
+        CHECK(QtmRtPacket::parse6dBodyNames(truncated).size() == 1);
+    });
+
+    tests.add("QtmRt/parseGeneralFrequency", []() {
+        double hz = 0.0;
+        CHECK(QtmRtPacket::parseGeneralFrequency(
+            "<General><Frequency>250</Frequency><Camera><ID>1</ID></Camera></General>", hz));
+        CHECK(hz == 250.0);
+
+        hz = -1.0;
+        CHECK(!QtmRtPacket::parseGeneralFrequency("<General></General><Frequency>100</Frequency>", hz));
+        CHECK(!QtmRtPacket::parseGeneralFrequency("<General><Frequency>abc</Frequency></General>", hz));
+        CHECK(!QtmRtPacket::parseGeneralFrequency("<General><Frequency>0</Frequency></General>", hz));
+        CHECK(!QtmRtPacket::parseGeneralFrequency("<The_6D></The_6D>", hz));
+        CHECK(hz == -1.0);
+    });
+}
+
+} // namespace
+
+void registerQtmRtProtocolTests(UnitTest& tests)
+{
+    registerDataPacket(tests);
+    registerQuaternion(tests);
+    registerPackets(tests);
+}
@@ -20,6 +20,21 @@ struct QualisysConfig {
     bool           useUDP = false;
     unsigned short udpPort = 0;  // 0 = port auto-assigné
 
+    // Capture multi-corps : tous les corps 6DOF de chaque paquet (RigidBodyBatch)
+    bool captureAllBodies = false;
+
+    // Orientation : 6DRes (matrice de rotation + résidu) au lieu de 6DEuler.
+    // Quaternion et qualité réelle ; Euler recalculés à l'export (convention choisie)
+    bool streamRotationMatrix = false;
+
+    // Décimation côté QTM : cadence demandée = fréquence cible x suréchantillonnage,
+    // marge pour l'interpolation du synchroniseur (2 = au moins deux frames par échantillon)
+    double oversamplingFactor = 2.0;
+
+    // Latence : part constante non observable sans horloges synchronisées (trajet de la
+    // frame la plus rapide), ajoutée à l'estimation. 0 = latence au-delà de la meilleure frame
+    double latencyFloorMs = 0.0;
+
     QualisysConfig() = default;
 };
 
@@ -1,19 +1,37 @@
 #include "QualisysSystem.h"
+#include "EulerBatch.h"
+#include "TraceRecorder.h"
+#include "Profiler.h"
 #include <QDebug>
+#include <algorithm>
 #include <cmath>
 
+namespace {
+
+// Même échelle qu'OptiTrack (1 - erreur en mètres) : qualités comparables entre systèmes
+double qualityFromResidual(float residualMm)
+{
+    if (residualMm < 0.0f) return 1.0;     // Composant sans résidu
+    const double residualM = residualMm / 1000.0;
+    return residualM < 1.0 ? 1.0 - residualM : 0.0;
+}
+
+} // namespace
+
 QualisysSystem::QualisysSystem(QObject* parent)
     : IMeasurementSystem(parent)
-    , m_rtProtocol(nullptr)
-    , m_isConnected(false)
     , m_acquisitionThread(nullptr)
     , m_targetBodyIndex(-1)
     , m_lastFrameTime(0)
     , m_latency(0.0)
     , m_frequency(0.0)
     , m_lastFrameNumber(0)
+    , m_frameStep(1)
+    , m_cameraFrequency(0.0)
 {
     initializeCapabilities();
+    m_batch.systemName     = "Qualisys";
+    m_batch.hasQuaternions = false; // 6DEuler : orientation en angles d'Euler uniquement
     m_timer.start();
 }
 
@@ -40,11 +58,7 @@ bool QualisysSystem::initialize()
 {
     emit logMessage("Initializing Qualisys system...");
 
-    m_rtProtocol = new CRTProtocol();
-    if (!m_rtProtocol) {
-        emit errorOccurred("Failed to create CRTProtocol instance");
-        return false;
-    }
+    m_rtClient = std::make_unique<QtmRtClient>();
 
     emit logMessage("Qualisys system initialized");
     return true;
@@ -57,10 +71,15 @@ bool QualisysSystem::connect(const ConnectionConfig& config)
         disconnect();
     }
 
-    if (!m_rtProtocol) {
+    if (!m_rtClient) {
         if (!initialize()) return false;
     }
 
+    if (m_qualisysConfig.bigEndian) {
+        emit errorOccurred("Big-endian QTM RT stream is not supported (use the little-endian port, base + 1)");
+        return false;
+    }
+
     const unsigned short port = config.port > 0
         ? static_cast<unsigned short>(config.port)
         : m_qualisysConfig.basePort;
@@ -68,35 +87,70 @@ bool QualisysSystem::connect(const ConnectionConfig& config)
     emit logMessage(QString("Connecting to QTM: %1:%2")
         .arg(config.serverAddress).arg(port));
 
-    unsigned short udpServerPort = 0;
-    if (!m_rtProtocol->Connect(
-        config.serverAddress.toStdString().c_str(),
-        port,
-        &udpServerPort,
-        m_qualisysConfig.majorVersion,
-        m_qualisysConfig.minorVersion,
-        m_qualisysConfig.bigEndian))
-    {
+    QtmRtClient::Settings settings;
+    settings.serverAddress = config.serverAddress.toStdString();
+    settings.port          = port;
+    settings.majorVersion  = m_qualisysConfig.majorVersion;
+    settings.minorVersion  = m_qualisysConfig.minorVersion;
+    settings.useUdp        = m_qualisysConfig.useUDP;
+    settings.udpPort       = m_qualisysConfig.udpPort;
+
+    if (!m_rtClient->connect(settings)) {
         emit errorOccurred(QString("Failed to connect to QTM: %1")
-            .arg(m_rtProtocol->GetErrorString()));
+            .arg(QString::fromStdString(m_rtClient->lastError())));
         return false;
     }
+    const QString version = QString("QTM RT %1.%2")
+        .arg(m_qualisysConfig.majorVersion).arg(m_qualisysConfig.minorVersion);
 
     // ✅ Récupérer la liste des corps 6DOF
-    bool dataAvailable = false;
-    if (!m_rtProtocol->Read6DOFSettings(dataAvailable)) {
-        emit logMessage("Warning: Could not read 6DOF settings");
+    std::vector<std::string> bodyNames;
+    QStringList names;
+    if (!m_rtClient->read6dSettings(bodyNames)) {
+        emit logMessage(QString("Warning: Could not read 6DOF settings (%1)")
+            .arg(QString::fromStdString(m_rtClient->lastError())));
     }
     else {
-        m_bodyNames.clear();
-        const unsigned int nBodies = m_rtProtocol->Get6DOFBodyCount();
-        for (unsigned int i = 0; i < nBodies; ++i) {
-            m_bodyNames << QString::fromUtf8(m_rtProtocol->Get6DOFBodyName(i));
+        for (const std::string& name : bodyNames) {
+            names << QString::fromStdString(name);
         }
         emit logMessage(QString("Found %1 6DOF body/bodies: %2")
-            .arg(nBodies).arg(m_bodyNames.join(", ")));
+            .arg(names.size()).arg(names.join(", ")));
     }
 
+    // Fréquence caméra : base de la décimation côté serveur
+    m_cameraFrequency = 0.0;
+    double cameraFrequency = 0.0;
+    if (m_rtClient->readGeneralSettings(cameraFrequency)) {
+        m_cameraFrequency = cameraFrequency;
+        emit logMessage(QString("QTM capture frequency: %1 Hz").arg(cameraFrequency));
+    }
+    else {
+        emit logMessage(QString("Warning: Could not read QTM general settings (%1)")
+            .arg(QString::fromStdString(m_rtClient->lastError())));
+    }
+
+    m_qualisysConfig.captureAllBodies = config.customParams
+        .value("captureAllBodies", m_qualisysConfig.captureAllBodies).toBool();
+    m_qualisysConfig.streamRotationMatrix = config.customParams
+        .value("rotationMatrix", m_qualisysConfig.streamRotationMatrix).toBool();
+    m_qualisysConfig.oversamplingFactor = config.customParams
+        .value("oversampling", m_qualisysConfig.oversamplingFactor).toDouble();
+    m_qualisysConfig.latencyFloorMs = config.customParams
+        .value("latencyFloorMs", m_qualisysConfig.latencyFloorMs).toDouble();
+
+    // Lus par l'UI pendant que connect() tourne dans un thread de l'orchestrateur
+    {
+        QMutexLocker locker(&m_frameMutex);
+        m_bodyNames            = names;
+        m_capabilities.version = version;
+        if (m_cameraFrequency > 0.0)
+            m_capabilities.maxNativeFrequency = m_cameraFrequency;
+        // 6DRes : orientation complète (quaternion) ; 6DEuler : angles QTM uniquement
+        m_capabilities.supportsQuaternions = m_qualisysConfig.streamRotationMatrix;
+    }
+    m_batch.hasQuaternions = m_qualisysConfig.streamRotationMatrix;
+
     m_targetBodyName  = config.objectName;
     m_targetBodyIndex = findBodyIndex(config.objectName);
 
@@ -119,7 +173,7 @@ bool QualisysSystem::disconnect()
 
     emit logMessage("Disconnecting from Qualisys...");
     if (m_isAcquiring)  stopAcquisition();
-    if (m_rtProtocol)   m_rtProtocol->Disconnect();
+    if (m_rtClient)     m_rtClient->disconnect();
 
     m_isConnected = false;
     emit disconnected();
@@ -145,19 +199,13 @@ bool QualisysSystem::startAcquisition()
         return true;
     }
 
-    // ✅ Démarrer le streaming 6DEuler depuis QTM
-    const unsigned short udpPort = m_qualisysConfig.useUDP
-        ? m_qualisysConfig.udpPort : 0;
-
-    if (!m_rtProtocol->StreamFrames(
-        CRTProtocol::EStreamRate::RateAllFrames,
-        0,
-        udpPort,
-        nullptr,
-        CRTProtocol::cComponent6dEuler))
+    // ✅ Démarrer le streaming depuis QTM (TCP, ou UDP si configuré à la connexion)
+    const char* components = m_qualisysConfig.streamRotationMatrix ? "6DRes" : "6DEuler";
+    const QString rate = negotiateStreamRate();
+    if (!m_rtClient->streamFrames(rate.toStdString(), components))
     {
         emit errorOccurred(QString("Failed to start streaming: %1")
-            .arg(m_rtProtocol->GetErrorString()));
+            .arg(QString::fromStdString(m_rtClient->lastError())));
         return false;
     }
 
@@ -167,11 +215,22 @@ bool QualisysSystem::startAcquisition()
     m_isAcquiring     = true;
     m_lastFrameTime   = 0;
     m_lastFrameNumber = 0;
+    m_latency         = 0.0;
+
+    ClockOffsetEstimator::Settings clockSettings;
+    clockSettings.latencyFloorMs = m_qualisysConfig.latencyFloorMs;
+    m_clockEstimator.setSettings(clockSettings);
 
     m_acquisitionThread = QThread::create([this]() { acquisitionLoop(); });
+    m_acquisitionThread->moveToThread(thread());
     m_acquisitionThread->start();
 
-    emit logMessage("Qualisys acquisition started (StreamFrames AllFrames 6DEuler)");
+    if (m_qualisysConfig.captureAllBodies) {
+        emit logMessage(QString("Qualisys multi-body capture: %1 6DOF body/bodies")
+            .arg(m_bodyNames.size()));
+    }
+    emit logMessage(QString("Qualisys acquisition started (StreamFrames %1 %2, ~%3 Hz)")
+        .arg(rate).arg(components).arg(m_capabilities.effectiveStreamRate, 0, 'f', 1));
     return true;
 }
 
@@ -182,7 +241,9 @@ bool QualisysSystem::stopAcquisition()
     emit logMessage("Stopping Qualisys acquisition...");
     m_isAcquiring = false; // Signal au thread de s'arrêter
 
-    if (m_rtProtocol) m_rtProtocol->StreamFramesStop();
+    // StreamFrames arrêté par le thread d'acquisition lui-même, en sortie de boucle
+    if (m_rtClient)
+        m_rtClient->wakeup();
 
     // Attendre la fin propre du thread
     if (m_acquisitionThread) {
@@ -209,44 +270,76 @@ bool QualisysSystem::isAcquiring() const
 void QualisysSystem::acquisitionLoop()
 {
     emit logMessage("Qualisys acquisition loop started");
+    MOBOT_TRACE_THREAD_NAME("Qualisys");
+    MOBOT_PROFILE_SYSTEM("Qualisys");
 
     while (m_isAcquiring.load()) {
-        CRTPacket::EPacketType packetType;
-        const int timeoutMs = computeReceiveTimeoutMs();
-
-        auto response = m_rtProtocol->Receive(packetType, false, timeoutMs);
+        // Attente sans délai : stopAcquisition() réveille le client
+        const QtmRtClient::Message message = m_rtClient->receive(-1);
 
         if (!m_isAcquiring.load()) break;
 
-        if (response == CNetwork::ResponseType::timeout) continue;
+        if (message == QtmRtClient::Message::None) continue;
+
+        if (message == QtmRtClient::Message::Disconnected) {
+            emit errorOccurred(QString("Qualisys: connection lost (%1)")
+                .arg(QString::fromStdString(m_rtClient->lastError())));
+            m_isAcquiring = false;
+            break;
+        }
+
+        if (message == QtmRtClient::Message::Error) {
+            emit logMessage(QString("QTM error: %1").arg(QString::fromStdString(m_rtClient->lastText())));
+            continue;
+        }
 
-        if (response != CNetwork::ResponseType::success) {
-            emit logMessage("Qualisys: receive error, retrying...");
+        if (message == QtmRtClient::Message::Invalid) {
+            emit logMessage("Qualisys: invalid packet, skipped");
             continue;
         }
 
-        if (packetType == CRTPacket::PacketNoMoreData) {
+        if (message == QtmRtClient::Message::NoMoreData) {
             emit logMessage("QTM: No more data");
             m_isAcquiring = false;
             break;
         }
 
-        if (packetType != CRTPacket::PacketData) continue;
+        if (message != QtmRtClient::Message::Data) continue;
 
-        CRTPacket* pPacket = m_rtProtocol->GetRTPacket();
-        if (!pPacket) continue;
+        // Armé en attente du départ commun : frames lues et écartées
+        if (!sessionStarted()) continue;
+        const qint64 nowUs = m_timer.nsecsElapsed() / 1000;   // Réception (avant décodage)
 
-        const unsigned int bodyCount = pPacket->Get6DOFEulerBodyCount();
+        // Paquet lu en place dans le tampon de réception : valide jusqu'au receive() suivant
+        const QtmDataPacket& packet = m_rtClient->dataPacket();
+        MOBOT_TRACE_SCOPE_ARG("qtm.frame", packet.frameNumber());
+        MOBOT_PROFILE_SCOPE("Qualisys / frame");
+        const int bodyCount = m_qualisysConfig.streamRotationMatrix
+            ? packet.bodyCount6d() : packet.bodyCount6dEuler();
         if (bodyCount == 0) continue;
 
         // Détecter les frames perdues
-        const quint32 frameNumber = pPacket->GetFrameNumber();
-        if (m_lastFrameNumber > 0 && frameNumber > m_lastFrameNumber + 1) {
-            m_metrics.droppedFrames += frameNumber - m_lastFrameNumber - 1;
+        // (flux décimé : les numéros avancent de m_frameStep, appris au 1er écart si inconnu)
+        const quint32 frameNumber = packet.frameNumber();
+        if (m_lastFrameNumber > 0 && frameNumber > m_lastFrameNumber) {
+            const quint32 gap = frameNumber - m_lastFrameNumber;
+            if (m_frameStep == 0)
+                m_frameStep = gap;
+            else if (gap > m_frameStep)
+                m_metrics.droppedFrames += (gap + m_frameStep / 2) / m_frameStep - 1;
         }
         m_lastFrameNumber = frameNumber;
 
-        MeasurementFrame frame = parseFrame(pPacket);
+        // Capture multi-corps : lot complet + flux par corps pour les abonnés C++
+        const bool captureAll = m_qualisysConfig.captureAllBodies;
+        if (captureAll) {
+            fillBatch(packet);
+            publishBatch(m_batch);
+            for (int i = 0; i < m_batch.size(); ++i)
+                notifySubscribers(m_batch.frameAt(i));
+        }
+
+        MeasurementFrame frame = parseFrame(packet);
         if (!frame.isValid) continue;
 
         {
@@ -256,7 +349,6 @@ void QualisysSystem::acquisitionLoop()
         m_frameBuffer.push(frame);
 
         // Calcul fréquence instantanée
-        const qint64 nowUs = m_timer.nsecsElapsed() / 1000;
         if (m_lastFrameTime > 0) {
             const qint64 delta = nowUs - m_lastFrameTime;
             if (delta > 0)
@@ -264,56 +356,213 @@ void QualisysSystem::acquisitionLoop()
         }
         m_lastFrameTime = nowUs;
 
-        // ✅ Qualisys : latence non mesurable via RT protocol → latencyKnown = false
-        updateRunningStats(0.0, m_frequency, false);
-
-        emit newFrameAvailable(frame);
-        emit performanceUpdate(m_metrics);
+        // Latence : horodatage caméra QTM vs réception, décalage d'horloges estimé
+        // (latencyKnown = false pendant la calibration de l'enveloppe)
+        const ClockOffsetEstimator::Estimate latency =
+            m_clockEstimator.addSample(packet.timestamp(), nowUs);
+        if (latency.valid)
+            m_latency.store(latency.latencyMs, std::memory_order_relaxed);
+        updateRunningStats(latency.latencyMs, m_frequency, latency.valid);
+        m_metrics.latencyJitterMs = latency.jitterMs;
+        updatePoseStats(frame);
+
+        // En capture multi-corps, les abonnés C++ ont déjà reçu ce corps via son flux dédié
+        if (captureAll)
+            m_dispatcher->postFrame(frame);
+        else
+            publishFrame(frame);
+        publishMetrics();
     }
 
+    // Commandes RT depuis ce thread uniquement (sans effet si la connexion est perdue)
+    m_rtClient->stopStreaming();
     emit logMessage("Qualisys acquisition loop ended");
 }
 
 // ========== Parsing ==========
 
-MeasurementFrame QualisysSystem::parseFrame(CRTPacket* packet)
+MeasurementFrame QualisysSystem::parseFrame(const QtmDataPacket& packet)
 {
+    MOBOT_TRACE_SCOPE("qtm.parse");
+    MOBOT_PROFILE_SCOPE("Qualisys / parse");
+
     MeasurementFrame frame;
     frame.systemName  = "Qualisys";
     frame.isValid     = false;
-    frame.frameNumber = packet->GetFrameNumber();
-    frame.timestamp   = static_cast<qint64>(packet->GetTimeStamp());
+    frame.frameNumber = packet.frameNumber();
+    frame.timestamp   = static_cast<qint64>(packet.timestamp());
 
     if (m_targetBodyIndex < 0) return frame;
 
-    float x, y, z, ang1, ang2, ang3;
-    if (!packet->Get6DOFEulerBody(
-        static_cast<unsigned int>(m_targetBodyIndex),
-        x, y, z, ang1, ang2, ang3))
+    if (m_qualisysConfig.streamRotationMatrix) {
+        QtmBody6d body;
+        if (!packet.body6d(m_targetBodyIndex, body)) return frame;
+        if (std::isnan(body.x) || std::isnan(body.y) || std::isnan(body.z)) return frame;
+
+        frame.isValid    = true;
+        frame.objectName = m_targetBodyName;
+
+        frame.x = static_cast<double>(body.x);
+        frame.y = static_cast<double>(body.y);
+        frame.z = static_cast<double>(body.z);
+
+        // Matrice → quaternion : orientation de référence, sans singularité
+        body.quaternion(frame.quaternion.x, frame.quaternion.y, frame.quaternion.z, frame.quaternion.w);
+        frame.quaternion.valid = true;
+
+        // Euler d'affichage seulement, même convention qu'OptiTrack (R = Rz·Ry·Rx) ;
+        // l'export les recalcule depuis le quaternion (CoordinateConverter::applyConventionBatch)
+        EulerBatch::quaternionsToEuler(
+            &frame.quaternion.x, &frame.quaternion.y, &frame.quaternion.z, &frame.quaternion.w,
+            1, AngleConvention::RzRyRx, &frame.rz, &frame.ry, &frame.rx);
+
+        frame.quality = qualityFromResidual(body.residual);
+        return frame;
+    }
+
+    QtmBodyEuler body;
+    if (!packet.body6dEuler(m_targetBodyIndex, body))
     {
         return frame;
     }
 
-    if (std::isnan(x) || std::isnan(y) || std::isnan(z)) return frame;
+    if (std::isnan(body.x) || std::isnan(body.y) || std::isnan(body.z)) return frame;
 
     frame.isValid    = true;
     frame.objectName = m_targetBodyName;
 
-    frame.x  = static_cast<double>(x);
-    frame.y  = static_cast<double>(y);
-    frame.z  = static_cast<double>(z);
-    frame.rx = static_cast<double>(ang1);
-    frame.ry = static_cast<double>(ang2);
-    frame.rz = static_cast<double>(ang3);
+    frame.x  = static_cast<double>(body.x);
+    frame.y  = static_cast<double>(body.y);
+    frame.z  = static_cast<double>(body.z);
+    frame.rx = static_cast<double>(body.angles[0]);
+    frame.ry = static_cast<double>(body.angles[1]);
+    frame.rz = static_cast<double>(body.angles[2]);
 
     frame.quaternion.valid = false;
-    frame.quality          = 1.0;
+    frame.quality          = qualityFromResidual(body.residual);
 
     return frame;
 }
 
+void QualisysSystem::fillBatch(const QtmDataPacket& packet)
+{
+    const bool matrix = m_qualisysConfig.streamRotationMatrix;
+    const int count = matrix ? packet.bodyCount6d() : packet.bodyCount6dEuler();
+    m_batch.timestamp   = static_cast<qint64>(packet.timestamp());
+    m_batch.frameNumber = static_cast<int>(packet.frameNumber());
+    m_batch.resize(count);
+
+    const int named = qMin(count, static_cast<int>(m_bodyNames.size()));
+
+    if (matrix) {
+        QtmBody6d body;
+        for (int i = 0; i < count; ++i) {
+            packet.body6d(i, body);
+
+            m_batch.ids[i]   = i;
+            m_batch.names[i] = i < named ? m_bodyNames[i] : QString();
+
+            const bool tracked = !std::isnan(body.x);
+            m_batch.tracked[i] = tracked ? 1 : 0;
+
+            m_batch.x[i] = body.x;
+            m_batch.y[i] = body.y;
+            m_batch.z[i] = body.z;
+
+            if (tracked) {
+                body.quaternion(m_batch.qx[i], m_batch.qy[i], m_batch.qz[i], m_batch.qw[i]);
+            }
+            else {
+                m_batch.qx[i] = m_batch.qy[i] = m_batch.qz[i] = 0.0;
+                m_batch.qw[i] = 1.0;
+            }
+
+            m_batch.meanError[i] = body.residual >= 0.0f ? body.residual : 0.0;
+            m_batch.quality[i]   = tracked ? qualityFromResidual(body.residual) : 0.0;
+        }
+
+        // Euler d'affichage de tous les corps en un appel vectorisé (R = Rz·Ry·Rx)
+        EulerBatch::quaternionsToEuler(
+            m_batch.qx.constData(), m_batch.qy.constData(), m_batch.qz.constData(), m_batch.qw.constData(),
+            count, AngleConvention::RzRyRx,
+            m_batch.rz.data(), m_batch.ry.data(), m_batch.rx.data());
+        return;
+    }
+
+    QtmBodyEuler body;
+    for (int i = 0; i < count; ++i) {
+        packet.body6dEuler(i, body);
+
+        // QTM n'a pas d'ID de corps : index dans le flux (= ordre de GetParameters 6D)
+        m_batch.ids[i]   = i;
+        m_batch.names[i] = i < named ? m_bodyNames[i] : QString();
+
+        const bool tracked = !std::isnan(body.x);
+        m_batch.tracked[i] = tracked ? 1 : 0;
+
+        m_batch.x[i]  = body.x;
+        m_batch.y[i]  = body.y;
+        m_batch.z[i]  = body.z;
+        m_batch.rx[i] = body.angles[0];
+        m_batch.ry[i] = body.angles[1];
+        m_batch.rz[i] = body.angles[2];
+
+        m_batch.qx[i] = m_batch.qy[i] = m_batch.qz[i] = 0.0;
+        m_batch.qw[i] = 1.0;
+
+        m_batch.meanError[i] = body.residual >= 0.0f ? body.residual : 0.0;
+        m_batch.quality[i]   = tracked ? qualityFromResidual(body.residual) : 0.0;
+    }
+}
+
+// ========== Capture multi-corps ==========
+
+void QualisysSystem::setCaptureAllBodies(bool enabled)
+{
+    m_qualisysConfig.captureAllBodies = enabled;
+}
+
+bool QualisysSystem::captureAllBodies() const
+{
+    return m_qualisysConfig.captureAllBodies;
+}
+
 // ========== Helpers ==========
 
+QString QualisysSystem::negotiateStreamRate()
+{
+    const double target = targetFrequency();
+    const double wanted = target * std::max(1.0, m_qualisysConfig.oversamplingFactor);
+
+    m_frameStep = 1;
+    double  effectiveRate = m_cameraFrequency;
+    QString rate          = "AllFrames";
+
+    if (target <= 0.0) {
+        // AllFrames
+    }
+    else if (m_cameraFrequency > 0.0) {
+        // Diviseur entier arrondi vers le bas : jamais moins que la cadence demandée
+        const int divisor = static_cast<int>(std::floor(m_cameraFrequency / wanted));
+        if (divisor > 1) {
+            m_frameStep   = static_cast<quint32>(divisor);
+            effectiveRate = m_cameraFrequency / divisor;
+            rate          = QString("FrequencyDivisor:%1").arg(divisor);
+        }
+    }
+    else {
+        // Fréquence caméra inconnue : QTM choisit les frames, écart appris en cours de flux
+        const int frequency = static_cast<int>(std::ceil(wanted));
+        m_frameStep   = 0;
+        effectiveRate = frequency;
+        rate          = QString("Frequency:%1").arg(frequency);
+    }
+
+    QMutexLocker locker(&m_frameMutex);
+    m_capabilities.effectiveStreamRate = effectiveRate;
+    return rate;
+}
+
 int QualisysSystem::findBodyIndex(const QString& name) const
 {
     if (name.isEmpty()) return m_bodyNames.isEmpty() ? -1 : 0;
@@ -324,15 +573,6 @@ int QualisysSystem::findBodyIndex(const QString& name) const
     return -1;
 }
 
-int QualisysSystem::computeReceiveTimeoutMs() const
-{
-    if (m_frequency > 1.0) {
-        const int twoPeriods = static_cast<int>(2000.0 / m_frequency);
-        return qBound(100, twoPeriods, 1000);
-    }
-    return kDefaultReceiveTimeoutMs;
-}
-
 // ========== Getters ==========
 
 MeasurementFrame QualisysSystem::getLatestFrame() const
@@ -343,19 +583,36 @@ MeasurementFrame QualisysSystem::getLatestFrame() const
 
 double QualisysSystem::getNativeFrequency() const
 {
-    return m_frequency > 0.0 ? m_frequency : m_capabilities.maxNativeFrequency;
+    if (m_frequency > 0.0) return m_frequency;
+    QMutexLocker locker(&m_frameMutex);
+    return m_capabilities.maxNativeFrequency;
 }
 
 double QualisysSystem::getLatency() const
 {
-    // Le protocole QTM RT ne fournit pas de mesure de latence.
-    return 0.0;
+    // Estimée (horodatage QTM vs réception) : 0 tant que l'enveloppe n'est pas calibrée
+    return m_latency.load(std::memory_order_relaxed);
 }
 
-QStringList QualisysSystem::getAvailableObjects() const { return m_bodyNames; }
-SystemCapabilities QualisysSystem::getCapabilities() const { return m_capabilities; }
-QString QualisysSystem::getSystemName()    const { return "Qualisys"; }
-QString QualisysSystem::getSystemVersion() const { return m_capabilities.version; }
+QStringList QualisysSystem::getAvailableObjects() const
+{
+    QMutexLocker locker(&m_frameMutex);
+    return m_bodyNames;
+}
+
+SystemCapabilities QualisysSystem::getCapabilities() const
+{
+    QMutexLocker locker(&m_frameMutex);
+    return m_capabilities;
+}
+
+QString QualisysSystem::getSystemName() const { return "Qualisys"; }
+
+QString QualisysSystem::getSystemVersion() const
+{
+    QMutexLocker locker(&m_frameMutex);
+    return m_capabilities.version;
+}
 
 IMeasurementSystem::ThreadingModel QualisysSystem::getThreadingModel() const
 {
@@ -365,5 +622,5 @@ IMeasurementSystem::ThreadingModel QualisysSystem::getThreadingModel() const
 void QualisysSystem::cleanup()
 {
     disconnect();
-    if (m_rtProtocol) { delete m_rtProtocol; m_rtProtocol = nullptr; }
+    m_rtClient.reset();
 }
@@ -6,10 +6,11 @@
 #include "QualisysConfig.h"
 #include <QThread>
 #include <QElapsedTimer>
-
-// SDK Qualisys
-#include <RTProtocol.h>
-#include <RTPacket.h>
+#include <atomic>
+#include <memory>
+#include "QtmRtClient.h"
+#include "ClockOffsetEstimator.h"
+#include "RigidBodyBatch.h"
 
 class QualisysSystem : public IMeasurementSystem {
     Q_OBJECT
@@ -39,23 +40,42 @@ public:
     QString getSystemVersion() const override;
     ThreadingModel getThreadingModel() const override;
 
+    // ========== Mthodes spcifiques Qualisys ==========
+
+    /**
+     * @brief Capture de tous les corps 6DOF de chaque paquet
+     *
+     * Les abonns subscribeBatches() reoivent un RigidBodyBatch par frame ; les
+     * abonns subscribe() filtrs par objectName reoivent le flux de leur corps.
+     * newFrameAvailable et les statistiques suivent toujours le corps suivi.
+     *  rgler avant startAcquisition() (ou ConnectionConfig::customParams["captureAllBodies"]).
+     */
+    void setCaptureAllBodies(bool enabled);
+    bool captureAllBodies() const;
+
 private:
     // ========== Thread d'acquisition ==========
 
     /**
      * @brief Boucle d'acquisition - tourne dans m_acquisitionThread
      *
-     * Utilise Receive() bloquant avec timeout : PAS de sleep() ici.
-     * Le timeout IS l'attente rseau.
+     * Bloque sur la socket RT et le WakeupChannel du client, sans dlai :
+     * ni sleep() ni scrutation, stopAcquisition() rveille la boucle.
      */
     void acquisitionLoop();
 
     // ========== Mthodes internes ==========
 
     /**
-     * @brief Parse une frame 6DEuler depuis un CRTPacket
+     * @brief Parse la frame du corps suivi (6DEuler ou 6DRes selon la config),
+     *        lue en place dans le tampon de rception
      */
-    MeasurementFrame parseFrame(CRTPacket* packet);
+    MeasurementFrame parseFrame(const QtmDataPacket& packet);
+
+    /**
+     * @brief Extrait tous les corps du paquet dans m_batch, en une passe
+     */
+    void fillBatch(const QtmDataPacket& packet);
 
     /**
      * @brief Cherche l'index d'un corps par nom
@@ -63,40 +83,45 @@ private:
     int findBodyIndex(const QString& name) const;
 
     /**
-     * @brief Calcule le timeout rseau optimal pour Receive()
-     * = 2 priodes de frame, born entre 100ms et 1000ms
-     * NE PAS confondre avec un sleep : c'est un timeout rseau
+     * @brief Cadence StreamFrames dduite de targetFrequency() x surchantillonnage
+     *
+     * Frquence camra connue : "FrequencyDivisor:n" (dcimation entire, frames
+     * quidistantes). Sinon "Frequency:n". "AllFrames" sans frquence cible ou si
+     * la dcimation ne rduit rien. Met  jour m_frameStep et effectiveStreamRate.
      */
-    int computeReceiveTimeoutMs() const;
+    QString negotiateStreamRate();
 
     void initializeCapabilities();
     void cleanup();
 
-    // ========== SDK ==========
-    CRTProtocol* m_rtProtocol;
+    // ========== Client QTM RT (intgr, sans SDK) ==========
+    std::unique_ptr<QtmRtClient> m_rtClient;
 
     // ========== Config ==========
     QualisysConfig m_qualisysConfig;
 
     // ========== tat ==========
-    bool     m_isConnected;
+    std::atomic<bool> m_isConnected{ false };
     QThread* m_acquisitionThread;
 
     // ========== Corps 6DOF ==========
-    QStringList m_bodyNames;       // Noms rcuprs via GetParameters 6D
+    QStringList m_bodyNames;       // GetParameters 6D ; crit sous m_frameMutex (connect), lu par l'UI
     int         m_targetBodyIndex; // Index dans le flux de donnes
     QString     m_targetBodyName;
+    RigidBodyBatch m_batch;        // Capture multi-corps (rutilis, thread d'acquisition)
 
     // ========== Performance ==========
     QElapsedTimer m_timer;
     qint64        m_lastFrameTime;   // s (horloge locale)
-    double        m_latency;         // ms (toujours 0 : protocole ne le fournit pas)
+    std::atomic<double> m_latency;   // ms, estime (m_clockEstimator), 0 pendant la calibration ; lue par l'UI
+    ClockOffsetEstimator m_clockEstimator; // Horodatage QTM -> latence (thread d'acquisition)
     double        m_frequency;       // Hz mesur
 
     // Dtection frames perdues (via Marker Frame Number)
     quint32 m_lastFrameNumber;
+    quint32 m_frameStep;           // cart attendu entre numros de frame (diviseur), 0 =  apprendre
 
-    static constexpr int kDefaultReceiveTimeoutMs = 1000;
+    double  m_cameraFrequency;     // Hz, GetParameters General (0 = inconnue)
 };
 
 #endif // QUALIYSSYSTEM_H
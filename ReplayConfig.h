@@ -0,0 +1,32 @@
+#pragma once
+#ifndef REPLAYCONFIG_H
+#define REPLAYCONFIG_H
+
+#include <QString>
+
+/**
+ * @brief Configuration du rejeu d'une session enregistrée (SessionFile, CSV ou binaire)
+ *
+ * Surchargeable à la connexion par ConnectionConfig::customParams : "file", "speed",
+ * "loop", "system", "rebase". ConnectionConfig::objectName choisit le corps suivi.
+ */
+struct ReplayConfig {
+    QString filePath;
+
+    // 1 = cadence d'origine, N = N fois plus vite, 0 = au plus vite (débit maximal)
+    double speed = 1.0;
+
+    // Reprend au début en fin de fichier ; les timestamps continuent de croître
+    bool loop = false;
+
+    // Ne rejouer que les frames de ce système (session synchronisée) ; vide = toutes
+    QString systemFilter;
+
+    // false : timestamps d'origine (retraitement hors ligne)
+    // true  : recalés sur l'horloge courante (mélange avec des systèmes en direct)
+    bool rebaseTimestamps = false;
+
+    ReplayConfig() = default;
+};
+
+#endif // REPLAYCONFIG_H
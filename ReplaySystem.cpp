@@ -0,0 +1,445 @@
+#include "ReplaySystem.h"
+#include "Profiler.h"
+#include <QDateTime>
+#include <QHash>
+#include <QMutexLocker>
+#include <QSet>
+#include <chrono>
+#include <thread>
+#include <utility>
+
+namespace {
+
+// Fin d'attente en attente active : le sommeil de l'OS est trop grossier au-delà du kHz
+#ifdef _WIN32
+constexpr qint64 kSpinMarginNs = 1500000;
+#else
+constexpr qint64 kSpinMarginNs = 200000;
+#endif
+
+} // namespace
+
+ReplaySystem::ReplaySystem(const ReplayConfig& config, QObject* parent)
+    : IMeasurementSystem(parent)
+    , m_config(config)
+{
+    initializeCapabilities();
+    m_timer.start();
+}
+
+ReplaySystem::~ReplaySystem()
+{
+    if (m_isAcquiring) stopAcquisition();
+    disconnect();
+}
+
+void ReplaySystem::initializeCapabilities()
+{
+    m_capabilities.systemName              = "Replay";
+    m_capabilities.version                 = "1.0";
+    m_capabilities.maxNativeFrequency      = m_nativeFrequency;
+    m_capabilities.minNativeFrequency      = m_nativeFrequency;
+    m_capabilities.supportsVariableRate    = false;
+    m_capabilities.supportsQuaternions     = true;
+    m_capabilities.supportsMultipleObjects = true;
+    m_capabilities.typicalLatency          = 0.0;
+    // Cadence effective du rejeu ; 0 = non bornée (au plus vite)
+    m_capabilities.effectiveStreamRate     = m_nativeFrequency * m_config.speed;
+}
+
+// ========== Cycle de vie ==========
+
+bool ReplaySystem::initialize()
+{
+    return true;
+}
+
+bool ReplaySystem::connect(const ConnectionConfig& config)
+{
+    if (m_isAcquiring) {
+        emit errorOccurred("Replay: cannot reconnect during acquisition");
+        return false;
+    }
+
+    applyConnectionParams(config);
+    if (m_config.filePath.isEmpty()) {
+        emit errorOccurred("Replay: no session file");
+        return false;
+    }
+    if (!m_session.open(m_config.filePath)) {
+        emit errorOccurred(QString("Replay: %1").arg(m_session.errorString()));
+        return false;
+    }
+
+    if (!indexSession()) {
+        m_session.close();
+        return false;
+    }
+
+    {
+        QMutexLocker locker(&m_frameMutex);
+        m_targetObject = m_objectNames.contains(config.objectName) ? config.objectName : m_objectNames.first();
+        initializeCapabilities();
+    }
+
+    m_isConnected = true;
+    emit connected();
+    emit logMessage(QString("Replay ready: %1 (%2, %3 frames, %4 s, %5 object(s), ~%6 Hz, speed %7)")
+        .arg(m_config.filePath)
+        .arg(m_session.format() == SessionFile::Format::Binary ? "binary" : "CSV")
+        .arg(m_recordCount).arg(sessionDuration(), 0, 'f', 3)
+        .arg(m_objectNames.size()).arg(m_nativeFrequency, 0, 'f', 1)
+        .arg(m_config.speed > 0.0 ? QString("x%1").arg(m_config.speed) : QString("max")));
+    return true;
+}
+
+void ReplaySystem::applyConnectionParams(const ConnectionConfig& config)
+{
+    const QVariantMap& p = config.customParams;
+    m_config.filePath         = p.value("file",   m_config.filePath).toString();
+    m_config.speed            = p.value("speed",  m_config.speed).toDouble();
+    m_config.loop             = p.value("loop",   m_config.loop).toBool();
+    m_config.systemFilter     = p.value("system", m_config.systemFilter).toString();
+    m_config.rebaseTimestamps = p.value("rebase", m_config.rebaseTimestamps).toBool();
+
+    m_config.speed = qMax(0.0, m_config.speed);
+}
+
+bool ReplaySystem::indexSession()
+{
+    QStringList objectNames;
+    m_recordCount    = 0;
+    m_firstTimestamp = 0;
+    m_lastTimestamp  = 0;
+
+    QSet<QString>          seen;
+    QHash<QString, qint64> perObject;
+    MeasurementFrame       frame;
+    qint64 offset = m_session.firstRecordOffset();
+    qint64 next   = 0;
+
+    while (m_session.readFrame(offset, frame, next)) {
+        offset = next;
+        if (!acceptsFrame(frame))
+            continue;
+
+        if (m_recordCount == 0)
+            m_firstTimestamp = frame.timestamp;
+        m_lastTimestamp = frame.timestamp;
+        ++m_recordCount;
+
+        if (!seen.contains(frame.objectName)) {
+            seen.insert(frame.objectName);
+            objectNames << frame.objectName;
+        }
+        ++perObject[frame.objectName];
+    }
+
+    // Enregistrement corrompu : on rejoue ce qui précède
+    m_endOffset = offset;
+    if (offset < m_session.size() && !m_session.errorString().isEmpty())
+        emit logMessage(QString("Replay: %1, replay stops there").arg(m_session.errorString()));
+
+    if (m_recordCount == 0) {
+        emit errorOccurred(m_config.systemFilter.isEmpty()
+            ? QString("Replay: no frame in %1").arg(m_config.filePath)
+            : QString("Replay: no %1 frame in %2").arg(m_config.systemFilter, m_config.filePath));
+        return false;
+    }
+
+    // Cadence d'origine estimée sur l'objet le plus fréquent
+    qint64 maxCount = 0;
+    for (auto it = perObject.constBegin(); it != perObject.constEnd(); ++it)
+        maxCount = qMax(maxCount, it.value());
+    const double durationS = sessionDuration();
+
+    // Lus par l'UI pendant que connect() tourne dans un thread de l'orchestrateur
+    QMutexLocker locker(&m_frameMutex);
+    m_objectNames     = objectNames;
+    m_nativeFrequency = (durationS > 0.0 && maxCount > 1) ? (maxCount - 1) / durationS : 0.0;
+    return true;
+}
+
+bool ReplaySystem::acceptsFrame(const MeasurementFrame& frame) const
+{
+    return m_config.systemFilter.isEmpty() || frame.systemName == m_config.systemFilter;
+}
+
+bool ReplaySystem::disconnect()
+{
+    if (!m_isConnected) return true;
+    if (m_isAcquiring)  stopAcquisition();
+
+    m_session.close();
+    m_isConnected = false;
+    emit disconnected();
+    return true;
+}
+
+bool ReplaySystem::isConnected() const
+{
+    return m_isConnected;
+}
+
+// ========== Acquisition ==========
+
+bool ReplaySystem::startAcquisition()
+{
+    if (!m_isConnected) {
+        emit errorOccurred("Cannot start acquisition: not connected");
+        return false;
+    }
+    if (m_isAcquiring) return true;
+
+    resetSessionStats();
+    m_offset        = m_session.firstRecordOffset();
+    m_hasPending    = false;
+    m_groupSize     = 0;
+    m_lastFrameTime = 0;
+    m_frequency     = 0.0;
+    m_progressOffset.store(m_offset);
+
+    m_isAcquiring = true;
+    m_acquisitionThread = QThread::create([this]() { acquisitionLoop(); });
+    m_acquisitionThread->moveToThread(thread());
+    m_acquisitionThread->setObjectName(QStringLiteral("ReplayAcqThread"));
+    m_acquisitionThread->start(QThread::TimeCriticalPriority);
+
+    emit logMessage(QString("Replay started (%1)")
+        .arg(m_config.speed > 0.0 ? QString("speed x%1").arg(m_config.speed) : QString("as fast as possible")));
+    return true;
+}
+
+bool ReplaySystem::stopAcquisition()
+{
+    if (!m_isAcquiring) return true;
+
+    m_isAcquiring = false;
+    if (m_acquisitionThread) {
+        m_acquisitionThread->wait(3000);
+        delete m_acquisitionThread;
+        m_acquisitionThread = nullptr;
+    }
+
+    const AcquisitionSummary summary = buildSummary(m_targetObject);
+    emit acquisitionCompleted(summary);
+    emit logMessage(QString("Replay stopped — %1 frames").arg(summary.totalFrames));
+    return true;
+}
+
+bool ReplaySystem::isAcquiring() const
+{
+    return m_isAcquiring.load();
+}
+
+// ========== Boucle de rejeu ==========
+
+void ReplaySystem::acquisitionLoop()
+{
+    MOBOT_PROFILE_SYSTEM("Replay");
+    if (!waitForSessionStart())
+        return;
+
+    const double speed   = m_config.speed;
+    const qint64 startNs = m_timer.nsecsElapsed();
+    const qint64 startEpochUs = sessionStartTimestamp();
+
+    // En boucle, chaque passe reprend une période après la dernière frame de la précédente
+    const qint64 periodUs     = m_nativeFrequency > 0.0 ? static_cast<qint64>(1e6 / m_nativeFrequency) : 0;
+    const qint64 loopPeriodUs = (m_lastTimestamp - m_firstTimestamp) + qMax<qint64>(periodUs, 1);
+    qint64 loopOffsetUs = 0;
+    qint64 groups       = 0;
+
+    while (m_isAcquiring.load(std::memory_order_relaxed)) {
+        if (!readGroup()) {
+            if (!m_config.loop)
+                break;
+            loopOffsetUs += loopPeriodUs;
+            m_offset     = m_session.firstRecordOffset();
+            m_hasPending = false;
+            continue;
+        }
+
+        // Temps écoulé depuis le début de la session, sur l'horloge d'origine
+        const qint64 sourceUs = m_group[0].timestamp - m_firstTimestamp + loopOffsetUs;
+
+        if (speed > 0.0) {
+            // Échéancier absolu : un retard (préemption) est rattrapé en rafale, sans dérive
+            const qint64 dueNs       = startNs + static_cast<qint64>(sourceUs * 1000.0 / speed);
+            const qint64 remainingNs = dueNs - m_timer.nsecsElapsed();
+            if (remainingNs > kSpinMarginNs)
+                std::this_thread::sleep_for(std::chrono::nanoseconds(remainingNs - kSpinMarginNs));
+            while (m_timer.nsecsElapsed() < dueNs && m_isAcquiring.load(std::memory_order_relaxed))
+                std::this_thread::yield();
+            if (!m_isAcquiring.load(std::memory_order_relaxed))
+                break;
+        }
+
+        qint64 emittedUs = m_group[0].timestamp + loopOffsetUs;
+        if (m_config.rebaseTimestamps)
+            emittedUs = startEpochUs + (speed > 0.0 ? static_cast<qint64>(sourceUs / speed) : sourceUs);
+
+        publishGroup(emittedUs);
+        m_progressOffset.store(m_offset, std::memory_order_relaxed);
+        ++groups;
+    }
+
+    if (m_isAcquiring.load()) {
+        const double elapsedS = (m_timer.nsecsElapsed() - startNs) / 1e9;
+        emit logMessage(QString("Replay finished: %1 frames in %2 s (%3 frames/s)")
+            .arg(groups).arg(elapsedS, 0, 'f', 3)
+            .arg(elapsedS > 0.0 ? groups / elapsedS : 0.0, 0, 'f', 0));
+        emit replayFinished();
+    }
+}
+
+bool ReplaySystem::readGroup()
+{
+    m_groupSize = 0;
+    for (;;) {
+        if (!m_hasPending) {
+            qint64 next = 0;
+            if (m_offset >= m_endOffset || !m_session.readFrame(m_offset, m_pending, next))
+                return m_groupSize > 0;
+            m_offset = next;
+            if (!acceptsFrame(m_pending))
+                continue;
+            m_hasPending = true;
+        }
+
+        if (m_groupSize > 0) {
+            const MeasurementFrame& head = m_group[0];
+            if (m_pending.timestamp != head.timestamp
+                || m_pending.frameNumber != head.frameNumber
+                || m_pending.systemName != head.systemName)
+                return true;
+        }
+
+        // Échange plutôt que copie : chaînes et extras changent de slot sans allocation
+        if (m_group.size() <= m_groupSize)
+            m_group.resize(m_groupSize + 1);
+        std::swap(m_group[m_groupSize++], m_pending);
+        m_hasPending = false;
+    }
+}
+
+void ReplaySystem::publishGroup(qint64 emittedTimestamp)
+{
+    for (int i = 0; i < m_groupSize; ++i)
+        m_group[i].timestamp = emittedTimestamp;
+
+    if (m_groupSize > 1) {
+        m_batch.resize(m_groupSize);
+        m_batch.systemName     = m_group[0].systemName;
+        m_batch.timestamp      = emittedTimestamp;
+        m_batch.frameNumber    = m_group[0].frameNumber;
+        m_batch.hasQuaternions = true;
+        for (int i = 0; i < m_groupSize; ++i) {
+            const MeasurementFrame& f = m_group[i];
+            m_batch.ids[i]   = i + 1;
+            m_batch.names[i] = f.objectName;
+            m_batch.x[i]  = f.x;  m_batch.y[i]  = f.y;  m_batch.z[i]  = f.z;
+            m_batch.rx[i] = f.rx; m_batch.ry[i] = f.ry; m_batch.rz[i] = f.rz;
+            m_batch.qx[i] = f.quaternion.x;
+            m_batch.qy[i] = f.quaternion.y;
+            m_batch.qz[i] = f.quaternion.z;
+            m_batch.qw[i] = f.quaternion.w;
+            m_batch.meanError[i] = 0.0;
+            m_batch.quality[i]   = f.quality;
+            m_batch.tracked[i]   = f.isValid ? 1 : 0;
+            m_batch.hasQuaternions = m_batch.hasQuaternions && f.quaternion.valid;
+        }
+        publishBatch(m_batch);
+    }
+
+    // Flux par corps ; le corps suivi passe par publishFrame (abonnés + signaux Qt)
+    const MeasurementFrame* target = nullptr;
+    for (int i = 0; i < m_groupSize; ++i) {
+        const MeasurementFrame& f = m_group[i];
+        if (!target && f.objectName == m_targetObject)
+            target = &f;
+        else
+            notifySubscribers(f);
+    }
+    if (!target)
+        return;
+
+    {
+        QMutexLocker locker(&m_frameMutex);
+        m_latestFrame = *target;
+    }
+    m_frameBuffer.push(*target);
+
+    const qint64 nowUs = m_timer.nsecsElapsed() / 1000;
+    if (m_lastFrameTime > 0 && nowUs > m_lastFrameTime)
+        m_frequency = 1000000.0 / static_cast<double>(nowUs - m_lastFrameTime);
+    m_lastFrameTime = nowUs;
+
+    // Latence d'origine inconnue : elle n'est pas enregistrée dans la session
+    updateRunningStats(0.0, m_frequency, false);
+    if (target->isValid)
+        updatePoseStats(*target);
+
+    publishFrame(*target);
+    publishMetrics();
+}
+
+// ========== Rejeu ==========
+
+double ReplaySystem::progress() const
+{
+    const qint64 first = m_session.firstRecordOffset();
+    const qint64 span  = m_endOffset - first;
+    if (span <= 0)
+        return 0.0;
+    return qBound(0.0, static_cast<double>(m_progressOffset.load(std::memory_order_relaxed) - first) / span, 1.0);
+}
+
+double ReplaySystem::sessionDuration() const
+{
+    return (m_lastTimestamp - m_firstTimestamp) / 1e6;
+}
+
+// ========== Getters ==========
+
+MeasurementFrame ReplaySystem::getLatestFrame() const
+{
+    QMutexLocker locker(&m_frameMutex);
+    return m_latestFrame;
+}
+
+double ReplaySystem::getNativeFrequency() const
+{
+    QMutexLocker locker(&m_frameMutex);
+    return m_nativeFrequency;
+}
+
+double ReplaySystem::getLatency() const
+{
+    return 0.0;
+}
+
+QStringList ReplaySystem::getAvailableObjects() const
+{
+    QMutexLocker locker(&m_frameMutex);
+    return m_objectNames;
+}
+
+SystemCapabilities ReplaySystem::getCapabilities() const
+{
+    QMutexLocker locker(&m_frameMutex);
+    return m_capabilities;
+}
+
+QString ReplaySystem::getSystemName() const { return "Replay"; }
+
+QString ReplaySystem::getSystemVersion() const
+{
+    QMutexLocker locker(&m_frameMutex);
+    return m_capabilities.version;
+}
+
+IMeasurementSystem::ThreadingModel ReplaySystem::getThreadingModel() const
+{
+    return ThreadingModel::ApplicationManaged;
+}
@@ -0,0 +1,114 @@
+#pragma once
+#ifndef REPLAYSYSTEM_H
+#define REPLAYSYSTEM_H
+
+#include "IMeasurementSystem.h"
+#include "ReplayConfig.h"
+#include "SessionFile.h"
+#include "RigidBodyBatch.h"
+#include <QElapsedTimer>
+#include <QStringList>
+#include <atomic>
+
+/**
+ * @brief Rejoue une session enregistrée (SessionFile) comme un système de mesure en direct
+ *
+ * Les frames sont relues telles qu'enregistrées — système et objet d'origine, numéros
+ * de frame, qualité, quaternion, extras — et publiées par le même chemin que les
+ * systèmes réels : le synchroniseur, l'enregistrement et l'analyse les traitent sans
+ * distinction. Sert au retraitement hors ligne de données terrain et à mesurer le
+ * pipeline à débit maximal (speed = 0).
+ *
+ * Cadence : échéancier absolu sur les timestamps d'origine, divisés par speed.
+ * Les enregistrements consécutifs de même (système, numéro de frame, timestamp)
+ * forment une frame multi-corps : RigidBodyBatch aux abonnés de lots, flux par corps,
+ * newFrameAvailable sur le corps suivi (comme OptiTrack / Qualisys).
+ *
+ * En fin de fichier (sans loop), replayFinished() est émis ; l'acquisition reste
+ * ouverte jusqu'à stopAcquisition(), qui produit le résumé de session.
+ */
+class ReplaySystem : public IMeasurementSystem {
+    Q_OBJECT
+
+public:
+    explicit ReplaySystem(const ReplayConfig& config = ReplayConfig(), QObject* parent = nullptr);
+    ~ReplaySystem() override;
+
+    // ========== Interface IMeasurementSystem ==========
+
+    bool initialize() override;
+    bool connect(const ConnectionConfig& config) override;
+    bool disconnect() override;
+    bool isConnected() const override;
+
+    bool startAcquisition() override;
+    bool stopAcquisition() override;
+    bool isAcquiring() const override;
+
+    MeasurementFrame getLatestFrame() const override;
+    double getNativeFrequency() const override;
+    QStringList getAvailableObjects() const override;
+    double getLatency() const override;
+
+    SystemCapabilities getCapabilities() const override;
+    QString getSystemName() const override;
+    QString getSystemVersion() const override;
+    ThreadingModel getThreadingModel() const override;
+
+    // ========== Rejeu ==========
+
+    /** @brief Avancement dans le fichier [0, 1] (par position, toutes boucles confondues) */
+    double progress() const;
+
+    /** @brief Durée enregistrée (s), du premier au dernier timestamp */
+    double sessionDuration() const;
+
+signals:
+    /** @brief Fin de fichier atteinte (jamais émis avec loop) */
+    void replayFinished();
+
+private:
+    void acquisitionLoop();
+
+    /** @brief Parcourt le fichier : objets, nombre de frames, premier/dernier timestamp */
+    bool indexSession();
+
+    /** @brief Lit le prochain groupe (même système, frame, timestamp) dans m_group */
+    bool readGroup();
+
+    /** @brief Publie m_group (lot multi-corps, flux par corps, corps suivi) */
+    void publishGroup(qint64 emittedTimestamp);
+
+    bool acceptsFrame(const MeasurementFrame& frame) const;
+    void applyConnectionParams(const ConnectionConfig& config);
+    void initializeCapabilities();
+
+    ReplayConfig m_config;
+    SessionFile  m_session;
+
+    // ========== Contenu de la session (indexSession) ==========
+    std::atomic<bool> m_isConnected{ false };
+    QStringList m_objectNames;          // m_frameMutex (lu par l'UI)
+    QString     m_targetObject;
+    qint64      m_recordCount  = 0;
+    qint64      m_firstTimestamp = 0;   // µs
+    qint64      m_lastTimestamp  = 0;   // µs
+    double      m_nativeFrequency = 0.0;
+    qint64      m_endOffset = 0;        // Fin des enregistrements lisibles
+
+    // ========== Lecture (thread de rejeu) ==========
+    qint64                   m_offset = 0;
+    MeasurementFrame         m_pending;            // Premier enregistrement du groupe suivant
+    bool                     m_hasPending = false;
+    QVector<MeasurementFrame> m_group;             // Capacité conservée d'un groupe à l'autre
+    int                      m_groupSize = 0;
+    RigidBodyBatch           m_batch;
+    std::atomic<qint64>      m_progressOffset{ 0 };
+
+    // ========== Performance ==========
+    QElapsedTimer m_timer;
+    qint64        m_lastFrameTime = 0;   // µs (horloge locale)
+    double        m_frequency     = 0.0; // Hz mesuré à la livraison
+};
+
+#endif // REPLAYSYSTEM_H
@@ -0,0 +1,72 @@
+#pragma once
+#ifndef RIGIDBODYBATCH_H
+#define RIGIDBODYBATCH_H
+
+#include <QString>
+#include <QVector>
+#include <QtGlobal>
+#include "MeasurementFrame.h"
+
+/**
+ * @brief Tous les corps rigides d'une même frame, en structure de tableaux (SoA)
+ *
+ * Une colonne par grandeur, indexée par corps : les traitements par lot
+ * (conversion, export, synchronisation) parcourent des tableaux contigus.
+ * Les colonnes gardent leur capacité d'une frame à l'autre (resize ne
+ * libère pas) : une instance réutilisée n'alloue plus en régime établi.
+ *
+ * Unités identiques à MeasurementFrame : mm, degrés.
+ */
+struct RigidBodyBatch {
+    QString systemName;
+    qint64  timestamp   = 0;    // µs, horloge du système source
+    int     frameNumber = 0;
+    bool    hasQuaternions = true;  // false : source sans orientation quaternion (Euler seul)
+
+    QVector<int>     ids;
+    QVector<QString> names;     // Vide si le nom n'est pas connu
+
+    QVector<double> x, y, z;
+    QVector<double> qx, qy, qz, qw;
+    QVector<double> rx, ry, rz;
+
+    QVector<double> meanError;  // Erreur résiduelle (mm)
+    QVector<double> quality;    // 0.0 à 1.0
+    QVector<quint8> tracked;    // 1 = pose valide
+
+    int size() const { return ids.size(); }
+    bool isEmpty() const { return ids.isEmpty(); }
+
+    /** @brief Dimensionne toutes les colonnes (contenu non initialisé pour les nouveaux corps) */
+    void resize(int count)
+    {
+        ids.resize(count);
+        names.resize(count);
+        x.resize(count);  y.resize(count);  z.resize(count);
+        qx.resize(count); qy.resize(count); qz.resize(count); qw.resize(count);
+        rx.resize(count); ry.resize(count); rz.resize(count);
+        meanError.resize(count);
+        quality.resize(count);
+        tracked.resize(count);
+    }
+
+    /** @brief Vue MeasurementFrame du corps i (flux par corps, objectName = nom du corps) */
+    MeasurementFrame frameAt(int i) const
+    {
+        MeasurementFrame frame(timestamp, systemName,
+            names[i].isEmpty() ? QString::number(ids[i]) : names[i]);
+        frame.frameNumber = frameNumber;
+        frame.isValid     = tracked[i] != 0;
+        frame.x  = x[i];  frame.y  = y[i];  frame.z  = z[i];
+        frame.rx = rx[i]; frame.ry = ry[i]; frame.rz = rz[i];
+        frame.quaternion.x     = qx[i];
+        frame.quaternion.y     = qy[i];
+        frame.quaternion.z     = qz[i];
+        frame.quaternion.w     = qw[i];
+        frame.quaternion.valid = hasQuaternions;
+        frame.quality = quality[i];
+        return frame;
+    }
+};
+
+#endif // RIGIDBODYBATCH_H
@@ -0,0 +1,121 @@
+#include "RigidBodyDirectory.h"
+#include <algorithm>
+
+// =============================================================================
+// Descriptions
+// =============================================================================
+
+void RigidBodyDirectory::clear()
+{
+    m_names.clear();
+    m_idByName.clear();
+    m_nameById.clear();
+    m_sparseNameById.clear();
+    m_slotById.clear();
+    m_sparseSlotById.clear();
+    m_layoutValid = false;
+}
+
+void RigidBodyDirectory::addBody(int id, const QString& name)
+{
+    if (id < 0)
+        return;
+
+    m_names << name;
+    m_idByName.insert(name, id);
+
+    if (id < kMaxDenseId) {
+        if (static_cast<std::size_t>(id) >= m_nameById.size())
+            m_nameById.resize(static_cast<std::size_t>(id) + 1);
+        m_nameById[static_cast<std::size_t>(id)] = name;
+    }
+    else {
+        m_sparseNameById.insert(id, name);
+    }
+}
+
+const QString& RigidBodyDirectory::nameForId(int id) const
+{
+    static const QString kUnknown;
+
+    if (id >= 0 && static_cast<std::size_t>(id) < m_nameById.size())
+        return m_nameById[static_cast<std::size_t>(id)];
+    if (id >= kMaxDenseId) {
+        const auto it = m_sparseNameById.constFind(id);
+        if (it != m_sparseNameById.constEnd())
+            return it.value();
+    }
+    return kUnknown;
+}
+
+// =============================================================================
+// Résolution par frame
+// =============================================================================
+
+const NatNetRigidBodySample* RigidBodyDirectory::find(const NatNetFrameSnapshot& snapshot, int id)
+{
+    if (id < 0)
+        return nullptr;
+
+    // Chemin nominal : même disposition que la frame précédente
+    int slot = cachedSlot(id);
+    if (slot >= 0 && slot < snapshot.rigidBodyCount && snapshot.rigidBodies[slot].id == id)
+        return &snapshot.rigidBodies[slot];
+
+    // Corps absent de la disposition connue : pas de reconstruction tant qu'elle ne change pas
+    const uint64_t signature = layoutSignature(snapshot);
+    if (slot < 0 && m_layoutValid && signature == m_layoutSignature)
+        return nullptr;
+
+    // Disposition modifiée (corps ajouté / retiré) : une passe, puis retour à l'accès direct
+    rebuildSlots(snapshot);
+    m_layoutSignature = signature;
+    m_layoutValid     = true;
+    slot = cachedSlot(id);
+    return slot >= 0 ? &snapshot.rigidBodies[slot] : nullptr;
+}
+
+uint64_t RigidBodyDirectory::layoutSignature(const NatNetFrameSnapshot& snapshot)
+{
+    // FNV-1a sur le nombre de corps et leurs IDs, dans l'ordre de la frame
+    uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](uint32_t value) {
+        for (int byte = 0; byte < 4; ++byte) {
+            hash ^= (value >> (8 * byte)) & 0xFFu;
+            hash *= 1099511628211ull;
+        }
+    };
+    mix(static_cast<uint32_t>(snapshot.rigidBodyCount));
+    for (int i = 0; i < snapshot.rigidBodyCount; i++)
+        mix(static_cast<uint32_t>(snapshot.rigidBodies[i].id));
+    return hash;
+}
+
+int RigidBodyDirectory::cachedSlot(int id) const
+{
+    if (static_cast<std::size_t>(id) < m_slotById.size())
+        return m_slotById[static_cast<std::size_t>(id)];
+    if (id >= kMaxDenseId)
+        return m_sparseSlotById.value(id, -1);
+    return -1;
+}
+
+void RigidBodyDirectory::rebuildSlots(const NatNetFrameSnapshot& snapshot)
+{
+    std::fill(m_slotById.begin(), m_slotById.end(), -1);
+    m_sparseSlotById.clear();
+
+    for (int i = 0; i < snapshot.rigidBodyCount; i++) {
+        const int id = snapshot.rigidBodies[i].id;
+        if (id < 0)
+            continue;
+        if (id < kMaxDenseId) {
+            if (static_cast<std::size_t>(id) >= m_slotById.size())
+                m_slotById.resize(static_cast<std::size_t>(id) + 1, -1);
+            m_slotById[static_cast<std::size_t>(id)] = i;
+        }
+        else {
+            m_sparseSlotById.insert(id, i);
+        }
+    }
+}
@@ -0,0 +1,75 @@
+#pragma once
+#ifndef RIGIDBODYDIRECTORY_H
+#define RIGIDBODYDIRECTORY_H
+
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <vector>
+#include "NatNetFrameData.h"
+
+/**
+ * @brief Annuaire des rigid bodies NatNet : nom ↔ ID, et ID → position dans la frame
+ *
+ * Construit une fois à partir des descriptions de données (connexion, démarrage,
+ * notification de changement de modèles), puis utilisé à chaque frame :
+ *   - nom → ID et ID → nom par table (pas de parcours des descriptions)
+ *   - ID → index dans NatNetFrameSnapshot::rigidBodies mis en cache ; la
+ *     recherche est un accès direct validé par comparaison d'ID. Si la
+ *     disposition de la frame change, le cache est reconstruit en une passe.
+ *
+ * Les IDs Motive sont en pratique petits et denses : ils indexent directement
+ * des tableaux jusqu'à kMaxDenseId, au-delà une table de hachage prend le relais.
+ *
+ * Non thread-safe : un seul thread propriétaire (worker OptiTrack).
+ */
+class RigidBodyDirectory {
+public:
+    static constexpr int kMaxDenseId = 4096;
+
+    // ========== Descriptions ==========
+
+    void clear();
+    void addBody(int id, const QString& name);
+
+    int  size() const { return m_names.size(); }
+    bool isEmpty() const { return m_names.isEmpty(); }
+
+    /** @brief Noms dans l'ordre des descriptions */
+    const QStringList& names() const { return m_names; }
+
+    /** @return -1 si le nom est inconnu */
+    int idForName(const QString& name) const { return m_idByName.value(name, -1); }
+
+    /** @return Chaîne vide si l'ID est inconnu */
+    const QString& nameForId(int id) const;
+
+    // ========== Résolution par frame ==========
+
+    /**
+     * @brief Corps d'ID donné dans la frame, nullptr s'il n'y figure pas
+     *
+     * O(1) tant que la disposition des corps dans la frame ne change pas. Un ID
+     * absent de la frame coûte une lecture des IDs (signature de disposition),
+     * sans reconstruction du cache si la disposition est celle déjà connue.
+     */
+    const NatNetRigidBodySample* find(const NatNetFrameSnapshot& snapshot, int id);
+
+private:
+    int  cachedSlot(int id) const;
+    void rebuildSlots(const NatNetFrameSnapshot& snapshot);
+    static uint64_t layoutSignature(const NatNetFrameSnapshot& snapshot);
+
+    QStringList         m_names;
+    QHash<QString, int> m_idByName;
+
+    std::vector<QString>   m_nameById;        // Indexé par ID (< kMaxDenseId)
+    QHash<int, QString>    m_sparseNameById;  // IDs >= kMaxDenseId
+
+    std::vector<int>       m_slotById;        // Indexé par ID, -1 = absent
+    QHash<int, int>        m_sparseSlotById;
+    uint64_t               m_layoutSignature = 0;     // Disposition ayant servi au cache
+    bool                   m_layoutValid     = false;
+};
+
+#endif // RIGIDBODYDIRECTORY_H
@@ -0,0 +1,314 @@
+#include "RsiEmulator.h"
+#include "NativeUdpSocket.h"
+#include "TrameHelper.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdarg>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <thread>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr double      kPi           = 3.14159265358979323846;
+constexpr std::size_t kFrameBufSize = 2048;
+constexpr int         kPendingIpocs = 64;    // IPOC récents reconnus comme ACK tardifs
+
+// Marge de fin d'attente en attente active : le sommeil de l'OS est trop grossier
+// pour une échéance de 1 ms (≈ 1 ms sous Windows, ≈ 50 µs sous Linux)
+#ifdef _WIN32
+constexpr int kSpinMarginUs = 1500;
+#else
+constexpr int kSpinMarginUs = 200;
+#endif
+
+double elapsedUs(Clock::time_point from, Clock::time_point to)
+{
+    return std::chrono::duration<double, std::micro>(to - from).count();
+}
+
+void waitUntil(Clock::time_point deadline)
+{
+    const auto coarse = deadline - std::chrono::microseconds(kSpinMarginUs);
+    if (Clock::now() < coarse)
+        std::this_thread::sleep_until(coarse);
+    while (Clock::now() < deadline)
+        std::this_thread::yield();  // Attente active, cède le cœur au client sur petite machine
+}
+
+/** @brief Attente de lecture à la microseconde (NativeUdpSocket::waitForData est en ms) */
+bool waitReadable(SOCKET socket, double timeoutUs)
+{
+    if (timeoutUs < 0.0)
+        timeoutUs = 0.0;
+    fd_set readfds;
+    FD_ZERO(&readfds);
+    FD_SET(socket, &readfds);
+
+    const long us = static_cast<long>(timeoutUs);
+    timeval tv;
+    tv.tv_sec  = us / 1000000;
+    tv.tv_usec = us % 1000000;
+    return select(static_cast<int>(socket) + 1, &readfds, nullptr, nullptr, &tv) > 0;
+}
+
+/** @brief snprintf à la suite du tampon ; false si la place manque */
+bool append(char*& p, const char* end, const char* format, ...)
+{
+    const int available = static_cast<int>(end - p);
+    va_list args;
+    va_start(args, format);
+    const int written = std::vsnprintf(p, static_cast<std::size_t>(available), format, args);
+    va_end(args);
+    if (written < 0 || written >= available)
+        return false;
+    p += written;
+    return true;
+}
+
+} // namespace
+
+RsiEmulator::RsiEmulator(const Settings& settings)
+    : m_settings(settings)
+{
+    if (m_settings.cycleUs <= 0)
+        m_settings.cycleUs = 4000;
+    if (m_settings.deadlineUs <= 0)
+        m_settings.deadlineUs = m_settings.cycleUs;
+    // Jitter borné à un demi-cycle : les trames restent dans l'ordre des IPOC
+    m_settings.jitterUs = std::clamp(m_settings.jitterUs, 0, m_settings.cycleUs / 2);
+}
+
+// =============================================================================
+// Trames
+// =============================================================================
+
+std::size_t RsiEmulator::buildRobFrame(uint64_t cycle, uint64_t ipoc, int cycleUs,
+    double durationJobMs, char* dst, std::size_t cap)
+{
+    const double t  = static_cast<double>(cycle) * cycleUs * 1e-6;   // s
+    const double dt = cycleUs * 1e-6;
+
+    // Trajectoire lente et continue, identique d'une exécution à l'autre
+    auto pose = [](double s, double out[6]) {
+        out[0] = 500.0 + 100.0 * std::sin(2.0 * kPi * 0.20 * s);
+        out[1] =         100.0 * std::cos(2.0 * kPi * 0.20 * s);
+        out[2] = 800.0 +  50.0 * std::sin(2.0 * kPi * 0.10 * s);
+        out[3] =  90.0 +   5.0 * std::sin(2.0 * kPi * 0.05 * s);
+        out[4] =           3.0 * std::sin(2.0 * kPi * 0.07 * s);
+        out[5] = 180.0 -   2.0 * std::cos(2.0 * kPi * 0.09 * s);
+    };
+    auto joints = [](double s, double out[6]) {
+        static const double kBase[6] = { 0.0, -90.0, 90.0, 0.0, 45.0, 0.0 };
+        for (int i = 0; i < 6; ++i)
+            out[i] = kBase[i] + 10.0 * std::sin(2.0 * kPi * (0.05 + 0.02 * i) * s);
+    };
+
+    double rist[6], rsol[6], aipos[6], aspos[6], macur[6];
+    pose(t, rist);
+    pose(t + dt, rsol);      // La consigne précède la mesure d'un cycle
+    joints(t, aipos);
+    joints(t + dt, aspos);
+    for (int i = 0; i < 6; ++i)
+        macur[i] = 2.0 * std::sin(2.0 * kPi * (0.05 + 0.02 * i) * t + 0.5 * i);
+
+    char* p = dst;
+    const char* end = dst + cap;
+
+    auto xyzabc = [&](const char* tag, const double v[6]) {
+        return append(p, end, "<%s X=\"%.4f\" Y=\"%.4f\" Z=\"%.4f\" A=\"%.4f\" B=\"%.4f\" C=\"%.4f\"/>",
+            tag, v[0], v[1], v[2], v[3], v[4], v[5]);
+    };
+    auto axes = [&](const char* tag, const double v[6]) {
+        return append(p, end, "<%s A1=\"%.4f\" A2=\"%.4f\" A3=\"%.4f\" A4=\"%.4f\" A5=\"%.4f\" A6=\"%.4f\"/>",
+            tag, v[0], v[1], v[2], v[3], v[4], v[5]);
+    };
+
+    const bool ok = append(p, end, "<Rob Type=\"KUKA\">")
+        && xyzabc("RIst", rist)
+        && xyzabc("RSol", rsol)
+        && axes("AIPos", aipos)
+        && axes("ASPos", aspos)
+        && axes("MACur", macur)
+        && append(p, end, "<Delay D=\"0\"/><Digin>0</Digin><Digout>0</Digout><Krl>0</Krl><Mode>0</Mode>")
+        && append(p, end, "<Bloc_Steps>0</Bloc_Steps><Bloc_Start>0</Bloc_Start><Bloc_Waiting>0</Bloc_Waiting>"
+                          "<Bloc_End>0</Bloc_End><Bloc_Continue>0</Bloc_Continue><Bloc_Cancel>0</Bloc_Cancel>"
+                          "<Bloc_ID>0</Bloc_ID>")
+        && append(p, end, "<Log><DtSend>%.3f</DtSend><DurationJob>%.3f</DurationJob>"
+                          "<TimeToWait>%.0f</TimeToWait><ConnectionStatus>4</ConnectionStatus>"
+                          "<Status>0</Status><ReqStatus>0</ReqStatus></Log>",
+                  cycleUs / 1000.0, durationJobMs,
+                  std::max(0.0, cycleUs - durationJobMs * 1000.0))
+        && append(p, end, "<IPOC>%llu</IPOC></Rob>", static_cast<unsigned long long>(ipoc));
+
+    return ok ? static_cast<std::size_t>(p - dst) : 0;
+}
+
+bool RsiEmulator::parseAckIpoc(const char* data, std::size_t len, uint64_t& ipoc)
+{
+    const char* value = nullptr;
+    std::size_t valueLen = 0;
+    if (!TrameHelper::findLastTag(data, len, "IPOC>", "</IPOC>", value, valueLen) || valueLen == 0)
+        return false;
+
+    uint64_t result = 0;
+    for (std::size_t i = 0; i < valueLen; ++i) {
+        if (value[i] < '0' || value[i] > '9')
+            return false;
+        result = result * 10 + static_cast<uint64_t>(value[i] - '0');
+    }
+    ipoc = result;
+    return true;
+}
+
+// =============================================================================
+// Exécution
+// =============================================================================
+
+bool RsiEmulator::run(const std::atomic<bool>* stop)
+{
+    m_report = Report();
+    m_lastError.clear();
+
+    NativeUdpSocket socket("0.0.0.0", m_settings.localPort, 1 << 20);
+    if (!socket.open() || !socket.bind()) {
+        m_lastError = "Cannot open robot UDP port " + std::to_string(m_settings.localPort);
+        return false;
+    }
+
+    std::ofstream csv;
+    if (!m_settings.csvPath.empty()) {
+        csv.open(m_settings.csvPath);
+        if (!csv) {
+            m_lastError = "Cannot write " + m_settings.csvPath;
+            return false;
+        }
+        csv << "cycle,ipoc,sent,send_lateness_us,rtt_us,status\n";
+    }
+
+    std::mt19937 rng(m_settings.seed);
+    std::uniform_int_distribution<int>     jitter(-m_settings.jitterUs, m_settings.jitterUs);
+    std::uniform_real_distribution<double> loss(0.0, 1.0);
+
+    // IPOC : horloge interpolateur en ms, avance d'un cycle à chaque trame
+    const uint64_t ipocStep = static_cast<uint64_t>(std::max(1, m_settings.cycleUs / 1000));
+    uint64_t ipoc = 1000000;
+
+    uint64_t pendingIpoc[kPendingIpocs] = {};
+    std::vector<double> rtts;
+    rtts.reserve(static_cast<std::size_t>(std::min<uint64_t>(m_settings.cycles, 10000000)));
+
+    char frame[kFrameBufSize];
+    char ack[kFrameBufSize];
+    double lastRttMs = 0.0;
+
+    const auto start = Clock::now() + std::chrono::milliseconds(10);
+    for (uint64_t cycle = 0; cycle < m_settings.cycles; ++cycle) {
+        if (stop && stop->load(std::memory_order_relaxed))
+            break;
+
+        // Échéancier absolu : le jitter décale une trame sans dériver les suivantes
+        const auto nominal = start + std::chrono::microseconds(static_cast<int64_t>(cycle) * m_settings.cycleUs);
+        const auto nextCycle = nominal + std::chrono::microseconds(m_settings.cycleUs);
+        const int  offsetUs = m_settings.jitterUs > 0 ? jitter(rng) : 0;
+        const bool drop = m_settings.lossRate > 0.0 && loss(rng) < m_settings.lossRate;
+        ipoc += ipocStep;
+
+        const auto scheduled = nominal + std::chrono::microseconds(offsetUs);
+        waitUntil(scheduled);
+
+        bool sent = false;
+        double lateness = 0.0;
+        Clock::time_point sendTime = scheduled;
+        if (drop) {
+            ++m_report.injectedLosses;
+        }
+        else {
+            const std::size_t len = buildRobFrame(cycle, ipoc, m_settings.cycleUs, lastRttMs, frame, sizeof(frame));
+            sendTime = Clock::now();
+            lateness = elapsedUs(scheduled, sendTime);
+            m_report.sendLatenessMaxUs = std::max(m_report.sendLatenessMaxUs, lateness);
+            sent = len > 0 && socket.sendTo(frame, static_cast<int>(len), m_settings.targetIp, m_settings.targetPort) > 0;
+            if (sent) {
+                ++m_report.sent;
+                pendingIpoc[cycle % kPendingIpocs] = ipoc;
+            }
+        }
+
+        // Attente de l'ACK jusqu'à l'échéance (bornée au début du cycle suivant)
+        const auto deadline = std::min(nextCycle,
+            scheduled + std::chrono::microseconds(m_settings.deadlineUs));
+        double rttUs = -1.0;
+        const char* status = sent ? "miss" : (drop ? "dropped" : "send_error");
+
+        while (true) {
+            const auto now = Clock::now();
+            const double waitUs = elapsedUs(now, sent && rttUs < 0.0 ? deadline : nextCycle);
+            if (waitUs <= 0.0 || !waitReadable(socket.nativeHandle(), waitUs))
+                break;
+
+            std::string senderIp;
+            u_short senderPort = 0;
+            const int len = socket.recvFrom(ack, sizeof(ack), senderIp, senderPort);
+            const auto received = Clock::now();
+            if (len <= 0)
+                continue;
+
+            uint64_t echoed = 0;
+            if (!parseAckIpoc(ack, static_cast<std::size_t>(len), echoed)) {
+                ++m_report.echoErrors;
+                continue;
+            }
+            if (sent && rttUs < 0.0 && echoed == ipoc && received <= deadline) {
+                rttUs = elapsedUs(sendTime, received);
+                rtts.push_back(rttUs);
+                lastRttMs = rttUs / 1000.0;
+                ++m_report.acked;
+                status = "ok";
+                continue;   // Drainer jusqu'au cycle suivant (ACK dupliqués, tardifs)
+            }
+            if (std::find(std::begin(pendingIpoc), std::end(pendingIpoc), echoed) != std::end(pendingIpoc))
+                ++m_report.lateAcks;
+            else
+                ++m_report.echoErrors;
+        }
+        if (sent && rttUs < 0.0)
+            ++m_report.deadlineMisses;
+
+        if (csv.is_open()) {
+            csv << cycle << ',' << ipoc << ',' << (sent ? 1 : 0) << ','
+                << lateness << ',' << rttUs << ',' << status << '\n';
+        }
+    }
+
+    computeRttStatistics(rtts);
+    return true;
+}
+
+void RsiEmulator::computeRttStatistics(std::vector<double>& rtts)
+{
+    if (rtts.empty())
+        return;
+
+    std::sort(rtts.begin(), rtts.end());
+    auto percentile = [&](double q) {
+        const std::size_t index = static_cast<std::size_t>(q * static_cast<double>(rtts.size() - 1) + 0.5);
+        return rtts[std::min(index, rtts.size() - 1)];
+    };
+
+    double sum = 0.0;
+    for (double rtt : rtts)
+        sum += rtt;
+
+    m_report.rttMinUs  = rtts.front();
+    m_report.rttMaxUs  = rtts.back();
+    m_report.rttMeanUs = sum / static_cast<double>(rtts.size());
+    m_report.rttP50Us  = percentile(0.50);
+    m_report.rttP99Us  = percentile(0.99);
+    m_report.rttP999Us = percentile(0.999);
+}
@@ -0,0 +1,93 @@
+#pragma once
+#ifndef RSIEMULATOR_H
+#define RSIEMULATOR_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Contrôleur KUKA RSI émulé : trames <Rob> cadencées, contrôle des ACK <Sen>
+ *
+ * Joue le rôle du robot face à KukaRsiSystem (ou à tout client RSI) : envoie une trame
+ * <Rob> par cycle IPOC (RIst, RSol, AIPos, ASPos, MACur, Delay, scalaires, bloc <Log>),
+ * attend l'ACK avant le cycle suivant et vérifie l'écho de l'IPOC.
+ *
+ * Déterministe : trajectoire fonction du seul numéro de cycle, jitter et pertes tirés
+ * d'un générateur pseudo-aléatoire initialisé par Settings::seed. Deux exécutions avec
+ * les mêmes réglages envoient exactement les mêmes trames aux mêmes instants prévus.
+ *
+ * Sans Qt : outil en ligne de commande (RsiEmulatorMain.cpp), se compile aussi sous Linux :
+ *   g++ -std=c++17 -O2 -pthread RsiEmulatorMain.cpp RsiEmulator.cpp NativeUdpSocket.cpp DatagramCapture.cpp TrameHelper.cpp
+ */
+class RsiEmulator {
+public:
+    struct Settings {
+        std::string targetIp   = "127.0.0.1";   // Hôte Mobot4 (KukaRsiConfig::hostAddress)
+        uint16_t    targetPort = 49152;         // KukaRsiConfig::hostPort
+        uint16_t    localPort  = 0;             // Port du "robot", 0 = éphémère
+
+        int      cycleUs    = 4000;             // Cadence IPOC : 4000 (RSI 4 ms) ou 1000 (1 ms)
+        uint64_t cycles     = 2500;             // Nombre de cycles (10 s à 4 ms)
+        int      jitterUs   = 0;                // Jitter d'émission uniforme ±jitterUs
+        double   lossRate   = 0.0;              // Proportion de trames non émises [0, 1]
+        uint32_t seed       = 1;
+
+        // Délai d'ACK toléré : par défaut la durée d'un cycle (comme le contrôleur)
+        int      deadlineUs = 0;
+
+        std::string csvPath;                    // Trace par cycle (vide = aucune)
+    };
+
+    /** @brief Bilan d'une exécution (temps aller-retour en µs) */
+    struct Report {
+        uint64_t sent           = 0;
+        uint64_t injectedLosses = 0;    // Trames volontairement non émises
+        uint64_t acked          = 0;    // ACK valides reçus dans le délai
+        uint64_t deadlineMisses = 0;    // Trame émise sans ACK avant l'échéance
+        uint64_t lateAcks       = 0;    // ACK d'un IPOC précédent (arrivé après son échéance)
+        uint64_t echoErrors     = 0;    // ACK sans IPOC ou IPOC inconnu
+        double   rttMinUs  = 0.0;
+        double   rttMeanUs = 0.0;
+        double   rttP50Us  = 0.0;
+        double   rttP99Us  = 0.0;
+        double   rttP999Us = 0.0;
+        double   rttMaxUs  = 0.0;
+        double   sendLatenessMaxUs = 0.0;   // Retard max d'émission sur l'échéancier (ordonnanceur)
+
+        double missRate() const { return sent > 0 ? static_cast<double>(deadlineMisses) / sent : 0.0; }
+    };
+
+    explicit RsiEmulator(const Settings& settings);
+
+    /**
+     * @brief Exécute Settings::cycles cycles (bloquant)
+     * @param stop Arrêt anticipé (Ctrl+C), peut être nul
+     * @return false si le socket n'a pas pu être ouvert (voir lastError())
+     */
+    bool run(const std::atomic<bool>* stop = nullptr);
+
+    const Report&      report() const { return m_report; }
+    const std::string& lastError() const { return m_lastError; }
+
+    /**
+     * @brief Trame <Rob> du cycle donné (trajectoire déterministe)
+     * @return Taille écrite, 0 si le tampon est trop petit
+     */
+    static std::size_t buildRobFrame(uint64_t cycle, uint64_t ipoc, int cycleUs,
+        double durationJobMs, char* dst, std::size_t cap);
+
+    /** @brief IPOC en écho dans un ACK <Sen> ; false si absent ou non numérique */
+    static bool parseAckIpoc(const char* data, std::size_t len, uint64_t& ipoc);
+
+private:
+    void computeRttStatistics(std::vector<double>& rtts);
+
+    Settings    m_settings;
+    Report      m_report;
+    std::string m_lastError;
+};
+
+#endif // RSIEMULATOR_H
@@ -0,0 +1,177 @@
+// ============================================================================
+// RsiEmulatorMain.cpp - Émulateur de contrôleur KUKA RSI (banc de test sans robot)
+// ============================================================================
+// Exemples :
+//   RsiEmulator --target 127.0.0.1:49152 --cycle-us 4000 --duration 30
+//   RsiEmulator --cycle-us 1000 --jitter-us 150 --loss 0.001 --csv run.csv
+//   RsiEmulator --robots 4 --target 127.0.0.1:49152   (ports 49152..49155)
+//
+// Code de sortie : 0 si le taux d'échéances manquées reste sous --max-miss-rate
+// et qu'aucun ACK n'a renvoyé un IPOC erroné ; 1 sinon ; 2 si erreur d'usage.
+// ============================================================================
+
+#include "RsiEmulator.h"
+
+#include <atomic>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+std::atomic<bool> g_stop{ false };
+
+void onSignal(int)
+{
+    g_stop.store(true);
+}
+
+void printUsage()
+{
+    std::printf(
+        "Usage: RsiEmulator [options]\n"
+        "  --target IP:PORT     Mobot4 RSI endpoint (default 127.0.0.1:49152)\n"
+        "  --local-port N       Robot-side UDP port (default 0 = ephemeral)\n"
+        "  --cycle-us N         IPOC cycle, 4000 or 1000 (default 4000)\n"
+        "  --cycles N           Number of cycles (default 2500)\n"
+        "  --duration S         Run time in seconds (overrides --cycles)\n"
+        "  --jitter-us N        Uniform send jitter +/-N us (default 0)\n"
+        "  --loss P             Injected frame loss ratio 0..1 (default 0)\n"
+        "  --seed N             Jitter / loss generator seed (default 1)\n"
+        "  --deadline-us N      ACK deadline (default = cycle)\n"
+        "  --robots N           Parallel robots on PORT, PORT+1, ... (default 1)\n"
+        "  --csv FILE           Per-cycle trace (robot index appended if --robots > 1)\n"
+        "  --max-miss-rate P    Fail threshold for deadline misses (default 0.001)\n");
+}
+
+bool parseEndpoint(const std::string& text, std::string& ip, uint16_t& port)
+{
+    const size_t colon = text.rfind(':');
+    if (colon == std::string::npos)
+        return false;
+    ip = text.substr(0, colon);
+    const long value = std::strtol(text.c_str() + colon + 1, nullptr, 10);
+    if (ip.empty() || value <= 0 || value > 65535)
+        return false;
+    port = static_cast<uint16_t>(value);
+    return true;
+}
+
+void printReport(int robot, const RsiEmulator::Settings& settings, const RsiEmulator::Report& r)
+{
+    std::printf("[robot %d -> %s:%u] cycle %d us\n", robot,
+        settings.targetIp.c_str(), static_cast<unsigned>(settings.targetPort), settings.cycleUs);
+    std::printf("  sent %llu, injected losses %llu, acked %llu\n",
+        static_cast<unsigned long long>(r.sent),
+        static_cast<unsigned long long>(r.injectedLosses),
+        static_cast<unsigned long long>(r.acked));
+    std::printf("  deadline misses %llu (%.4f %%), late ACKs %llu, echo errors %llu\n",
+        static_cast<unsigned long long>(r.deadlineMisses), 100.0 * r.missRate(),
+        static_cast<unsigned long long>(r.lateAcks),
+        static_cast<unsigned long long>(r.echoErrors));
+    std::printf("  RTT us: min %.1f  mean %.1f  p50 %.1f  p99 %.1f  p99.9 %.1f  max %.1f\n",
+        r.rttMinUs, r.rttMeanUs, r.rttP50Us, r.rttP99Us, r.rttP999Us, r.rttMaxUs);
+    std::printf("  send lateness max %.1f us\n", r.sendLatenessMaxUs);
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    RsiEmulator::Settings settings;
+    int    robots = 1;
+    double durationS = 0.0;
+    double maxMissRate = 0.001;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        auto value = [&]() { return std::string(argv[++i]); };
+
+        if (std::strcmp(arg, "--help") == 0 || std::strcmp(arg, "-h") == 0) {
+            printUsage();
+            return 0;
+        }
+        if (!hasValue) {
+            std::fprintf(stderr, "Missing value for %s\n", arg);
+            return 2;
+        }
+
+        if (std::strcmp(arg, "--target") == 0) {
+            if (!parseEndpoint(value(), settings.targetIp, settings.targetPort)) {
+                std::fprintf(stderr, "Invalid --target (expected IP:PORT)\n");
+                return 2;
+            }
+        }
+        else if (std::strcmp(arg, "--local-port") == 0)  settings.localPort = static_cast<uint16_t>(std::atoi(value().c_str()));
+        else if (std::strcmp(arg, "--cycle-us") == 0)    settings.cycleUs = std::atoi(value().c_str());
+        else if (std::strcmp(arg, "--cycles") == 0)      settings.cycles = std::strtoull(value().c_str(), nullptr, 10);
+        else if (std::strcmp(arg, "--duration") == 0)    durationS = std::atof(value().c_str());
+        else if (std::strcmp(arg, "--jitter-us") == 0)   settings.jitterUs = std::atoi(value().c_str());
+        else if (std::strcmp(arg, "--loss") == 0)        settings.lossRate = std::atof(value().c_str());
+        else if (std::strcmp(arg, "--seed") == 0)        settings.seed = static_cast<uint32_t>(std::strtoul(value().c_str(), nullptr, 10));
+        else if (std::strcmp(arg, "--deadline-us") == 0) settings.deadlineUs = std::atoi(value().c_str());
+        else if (std::strcmp(arg, "--robots") == 0)      robots = std::atoi(value().c_str());
+        else if (std::strcmp(arg, "--csv") == 0)         settings.csvPath = value();
+        else if (std::strcmp(arg, "--max-miss-rate") == 0) maxMissRate = std::atof(value().c_str());
+        else {
+            std::fprintf(stderr, "Unknown option %s\n", arg);
+            printUsage();
+            return 2;
+        }
+    }
+
+    if (settings.cycleUs <= 0 || robots <= 0 || settings.lossRate < 0.0 || settings.lossRate > 1.0) {
+        std::fprintf(stderr, "Invalid settings (cycle, robots or loss ratio)\n");
+        return 2;
+    }
+    if (durationS > 0.0)
+        settings.cycles = static_cast<uint64_t>(durationS * 1e6 / settings.cycleUs);
+
+    std::signal(SIGINT, onSignal);
+
+    // Un thread par robot émulé : même cadence, ports cibles consécutifs, graines distinctes
+    std::vector<RsiEmulator::Settings> perRobot(static_cast<size_t>(robots), settings);
+    std::vector<RsiEmulator::Report>   reports(static_cast<size_t>(robots));
+    std::vector<std::string>           errors(static_cast<size_t>(robots));
+    std::vector<std::thread>           threads;
+
+    for (int r = 0; r < robots; ++r) {
+        RsiEmulator::Settings& s = perRobot[static_cast<size_t>(r)];
+        s.targetPort = static_cast<uint16_t>(settings.targetPort + r);
+        if (settings.localPort != 0)
+            s.localPort = static_cast<uint16_t>(settings.localPort + r);
+        s.seed = settings.seed + static_cast<uint32_t>(r);
+        if (robots > 1 && !s.csvPath.empty())
+            s.csvPath += "." + std::to_string(r);
+
+        threads.emplace_back([&, r]() {
+            RsiEmulator emulator(perRobot[static_cast<size_t>(r)]);
+            if (!emulator.run(&g_stop))
+                errors[static_cast<size_t>(r)] = emulator.lastError();
+            reports[static_cast<size_t>(r)] = emulator.report();
+        });
+    }
+    for (std::thread& t : threads)
+        t.join();
+
+    bool pass = true;
+    for (int r = 0; r < robots; ++r) {
+        const size_t index = static_cast<size_t>(r);
+        if (!errors[index].empty()) {
+            std::fprintf(stderr, "[robot %d] %s\n", r, errors[index].c_str());
+            pass = false;
+            continue;
+        }
+        printReport(r, perRobot[index], reports[index]);
+        if (reports[index].missRate() > maxMissRate || reports[index].echoErrors > 0)
+            pass = false;
+    }
+
+    std::printf("%s\n", pass ? "PASS" : "FAIL");
+    return pass ? 0 : 1;
+}
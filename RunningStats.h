@@ -0,0 +1,149 @@
+#pragma once
+#ifndef RUNNINGSTATS_H
+#define RUNNINGSTATS_H
+
+#include <QtGlobal>
+#include <array>
+#include <cmath>
+#include <limits>
+
+/**
+ * @brief Moyenne / variance en flux (algorithme de Welford)
+ *
+ * Numériquement stable même sur des millions d'échantillons proches
+ * (ex: périodes de 4 ms ± quelques µs), contrairement à Σx² − (Σx)²/n.
+ * Coût : O(1) par échantillon, aucune allocation.
+ */
+class RunningStats {
+public:
+    void reset()
+    {
+        m_count = 0;
+        m_mean  = 0.0;
+        m_m2    = 0.0;
+        m_min   = std::numeric_limits<double>::max();
+        m_max   = std::numeric_limits<double>::lowest();
+    }
+
+    void add(double x)
+    {
+        ++m_count;
+        const double delta = x - m_mean;
+        m_mean += delta / static_cast<double>(m_count);
+        m_m2   += delta * (x - m_mean);
+        if (x < m_min) m_min = x;
+        if (x > m_max) m_max = x;
+    }
+
+    quint64 count() const { return m_count; }
+    double  mean()  const { return m_mean; }
+    double  min()   const { return m_count > 0 ? m_min : 0.0; }
+    double  max()   const { return m_count > 0 ? m_max : 0.0; }
+
+    /** @brief Variance d'échantillon (n − 1) — 0 si moins de 2 échantillons */
+    double variance() const
+    {
+        return m_count > 1 ? m_m2 / static_cast<double>(m_count - 1) : 0.0;
+    }
+
+    double stddev() const { return std::sqrt(variance()); }
+
+private:
+    quint64 m_count = 0;
+    double  m_mean  = 0.0;
+    double  m_m2    = 0.0;
+    double  m_min   = std::numeric_limits<double>::max();
+    double  m_max   = std::numeric_limits<double>::lowest();
+};
+
+/**
+ * @brief Déviation d'Allan (non recouvrante) calculée en flux sur des fenêtres octaves
+ *
+ * Niveau k = blocs de 2^k échantillons consécutifs. Chaque bloc terminé au niveau k
+ * est comparé au bloc précédent du même niveau (σ²(k) = ½·⟨(ȳ[i+1] − ȳ[i])²⟩),
+ * puis fusionné par paires pour alimenter le niveau k+1.
+ * Coût amorti : O(1) par échantillon, mémoire fixe (kMaxOctaves niveaux).
+ *
+ * Appliquée à la période inter-frame, elle sépare le jitter blanc (pente −½)
+ * de la dérive d'horloge (remontée aux grands τ).
+ */
+class AllanDeviation {
+public:
+    static constexpr int kMaxOctaves = 20;   // 2^19 échantillons ≈ 35 min à 250 Hz
+
+    void reset()
+    {
+        m_levels = {};
+        m_sampleCount = 0;
+    }
+
+    void add(double y)
+    {
+        ++m_sampleCount;
+        double blockMean = y;
+        for (int k = 0; k < kMaxOctaves; ++k) {
+            Level& lv = m_levels[k];
+
+            // Bloc de niveau k terminé : différence avec le bloc précédent
+            if (lv.hasPrevious) {
+                const double d = blockMean - lv.previousMean;
+                lv.sumSqDiff += d * d;
+                ++lv.diffCount;
+            }
+            lv.previousMean = blockMean;
+            lv.hasPrevious  = true;
+
+            // Fusion par paires → niveau supérieur
+            if (!lv.hasPending) {
+                lv.pendingMean = blockMean;
+                lv.hasPending  = true;
+                return;
+            }
+            blockMean     = 0.5 * (lv.pendingMean + blockMean);
+            lv.hasPending = false;
+        }
+    }
+
+    /** @brief Nombre d'octaves disposant d'au moins une différence */
+    int octaveCount() const
+    {
+        int n = 0;
+        while (n < kMaxOctaves && m_levels[n].diffCount > 0) ++n;
+        return n;
+    }
+
+    /** @brief Taille de fenêtre du niveau k, en nombre d'échantillons (2^k) */
+    static quint64 windowSamples(int octave) { return quint64(1) << octave; }
+
+    /** @brief Déviation d'Allan du niveau k (même unité que les échantillons) */
+    double deviation(int octave) const
+    {
+        if (octave < 0 || octave >= kMaxOctaves) return 0.0;
+        const Level& lv = m_levels[octave];
+        return lv.diffCount > 0
+            ? std::sqrt(lv.sumSqDiff / (2.0 * static_cast<double>(lv.diffCount)))
+            : 0.0;
+    }
+
+    quint64 differenceCount(int octave) const
+    {
+        return (octave >= 0 && octave < kMaxOctaves) ? m_levels[octave].diffCount : 0;
+    }
+
+    quint64 sampleCount() const { return m_sampleCount; }
+
+private:
+    struct Level {
+        double  pendingMean  = 0.0;
+        double  previousMean = 0.0;
+        double  sumSqDiff    = 0.0;
+        quint64 diffCount    = 0;
+        bool    hasPending   = false;
+        bool    hasPrevious  = false;
+    };
+
+    std::array<Level, kMaxOctaves> m_levels{};
+    quint64 m_sampleCount = 0;
+};
+
+#endif // RUNNINGSTATS_H
@@ -0,0 +1,459 @@
+#include "SessionFile.h"
+#include "TraceRecorder.h"
+#include <QLocale>
+#include <QtEndian>
+#include <charconv>
+#include <cstring>
+
+namespace {
+
+constexpr int kMaxInternedNames = 256;
+constexpr int kBinaryFixedSize  = 24 + 11 * 8;     // Partie fixe d'un enregistrement binaire
+
+enum BinaryFlags : quint8 {
+    FlagValid      = 0x01,
+    FlagQuaternion = 0x02
+};
+
+// ========== Écriture ==========
+
+void appendNumber(QByteArray& out, double value)
+{
+    // Plus courte représentation relisible à l'identique, indépendante de la locale
+    out.append(QByteArray::number(value, 'g', QLocale::FloatingPointShortest));
+}
+
+void appendCsvName(QByteArray& out, const QString& name)
+{
+    const QByteArray utf8 = name.toUtf8();
+    if (!utf8.contains(',') && !utf8.contains('"')) {
+        out.append(utf8);
+        return;
+    }
+    QByteArray quoted = utf8;
+    quoted.replace("\"", "\"\"");
+    out.append('"').append(quoted).append('"');
+}
+
+template <typename T>
+void appendLittleEndian(QByteArray& out, T value)
+{
+    char bytes[sizeof(T)];
+    qToLittleEndian(value, bytes);
+    out.append(bytes, sizeof(T));
+}
+
+// ========== Lecture CSV ==========
+
+/** @brief Champ [begin, end[ de la ligne, guillemets retirés ; pos avance après la virgule */
+struct CsvField {
+    const char* begin  = nullptr;
+    const char* end    = nullptr;
+    bool        quoted = false;     // Contient des "" à déséchapper
+};
+
+bool nextCsvField(const char*& pos, const char* lineEnd, CsvField& field)
+{
+    if (pos > lineEnd)
+        return false;
+
+    field.quoted = false;
+    if (pos < lineEnd && *pos == '"') {
+        const char* p = pos + 1;
+        field.begin = p;
+        for (;;) {
+            const char* quote = static_cast<const char*>(std::memchr(p, '"', static_cast<size_t>(lineEnd - p)));
+            if (!quote)
+                return false;
+            if (quote + 1 < lineEnd && quote[1] == '"') {
+                field.quoted = true;
+                p = quote + 2;
+                continue;
+            }
+            field.end = quote;
+            pos = quote + 1;
+            break;
+        }
+        if (pos < lineEnd && *pos != ',')
+            return false;
+        ++pos;
+        return true;
+    }
+
+    const char* comma = static_cast<const char*>(std::memchr(pos, ',', static_cast<size_t>(lineEnd - pos)));
+    field.begin = pos;
+    field.end   = comma ? comma : lineEnd;
+    pos = field.end + 1;
+    return true;
+}
+
+template <typename T>
+bool parseNumber(const CsvField& field, T& value)
+{
+    const std::from_chars_result r = std::from_chars(field.begin, field.end, value);
+    return r.ec == std::errc() && r.ptr == field.end;
+}
+
+template <typename Intern>
+bool parseExtras(const char* p, const char* end, QMap<QString, QVector<double>>& extras, Intern intern)
+{
+    while (p < end) {
+        const char* entryEnd = static_cast<const char*>(std::memchr(p, ';', static_cast<size_t>(end - p)));
+        if (!entryEnd)
+            entryEnd = end;
+        const char* equal = static_cast<const char*>(std::memchr(p, '=', static_cast<size_t>(entryEnd - p)));
+        if (!equal)
+            return false;
+
+        QVector<double>& values = extras[intern(p, static_cast<int>(equal - p))];
+        const char* v = equal + 1;
+        while (v < entryEnd) {
+            double value = 0.0;
+            const std::from_chars_result r = std::from_chars(v, entryEnd, value);
+            if (r.ec != std::errc())
+                return false;
+            values.append(value);
+            v = r.ptr;
+            while (v < entryEnd && *v == ' ')
+                ++v;
+        }
+        p = entryEnd + 1;
+    }
+    return true;
+}
+
+} // namespace
+
+// ========== Écriture ==========
+
+QByteArray SessionFile::fileHeader(Format format)
+{
+    QByteArray header;
+    if (format == Format::Csv) {
+        header.append(kCsvHeader).append('\n');
+    }
+    else if (format == Format::Binary) {
+        header.append(kBinaryMagic, 8);
+        appendLittleEndian<quint32>(header, kBinaryVersion);
+        appendLittleEndian<quint32>(header, 0);
+    }
+    return header;
+}
+
+void SessionFile::appendFrame(Format format, QByteArray& out, const MeasurementFrame& frame)
+{
+    MOBOT_TRACE_SCOPE("session.append");
+
+    if (format == Format::Csv) {
+        out.append(QByteArray::number(frame.timestamp)).append(',');
+        appendCsvName(out, frame.systemName);
+        out.append(',');
+        appendCsvName(out, frame.objectName);
+        out.append(',').append(QByteArray::number(frame.frameNumber));
+        out.append(',').append(frame.isValid ? '1' : '0').append(',');
+        appendNumber(out, frame.quality);
+        for (double v : { frame.x, frame.y, frame.z, frame.rx, frame.ry, frame.rz }) {
+            out.append(',');
+            appendNumber(out, v);
+        }
+        const MeasurementFrame::Quaternion& q = frame.quaternion;
+        for (double v : { q.w, q.x, q.y, q.z }) {
+            out.append(',');
+            if (q.valid)
+                appendNumber(out, v);
+        }
+        out.append(',');
+        for (auto it = frame.extras.constBegin(); it != frame.extras.constEnd(); ++it) {
+            if (it != frame.extras.constBegin())
+                out.append(';');
+            out.append(it.key().toUtf8()).append('=');
+            for (int i = 0; i < it.value().size(); ++i) {
+                if (i > 0)
+                    out.append(' ');
+                appendNumber(out, it.value()[i]);
+            }
+        }
+        out.append('\n');
+        return;
+    }
+
+    if (format != Format::Binary)
+        return;
+
+    const QByteArray system = frame.systemName.toUtf8();
+    const QByteArray object = frame.objectName.toUtf8();
+
+    const qint64 start = out.size();
+    appendLittleEndian<quint32>(out, 0);                // Taille, complétée à la fin
+    appendLittleEndian<qint64>(out, frame.timestamp);
+    appendLittleEndian<qint32>(out, frame.frameNumber);
+    out.append(static_cast<char>((frame.isValid ? FlagValid : 0)
+                               | (frame.quaternion.valid ? FlagQuaternion : 0)));
+    out.append('\0');
+    appendLittleEndian<quint16>(out, static_cast<quint16>(system.size()));
+    appendLittleEndian<quint16>(out, static_cast<quint16>(object.size()));
+    appendLittleEndian<quint16>(out, static_cast<quint16>(frame.extras.size()));
+
+    const MeasurementFrame::Quaternion& q = frame.quaternion;
+    for (double v : { frame.quality, frame.x, frame.y, frame.z, frame.rx, frame.ry, frame.rz,
+                      q.w, q.x, q.y, q.z })
+        appendLittleEndian<double>(out, v);
+
+    out.append(system).append(object);
+    for (auto it = frame.extras.constBegin(); it != frame.extras.constEnd(); ++it) {
+        const QByteArray name = it.key().toUtf8();
+        appendLittleEndian<quint16>(out, static_cast<quint16>(name.size()));
+        appendLittleEndian<quint16>(out, static_cast<quint16>(it.value().size()));
+        out.append(name);
+        for (double v : it.value())
+            appendLittleEndian<double>(out, v);
+    }
+
+    qToLittleEndian<quint32>(static_cast<quint32>(out.size() - start), out.data() + start);
+}
+
+// ========== Lecture ==========
+
+SessionFile::~SessionFile()
+{
+    close();
+}
+
+SessionFile::Format SessionFile::detectFormat(const char* data, qint64 size)
+{
+    if (size >= kBinaryHeaderSize && std::memcmp(data, kBinaryMagic, 8) == 0)
+        return Format::Binary;
+
+    // BOM UTF-8 toléré (fichier réenregistré par un éditeur)
+    if (size >= 3 && std::memcmp(data, "\xEF\xBB\xBF", 3) == 0) {
+        data += 3;
+        size -= 3;
+    }
+    const qint64 prefix = static_cast<qint64>(std::strlen("timestamp_us,"));
+    if (size >= prefix && std::memcmp(data, kCsvHeader, static_cast<size_t>(prefix)) == 0)
+        return Format::Csv;
+
+    return Format::Unknown;
+}
+
+bool SessionFile::open(const QString& path)
+{
+    close();
+
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        m_errorString = QString("Cannot open %1: %2").arg(path, m_file.errorString());
+        return false;
+    }
+
+    m_size = m_file.size();
+    if (m_size == 0) {
+        m_errorString = QString("Empty session file: %1").arg(path);
+        close();
+        return false;
+    }
+
+    const uchar* mapped = m_file.map(0, m_size);
+    if (!mapped) {
+        m_errorString = QString("Cannot map %1: %2").arg(path, m_file.errorString());
+        close();
+        return false;
+    }
+    m_data = reinterpret_cast<const char*>(mapped);
+
+    m_format = detectFormat(m_data, m_size);
+    switch (m_format) {
+    case Format::Binary: {
+        const quint32 version = qFromLittleEndian<quint32>(m_data + 8);
+        if (version != kBinaryVersion) {
+            m_errorString = QString("Unsupported session version %1 in %2").arg(version).arg(path);
+            close();
+            return false;
+        }
+        m_firstRecord = kBinaryHeaderSize;
+        break;
+    }
+    case Format::Csv: {
+        const char* eol = static_cast<const char*>(std::memchr(m_data, '\n', static_cast<size_t>(m_size)));
+        m_firstRecord = eol ? (eol - m_data) + 1 : m_size;
+        break;
+    }
+    case Format::Unknown:
+    default:
+        m_errorString = QString("Not a Mobot4 session file: %1").arg(path);
+        close();
+        return false;
+    }
+
+    m_errorString.clear();
+    return true;
+}
+
+void SessionFile::close()
+{
+    if (m_data)
+        m_file.unmap(reinterpret_cast<uchar*>(const_cast<char*>(m_data)));
+    if (m_file.isOpen())
+        m_file.close();
+
+    m_data        = nullptr;
+    m_size        = 0;
+    m_firstRecord = 0;
+    m_format      = Format::Unknown;
+    m_names.clear();
+}
+
+bool SessionFile::readFrame(qint64 offset, MeasurementFrame& frame, qint64& next)
+{
+    next = m_size;
+    if (!m_data || offset < m_firstRecord || offset >= m_size)
+        return false;
+
+    return m_format == Format::Binary ? readBinary(offset, frame, next)
+                                      : readCsv(offset, frame, next);
+}
+
+bool SessionFile::readBinary(qint64 offset, MeasurementFrame& frame, qint64& next)
+{
+    const char*  p         = m_data + offset;
+    const qint64 available = m_size - offset;
+    if (available < kBinaryFixedSize) {
+        m_errorString = QString("Truncated record at offset %1").arg(offset);
+        return false;
+    }
+
+    const quint32 recordSize = qFromLittleEndian<quint32>(p);
+    const quint16 systemLen  = qFromLittleEndian<quint16>(p + 18);
+    const quint16 objectLen  = qFromLittleEndian<quint16>(p + 20);
+    const quint16 extraCount = qFromLittleEndian<quint16>(p + 22);
+    if (recordSize < static_cast<quint32>(kBinaryFixedSize + systemLen + objectLen)
+        || recordSize > available) {
+        m_errorString = QString("Corrupted record at offset %1").arg(offset);
+        return false;
+    }
+
+    frame.timestamp   = qFromLittleEndian<qint64>(p + 4);
+    frame.frameNumber = qFromLittleEndian<qint32>(p + 12);
+    const quint8 flags = static_cast<quint8>(p[16]);
+    frame.isValid          = (flags & FlagValid) != 0;
+    frame.quaternion.valid = (flags & FlagQuaternion) != 0;
+
+    const char* values = p + 24;
+    auto value = [values](int i) { return qFromLittleEndian<double>(values + 8 * i); };
+    frame.quality = value(0);
+    frame.x  = value(1);  frame.y  = value(2);  frame.z  = value(3);
+    frame.rx = value(4);  frame.ry = value(5);  frame.rz = value(6);
+    frame.quaternion.w = value(7);
+    frame.quaternion.x = value(8);
+    frame.quaternion.y = value(9);
+    frame.quaternion.z = value(10);
+
+    const char* names = p + kBinaryFixedSize;
+    frame.systemName = intern(names, systemLen);
+    frame.objectName = intern(names + systemLen, objectLen);
+
+    frame.extras.clear();
+    const char* q   = names + systemLen + objectLen;
+    const char* end = p + recordSize;
+    for (int i = 0; i < extraCount; ++i) {
+        if (end - q < 4)
+            break;
+        const quint16 nameLen    = qFromLittleEndian<quint16>(q);
+        const quint16 valueCount = qFromLittleEndian<quint16>(q + 2);
+        q += 4;
+        if (end - q < nameLen + 8LL * valueCount)
+            break;
+        QVector<double>& extra = frame.extras[intern(q, nameLen)];
+        q += nameLen;
+        extra.resize(valueCount);
+        for (int k = 0; k < valueCount; ++k, q += 8)
+            extra[k] = qFromLittleEndian<double>(q);
+    }
+
+    next = offset + recordSize;
+    return true;
+}
+
+bool SessionFile::readCsv(qint64 offset, MeasurementFrame& frame, qint64& next)
+{
+    // Lignes vides tolérées (fin de fichier, édition manuelle)
+    const char* lineBegin = m_data + offset;
+    const char* fileEnd   = m_data + m_size;
+    const char* lineEnd   = nullptr;
+    for (;;) {
+        const char* eol = static_cast<const char*>(std::memchr(lineBegin, '\n', static_cast<size_t>(fileEnd - lineBegin)));
+        lineEnd = eol ? eol : fileEnd;
+        next    = eol ? (eol - m_data) + 1 : m_size;
+        if (lineEnd > lineBegin && lineEnd[-1] == '\r')
+            --lineEnd;
+        if (lineEnd > lineBegin)
+            break;
+        if (!eol)
+            return false;
+        lineBegin = eol + 1;
+    }
+
+    const char* pos = lineBegin;
+    CsvField f[17];
+    for (int i = 0; i < 17; ++i) {
+        if (!nextCsvField(pos, lineEnd, f[i])) {
+            m_errorString = QString("Malformed CSV line at offset %1").arg(lineBegin - m_data);
+            return false;
+        }
+    }
+
+    int valid = 0;
+    bool ok = parseNumber(f[0], frame.timestamp)
+           && parseNumber(f[3], frame.frameNumber)
+           && parseNumber(f[4], valid)
+           && parseNumber(f[5], frame.quality)
+           && parseNumber(f[6], frame.x)  && parseNumber(f[7], frame.y)  && parseNumber(f[8], frame.z)
+           && parseNumber(f[9], frame.rx) && parseNumber(f[10], frame.ry) && parseNumber(f[11], frame.rz);
+
+    frame.isValid = valid != 0;
+    frame.quaternion.valid = f[12].begin != f[12].end;
+    if (frame.quaternion.valid) {
+        ok = ok && parseNumber(f[12], frame.quaternion.w) && parseNumber(f[13], frame.quaternion.x)
+                && parseNumber(f[14], frame.quaternion.y) && parseNumber(f[15], frame.quaternion.z);
+    }
+    else {
+        frame.quaternion = MeasurementFrame::Quaternion();
+    }
+
+    frame.extras.clear();
+    ok = ok && parseExtras(f[16].begin, f[16].end, frame.extras,
+        [this](const char* name, int length) { return intern(name, length); });
+    if (!ok) {
+        m_errorString = QString("Invalid value in CSV line at offset %1").arg(lineBegin - m_data);
+        return false;
+    }
+
+    for (int i = 1; i <= 2; ++i) {
+        QString& name = i == 1 ? frame.systemName : frame.objectName;
+        if (f[i].quoted) {
+            QByteArray unescaped(f[i].begin, static_cast<int>(f[i].end - f[i].begin));
+            unescaped.replace("\"\"", "\"");
+            name = intern(unescaped.constData(), static_cast<int>(unescaped.size()));
+        }
+        else {
+            name = intern(f[i].begin, static_cast<int>(f[i].end - f[i].begin));
+        }
+    }
+    return true;
+}
+
+const QString& SessionFile::intern(const char* utf8, int length)
+{
+    for (const InternedName& entry : m_names) {
+        if (entry.utf8.size() == length && std::memcmp(entry.utf8.constData(), utf8, static_cast<size_t>(length)) == 0)
+            return entry.name;
+    }
+
+    if (m_names.size() < kMaxInternedNames) {
+        m_names.append({ QByteArray(utf8, length), QString::fromUtf8(utf8, length) });
+        return m_names.last().name;
+    }
+
+    m_scratch = QString::fromUtf8(utf8, length);
+    return m_scratch;
+}
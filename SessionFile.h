@@ -0,0 +1,112 @@
+#pragma once
+#ifndef SESSIONFILE_H
+#define SESSIONFILE_H
+
+#include <QByteArray>
+#include <QFile>
+#include <QString>
+#include <QVector>
+#include "MeasurementFrame.h"
+
+/**
+ * @brief Fichier de session brut : une frame MeasurementFrame complète par enregistrement
+ *
+ * Contrairement à l'export (CoordinateConverter::frameToCSVLine, colonnes choisies et
+ * convention d'angles appliquée), la session garde tout ce que le système a publié :
+ * horodatage, numéro de frame, validité, qualité, pose, quaternion et extras. C'est ce
+ * que ReplaySystem relit pour réinjecter une session dans le pipeline.
+ *
+ * Deux formats, détectés à l'ouverture :
+ *
+ *   CSV (texte, lisible) — en-tête kCsvHeader puis une ligne par frame :
+ *     timestamp_us,system,object,frame,valid,quality,x,y,z,rx,ry,rz,qw,qx,qy,qz,extras
+ *     Quaternion vide si invalide. Extras : "Tag=v1 v2 ...;Tag2=v" (sans virgule).
+ *     Noms entre guillemets s'ils contiennent une virgule ou un guillemet (RFC 4180).
+ *
+ *   Binaire (compact, sans conversion) — en-tête de 16 octets ("MOBOTSES", version,
+ *     réservé) puis des enregistrements little-endian de taille variable :
+ *       u32 taille totale | i64 timestamp | i32 frame | u8 drapeaux (bit0 valide,
+ *       bit1 quaternion) | u8 réservé | u16 len(system) | u16 len(object) |
+ *       u16 nb extras | f64 × 11 (quality, x, y, z, rx, ry, rz, qw, qx, qy, qz) |
+ *       system UTF-8 | object UTF-8 | par extra : u16 len(nom), u16 nb valeurs,
+ *       nom UTF-8, f64 × nb valeurs
+ *
+ * Lecture : le fichier est projeté en mémoire (QFile::map) et décodé sur place, sans
+ * copie ni lecture bloquante ; seuls les noms rencontrés sont convertis en QString,
+ * une fois (partage implicite pour toutes les frames suivantes).
+ */
+class SessionFile {
+public:
+    enum class Format {
+        Unknown,
+        Csv,
+        Binary
+    };
+
+    static constexpr char    kBinaryMagic[9]   = "MOBOTSES";
+    static constexpr quint32 kBinaryVersion    = 1;
+    static constexpr int     kBinaryHeaderSize = 16;
+    static constexpr char    kCsvHeader[] =
+        "timestamp_us,system,object,frame,valid,quality,x,y,z,rx,ry,rz,qw,qx,qy,qz,extras";
+
+    // ========== Écriture (enregistreur) ==========
+
+    /** @brief En-tête de fichier (à écrire une fois, avant la première frame) */
+    static QByteArray fileHeader(Format format);
+
+    /** @brief Ajoute la frame à out, au format donné (précision complète, aller-retour exact) */
+    static void appendFrame(Format format, QByteArray& out, const MeasurementFrame& frame);
+
+    // ========== Lecture ==========
+
+    SessionFile() = default;
+    ~SessionFile();
+
+    SessionFile(const SessionFile&) = delete;
+    SessionFile& operator=(const SessionFile&) = delete;
+
+    /** @brief Projette le fichier en mémoire et détecte son format */
+    bool open(const QString& path);
+    void close();
+
+    bool isOpen() const { return m_data != nullptr; }
+    Format format() const { return m_format; }
+    qint64 size() const { return m_size; }
+    const QString& errorString() const { return m_errorString; }
+
+    /** @brief Position du premier enregistrement (après l'en-tête) */
+    qint64 firstRecordOffset() const { return m_firstRecord; }
+
+    /**
+     * @brief Décode l'enregistrement à offset
+     * @param next Position de l'enregistrement suivant (size() en fin de fichier)
+     * @return false en fin de fichier ou si l'enregistrement est corrompu
+     *         (errorString() renseigné dans ce dernier cas)
+     */
+    bool readFrame(qint64 offset, MeasurementFrame& frame, qint64& next);
+
+    static Format detectFormat(const char* data, qint64 size);
+
+private:
+    bool readBinary(qint64 offset, MeasurementFrame& frame, qint64& next);
+    bool readCsv(qint64 offset, MeasurementFrame& frame, qint64& next);
+
+    /** @brief QString partagée pour un nom déjà rencontré (aucune allocation en régime établi) */
+    const QString& intern(const char* utf8, int length);
+
+    QFile        m_file;
+    const char*  m_data        = nullptr;
+    qint64       m_size        = 0;
+    qint64       m_firstRecord = 0;
+    Format       m_format      = Format::Unknown;
+    QString      m_errorString;
+
+    struct InternedName {
+        QByteArray utf8;
+        QString    name;
+    };
+    QVector<InternedName> m_names;
+    QString               m_scratch;   // Nom non mémorisé (au-delà de kMaxInternedNames)
+};
+
+#endif // SESSIONFILE_H
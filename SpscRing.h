@@ -0,0 +1,123 @@
+#pragma once
+#ifndef SPSCRING_H
+#define SPSCRING_H
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief File circulaire lock-free, un seul producteur / un seul consommateur
+ *
+ * Contrairement à CircularBuffer (mutex, écrase les anciennes données), la file
+ * refuse l'insertion quand elle est pleine : le producteur compte la perte et
+ * continue sans jamais bloquer (contrainte des threads temps réel / SDK).
+ *
+ * Capacité arrondie à la puissance de 2 supérieure. Emplacements préalloués :
+ * aucune allocation après construction tant que T n'en fait pas à la copie.
+ */
+template<typename T>
+class SpscRing {
+public:
+    explicit SpscRing(std::size_t capacity)
+        : m_mask(roundUpPow2(capacity < 2 ? 2 : capacity) - 1)
+        , m_slots(m_mask + 1)
+    {
+    }
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    // ========== Producteur ==========
+
+    bool tryPush(const T& item)
+    {
+        const std::size_t head = m_head.load(std::memory_order_relaxed);
+        if (head - m_tailCache > m_mask) {
+            m_tailCache = m_tail.load(std::memory_order_acquire);
+            if (head - m_tailCache > m_mask)
+                return false;
+        }
+        m_slots[head & m_mask] = item;
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Accès direct à l'emplacement suivant (remplissage en place, sans copie)
+     * @return nullptr si la file est pleine. Appeler commitWrite() une fois rempli.
+     */
+    T* beginWrite()
+    {
+        const std::size_t head = m_head.load(std::memory_order_relaxed);
+        if (head - m_tailCache > m_mask) {
+            m_tailCache = m_tail.load(std::memory_order_acquire);
+            if (head - m_tailCache > m_mask)
+                return nullptr;
+        }
+        return &m_slots[head & m_mask];
+    }
+
+    void commitWrite()
+    {
+        m_head.store(m_head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // ========== Consommateur ==========
+
+    bool tryPop(T& item)
+    {
+        const T* slot = front();
+        if (!slot)
+            return false;
+        item = *slot;
+        popFront();
+        return true;
+    }
+
+    /** @brief Élément le plus ancien sans copie, nullptr si vide. Libérer via popFront(). */
+    const T* front()
+    {
+        const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail == m_headCache) {
+            m_headCache = m_head.load(std::memory_order_acquire);
+            if (tail == m_headCache)
+                return nullptr;
+        }
+        return &m_slots[tail & m_mask];
+    }
+
+    void popFront()
+    {
+        m_tail.store(m_tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // ========== Observateurs (approximatifs hors des threads propriétaires) ==========
+
+    std::size_t size() const
+    {
+        return m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_acquire);
+    }
+
+    std::size_t capacity() const { return m_mask + 1; }
+    bool isEmpty() const { return size() == 0; }
+
+private:
+    static std::size_t roundUpPow2(std::size_t v)
+    {
+        std::size_t p = 1;
+        while (p < v) p <<= 1;
+        return p;
+    }
+
+    const std::size_t m_mask;
+    std::vector<T>    m_slots;
+
+    // Index producteur / consommateur sur des lignes de cache distinctes
+    alignas(64) std::atomic<std::size_t> m_head{ 0 };
+    std::size_t                          m_tailCache = 0;   // Copie locale côté producteur
+    alignas(64) std::atomic<std::size_t> m_tail{ 0 };
+    std::size_t                          m_headCache = 0;   // Copie locale côté consommateur
+};
+
+#endif // SPSCRING_H
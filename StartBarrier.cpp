@@ -0,0 +1,46 @@
+#include "StartBarrier.h"
+
+#include <QDateTime>
+#include <chrono>
+
+qint64 StartBarrier::steadyNowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void StartBarrier::release()
+{
+    finish(State::Released);
+}
+
+void StartBarrier::cancel()
+{
+    finish(State::Cancelled);
+}
+
+void StartBarrier::finish(State state)
+{
+    QMutexLocker locker(&m_mutex);
+    if (m_state.load(std::memory_order_relaxed) != State::Armed)
+        return;
+
+    if (state == State::Released) {
+        // Les deux horloges relevées au plus près l'une de l'autre
+        m_t0SteadyNs = steadyNowNs();
+        m_t0EpochUs  = QDateTime::currentMSecsSinceEpoch() * 1000LL;
+    }
+    m_state.store(state, std::memory_order_release);
+    m_done.wakeAll();
+}
+
+bool StartBarrier::wait(int timeoutMs)
+{
+    if (m_state.load(std::memory_order_acquire) != State::Armed)
+        return true;
+
+    QMutexLocker locker(&m_mutex);
+    if (m_state.load(std::memory_order_relaxed) == State::Armed)
+        m_done.wait(&m_mutex, static_cast<unsigned long>(timeoutMs));
+    return m_state.load(std::memory_order_relaxed) != State::Armed;
+}
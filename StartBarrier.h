@@ -0,0 +1,74 @@
+#pragma once
+#ifndef STARTBARRIER_H
+#define STARTBARRIER_H
+
+#include <QMutex>
+#include <QWaitCondition>
+#include <QtGlobal>
+#include <atomic>
+
+/**
+ * @brief Départ commun de plusieurs systèmes : une seule origine t0 pour la session
+ *
+ * Le coordinateur (SystemOrchestrator, HeadlessRunner) confie la même barrière à
+ * chaque système avant startAcquisition() : le système s'arme (connexion, threads,
+ * flux) puis retient ses frames jusqu'à release(). release() relève t0 une seule
+ * fois, sur l'horloge monotone de l'hôte et sur l'horloge murale ; tous les
+ * systèmes prennent ce t0 comme début de session (AcquisitionSummary::startTimestamp).
+ *
+ * cancel() libère les systèmes en attente sans t0 commun (démarrage partiel) :
+ * chacun reprend alors sa propre origine.
+ *
+ * Thread-safe : release()/cancel() depuis le coordinateur, attente et lecture
+ * depuis les threads d'acquisition.
+ */
+class StartBarrier {
+public:
+    StartBarrier() = default;
+
+    StartBarrier(const StartBarrier&) = delete;
+    StartBarrier& operator=(const StartBarrier&) = delete;
+
+    /** @brief Relève t0 et libère les systèmes armés (sans effet après release/cancel) */
+    void release();
+
+    /** @brief Libère les systèmes armés sans t0 commun (sans effet après release/cancel) */
+    void cancel();
+
+    bool isReleased()  const { return m_state.load(std::memory_order_acquire) == State::Released; }
+    bool isCancelled() const { return m_state.load(std::memory_order_acquire) == State::Cancelled; }
+
+    /**
+     * @brief Attend release() ou cancel()
+     * @return true si la barrière n'est plus armée (libérée ou annulée)
+     */
+    bool wait(int timeoutMs);
+
+    /** @brief t0 en µs epoch (valide après release) */
+    qint64 t0EpochUs()  const { return m_t0EpochUs; }
+
+    /** @brief t0 en ns sur l'horloge monotone de l'hôte (valide après release) */
+    qint64 t0SteadyNs() const { return m_t0SteadyNs; }
+
+    /** @brief Horloge monotone de l'hôte (ns), même origine que t0SteadyNs() */
+    static qint64 steadyNowNs();
+
+private:
+    enum class State {
+        Armed,
+        Released,
+        Cancelled
+    };
+
+    void finish(State state);
+
+    std::atomic<State> m_state{ State::Armed };
+    QMutex             m_mutex;
+    QWaitCondition     m_done;
+
+    // Écrits une fois avant la publication de Released (release), lus après (acquire)
+    qint64 m_t0EpochUs  = 0;
+    qint64 m_t0SteadyNs = 0;
+};
+
+#endif // STARTBARRIER_H
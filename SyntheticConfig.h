@@ -0,0 +1,39 @@
+#pragma once
+#ifndef SYNTHETICCONFIG_H
+#define SYNTHETICCONFIG_H
+
+#include <QtGlobal>
+
+/**
+ * @brief Configuration du système synthétique (trajectoires analytiques, sans matériel)
+ *
+ * Surchargeable à la connexion par ConnectionConfig::customParams : "frequency",
+ * "bodies", "noiseMm", "noiseDeg", "dropoutRate", "driftPpm", "latencyMs", "seed".
+ */
+struct SyntheticConfig {
+    // Cadence (horloge source) et nombre de corps rigides
+    double frequencyHz = 1000.0;    // 1 Hz à kMaxFrequencyHz
+    int    bodyCount   = 1;
+
+    // Bruit blanc gaussien ajouté à la vérité terrain (écart-type)
+    double positionNoiseMm = 0.0;
+    double angleNoiseDeg   = 0.0;
+
+    // Proportion de frames perdues (numéro de frame sauté, comptées dans droppedFrames)
+    double dropoutRate = 0.0;
+
+    // Dérive de l'horloge source (ppm) : > 0 = la source émet plus vite que l'hôte ne le croit
+    double clockDriftPpm = 0.0;
+
+    // Délai constant entre l'instant d'échantillonnage (timestamp) et la livraison
+    double latencyMs = 0.0;
+
+    // Graine du bruit et des pertes : deux sessions identiques produisent les mêmes frames
+    quint32 seed = 1;
+
+    static constexpr double kMaxFrequencyHz = 10000.0;
+
+    SyntheticConfig() = default;
+};
+
+#endif // SYNTHETICCONFIG_H
@@ -0,0 +1,368 @@
+#include "SyntheticSystem.h"
+#include "Profiler.h"
+#include <QDateTime>
+#include <QMutexLocker>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+
+// Fin d'attente en attente active : le sommeil de l'OS est trop grossier à 10 kHz
+#ifdef _WIN32
+constexpr qint64 kSpinMarginNs = 1500000;
+#else
+constexpr qint64 kSpinMarginNs = 200000;
+#endif
+
+/** @brief Quaternion de R = Rz(rz) · Ry(ry) · Rx(rx), angles de la frame en degrés */
+void setQuaternionFromEuler(MeasurementFrame& frame)
+{
+    const double hx = frame.rx * kPi / 360.0, hy = frame.ry * kPi / 360.0, hz = frame.rz * kPi / 360.0;
+    const double cx = std::cos(hx), sx = std::sin(hx);
+    const double cy = std::cos(hy), sy = std::sin(hy);
+    const double cz = std::cos(hz), sz = std::sin(hz);
+    frame.quaternion.w     = cz * cy * cx + sz * sy * sx;
+    frame.quaternion.x     = cz * cy * sx - sz * sy * cx;
+    frame.quaternion.y     = cz * sy * cx + sz * cy * sx;
+    frame.quaternion.z     = sz * cy * cx - cz * sy * sx;
+    frame.quaternion.valid = true;
+}
+
+} // namespace
+
+SyntheticSystem::SyntheticSystem(const SyntheticConfig& config, QObject* parent)
+    : IMeasurementSystem(parent)
+    , m_config(config)
+{
+    m_batch.systemName     = "Synthetic";
+    m_batch.hasQuaternions = true;
+    initializeCapabilities();
+    m_timer.start();
+}
+
+SyntheticSystem::~SyntheticSystem()
+{
+    if (m_isAcquiring) stopAcquisition();
+    disconnect();
+}
+
+void SyntheticSystem::initializeCapabilities()
+{
+    m_capabilities.systemName              = "Synthetic";
+    m_capabilities.version                 = "1.0";
+    m_capabilities.maxNativeFrequency      = SyntheticConfig::kMaxFrequencyHz;
+    m_capabilities.minNativeFrequency      = 1.0;
+    m_capabilities.supportsVariableRate    = true;
+    m_capabilities.supportsQuaternions     = true;
+    m_capabilities.supportsMultipleObjects = true;
+    m_capabilities.typicalLatency          = m_config.latencyMs;
+    m_capabilities.effectiveStreamRate     = m_config.frequencyHz;
+}
+
+// ========== Cycle de vie ==========
+
+bool SyntheticSystem::initialize()
+{
+    return true;
+}
+
+bool SyntheticSystem::connect(const ConnectionConfig& config)
+{
+    if (m_isAcquiring) {
+        emit errorOccurred("Synthetic: cannot reconnect during acquisition");
+        return false;
+    }
+
+    applyConnectionParams(config);
+
+    QStringList bodyNames;
+    for (int i = 0; i < m_config.bodyCount; ++i)
+        bodyNames << bodyName(i);
+
+    m_targetBodyIndex = std::max(0, static_cast<int>(bodyNames.indexOf(config.objectName)));
+    m_targetBodyName  = bodyNames.value(m_targetBodyIndex);
+
+    // Lus par l'UI pendant que connect() tourne dans un thread de l'orchestrateur
+    {
+        QMutexLocker locker(&m_frameMutex);
+        m_bodyNames = bodyNames;
+        initializeCapabilities();
+    }
+
+    m_isConnected = true;
+    emit connected();
+    emit logMessage(QString("Synthetic system ready: %1 body/bodies at %2 Hz "
+                            "(noise %3 mm / %4 deg, dropout %5, drift %6 ppm, latency %7 ms)")
+        .arg(m_config.bodyCount).arg(m_config.frequencyHz)
+        .arg(m_config.positionNoiseMm).arg(m_config.angleNoiseDeg)
+        .arg(m_config.dropoutRate).arg(m_config.clockDriftPpm).arg(m_config.latencyMs));
+    return true;
+}
+
+void SyntheticSystem::applyConnectionParams(const ConnectionConfig& config)
+{
+    const QVariantMap& p = config.customParams;
+    m_config.frequencyHz     = p.value("frequency",   m_config.frequencyHz).toDouble();
+    m_config.bodyCount       = p.value("bodies",      m_config.bodyCount).toInt();
+    m_config.positionNoiseMm = p.value("noiseMm",     m_config.positionNoiseMm).toDouble();
+    m_config.angleNoiseDeg   = p.value("noiseDeg",    m_config.angleNoiseDeg).toDouble();
+    m_config.dropoutRate     = p.value("dropoutRate", m_config.dropoutRate).toDouble();
+    m_config.clockDriftPpm   = p.value("driftPpm",    m_config.clockDriftPpm).toDouble();
+    m_config.latencyMs       = p.value("latencyMs",   m_config.latencyMs).toDouble();
+    m_config.seed            = p.contains("seed") ? p.value("seed").toUInt() : m_config.seed;
+
+    m_config.frequencyHz = qBound(1.0, m_config.frequencyHz, SyntheticConfig::kMaxFrequencyHz);
+    m_config.bodyCount   = qMax(1, m_config.bodyCount);
+    m_config.dropoutRate = qBound(0.0, m_config.dropoutRate, 1.0);
+    m_config.latencyMs   = qMax(0.0, m_config.latencyMs);
+}
+
+bool SyntheticSystem::disconnect()
+{
+    if (!m_isConnected) return true;
+    if (m_isAcquiring)  stopAcquisition();
+
+    m_isConnected = false;
+    emit disconnected();
+    return true;
+}
+
+bool SyntheticSystem::isConnected() const
+{
+    return m_isConnected;
+}
+
+// ========== Acquisition ==========
+
+bool SyntheticSystem::startAcquisition()
+{
+    if (!m_isConnected) {
+        emit errorOccurred("Cannot start acquisition: not connected");
+        return false;
+    }
+    if (m_isAcquiring) return true;
+
+    resetSessionStats();
+    m_rng.seed(m_config.seed);
+    m_lastFrameTime = 0;
+    m_frequency     = 0.0;
+
+    m_isAcquiring = true;
+    m_acquisitionThread = QThread::create([this]() { acquisitionLoop(); });
+    m_acquisitionThread->moveToThread(thread());
+    m_acquisitionThread->setObjectName(QStringLiteral("SyntheticAcqThread"));
+    m_acquisitionThread->start(QThread::TimeCriticalPriority);
+
+    emit logMessage(QString("Synthetic acquisition started (%1 Hz, %2 body/bodies)")
+        .arg(m_config.frequencyHz).arg(m_config.bodyCount));
+    return true;
+}
+
+bool SyntheticSystem::stopAcquisition()
+{
+    if (!m_isAcquiring) return true;
+
+    m_isAcquiring = false;
+    if (m_acquisitionThread) {
+        m_acquisitionThread->wait(3000);
+        delete m_acquisitionThread;
+        m_acquisitionThread = nullptr;
+    }
+
+    const AcquisitionSummary summary = buildSummary(m_targetBodyName);
+    emit acquisitionCompleted(summary);
+    emit logMessage(QString("Synthetic acquisition stopped — %1 frames").arg(summary.totalFrames));
+    return true;
+}
+
+bool SyntheticSystem::isAcquiring() const
+{
+    return m_isAcquiring.load();
+}
+
+// ========== Boucle de génération ==========
+
+void SyntheticSystem::acquisitionLoop()
+{
+    MOBOT_PROFILE_SYSTEM("Synthetic");
+    std::uniform_real_distribution<double> dropout(0.0, 1.0);
+
+    const double sourcePeriodS = 1.0 / m_config.frequencyHz;
+    const double driftScale    = 1.0 + m_config.clockDriftPpm * 1e-6;  // source / hôte
+    const qint64 latencyNs     = static_cast<qint64>(m_config.latencyMs * 1e6);
+    const bool   multiBody     = m_config.bodyCount > 1;
+
+    if (!waitForSessionStart())
+        return;
+
+    m_sessionStartUs = sessionStartTimestamp();
+    const qint64 startNs = m_timer.nsecsElapsed();
+
+    for (qint64 n = 0; m_isAcquiring.load(std::memory_order_relaxed); ++n) {
+        // Échantillon n : temps source n·T, soit n·T / (1 + dérive) sur l'horloge hôte
+        const double sourceTimeS = static_cast<double>(n) * sourcePeriodS;
+        const qint64 deliveryNs  = startNs + static_cast<qint64>(sourceTimeS / driftScale * 1e9) + latencyNs;
+
+        // Échéancier absolu : un retard (préemption) est rattrapé en rafale, sans dérive
+        const qint64 remainingNs = deliveryNs - m_timer.nsecsElapsed();
+        if (remainingNs > kSpinMarginNs)
+            std::this_thread::sleep_for(std::chrono::nanoseconds(remainingNs - kSpinMarginNs));
+        while (m_timer.nsecsElapsed() < deliveryNs && m_isAcquiring.load(std::memory_order_relaxed))
+            std::this_thread::yield();
+        if (!m_isAcquiring.load(std::memory_order_relaxed))
+            break;
+
+        if (m_config.dropoutRate > 0.0 && dropout(m_rng) < m_config.dropoutRate) {
+            ++m_metrics.droppedFrames;
+            continue;
+        }
+
+        fillBatch(n, sourceTimeS);
+
+        if (multiBody) {
+            publishBatch(m_batch);
+            for (int i = 0; i < m_batch.size(); ++i)
+                notifySubscribers(m_batch.frameAt(i));
+        }
+
+        const MeasurementFrame frame = m_batch.frameAt(m_targetBodyIndex);
+        {
+            QMutexLocker locker(&m_frameMutex);
+            m_latestFrame = frame;
+        }
+        m_frameBuffer.push(frame);
+
+        const qint64 nowUs = m_timer.nsecsElapsed() / 1000;
+        if (m_lastFrameTime > 0 && nowUs > m_lastFrameTime)
+            m_frequency = 1000000.0 / static_cast<double>(nowUs - m_lastFrameTime);
+        m_lastFrameTime = nowUs;
+
+        updateRunningStats(m_config.latencyMs, m_frequency, m_config.latencyMs > 0.0);
+        updatePoseStats(frame);
+
+        // Multi-corps : les abonnés C++ ont déjà reçu ce corps via son flux dédié
+        if (multiBody)
+            m_dispatcher->postFrame(frame);
+        else
+            publishFrame(frame);
+        publishMetrics();
+    }
+}
+
+void SyntheticSystem::fillBatch(qint64 frameNumber, double sourceTimeS)
+{
+    std::normal_distribution<double> positionNoise(0.0, m_config.positionNoiseMm);
+    std::normal_distribution<double> angleNoise(0.0, m_config.angleNoiseDeg);
+    const bool noisyPosition = m_config.positionNoiseMm > 0.0;
+    const bool noisyAngles   = m_config.angleNoiseDeg > 0.0;
+
+    const int count = m_config.bodyCount;
+    m_batch.resize(count);
+    m_batch.timestamp   = m_sessionStartUs + static_cast<qint64>(std::llround(sourceTimeS * 1e6));
+    m_batch.frameNumber = static_cast<int>(frameNumber);
+
+    MeasurementFrame truth;
+    for (int i = 0; i < count; ++i) {
+        groundTruth(i, sourceTimeS, truth);
+        if (noisyPosition) {
+            truth.x += positionNoise(m_rng);
+            truth.y += positionNoise(m_rng);
+            truth.z += positionNoise(m_rng);
+        }
+        if (noisyAngles) {
+            // Bruit sur les angles puis quaternion recalculé : les deux restent cohérents
+            truth.rx += angleNoise(m_rng);
+            truth.ry += angleNoise(m_rng);
+            truth.rz += angleNoise(m_rng);
+            setQuaternionFromEuler(truth);
+        }
+
+        m_batch.ids[i]   = i + 1;
+        m_batch.names[i] = m_bodyNames.value(i);
+        m_batch.x[i]  = truth.x;  m_batch.y[i]  = truth.y;  m_batch.z[i]  = truth.z;
+        m_batch.rx[i] = truth.rx; m_batch.ry[i] = truth.ry; m_batch.rz[i] = truth.rz;
+        m_batch.qx[i] = truth.quaternion.x;
+        m_batch.qy[i] = truth.quaternion.y;
+        m_batch.qz[i] = truth.quaternion.z;
+        m_batch.qw[i] = truth.quaternion.w;
+        m_batch.meanError[i] = m_config.positionNoiseMm;
+        m_batch.quality[i]   = 1.0;
+        m_batch.tracked[i]   = 1;
+    }
+}
+
+// ========== Vérité terrain ==========
+
+void SyntheticSystem::groundTruth(int bodyIndex, double sourceTimeS, MeasurementFrame& frame)
+{
+    // Fréquences et phases propres à chaque corps : trajectoires distinctes, non corrélées
+    const double phase = 0.7 * bodyIndex;
+    const double w     = 2.0 * kPi * (0.25 + 0.05 * bodyIndex);
+    const double t     = sourceTimeS;
+
+    frame.x = 200.0 * bodyIndex + 300.0 * std::sin(w * t + phase);
+    frame.y = 200.0 * std::sin(2.0 * w * t + phase);
+    frame.z = 1000.0 + 100.0 * std::sin(0.5 * w * t + phase);
+
+    frame.rz = 60.0 * std::sin(0.5 * w * t + phase);
+    frame.ry = 30.0 * std::sin(0.7 * w * t + phase);
+    frame.rx = 45.0 * std::sin(0.9 * w * t + phase);
+
+    setQuaternionFromEuler(frame);
+    frame.isValid = true;
+    frame.quality = 1.0;
+}
+
+QString SyntheticSystem::bodyName(int bodyIndex)
+{
+    return QString("Body%1").arg(bodyIndex + 1);
+}
+
+// ========== Getters ==========
+
+MeasurementFrame SyntheticSystem::getLatestFrame() const
+{
+    QMutexLocker locker(&m_frameMutex);
+    return m_latestFrame;
+}
+
+double SyntheticSystem::getNativeFrequency() const
+{
+    QMutexLocker locker(&m_frameMutex);
+    return m_capabilities.effectiveStreamRate;
+}
+
+double SyntheticSystem::getLatency() const
+{
+    QMutexLocker locker(&m_frameMutex);
+    return m_capabilities.typicalLatency;
+}
+
+QStringList SyntheticSystem::getAvailableObjects() const
+{
+    QMutexLocker locker(&m_frameMutex);
+    return m_bodyNames;
+}
+
+SystemCapabilities SyntheticSystem::getCapabilities() const
+{
+    QMutexLocker locker(&m_frameMutex);
+    return m_capabilities;
+}
+
+QString SyntheticSystem::getSystemName() const { return "Synthetic"; }
+
+QString SyntheticSystem::getSystemVersion() const
+{
+    QMutexLocker locker(&m_frameMutex);
+    return m_capabilities.version;
+}
+
+IMeasurementSystem::ThreadingModel SyntheticSystem::getThreadingModel() const
+{
+    return ThreadingModel::ApplicationManaged;
+}
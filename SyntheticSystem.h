@@ -0,0 +1,104 @@
+#pragma once
+#ifndef SYNTHETICSYSTEM_H
+#define SYNTHETICSYSTEM_H
+
+#include "IMeasurementSystem.h"
+#include "SyntheticConfig.h"
+#include "RigidBodyBatch.h"
+#include <QThread>
+#include <QElapsedTimer>
+#include <QStringList>
+#include <atomic>
+#include <random>
+
+/**
+ * @brief Système de mesure synthétique : trajectoires connues analytiquement
+ *
+ * Génère, dans son propre thread, des frames à cadence fixe (jusqu'à 10 kHz) pour
+ * un ou plusieurs corps, avec bruit, pertes, dérive d'horloge et latence réglables.
+ * Sert à mesurer le pipeline (diffusion, enregistrement, synchronisation, UI) en
+ * charge maximale sans matériel, et à en vérifier le résultat : groundTruth() donne
+ * la pose exacte de chaque corps à n'importe quel instant de l'horloge source.
+ *
+ * Horodatage : timestamp = début de session (epoch, µs) + temps source de la frame.
+ * La frame n est échantillonnée à n / frequencyHz sur l'horloge source, qui dérive
+ * de clockDriftPpm par rapport à l'hôte, puis livrée latencyMs plus tard.
+ *
+ * Plusieurs corps : même diffusion que les systèmes multi-corps (OptiTrack,
+ * Qualisys en capture complète) — RigidBodyBatch par frame, flux par corps pour
+ * les abonnés filtrés, newFrameAvailable sur le corps suivi.
+ */
+class SyntheticSystem : public IMeasurementSystem {
+    Q_OBJECT
+
+public:
+    explicit SyntheticSystem(const SyntheticConfig& config = SyntheticConfig(), QObject* parent = nullptr);
+    ~SyntheticSystem() override;
+
+    // ========== Interface IMeasurementSystem ==========
+
+    bool initialize() override;
+    bool connect(const ConnectionConfig& config) override;
+    bool disconnect() override;
+    bool isConnected() const override;
+
+    bool startAcquisition() override;
+    bool stopAcquisition() override;
+    bool isAcquiring() const override;
+
+    MeasurementFrame getLatestFrame() const override;
+    double getNativeFrequency() const override;
+    QStringList getAvailableObjects() const override;
+    double getLatency() const override;
+
+    SystemCapabilities getCapabilities() const override;
+    QString getSystemName() const override;
+    QString getSystemVersion() const override;
+    ThreadingModel getThreadingModel() const override;
+
+    // ========== Vérité terrain ==========
+
+    /**
+     * @brief Pose exacte (sans bruit) du corps bodyIndex à l'instant source t
+     * @param sourceTimeS Secondes depuis la frame 0, horloge source
+     *                    (= (frame.timestamp − sessionStartUs) / 1e6)
+     *
+     * Position : Lissajous de quelques centaines de mm ; orientation Rz·Ry·Rx
+     * (rz, ry, rx dans ]-90, 90[) et quaternion correspondant.
+     */
+    static void groundTruth(int bodyIndex, double sourceTimeS, MeasurementFrame& frame);
+
+    /** @brief Timestamp (epoch, µs) de la frame 0 de la session en cours */
+    qint64 sessionStartUs() const { return m_sessionStartUs; }
+
+    static QString bodyName(int bodyIndex);
+
+private:
+    void acquisitionLoop();
+
+    /** @brief Vérité terrain + bruit de tous les corps de la frame n dans m_batch */
+    void fillBatch(qint64 frameNumber, double sourceTimeS);
+
+    void applyConnectionParams(const ConnectionConfig& config);
+    void initializeCapabilities();
+
+    SyntheticConfig m_config;
+
+    // ========== État ==========
+    std::atomic<bool> m_isConnected{ false };
+    QStringList m_bodyNames;            // m_frameMutex (lu par l'UI)
+    int         m_targetBodyIndex = 0;
+    QString     m_targetBodyName;
+
+    // ========== Génération (thread d'acquisition) ==========
+    RigidBodyBatch m_batch;
+    std::mt19937   m_rng;
+    qint64         m_sessionStartUs = 0;
+
+    // ========== Performance ==========
+    QElapsedTimer m_timer;
+    qint64        m_lastFrameTime = 0;   // µs (horloge locale)
+    double        m_frequency     = 0.0; // Hz mesuré à la livraison
+};
+
+#endif // SYNTHETICSYSTEM_H
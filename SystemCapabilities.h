@@ -16,6 +16,7 @@ struct SystemCapabilities {
     double maxNativeFrequency = 1000.0;    // Frquence max en Hz (ex: 240 pour OptiTrack)
     double minNativeFrequency = 30.0;      // Frquence min en Hz
     bool supportsVariableRate = false;     // Peut changer la frquence en live
+    double effectiveStreamRate = 0.0;      // Cadence rellement diffuse (dcimation serveur), 0 = inconnue
 
     // Capacits de mesure
     QStringList supportedComponents;       // Liste: "X", "Y", "Z", "Rx", "Ry", "Rz"
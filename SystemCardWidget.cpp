@@ -1,5 +1,4 @@
 ﻿#include "SystemCardWidget.h"
-#include "ConnectionConfig.h"
 
 #include <QVBoxLayout>
 #include <QHBoxLayout>
@@ -165,8 +164,8 @@ void SystemCardWidget::refreshDisplay()
 void SystemCardWidget::setAcquiring(bool acquiring)
 {
     m_acquiring = acquiring;
-    m_connectBtn->setEnabled(!acquiring);
-    m_removeBtn->setEnabled(!acquiring);
+    m_connectBtn->setEnabled(!acquiring && !m_connecting);
+    m_removeBtn->setEnabled(!acquiring && !m_connecting);
 }
 
 // =============================================================================
@@ -179,12 +178,28 @@ void SystemCardWidget::onConnectClicked()
         m_system->disconnect();
     }
     else {
-        m_system->initialize();
-        ConnectionConfig cfg;
-        m_system->connect(cfg);
+        // initialize() + connect() peuvent bloquer plusieurs secondes : hors thread UI
+        emit connectRequested();
     }
 }
 
+void SystemCardWidget::setConnecting(bool connecting)
+{
+    m_connecting = connecting;
+    m_connectBtn->setEnabled(!connecting && !m_acquiring);
+    m_removeBtn->setEnabled(!connecting && !m_acquiring);
+    if (connecting)
+        m_statusLabel->setText(QStringLiteral("Connexion..."));
+    else if (!m_connected)
+        m_statusLabel->setText(QStringLiteral("Déconnecté"));
+}
+
+void SystemCardWidget::showConnectionError(const QString& reason)
+{
+    if (!m_connected)
+        m_statusLabel->setText(reason);
+}
+
 void SystemCardWidget::updateConnectionUI(bool connected)
 {
     if (connected) {
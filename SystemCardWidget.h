@@ -27,9 +27,14 @@ public:
     virtual void refreshDisplay();
     void         setAcquiring(bool acquiring);
 
+    // Connexion menée par MainWindow (SystemOrchestrator, hors thread UI)
+    void         setConnecting(bool connecting);
+    void         showConnectionError(const QString& reason);
+
 signals:
     void connected();
     void disconnected();
+    void connectRequested();
     void removeRequested();
 
 protected:
@@ -40,6 +45,7 @@ protected:
     QString             m_displayName;
     bool                m_connected = false;
     bool                m_acquiring = false;
+    bool                m_connecting = false;
 
     // Données live (mis à jour à 20 Hz depuis m_system->getLatestFrame())
     MeasurementFrame    m_lastFrame;
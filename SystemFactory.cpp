@@ -1,4 +1,6 @@
 #include "SystemFactory.h"
+#include "SyntheticSystem.h"
+#include "ReplaySystem.h"
 #include <QDebug>
 
 // Inclusions conditionnelles selon les systmes implments
@@ -15,7 +17,9 @@ const QMap<QString, SystemFactory::SystemType> SystemFactory::s_systemTypeMap =
     {"Qualisys", SystemType::Qualisys},
     {"RSI_KUKA", SystemType::RSI_KUKA},
     {"RSI", SystemType::RSI_KUKA}, // Alias
-    {"KUKA", SystemType::RSI_KUKA}  // Alias
+    {"KUKA", SystemType::RSI_KUKA},  // Alias
+    {"Synthetic", SystemType::Synthetic},
+    {"Replay", SystemType::Replay}
 };
 
 IMeasurementSystem* SystemFactory::createSystem(SystemType type, QObject* parent)
@@ -41,6 +45,12 @@ IMeasurementSystem* SystemFactory::createSystem(SystemType type, QObject* parent
         qWarning() << "RSI KUKA system not yet implemented";
         return nullptr;
 
+    case SystemType::Synthetic:
+        return new SyntheticSystem(SyntheticConfig(), parent);
+
+    case SystemType::Replay:
+        return new ReplaySystem(ReplayConfig(), parent);
+
     case SystemType::Unknown:
     default:
         qWarning() << "Unknown system type";
@@ -70,6 +80,10 @@ QString SystemFactory::systemTypeToString(SystemType type)
         return "Qualisys";
     case SystemType::RSI_KUKA:
         return "RSI_KUKA";
+    case SystemType::Synthetic:
+        return "Synthetic";
+    case SystemType::Replay:
+        return "Replay";
     case SystemType::Unknown:
     default:
         return "Unknown";
@@ -93,6 +107,12 @@ QStringList SystemFactory::availableSystems()
     if (isSystemAvailable(SystemType::RSI_KUKA)) {
         systems << "RSI_KUKA";
     }
+    if (isSystemAvailable(SystemType::Synthetic)) {
+        systems << "Synthetic";
+    }
+    if (isSystemAvailable(SystemType::Replay)) {
+        systems << "Replay";
+    }
 
     return systems;
 }
@@ -128,6 +148,11 @@ bool SystemFactory::isSystemAvailable(SystemType type)
         // RSI utilise juste UDP/XML, toujours disponible
         return true;
 
+    case SystemType::Synthetic:
+    case SystemType::Replay:
+        // Aucun matriel ni SDK
+        return true;
+
     case SystemType::Unknown:
     default:
         return false;
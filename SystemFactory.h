@@ -23,6 +23,8 @@ public:
         Vicon,
         Qualisys,
         RSI_KUKA,
+        Synthetic,      // Trajectoires analytiques, sans matriel (bancs, tests)
+        Replay,         // Rejeu d'une session enregistre (customParams "file")
         Unknown
     };
 
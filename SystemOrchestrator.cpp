@@ -0,0 +1,179 @@
+#include "SystemOrchestrator.h"
+
+#include <QDebug>
+#include <QTimer>
+
+SystemOrchestrator::SystemOrchestrator(QObject* parent)
+    : QObject(parent)
+{
+}
+
+SystemOrchestrator::~SystemOrchestrator()
+{
+    // Un QThread détruit en cours d'exécution termine le processus : attente bornée
+    // (un connect() de SDK peut ne jamais rendre la main), puis abandon du thread
+    QElapsedTimer clock;
+    clock.start();
+    int abandoned = 0;
+    for (const auto& task : m_tasks) {
+        QObject::disconnect(task->thread, nullptr, this, nullptr);
+        const qint64 remainingMs = qMax<qint64>(0, kShutdownWaitMs - clock.elapsed());
+        if (task->thread->wait(static_cast<unsigned long>(remainingMs))) {
+            delete task->thread;
+            continue;
+        }
+        QObject::connect(task->thread, &QThread::finished, task->thread, &QObject::deleteLater);
+        if (task->thread->isFinished())
+            delete task->thread;
+        else
+            ++abandoned;
+    }
+    if (abandoned > 0)
+        qWarning() << "SystemOrchestrator:" << abandoned << "operation(s) still running at shutdown, threads abandoned";
+}
+
+QString SystemOrchestrator::outcomeText(Outcome outcome)
+{
+    switch (outcome) {
+    case Outcome::Succeeded: return "succeeded";
+    case Outcome::Failed:    return "failed";
+    case Outcome::TimedOut:  return "timed out";
+    }
+    return QString();
+}
+
+// =============================================================================
+// Lancement
+// =============================================================================
+
+int SystemOrchestrator::connectSystems(const QVector<Target>& targets)
+{
+    const int batch = m_nextBatch;
+    Batch state;
+    state.operation = Operation::Connect;
+
+    for (const Target& target : targets) {
+        if (!target.system || isBusy(target.system) || target.system->isConnected())
+            continue;
+
+        auto task = std::make_shared<Task>();
+        task->batch     = batch;
+        task->system    = target.system;
+        task->operation = Operation::Connect;
+        task->config    = target.config;
+        m_tasks.insert(target.system, task);
+        ++state.total;
+        launch(task, target.timeoutMs);
+    }
+
+    if (state.total == 0)
+        return 0;
+    m_batches.insert(batch, state);
+    ++m_nextBatch;
+    emit progress(batch, state.operation, 0, state.total);
+    return batch;
+}
+
+int SystemOrchestrator::startSystems(const QVector<IMeasurementSystem*>& systems, int timeoutMs)
+{
+    const int batch = m_nextBatch;
+    Batch state;
+    state.operation = Operation::Start;
+    state.barrier   = std::make_shared<StartBarrier>();
+
+    for (IMeasurementSystem* system : systems) {
+        if (!system || isBusy(system) || system->isAcquiring())
+            continue;
+
+        system->setStartBarrier(state.barrier);
+
+        auto task = std::make_shared<Task>();
+        task->batch     = batch;
+        task->system    = system;
+        task->operation = Operation::Start;
+        m_tasks.insert(system, task);
+        ++state.total;
+        launch(task, timeoutMs);
+    }
+
+    if (state.total == 0)
+        return 0;
+    m_batches.insert(batch, state);
+    ++m_nextBatch;
+    emit progress(batch, state.operation, 0, state.total);
+    return batch;
+}
+
+void SystemOrchestrator::launch(const std::shared_ptr<Task>& task, int timeoutMs)
+{
+    // Le thread ne touche qu'à son système ; signaux émis depuis ce thread → files Qt.
+    // La tâche est partagée : un thread abandonné au destructeur la garde en vie
+    task->thread = QThread::create([task]() {
+        if (task->operation == Operation::Connect)
+            task->ok = task->system->initialize() && task->system->connect(task->config);
+        else
+            task->ok = task->system->startAcquisition();
+    });
+
+    QObject::connect(task->thread, &QThread::finished, this, [this, task]() { onTaskFinished(task); });
+    QTimer::singleShot(timeoutMs, this, [this, task]() { onTaskTimeout(task); });
+
+    task->clock.start();
+    task->thread->start();
+}
+
+// =============================================================================
+// Résultats (thread de l'orchestrateur)
+// =============================================================================
+
+void SystemOrchestrator::onTaskTimeout(const std::shared_ptr<Task>& task)
+{
+    if (task->reported || task->thread->isFinished())
+        return;
+    report(task, Outcome::TimedOut);
+}
+
+void SystemOrchestrator::onTaskFinished(const std::shared_ptr<Task>& task)
+{
+    m_tasks.remove(task->system);
+    task->thread->deleteLater();
+
+    if (!task->reported) {
+        report(task, task->ok ? Outcome::Succeeded : Outcome::Failed);
+        return;
+    }
+
+    // Aboutie après l'annonce TimedOut : revenir à l'état annoncé
+    if (task->ok) {
+        if (task->operation == Operation::Connect)
+            task->system->disconnect();
+        else
+            task->system->stopAcquisition();
+    }
+}
+
+void SystemOrchestrator::report(const std::shared_ptr<Task>& task, Outcome outcome)
+{
+    task->reported = true;
+    emit systemFinished(task->batch, task->system, task->operation, outcome, task->clock.elapsed());
+
+    auto it = m_batches.find(task->batch);
+    if (it == m_batches.end())
+        return;
+    ++it->done;
+    if (outcome == Outcome::Succeeded)
+        ++it->succeeded;
+
+    const Batch state = *it;
+    emit progress(task->batch, state.operation, state.done, state.total);
+    if (state.done == state.total) {
+        m_batches.erase(it);
+        if (state.barrier) {
+            if (state.succeeded == state.total)
+                state.barrier->release();
+            else
+                state.barrier->cancel();
+        }
+        emit batchFinished(task->batch, state.operation, state.succeeded, state.total);
+    }
+}
@@ -0,0 +1,125 @@
+#pragma once
+#ifndef SYSTEMORCHESTRATOR_H
+#define SYSTEMORCHESTRATOR_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QThread>
+#include <QVector>
+#include <memory>
+
+#include "ConnectionConfig.h"
+#include "IMeasurementSystem.h"
+#include "StartBarrier.h"
+
+/**
+ * @brief Connexion et démarrage des systèmes en parallèle, avec délai par système
+ *
+ * Chaque opération (initialize() + connect(), ou startAcquisition()) s'exécute dans
+ * son propre QThread : cinq systèmes se connectent dans le temps du plus lent, et le
+ * thread UI ne bloque plus. Les résultats sont livrés dans le thread de
+ * l'orchestrateur, système par système (systemFinished), puis pour le lot complet
+ * (batchFinished).
+ *
+ * Délai : passé timeoutMs, l'opération est annoncée TimedOut. Les appels bloquants des
+ * SDK ne pouvant être interrompus, le thread continue ; s'il aboutit malgré tout, le
+ * système est aussitôt ramené à l'état annoncé (disconnect() ou stopAcquisition()).
+ *
+ * Départ commun : les systèmes d'un même startSystems() partagent une StartBarrier.
+ * Chacun s'arme puis retient ses frames ; la barrière n'est libérée (t0 commun)
+ * qu'une fois tous démarrés, et annulée si l'un d'eux échoue ou dépasse son délai.
+ *
+ * Un système n'a qu'une opération en cours à la fois : les demandes pour un système
+ * occupé sont ignorées. Le destructeur attend les opérations en cours au plus
+ * kShutdownWaitMs, puis abandonne les threads encore bloqués (libérés à leur fin).
+ *
+ * Les QThread créés par startAcquisition() dans le thread de l'opération sont
+ * rattachés par chaque système à son propre thread (moveToThread).
+ */
+class SystemOrchestrator : public QObject {
+    Q_OBJECT
+
+public:
+    enum class Operation {
+        Connect,
+        Start
+    };
+
+    enum class Outcome {
+        Succeeded,
+        Failed,
+        TimedOut
+    };
+
+    static constexpr int kDefaultConnectTimeoutMs = 10000;
+    static constexpr int kDefaultStartTimeoutMs   = 5000;
+    static constexpr int kShutdownWaitMs          = 2000;
+
+    struct Target {
+        IMeasurementSystem* system    = nullptr;
+        ConnectionConfig    config;                               // Connect uniquement
+        int                 timeoutMs = kDefaultConnectTimeoutMs;
+    };
+
+    explicit SystemOrchestrator(QObject* parent = nullptr);
+    ~SystemOrchestrator() override;
+
+    /**
+     * @brief Connecte les systèmes en parallèle
+     * @return Identifiant du lot, 0 si aucun système n'a été lancé (liste vide ou tous occupés)
+     */
+    int connectSystems(const QVector<Target>& targets);
+
+    /** @brief Démarre l'acquisition des systèmes en parallèle (même convention de retour) */
+    int startSystems(const QVector<IMeasurementSystem*>& systems,
+        int timeoutMs = kDefaultStartTimeoutMs);
+
+    bool isBusy() const { return !m_tasks.isEmpty(); }
+    bool isBusy(IMeasurementSystem* system) const { return m_tasks.contains(system); }
+
+    static QString outcomeText(Outcome outcome);
+
+signals:
+    /** @brief Résultat d'un système (TimedOut : le thread peut encore tourner) */
+    void systemFinished(int batch, IMeasurementSystem* system,
+        SystemOrchestrator::Operation operation, SystemOrchestrator::Outcome outcome, qint64 elapsedMs);
+
+    /** @brief Avancement du lot : done systèmes sur total ont un résultat */
+    void progress(int batch, SystemOrchestrator::Operation operation, int done, int total);
+
+    /** @brief Tous les systèmes du lot ont un résultat */
+    void batchFinished(int batch, SystemOrchestrator::Operation operation, int succeeded, int total);
+
+private:
+    struct Task {
+        int                 batch     = 0;
+        IMeasurementSystem* system    = nullptr;
+        Operation           operation = Operation::Connect;
+        ConnectionConfig    config;
+        QThread*            thread    = nullptr;
+        QElapsedTimer       clock;
+        bool                ok        = false;   // Écrit par le thread, lu après finished()
+        bool                reported  = false;   // Résultat déjà annoncé (délai dépassé)
+    };
+
+    struct Batch {
+        Operation operation = Operation::Connect;
+        int       total     = 0;
+        int       done      = 0;
+        int       succeeded = 0;
+
+        std::shared_ptr<StartBarrier> barrier;   // Start uniquement
+    };
+
+    void launch(const std::shared_ptr<Task>& task, int timeoutMs);
+    void onTaskTimeout(const std::shared_ptr<Task>& task);
+    void onTaskFinished(const std::shared_ptr<Task>& task);
+    void report(const std::shared_ptr<Task>& task, Outcome outcome);
+
+    QHash<IMeasurementSystem*, std::shared_ptr<Task>> m_tasks;
+    QHash<int, Batch>                                 m_batches;
+    int                                               m_nextBatch = 1;
+};
+
+#endif // SYSTEMORCHESTRATOR_H
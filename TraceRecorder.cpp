@@ -0,0 +1,321 @@
+#include "TraceRecorder.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+std::atomic<bool> TraceRecorder::s_enabled{ false };
+
+namespace {
+
+constexpr uint64_t kEventMask = TraceRecorder::kEventsPerThread - 1;
+static_assert((TraceRecorder::kEventsPerThread & kEventMask) == 0,
+    "kEventsPerThread must be a power of two");
+
+/**
+ * @brief Tampon d'un thread : un seul écrivain (le thread), lecteur = writeChromeTrace
+ *
+ * written est publié en release après l'écriture de l'événement : le lecteur voit
+ * des événements complets jusqu'à written, et écarte ceux que l'écrivain a pu
+ * réécrire pendant la copie (indice < written relu - capacité).
+ */
+struct ThreadBuffer {
+    std::vector<TraceRecorder::Event> events;
+    std::atomic<uint64_t> written{ 0 };
+    std::atomic<uint64_t> epoch{ 0 };
+    std::atomic<bool>     retired{ false };   // Thread terminé : libéré au prochain clear()
+    uint32_t              tid = 0;
+    std::string           name;               // Protégé par le mutex du registre
+};
+
+struct Registry {
+    std::mutex                                 mutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+    uint32_t                                   nextTid = 1;
+    std::atomic<uint64_t>                      epoch{ 1 };
+};
+
+Registry& registry()
+{
+    static Registry instance;
+    return instance;
+}
+
+/** @brief Marque le tampon retiré à la fin du thread (le registre garde ses événements) */
+struct ThreadBufferHandle {
+    ThreadBuffer* buffer = nullptr;
+    const char*   namePtr = nullptr;
+
+    ~ThreadBufferHandle()
+    {
+        if (buffer)
+            buffer->retired.store(true, std::memory_order_release);
+    }
+};
+
+thread_local ThreadBufferHandle t_handle;
+
+ThreadBuffer* localBuffer()
+{
+    ThreadBuffer* buffer = t_handle.buffer;
+    if (!buffer) {
+        auto created = std::make_unique<ThreadBuffer>();
+        created->events.resize(TraceRecorder::kEventsPerThread);
+
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        created->tid = reg.nextTid++;
+        created->epoch.store(reg.epoch.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        buffer = created.get();
+        reg.buffers.push_back(std::move(created));
+        t_handle.buffer = buffer;
+    }
+
+    // clear() depuis un autre thread : remise à zéro par le thread propriétaire
+    const uint64_t epoch = registry().epoch.load(std::memory_order_acquire);
+    if (buffer->epoch.load(std::memory_order_relaxed) != epoch) {
+        buffer->written.store(0, std::memory_order_relaxed);
+        buffer->epoch.store(epoch, std::memory_order_release);
+    }
+    return buffer;
+}
+
+std::string jsonEscape(const char* text)
+{
+    std::string out;
+    for (const char* p = text; p && *p; ++p) {
+        const unsigned char ch = static_cast<unsigned char>(*p);
+        if (ch == '"' || ch == '\\') {
+            out += '\\';
+            out += static_cast<char>(ch);
+        }
+        else if (ch < 0x20) {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", ch);
+            out += escaped;
+        }
+        else {
+            out += static_cast<char>(ch);
+        }
+    }
+    return out;
+}
+
+struct ThreadSnapshot {
+    uint32_t                          tid = 0;
+    std::string                       name;
+    std::vector<TraceRecorder::Event> events;
+};
+
+/** @brief Copie cohérente des tampons de l'époque courante */
+std::vector<ThreadSnapshot> snapshotBuffers()
+{
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    const uint64_t epoch = reg.epoch.load(std::memory_order_acquire);
+
+    std::vector<ThreadSnapshot> snapshots;
+    for (const auto& buffer : reg.buffers) {
+        if (buffer->epoch.load(std::memory_order_acquire) != epoch)
+            continue;
+
+        const uint64_t end   = buffer->written.load(std::memory_order_acquire);
+        const uint64_t begin = end > TraceRecorder::kEventsPerThread ? end - TraceRecorder::kEventsPerThread : 0;
+
+        ThreadSnapshot snapshot;
+        snapshot.tid  = buffer->tid;
+        snapshot.name = buffer->name;
+        snapshot.events.reserve(static_cast<std::size_t>(end - begin));
+        for (uint64_t i = begin; i < end; ++i)
+            snapshot.events.push_back(buffer->events[i & kEventMask]);
+
+        // Événements réécrits pendant la copie (l'écrivain a fait le tour du tampon).
+        // Le slot de l'événement n° after peut être en cours d'écriture : écarté aussi
+        const uint64_t after = buffer->written.load(std::memory_order_acquire);
+        if (after < end) {
+            continue;   // Remis à zéro entre-temps : rien de fiable
+        }
+        const uint64_t safeBegin = after + 1 > TraceRecorder::kEventsPerThread
+            ? after + 1 - TraceRecorder::kEventsPerThread : 0;
+        if (safeBegin > begin) {
+            const std::size_t overwritten = static_cast<std::size_t>(std::min(safeBegin, end) - begin);
+            snapshot.events.erase(snapshot.events.begin(), snapshot.events.begin() + overwritten);
+        }
+        if (!snapshot.events.empty() || !snapshot.name.empty())
+            snapshots.push_back(std::move(snapshot));
+    }
+    return snapshots;
+}
+
+} // namespace
+
+// =============================================================================
+// Configuration
+// =============================================================================
+
+void TraceRecorder::setEnabled(bool enabled)
+{
+    s_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void TraceRecorder::clear()
+{
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    reg.epoch.fetch_add(1, std::memory_order_acq_rel);
+
+    // Threads terminés : plus aucun écrivain, le tampon peut être libéré
+    reg.buffers.erase(std::remove_if(reg.buffers.begin(), reg.buffers.end(),
+        [](const std::unique_ptr<ThreadBuffer>& b) { return b->retired.load(std::memory_order_acquire); }),
+        reg.buffers.end());
+}
+
+void TraceRecorder::setThreadName(const char* name)
+{
+    // Appelé à chaque tour de boucle ou rappel SDK : seul un changement de nom verrouille
+    if (t_handle.namePtr == name && t_handle.buffer)
+        return;
+
+    ThreadBuffer* buffer = localBuffer();
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    buffer->name = name ? name : "";
+    t_handle.namePtr = name;
+}
+
+int64_t TraceRecorder::nowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// =============================================================================
+// Enregistrement
+// =============================================================================
+
+void TraceRecorder::append(const Event& event)
+{
+    ThreadBuffer* buffer = localBuffer();
+    const uint64_t index = buffer->written.load(std::memory_order_relaxed);
+    buffer->events[index & kEventMask] = event;
+    buffer->written.store(index + 1, std::memory_order_release);
+}
+
+void TraceRecorder::complete(const char* name, int64_t startNs, int64_t endNs, uint64_t arg, bool hasArg)
+{
+    Event event;
+    event.name       = name;
+    event.startNs    = startNs;
+    event.durationNs = endNs - startNs;
+    event.arg        = arg;
+    event.hasArg     = hasArg;
+    event.phase      = 'X';
+    append(event);
+}
+
+void TraceRecorder::instant(const char* name, uint64_t arg, bool hasArg)
+{
+    Event event;
+    event.name    = name;
+    event.startNs = nowNs();
+    event.arg     = arg;
+    event.hasArg  = hasArg;
+    event.phase   = 'i';
+    append(event);
+}
+
+void TraceRecorder::counter(const char* name, double value)
+{
+    Event event;
+    event.name    = name;
+    event.startNs = nowNs();
+    event.value   = value;
+    event.phase   = 'C';
+    append(event);
+}
+
+// =============================================================================
+// Export
+// =============================================================================
+
+std::size_t TraceRecorder::eventCount()
+{
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    const uint64_t epoch = reg.epoch.load(std::memory_order_acquire);
+
+    std::size_t count = 0;
+    for (const auto& buffer : reg.buffers) {
+        if (buffer->epoch.load(std::memory_order_acquire) == epoch)
+            count += static_cast<std::size_t>(std::min<uint64_t>(
+                buffer->written.load(std::memory_order_acquire), kEventsPerThread));
+    }
+    return count;
+}
+
+bool TraceRecorder::writeChromeTrace(const std::string& path, std::string& error)
+{
+    const std::vector<ThreadSnapshot> snapshots = snapshotBuffers();
+
+    // Origine des temps : premier événement, pour des ts lisibles (µs)
+    int64_t originNs = 0;
+    bool hasOrigin = false;
+    for (const ThreadSnapshot& s : snapshots) {
+        for (const Event& e : s.events) {
+            if (!hasOrigin || e.startNs < originNs) {
+                originNs = e.startNs;
+                hasOrigin = true;
+            }
+        }
+    }
+
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        error = "Cannot create trace file " + path;
+        return false;
+    }
+    std::vector<char> buffer(1 << 20);
+    std::setvbuf(file, buffer.data(), _IOFBF, buffer.size());
+
+    std::fprintf(file, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+    std::fprintf(file, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"Mobot4\"}}");
+
+    for (const ThreadSnapshot& s : snapshots) {
+        if (!s.name.empty()) {
+            std::fprintf(file, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s\"}}",
+                s.tid, jsonEscape(s.name.c_str()).c_str());
+        }
+        for (const Event& e : s.events) {
+            const std::string name = jsonEscape(e.name);
+            const double tsUs = static_cast<double>(e.startNs - originNs) / 1000.0;
+            switch (e.phase) {
+            case 'X':
+                std::fprintf(file, ",\n{\"name\":\"%s\",\"cat\":\"mobot\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f",
+                    name.c_str(), s.tid, tsUs, static_cast<double>(e.durationNs) / 1000.0);
+                break;
+            case 'i':
+                std::fprintf(file, ",\n{\"name\":\"%s\",\"cat\":\"mobot\",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":%u,\"ts\":%.3f",
+                    name.c_str(), s.tid, tsUs);
+                break;
+            default:   // 'C'
+                std::fprintf(file, ",\n{\"name\":\"%s\",\"ph\":\"C\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"args\":{\"value\":%.17g}}",
+                    name.c_str(), s.tid, tsUs, e.value);
+                continue;
+            }
+            if (e.hasArg)
+                std::fprintf(file, ",\"args\":{\"id\":%llu}}", static_cast<unsigned long long>(e.arg));
+            else
+                std::fprintf(file, "}");
+        }
+    }
+    std::fprintf(file, "\n]}\n");
+
+    const bool ok = std::ferror(file) == 0;
+    std::fclose(file);
+    if (!ok)
+        error = "Write error on " + path;
+    return ok;
+}
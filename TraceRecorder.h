@@ -0,0 +1,144 @@
+#pragma once
+#ifndef TRACERECORDER_H
+#define TRACERECORDER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Traçage de latence du pipeline (réception → parsing → ACK → publication →
+ * livraison Qt → affichage), exporté au format Chrome trace (chrome://tracing, Perfetto)
+ *
+ * Points de trace : macros MOBOT_TRACE_* en fin de fichier. Chaque thread écrit
+ * dans son propre tampon circulaire (kEventsPerThread événements, les plus récents
+ * conservés) : pas de verrou ni d'allocation sur le chemin nominal, seul le premier
+ * événement d'un thread l'enregistre sous mutex.
+ *
+ * Coût :
+ *   - désactivé : une lecture atomique relâchée par point de trace ;
+ *   - activé    : deux lectures d'horloge (steady_clock, QPC sous Windows) et une
+ *                 écriture de 40 octets, environ 80 ns ;
+ *   - compilé sans (MOBOT_TRACE_DISABLED) : rien.
+ *
+ * Les noms d'événements sont des littéraux : seul le pointeur est stocké. Le vidage
+ * (writeChromeTrace) peut se faire pendant l'acquisition ; les événements réécrits
+ * pendant la copie, et celui en cours d'écriture, sont écartés.
+ *
+ * Sans Qt, comme NativeUdpSocket : utilisable dans les couches protocole.
+ */
+class TraceRecorder {
+public:
+    static constexpr std::size_t kEventsPerThread = 1u << 16;   // 2.5 Mo par thread tracé
+
+    struct Event {
+        const char* name     = nullptr;
+        int64_t     startNs  = 0;
+        int64_t     durationNs = 0;
+        union {
+            uint64_t arg;          // Identifiant de corrélation (IPOC, numéro de frame...)
+            double   value;        // Compteur
+        };
+        char        phase    = 'X';   // 'X' durée, 'i' instantané, 'C' compteur
+        bool        hasArg   = false;
+
+        Event() : arg(0) {}
+    };
+
+    static bool isEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+
+    /** @brief Active / suspend l'enregistrement (les tampons sont conservés) */
+    static void setEnabled(bool enabled);
+
+    /** @brief Oublie tous les événements (les threads repartent à zéro à leur prochain événement) */
+    static void clear();
+
+    /** @brief Nomme le thread appelant dans la trace ("KUKA RSI", "UI"...) */
+    static void setThreadName(const char* name);
+
+    static int64_t nowNs();
+
+    // ========== Enregistrement (thread appelant) ==========
+
+    static void complete(const char* name, int64_t startNs, int64_t endNs, uint64_t arg, bool hasArg);
+    static void instant(const char* name, uint64_t arg, bool hasArg);
+    static void counter(const char* name, double value);
+
+    // ========== Export ==========
+
+    /** @brief Écrit le contenu courant des tampons au format Chrome trace JSON */
+    static bool writeChromeTrace(const std::string& path, std::string& error);
+
+    /** @brief Nombre d'événements disponibles (tous threads) */
+    static std::size_t eventCount();
+
+private:
+    static void append(const Event& event);
+
+    static std::atomic<bool> s_enabled;
+};
+
+/**
+ * @brief Événement de durée : de la construction à la destruction de la portée
+ */
+class TraceScope {
+public:
+    explicit TraceScope(const char* name)
+        : m_name(TraceRecorder::isEnabled() ? name : nullptr)
+    {
+        if (m_name)
+            m_startNs = TraceRecorder::nowNs();
+    }
+
+    TraceScope(const char* name, uint64_t arg)
+        : m_name(TraceRecorder::isEnabled() ? name : nullptr), m_arg(arg), m_hasArg(true)
+    {
+        if (m_name)
+            m_startNs = TraceRecorder::nowNs();
+    }
+
+    ~TraceScope()
+    {
+        if (m_name)
+            TraceRecorder::complete(m_name, m_startNs, TraceRecorder::nowNs(), m_arg, m_hasArg);
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* m_name;
+    int64_t     m_startNs = 0;
+    uint64_t    m_arg     = 0;
+    bool        m_hasArg  = false;
+};
+
+// ===== Points de trace =====
+
+#define MOBOT_TRACE_CONCAT_INNER(a, b) a##b
+#define MOBOT_TRACE_CONCAT(a, b) MOBOT_TRACE_CONCAT_INNER(a, b)
+
+#ifndef MOBOT_TRACE_DISABLED
+
+#define MOBOT_TRACE_SCOPE(name) \
+    TraceScope MOBOT_TRACE_CONCAT(mobotTraceScope_, __LINE__)(name)
+#define MOBOT_TRACE_SCOPE_ARG(name, arg) \
+    TraceScope MOBOT_TRACE_CONCAT(mobotTraceScope_, __LINE__)(name, static_cast<uint64_t>(arg))
+#define MOBOT_TRACE_INSTANT(name, arg) \
+    do { if (TraceRecorder::isEnabled()) TraceRecorder::instant(name, static_cast<uint64_t>(arg), true); } while (0)
+#define MOBOT_TRACE_COUNTER(name, value) \
+    do { if (TraceRecorder::isEnabled()) TraceRecorder::counter(name, static_cast<double>(value)); } while (0)
+#define MOBOT_TRACE_THREAD_NAME(name) TraceRecorder::setThreadName(name)
+
+#else
+
+#define MOBOT_TRACE_SCOPE(name)            ((void)0)
+#define MOBOT_TRACE_SCOPE_ARG(name, arg)   ((void)0)
+#define MOBOT_TRACE_INSTANT(name, arg)     ((void)0)
+#define MOBOT_TRACE_COUNTER(name, value)   ((void)0)
+#define MOBOT_TRACE_THREAD_NAME(name)      ((void)0)
+
+#endif
+
+#endif // TRACERECORDER_H
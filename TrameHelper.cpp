@@ -1,5 +1,6 @@
 #include "TrameHelper.h"
 #include <charconv>  // std::from_chars
+#include <cstring>   // std::strlen
 
 bool TrameHelper::matchAt(const char* p, const char* end, const char* lit)
 {
@@ -25,9 +26,10 @@ bool TrameHelper::findLastTag(const char* data, std::size_t len, const char* ope
 		{
 			const char* closePos = p - (closeLen - 1);
 			const std::size_t openLen = std::strlen(open);
-			for (const char* q = closePos; q >= begin + static_cast<ptrdiff_t>(openLen); --q)
+			// open sans '<' ("IPOC>") : le '<' précède le nom (évite "Status>" dans "<ConnectionStatus>")
+			for (const char* q = closePos; q >= begin + static_cast<ptrdiff_t>(openLen + 1); --q)
 			{
-				if (*(q - openLen) == '<' && matchAt(q - openLen, end, open))
+				if (*(q - openLen - 1) == '<' && matchAt(q - openLen, end, open))
 				{
 					const char* openPos = q - openLen;
 					valBegin = openPos + openLen;
@@ -49,7 +51,7 @@ bool TrameHelper::findOpenTagWindow(const char* data, std::size_t len, const cha
 
 	for (const char* p = begin; p + tagLen < end; ++p)
 	{
-		if (*p == '<' && matchAt(p, end, tagOpen))
+		if (*p == '<' && matchAt(p + 1, end, tagOpen))
 		{
 			winBegin = p;
 			for (const char* q = p; q + 1 < end; ++q)
@@ -0,0 +1,125 @@
+// ============================================================================
+// TrameHelperTests.cpp - Recherche de balises RSI (IPOC, RIst, scalaires)
+// ============================================================================
+// Les appelants passent le nom de balise sans '<' ("IPOC>", "RIst ") : le '<'
+// doit être vérifié avant le nom, sans quoi aucune balise n'est jamais trouvée
+// et un nom suffixe ("Status>") correspondrait à un autre ("<ConnectionStatus>").
+// ============================================================================
+
+#include "TrameHelper.h"
+#include "UnitTest.h"
+
+#include <cstddef>
+#include <string>
+
+namespace {
+
+const char* const kXYZABC[] = { "X", "Y", "Z", "A", "B", "C" };
+
+/** @brief Valeur de la dernière balise open...close, "<none>" si introuvable */
+std::string lastTag(const std::string& data, const char* open, const char* close)
+{
+    const char* value = nullptr;
+    std::size_t valueLen = 0;
+    if (!TrameHelper::findLastTag(data.data(), data.size(), open, close, value, valueLen))
+        return "<none>";
+    return std::string(value, valueLen);
+}
+
+/** @brief Fenêtre <tag .../>, "<none>" si introuvable */
+std::string openTagWindow(const std::string& data, const char* tagOpen)
+{
+    const char* winBegin = nullptr;
+    const char* winEnd = nullptr;
+    if (!TrameHelper::findOpenTagWindow(data.data(), data.size(), tagOpen, winBegin, winEnd))
+        return "<none>";
+    return std::string(winBegin, winEnd);
+}
+
+} // namespace
+
+void registerTrameHelperTests(UnitTest& tests)
+{
+    tests.add("TrameHelper/ipoc", []() {
+        const std::string rob =
+            "<Rob Type=\"KUKA\"><RIst X=\"1\" Y=\"2\" Z=\"3\" A=\"4\" B=\"5\" C=\"6\"/>"
+            "<IPOC>4208275431</IPOC></Rob>";
+        CHECK(lastTag(rob, "IPOC>", "</IPOC>") == "4208275431");
+
+        const std::string sen = "<Sen Type=\"ImFree\"><IPOC>17</IPOC></Sen>";
+        CHECK(lastTag(sen, "IPOC>", "</IPOC>") == "17");
+
+        // Balise vide : trouvée, valeur vide
+        CHECK(lastTag("<Rob><IPOC></IPOC></Rob>", "IPOC>", "</IPOC>").empty());
+    });
+
+    tests.add("TrameHelper/tagNameBoundary", []() {
+        // "Status>" ne doit pas correspondre à la fin de "<ConnectionStatus>"
+        const std::string log =
+            "<Log><ConnectionStatus>1</ConnectionStatus><Status>7</Status></Log>";
+        CHECK(lastTag(log, "Status>", "</Status>") == "7");
+        CHECK(lastTag(log, "ConnectionStatus>", "</ConnectionStatus>") == "1");
+
+        const std::string onlyConnection = "<Log><ConnectionStatus>1</ConnectionStatus></Log>";
+        CHECK(lastTag(onlyConnection, "Status>", "</Status>") == "<none>");
+    });
+
+    tests.add("TrameHelper/ristAttributes", []() {
+        const std::string rob =
+            "<Rob Type=\"KUKA\">"
+            "<RSol X=\"9\" Y=\"9\" Z=\"9\" A=\"9\" B=\"9\" C=\"9\"/>"
+            "<RIst X=\"512.25\" Y=\"-13.5\" Z=\"1024\" A=\"179.875\" B=\"-0.5\" C=\"90\"/>"
+            "<IPOC>100</IPOC></Rob>";
+
+        const char* winBegin = nullptr;
+        const char* winEnd = nullptr;
+        CHECK(TrameHelper::findOpenTagWindow(rob.data(), rob.size(), "RIst ", winBegin, winEnd));
+        CHECK(std::string(winBegin, winEnd) ==
+            "<RIst X=\"512.25\" Y=\"-13.5\" Z=\"1024\" A=\"179.875\" B=\"-0.5\" C=\"90\"/>");
+
+        double rist[6];
+        CHECK(TrameHelper::extractAttrDoubles(winBegin, winEnd, kXYZABC, rist, 6));
+        CHECK(rist[0] == 512.25);
+        CHECK(rist[1] == -13.5);
+        CHECK(rist[2] == 1024.0);
+        CHECK(rist[3] == 179.875);
+        CHECK(rist[4] == -0.5);
+        CHECK(rist[5] == 90.0);
+
+        // Le nom complet est exigé : "RIst " ne correspond ni à "<RIstX" ni à "<RSol "
+        CHECK(openTagWindow("<Rob><RIstX X=\"1\"/></Rob>", "RIst ") == "<none>");
+        CHECK(openTagWindow("<Rob><RSol X=\"1\"/></Rob>", "RIst ") == "<none>");
+    });
+
+    tests.add("TrameHelper/truncated", []() {
+        // Fermeture absente ou tronquée (datagramme coupé)
+        CHECK(lastTag("<Rob><IPOC>123456", "IPOC>", "</IPOC>") == "<none>");
+        CHECK(lastTag("<Rob><IPOC>123456</IPO", "IPOC>", "</IPOC>") == "<none>");
+        // Ouverture absente
+        CHECK(lastTag("<Rob>123456</IPOC></Rob>", "IPOC>", "</IPOC>") == "<none>");
+        CHECK(lastTag("", "IPOC>", "</IPOC>") == "<none>");
+
+        // Fenêtre d'attributs non refermée par "/>"
+        CHECK(openTagWindow("<Rob><RIst X=\"1\" Y=\"2\"", "RIst ") == "<none>");
+        CHECK(openTagWindow("<Rob><RIst", "RIst ") == "<none>");
+
+        // Attribut dont la valeur est coupée : les clés absentes restent à 0
+        const std::string cut = "<RIst X=\"7\" Y=\"";
+        double rist[6];
+        TrameHelper::extractAttrDoubles(cut.data(), cut.data() + cut.size(), kXYZABC, rist, 6);
+        CHECK(rist[0] == 7.0);
+        CHECK(rist[1] == 0.0);
+        CHECK(rist[5] == 0.0);
+    });
+
+    tests.add("TrameHelper/lastOccurrenceWins", []() {
+        const std::string data =
+            "<Rob><IPOC>1</IPOC><Delay D=\"0\"/><IPOC>22</IPOC>"
+            "<Log><IPOC>333</IPOC></Log></Rob>";
+        CHECK(lastTag(data, "IPOC>", "</IPOC>") == "333");
+
+        // Dernière occurrence complète : une ouverture finale sans fermeture est ignorée
+        const std::string trailing = "<IPOC>1</IPOC><IPOC>22</IPOC><IPOC>4";
+        CHECK(lastTag(trailing, "IPOC>", "</IPOC>") == "22");
+    });
+}
@@ -0,0 +1,322 @@
+#include "TriggerRecorder.h"
+
+#include "KukaRsiSystem.h"
+#include "StartBarrier.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QRegularExpression>
+#include <algorithm>
+#include <cmath>
+
+// =============================================================================
+// TriggerConfig
+// =============================================================================
+
+bool TriggerConfig::fromJson(const QJsonObject& obj, TriggerConfig& config, QString& error)
+{
+    const QString event = obj.value("event").toString(config.eventName()).toLower().remove('_');
+    if (event == QLatin1String("blocstart")) {
+        config.event = Event::BlocStart;
+    }
+    else if (event == QLatin1String("blocend")) {
+        config.event = Event::BlocEnd;
+    }
+    else if (event == QLatin1String("digin")) {
+        const QString edge = obj.value("edge").toString("rising").toLower();
+        if (edge != QLatin1String("rising") && edge != QLatin1String("falling")) {
+            error = QString("trigger: unknown edge \"%1\" (expected rising or falling)").arg(edge);
+            return false;
+        }
+        config.event    = edge == QLatin1String("rising") ? Event::DiginRising : Event::DiginFalling;
+        config.diginBit = obj.value("bit").toInt(config.diginBit);
+        if (config.diginBit < 0 || config.diginBit > 31) {
+            error = QString("trigger: Digin bit %1 out of range (0..31)").arg(config.diginBit);
+            return false;
+        }
+    }
+    else {
+        error = QString("trigger: unknown event \"%1\" (expected Bloc_Start, Bloc_End or Digin)")
+            .arg(obj.value("event").toString());
+        return false;
+    }
+
+    config.preSeconds  = obj.value("preSeconds").toDouble(config.preSeconds);
+    config.postSeconds = obj.value("postSeconds").toDouble(config.postSeconds);
+    if (config.preSeconds < 0.0 || config.postSeconds < 0.0
+        || config.preSeconds + config.postSeconds <= 0.0) {
+        error = "trigger: preSeconds and postSeconds must be >= 0 and not both 0";
+        return false;
+    }
+    return true;
+}
+
+QString TriggerConfig::eventName() const
+{
+    switch (event) {
+    case Event::BlocStart:    return QStringLiteral("Bloc_Start");
+    case Event::BlocEnd:      return QStringLiteral("Bloc_End");
+    case Event::DiginRising:  return QString("Digin%1_rising").arg(diginBit);
+    case Event::DiginFalling: return QString("Digin%1_falling").arg(diginBit);
+    }
+    return QString();
+}
+
+bool TriggerConfig::fired(const RsiRobotState& previous, const RsiRobotState& current) const
+{
+    const uint32_t mask = 1u << diginBit;
+    switch (event) {
+    case Event::BlocStart:    return previous.blocStart == 0 && current.blocStart != 0;
+    case Event::BlocEnd:      return previous.blocEnd == 0 && current.blocEnd != 0;
+    case Event::DiginRising:  return !(previous.digin & mask) && (current.digin & mask);
+    case Event::DiginFalling: return (previous.digin & mask) && !(current.digin & mask);
+    }
+    return false;
+}
+
+// =============================================================================
+// TriggerRecorder
+// =============================================================================
+
+TriggerRecorder::TriggerRecorder(const TriggerConfig& config, QObject* parent)
+    : QObject(parent)
+    , m_config(config)
+{
+    m_drainTimer = new QTimer(this);
+    m_drainTimer->setInterval(kDrainIntervalMs);
+    QObject::connect(m_drainTimer, &QTimer::timeout, this, &TriggerRecorder::onDrainTick);
+}
+
+TriggerRecorder::~TriggerRecorder()
+{
+    stop();
+}
+
+qint64 TriggerRecorder::hostNowUs()
+{
+    return StartBarrier::steadyNowNs() / 1000;
+}
+
+void TriggerRecorder::attach(IMeasurementSystem* system, const QString& name)
+{
+    auto channel = std::make_unique<Channel>();
+    channel->name   = name;
+    channel->system = system;
+    channel->ring   = std::make_shared<SpscRing<StampedFrame>>(kRingCapacity);
+
+    // Thread producteur du système : horodatage hôte à la publication
+    auto ring = channel->ring;
+    channel->subscription = system->subscribe([ring](const MeasurementFrame& frame) {
+        ring->tryPush(StampedFrame{ hostNowUs(), frame });
+    });
+    m_channels.push_back(std::move(channel));
+}
+
+void TriggerRecorder::addTriggerSource(KukaRsiSystem* robot)
+{
+    auto source = std::make_shared<Source>();
+    source->robot = robot;
+
+    // Thread d'acquisition du robot : robotStateUpdated suit publishFrame() dans le cycle
+    const QString robotName = robot->getAvailableObjects().value(0, robot->getSystemName());
+    QObject::connect(robot, &KukaRsiSystem::robotStateUpdated, this,
+        [this, source, robotName](const RsiRobotState& state) {
+            const bool fired = source->hasPrevious && m_config.fired(source->previous, state);
+            source->previous    = state;
+            source->hasPrevious = true;
+            if (fired) {
+                const qint64 hostUs  = hostNowUs();
+                const qint64 epochMs = QDateTime::currentMSecsSinceEpoch();
+                QMetaObject::invokeMethod(this, [this, hostUs, epochMs, robotName]() {
+                    onTrigger(hostUs, epochMs, robotName);
+                }, Qt::QueuedConnection);
+            }
+        }, Qt::DirectConnection);
+
+    m_sources.push_back(std::move(source));
+}
+
+bool TriggerRecorder::start()
+{
+    QDir dir(m_config.outputDirectory);
+    if (!dir.exists() && !dir.mkpath(".")) {
+        emit errorOccurred(QString("Cannot create output directory %1").arg(m_config.outputDirectory));
+        return false;
+    }
+    if (m_sources.empty())
+        emit logMessage("Trigger recorder: no KUKA source attached, nothing will be captured");
+
+    m_drainTimer->start();
+    emit logMessage(QString("Trigger recorder armed on %1 (%2 s before, %3 s after)")
+        .arg(m_config.eventName()).arg(m_config.preSeconds).arg(m_config.postSeconds));
+    return true;
+}
+
+void TriggerRecorder::stop()
+{
+    m_drainTimer->stop();
+
+    for (const auto& source : m_sources)
+        QObject::disconnect(source->robot, &KukaRsiSystem::robotStateUpdated, this, nullptr);
+    m_sources.clear();
+
+    // Frames déjà reçues : elles complètent la capture en cours
+    onDrainTick();
+    if (m_capturing)
+        closeCapture();
+
+    for (const auto& channel : m_channels)
+        channel->system->unsubscribe(channel->subscription);
+    m_channels.clear();
+}
+
+// =============================================================================
+// Historique et capture (thread du recorder)
+// =============================================================================
+
+void TriggerRecorder::onDrainTick()
+{
+    // Marge au-delà de pre : le déclenchement arrive ici par un appel différé,
+    // après des frames déjà postérieures à t
+    const qint64 keepUs = std::llround(m_config.preSeconds * 1e6) + kCompletionGraceMs * 1000LL;
+
+    for (const auto& channel : m_channels) {
+        StampedFrame stamped;
+        while (channel->ring->tryPop(stamped)) {
+            channel->lastHostUs = std::max(channel->lastHostUs, stamped.hostUs);
+            channel->history.push_back(std::move(stamped));
+        }
+
+        if (m_capturing)
+            appendWindow(*channel);
+
+        // Historique borné dans le temps, quelle que soit la cadence du système
+        while (!channel->history.empty()
+               && channel->history.front().hostUs < channel->lastHostUs - keepUs) {
+            channel->history.pop_front();
+            ++channel->historyBase;
+        }
+    }
+
+    if (!m_capturing)
+        return;
+
+    bool complete = true;
+    for (const auto& channel : m_channels)
+        complete = complete && channel->lastHostUs > m_captureEndUs;
+    if (complete || m_captureClock.elapsed() > m_captureWaitMs)
+        closeCapture();
+}
+
+void TriggerRecorder::onTrigger(qint64 hostUs, qint64 epochMs, const QString& robotName)
+{
+    const qint64 endUs = hostUs + std::llround(m_config.postSeconds * 1e6);
+
+    m_captureClock.start();
+    m_captureWaitMs = std::llround(m_config.postSeconds * 1000.0) + kCompletionGraceMs;
+
+    if (m_capturing) {
+        // Frames de l'historique entre l'ancienne et la nouvelle fin : sans trou
+        m_captureEndUs = std::max(m_captureEndUs, endUs);
+        for (const auto& channel : m_channels)
+            appendWindow(*channel);
+        emit logMessage(QString("%1 on %2: capture extended").arg(m_config.eventName(), robotName));
+        return;
+    }
+
+    m_captureStartUs = hostUs - std::llround(m_config.preSeconds * 1e6);
+    m_captureEndUs   = endUs;
+    if (!openCapture(epochMs))
+        return;
+
+    emit logMessage(QString("%1 on %2: capture #%3 started")
+        .arg(m_config.eventName(), robotName).arg(m_captureCount));
+}
+
+bool TriggerRecorder::openCapture(qint64 epochMs)
+{
+    const QString stamp = QDateTime::fromMSecsSinceEpoch(epochMs).toString("yyyyMMdd_HHmmss_zzz");
+    const QString extension = m_config.format == SessionFile::Format::Csv ? "csv" : "bin";
+    const QDir dir(m_config.outputDirectory);
+
+    for (const auto& channel : m_channels) {
+        QString safeName = channel->name;
+        safeName.replace(QRegularExpression("[^A-Za-z0-9_-]"), "_");
+
+        channel->file.setFileName(dir.filePath(QString("%1_%2_%3.%4")
+            .arg(safeName, stamp, m_config.eventName(), extension)));
+        if (!channel->file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            emit errorOccurred(QString("[%1] %2").arg(channel->name, channel->file.errorString()));
+            for (const auto& opened : m_channels)
+                opened->file.close();
+            return false;
+        }
+        channel->pending = SessionFile::fileHeader(m_config.format);
+        channel->pending.reserve(kWriteChunkBytes * 2);
+        channel->written = 0;
+
+        const auto first = std::lower_bound(channel->history.begin(), channel->history.end(), m_captureStartUs,
+            [](const StampedFrame& stamped, qint64 us) { return stamped.hostUs < us; });
+        channel->nextToWrite = channel->historyBase + static_cast<quint64>(first - channel->history.begin());
+    }
+
+    m_capturing = true;
+    ++m_captureCount;
+
+    // Fenêtre pré-déclenchement (et frames déjà reçues après l'événement)
+    for (const auto& channel : m_channels)
+        appendWindow(*channel);
+    return true;
+}
+
+void TriggerRecorder::appendWindow(Channel& channel)
+{
+    // Reprise après la dernière frame écrite, jusqu'à la fin courante (historique trié)
+    std::size_t i = static_cast<std::size_t>(std::max(channel.nextToWrite, channel.historyBase) - channel.historyBase);
+    for (; i < channel.history.size() && channel.history[i].hostUs <= m_captureEndUs; ++i)
+        append(channel, channel.history[i].frame);
+    channel.nextToWrite = channel.historyBase + i;
+}
+
+bool TriggerRecorder::append(Channel& channel, const MeasurementFrame& frame)
+{
+    if (!channel.file.isOpen())
+        return false;
+    SessionFile::appendFrame(m_config.format, channel.pending, frame);
+    ++channel.written;
+    return channel.pending.size() < kWriteChunkBytes || flush(channel);
+}
+
+bool TriggerRecorder::flush(Channel& channel)
+{
+    if (!channel.file.isOpen())
+        return false;
+    if (channel.file.write(channel.pending) != channel.pending.size()) {
+        emit errorOccurred(QString("[%1] Write error on %2: %3").arg(channel.name,
+            channel.file.fileName(), channel.file.errorString()));
+        channel.file.close();
+        channel.pending.clear();
+        return false;
+    }
+    channel.pending.clear();
+    return true;
+}
+
+void TriggerRecorder::closeCapture()
+{
+    QStringList files;
+    quint64     frames = 0;
+    for (const auto& channel : m_channels) {
+        if (!channel->file.isOpen())
+            continue;
+        flush(*channel);
+        files.append(channel->file.fileName());
+        frames += channel->written;
+        channel->file.close();
+    }
+    m_capturing = false;
+
+    emit logMessage(QString("Capture #%1 saved: %2 frames in %3 file(s)")
+        .arg(m_captureCount).arg(frames).arg(files.size()));
+    emit captureSaved(files, frames);
+}
@@ -0,0 +1,168 @@
+#pragma once
+#ifndef TRIGGERRECORDER_H
+#define TRIGGERRECORDER_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonObject>
+#include <QString>
+#include <QStringList>
+#include <QTimer>
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include "IMeasurementSystem.h"
+#include "RsiRobotState.h"
+#include "SessionFile.h"
+#include "SpscRing.h"
+
+class KukaRsiSystem;
+
+/**
+ * @brief Déclencheur et fenêtres d'un TriggerRecorder
+ *
+ *   "trigger": {
+ *     "event": "Bloc_Start",       // "Bloc_Start", "Bloc_End" ou "Digin"
+ *     "bit": 3,                    // Digin : numéro d'entrée (0..31)
+ *     "edge": "rising",            // Digin : "rising" ou "falling"
+ *     "preSeconds": 5,             // Historique gardé en mémoire avant l'événement
+ *     "postSeconds": 10            // Enregistrement après l'événement
+ *   }
+ *
+ * Bloc_Start / Bloc_End : front montant (0 → non nul) de la variable RSI.
+ */
+struct TriggerConfig {
+    enum class Event {
+        BlocStart,
+        BlocEnd,
+        DiginRising,
+        DiginFalling
+    };
+
+    Event               event           = Event::BlocStart;
+    int                 diginBit        = 0;
+    double              preSeconds      = 5.0;
+    double              postSeconds     = 5.0;
+    QString             outputDirectory = QStringLiteral(".");
+    SessionFile::Format format          = SessionFile::Format::Binary;
+
+    static bool fromJson(const QJsonObject& obj, TriggerConfig& config, QString& error);
+
+    /** @brief Libellé de l'événement (messages et noms de fichiers) */
+    QString eventName() const;
+
+    /** @brief Front de l'événement entre deux cycles RSI consécutifs */
+    bool fired(const RsiRobotState& previous, const RsiRobotState& current) const;
+};
+
+/**
+ * @brief Enregistrement sur événement robot : fenêtre pré-déclenchement + post-déclenchement
+ *
+ * Chaque système attaché dépose ses frames dans un anneau, vidé toutes les
+ * kDrainIntervalMs vers un historique en mémoire d'au moins preSeconds. Entre deux
+ * événements, rien n'est écrit sur disque.
+ *
+ * Fenêtres et complétude sont jugées sur l'horloge monotone de l'hôte
+ * (StartBarrier::steadyNowNs), relevée à la publication de chaque frame : les
+ * horodatages propres aux systèmes (epoch KUKA, horloge serveur NatNet, temps de
+ * capture QTM) ne sont pas comparables entre eux.
+ *
+ * Les sources (KukaRsiSystem) évaluent le déclencheur dans leur thread d'acquisition,
+ * à chaque robotStateUpdated ; t est relevé sur la même horloge. Au déclenchement, un
+ * fichier de session par système est ouvert (<nom>_<date>_<événement>.bin|csv) avec les
+ * frames de [t − pre, t + post]. Un nouvel événement pendant une capture la prolonge
+ * jusqu'à son propre t + post.
+ *
+ * La capture se termine quand tous les systèmes ont dépassé t + post, ou après
+ * kCompletionGraceMs supplémentaires si un système ne publie plus. stop() termine la
+ * capture en cours avec ce qui a été reçu.
+ */
+class TriggerRecorder : public QObject {
+    Q_OBJECT
+
+public:
+    static constexpr int         kDrainIntervalMs   = 20;
+    static constexpr std::size_t kRingCapacity      = 1u << 14;
+    static constexpr int         kWriteChunkBytes   = 1 << 20;
+    static constexpr int         kCompletionGraceMs = 2000;
+
+    explicit TriggerRecorder(const TriggerConfig& config, QObject* parent = nullptr);
+    ~TriggerRecorder() override;
+
+    /** @brief Historique et capture de ce système (avant start()) */
+    void attach(IMeasurementSystem* system, const QString& name);
+
+    /** @brief Évalue le déclencheur sur les cycles de ce robot (avant start()) */
+    void addTriggerSource(KukaRsiSystem* robot);
+
+    bool start();
+
+    /** @brief Termine la capture en cours et détache les systèmes */
+    void stop();
+
+    bool isCapturing() const { return m_capturing; }
+    int  captureCount() const { return m_captureCount; }
+
+signals:
+    void logMessage(const QString& message);
+    void errorOccurred(const QString& error);
+
+    /** @brief Capture terminée : un fichier par système attaché */
+    void captureSaved(const QStringList& files, quint64 frames);
+
+private:
+    /** @brief Frame et instant de publication (µs, horloge monotone de l'hôte) */
+    struct StampedFrame {
+        qint64           hostUs = 0;
+        MeasurementFrame frame;
+    };
+
+    struct Channel {
+        QString                                     name;
+        IMeasurementSystem*                         system = nullptr;
+        std::shared_ptr<SpscRing<StampedFrame>>     ring;
+        SubscriptionId                              subscription = 0;
+        std::deque<StampedFrame>                    history;        // Trié par hostUs
+        qint64                                      lastHostUs = 0;
+        quint64                                     historyBase = 0;    // Index absolu de history.front()
+        quint64                                     nextToWrite = 0;    // Index absolu (capture en cours)
+        QFile                                       file;
+        QByteArray                                  pending;
+        quint64                                     written = 0;
+    };
+
+    /** @brief État d'une source, propre à son thread d'acquisition */
+    struct Source {
+        KukaRsiSystem*    robot = nullptr;
+        RsiRobotState     previous;
+        bool              hasPrevious = false;
+    };
+
+    static qint64 hostNowUs();
+
+    void onDrainTick();
+    void onTrigger(qint64 hostUs, qint64 epochMs, const QString& robotName);
+
+    bool openCapture(qint64 epochMs);
+    void appendWindow(Channel& channel);
+    bool append(Channel& channel, const MeasurementFrame& frame);
+    bool flush(Channel& channel);
+    void closeCapture();
+
+    TriggerConfig                         m_config;
+    std::vector<std::unique_ptr<Channel>> m_channels;
+    std::vector<std::shared_ptr<Source>>  m_sources;
+    QTimer*                               m_drainTimer = nullptr;
+
+    bool          m_capturing      = false;
+    qint64        m_captureStartUs = 0;
+    qint64        m_captureEndUs   = 0;
+    QElapsedTimer m_captureClock;         // Depuis le dernier déclenchement
+    qint64        m_captureWaitMs  = 0;   // Au-delà : capture close même incomplète
+    int           m_captureCount   = 0;
+};
+
+#endif // TRIGGERRECORDER_H
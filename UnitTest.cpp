@@ -0,0 +1,53 @@
+#include "UnitTest.h"
+
+#include <chrono>
+#include <cstdio>
+
+int UnitTest::s_failures = 0;
+
+void UnitTest::add(const std::string& name, Body body)
+{
+    m_cases.push_back({ name, std::move(body) });
+}
+
+std::vector<std::string> UnitTest::names() const
+{
+    std::vector<std::string> result;
+    result.reserve(m_cases.size());
+    for (const Case& c : m_cases)
+        result.push_back(c.name);
+    return result;
+}
+
+int UnitTest::run(const std::string& filter) const
+{
+    int executed = 0;
+    int failed   = 0;
+    for (const Case& c : m_cases) {
+        if (!filter.empty() && c.name.find(filter) == std::string::npos)
+            continue;
+
+        s_failures = 0;
+        const auto start = std::chrono::steady_clock::now();
+        c.body();
+        const double ms = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start).count();
+
+        ++executed;
+        if (s_failures > 0)
+            ++failed;
+        std::printf("%-6s %-56s %8.2f ms\n", s_failures > 0 ? "FAIL" : "ok", c.name.c_str(), ms);
+    }
+
+    std::printf("\n%d test(s), %d failed\n", executed, failed);
+    return failed;
+}
+
+bool UnitTest::check(bool condition, const char* expression, const char* file, int line)
+{
+    if (!condition) {
+        ++s_failures;
+        std::fprintf(stderr, "  %s(%d): CHECK(%s) failed\n", file, line, expression);
+    }
+    return condition;
+}
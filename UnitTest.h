@@ -0,0 +1,98 @@
+#pragma once
+#ifndef UNITTEST_H
+#define UNITTEST_H
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Harnais de tests unitaires des décodeurs de protocole (exécutable Mobot4Tests)
+ *
+ * Chaque cas est une fonction ; CHECK compte les échecs sans interrompre le cas,
+ * pour voir toutes les assertions fausses d'un même paquet en une exécution.
+ *
+ * Sans Qt : le harnais ne dépend que de la bibliothèque standard, comme les
+ * décodeurs testés (NatNetDepacketizer, QtmRtProtocol).
+ */
+class UnitTest {
+public:
+    using Body = std::function<void()>;
+
+    /** @brief Enregistre un cas (nom "Groupe/cas", ordre d'exécution = ordre d'ajout) */
+    void add(const std::string& name, Body body);
+
+    std::vector<std::string> names() const;
+
+    /** @brief Exécute les cas dont le nom contient filter (vide = tous) ; nombre de cas en échec */
+    int run(const std::string& filter) const;
+
+    /** @brief Appelé par CHECK : un échec est attribué au cas en cours */
+    static bool check(bool condition, const char* expression, const char* file, int line);
+
+private:
+    struct Case {
+        std::string name;
+        Body        body;
+    };
+
+    std::vector<Case> m_cases;
+
+    static int s_failures;      // Échecs du cas en cours
+};
+
+#define CHECK(condition) UnitTest::check(static_cast<bool>(condition), #condition, __FILE__, __LINE__)
+
+/**
+ * @brief Construction de paquets de référence, champ par champ (little-endian hôte)
+ */
+class PacketWriter {
+public:
+    template<typename T>
+    PacketWriter& put(T value)
+    {
+        const std::size_t at = m_bytes.size();
+        m_bytes.resize(at + sizeof(T));
+        std::memcpy(&m_bytes[at], &value, sizeof(T));
+        return *this;
+    }
+
+    /** @brief Chaîne terminée par '\0' */
+    PacketWriter& putString(const std::string& text)
+    {
+        m_bytes.insert(m_bytes.end(), text.begin(), text.end());
+        m_bytes.push_back('\0');
+        return *this;
+    }
+
+    PacketWriter& putBytes(const std::string& bytes)
+    {
+        m_bytes.insert(m_bytes.end(), bytes.begin(), bytes.end());
+        return *this;
+    }
+
+    /** @brief Réserve un int32 à écrire plus tard (taille de section) ; sa position */
+    std::size_t reserveInt32()
+    {
+        const std::size_t at = m_bytes.size();
+        put<int32_t>(0);
+        return at;
+    }
+
+    /** @brief Écrit à at le nombre d'octets ajoutés depuis from */
+    void patchSize(std::size_t at, std::size_t from)
+    {
+        const int32_t size = static_cast<int32_t>(m_bytes.size() - from);
+        std::memcpy(&m_bytes[at], &size, sizeof(size));
+    }
+
+    std::size_t size() const { return m_bytes.size(); }
+    const std::string& bytes() const { return m_bytes; }
+
+private:
+    std::string m_bytes;
+};
+
+#endif // UNITTEST_H
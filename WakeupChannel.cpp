@@ -0,0 +1,95 @@
+#include "WakeupChannel.h"
+
+WakeupChannel::WakeupChannel() :
+	m_socket("127.0.0.1", 0)
+{
+}
+
+bool WakeupChannel::open()
+{
+	if (isOpen())
+		return true;
+
+	// Port éphémère, puis connexion à soi-même : seul wake() peut écrire ici
+	if (!m_socket.open() || !m_socket.bind() || !m_socket.connectTo("127.0.0.1", m_socket.localPort()))
+	{
+		m_socket.close();
+		return false;
+	}
+	m_pending = false;
+	return true;
+}
+
+void WakeupChannel::close()
+{
+	m_socket.close();
+	m_pending = false;
+}
+
+void WakeupChannel::wake()
+{
+	if (!isOpen() || m_pending.exchange(true, std::memory_order_acq_rel))
+		return;
+
+	const char byte = 1;
+	if (m_socket.send(&byte, 1) != 1)
+		m_pending = false;
+}
+
+int WakeupChannel::waitForAny(const SOCKET* handles, int count, int timeoutMs)
+{
+	fd_set readfds;
+	FD_ZERO(&readfds);
+
+	const SOCKET wakeHandle = m_socket.nativeHandle();
+	SOCKET maxFd = 0;
+	if (wakeHandle != INVALID_SOCKET)
+	{
+		FD_SET(wakeHandle, &readfds);
+		maxFd = wakeHandle;
+	}
+	else if (timeoutMs < 0)
+	{
+		timeoutMs = kFallbackTimeoutMs;
+	}
+
+	for (int i = 0; i < count; ++i)
+	{
+		if (handles[i] == INVALID_SOCKET)
+			continue;
+		FD_SET(handles[i], &readfds);
+		if (handles[i] > maxFd)
+			maxFd = handles[i];
+	}
+
+	timeval tv;
+	tv.tv_sec = timeoutMs / 1000;
+	tv.tv_usec = (timeoutMs % 1000) * 1000;
+
+	// Sous Winsock, le premier argument de select est ignoré (POSIX : plus grand fd + 1)
+	if (select(static_cast<int>(maxFd) + 1, &readfds, nullptr, nullptr, timeoutMs < 0 ? nullptr : &tv) <= 0)
+		return -1;
+
+	// Données prioritaires sur le réveil : l'appelant les traite puis réévalue son état
+	for (int i = 0; i < count; ++i)
+	{
+		if (handles[i] != INVALID_SOCKET && FD_ISSET(handles[i], &readfds))
+			return i;
+	}
+	if (wakeHandle != INVALID_SOCKET && FD_ISSET(wakeHandle, &readfds))
+		drain();
+	return -1;
+}
+
+void WakeupChannel::drain()
+{
+	// Remis à zéro avant la lecture : un wake() concurrent renvoie un datagramme
+	m_pending.store(false, std::memory_order_release);
+
+	char buffer[16];
+	while (m_socket.waitForData(0))
+	{
+		if (m_socket.recv(buffer, sizeof(buffer)) <= 0)
+			break;
+	}
+}
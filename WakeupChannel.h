@@ -0,0 +1,41 @@
+#pragma once
+#include "NativeUdpSocket.h"
+
+#include <atomic>
+
+// Réveil d'un thread bloqué dans select() (self-pipe portable)
+//
+// Socket UDP liée à 127.0.0.1 et connectée à elle-même : wake() s'envoie un
+// octet, ce qui la rend lisible. Le thread d'acquisition attend ses sockets via
+// waitForAny(), qui y ajoute ce canal, et peut alors bloquer sans délai : arrêt
+// et changements de consigne sont pris en compte immédiatement, sans réveil
+// périodique. Une socket plutôt qu'un eventfd/pipe : Winsock ne sait attendre
+// que des sockets dans select().
+class WakeupChannel {
+public:
+    WakeupChannel();
+    ~WakeupChannel() = default;
+
+    WakeupChannel(const WakeupChannel&) = delete;
+    WakeupChannel& operator=(const WakeupChannel&) = delete;
+
+    bool open();
+    void close();
+    bool isOpen() const { return m_socket.isConnected(); }
+
+    // Depuis n'importe quel thread ; les réveils en attente sont fusionnés
+    void wake();
+
+    // Attente sur handles (NativeUdpSocket / NativeTcpSocket::nativeHandle()) et sur
+    // ce canal : index du premier prêt, -1 si réveillé ou délai écoulé ; INVALID_SOCKET
+    // ignorés ; timeoutMs < 0 = sans délai (canal non ouvert : borné à kFallbackTimeoutMs)
+    int waitForAny(const SOCKET* handles, int count, int timeoutMs);
+
+    static constexpr int kFallbackTimeoutMs = 100;
+
+private:
+    void drain();
+
+    NativeUdpSocket   m_socket;
+    std::atomic<bool> m_pending{ false };   // Un datagramme déjà en route
+};
@@ -1,10 +1,15 @@
 ﻿#include <QApplication>
 #include "MainWindow.h"
+#include "TraceRecorder.h"
 
 int main(int argc, char* argv[])
 {
     QApplication app(argc, argv);
 
+    // MOBOT_TRACE=1 : traçage dès le démarrage (F9 arrête et enregistre)
+    if (qEnvironmentVariableIntValue("MOBOT_TRACE") != 0)
+        TraceRecorder::setEnabled(true);
+
     MainWindow w;
     w.show();
 
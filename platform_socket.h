@@ -0,0 +1,51 @@
+// ============================================================================
+// platform_socket.h - Sockets BSD portables (Winsock sous Windows, POSIX ailleurs)
+// ============================================================================
+// Objectif :
+//   - Windows : passer par platform_windows.h (ordre winsock2.h / windows.h)
+//   - Linux / macOS : exposer les mêmes noms que Winsock (SOCKET, INVALID_SOCKET,
+//     SOCKET_ERROR, closesocket, WSASetLastError...) pour que le code réseau
+//     (NativeUdpSocket, NativeTcpSocket, clients natifs) compile sans #ifdef à chaque appel
+//
+// À inclure à la place de platform_windows.h dans le code réseau portable
+// ============================================================================
+
+#pragma once
+
+#ifdef _WIN32
+
+#include "platform_windows.h"
+
+#else
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/select.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+
+using SOCKET = int;
+
+#ifndef INVALID_SOCKET
+#define INVALID_SOCKET (-1)
+#endif
+#ifndef SOCKET_ERROR
+#define SOCKET_ERROR   (-1)
+#endif
+
+#define WSAEINVAL      EINVAL
+#define WSAENOTCONN    ENOTCONN
+#define WSAEWOULDBLOCK EWOULDBLOCK
+#define WSAEINPROGRESS EINPROGRESS
+#define WSAETIMEDOUT   ETIMEDOUT
+
+inline int  closesocket(SOCKET s)   { return ::close(s); }
+inline void WSASetLastError(int e)  { errno = e; }
+inline int  WSAGetLastError()       { return errno; }
+
+#endif